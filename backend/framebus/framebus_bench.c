@@ -0,0 +1,159 @@
+/*
+ * framebus_bench - measure frame bus read latency and throughput.
+ *
+ *   framebus_bench --camera 1 --seconds 10
+ *   framebus_bench --synthetic 1280x800@100 --seconds 5
+ *
+ * With --synthetic a writer thread publishes Y8 frames on a private camera id,
+ * so the reader can be benchmarked without a running backend.
+ */
+#define _GNU_SOURCE
+#include "vision_framebus.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SYNTHETIC_CAMERA_ID 9999
+#define MAX_SAMPLES 1000000
+
+typedef struct {
+    int width;
+    int height;
+    int fps;
+    volatile int stop;
+    vfb_writer* writer;
+} synthetic_writer;
+
+static void sleep_us(int64_t us) {
+    struct timespec ts = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+    nanosleep(&ts, NULL);
+}
+
+static void* synthetic_loop(void* arg) {
+    synthetic_writer* sw = (synthetic_writer*)arg;
+    size_t size = (size_t)sw->width * sw->height;
+    uint8_t* frame = (uint8_t*)malloc(size);
+    int64_t period = 1000000 / sw->fps;
+    int64_t next = vfb_now_us();
+    uint64_t number = 0;
+
+    while (!__atomic_load_n(&sw->stop, __ATOMIC_RELAXED)) {
+        memset(frame, (int)(number & 0xff), size);
+        number++;
+        vfb_writer_publish(sw->writer, frame, (uint32_t)sw->width, (uint32_t)sw->height,
+                           (uint32_t)sw->width, VFB_FORMAT_Y8, VFB_EXPOSURE_ANY, number, vfb_now_us());
+        next += period;
+        int64_t wait = next - vfb_now_us();
+        if (wait > 0) sleep_us(wait);
+    }
+
+    free(frame);
+    return NULL;
+}
+
+static int compare_i64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr, "usage: %s [--camera N] [--seconds S] [--synthetic WxH@FPS]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    int camera_id = 1;
+    int seconds = 10;
+    int synthetic = 0;
+    synthetic_writer sw = {1280, 800, 100, 0, NULL};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--camera") == 0 && i + 1 < argc) {
+            camera_id = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--synthetic") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d@%d", &sw.width, &sw.height, &sw.fps) != 3 || sw.fps <= 0) {
+                usage(argv[0]);
+                return 2;
+            }
+            synthetic = 1;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    pthread_t writer_thread;
+    if (synthetic) {
+        int status = 0;
+        camera_id = SYNTHETIC_CAMERA_ID;
+        sw.writer = vfb_writer_create(camera_id, 4, (uint64_t)sw.width * sw.height, &status);
+        if (!sw.writer) {
+            fprintf(stderr, "failed to create synthetic ring (%d)\n", status);
+            return 1;
+        }
+        pthread_create(&writer_thread, NULL, synthetic_loop, &sw);
+    }
+
+    int status = 0;
+    vfb_reader* reader = vfb_reader_open(camera_id, &status);
+    if (!reader) {
+        fprintf(stderr, "failed to open /vision_cam%d (%d); is VISION_FRAMEBUS_ENABLED set?\n",
+                camera_id, status);
+        return 1;
+    }
+
+    size_t capacity = (size_t)vfb_reader_max_frame_size(reader);
+    uint8_t* buffer = (uint8_t*)malloc(capacity);
+    int64_t* latencies = (int64_t*)malloc(sizeof(int64_t) * MAX_SAMPLES);
+    size_t samples = 0;
+    uint64_t frames = 0, gaps = 0, bytes = 0, last = 0;
+
+    int64_t end = vfb_now_us() + (int64_t)seconds * 1000000;
+    while (vfb_now_us() < end) {
+        vfb_frame_info info;
+        int rc = vfb_reader_wait(reader, last, buffer, capacity, &info, 100);
+        int64_t after = vfb_now_us();
+        if (rc == VFB_NO_FRAME) continue;
+        if (rc != VFB_OK) {
+            fprintf(stderr, "read failed (%d)\n", rc);
+            break;
+        }
+
+        if (last != 0 && info.frame_number > last + 1) {
+            gaps += info.frame_number - last - 1;
+        }
+        last = info.frame_number;
+        frames++;
+        bytes += info.data_size;
+        if (samples < MAX_SAMPLES) {
+            latencies[samples++] = after - info.capture_time_us;
+        }
+    }
+
+    printf("frames read:       %llu\n", (unsigned long long)frames);
+    printf("frames skipped:    %llu\n", (unsigned long long)gaps);
+    printf("torn-read retries: %llu\n", (unsigned long long)vfb_reader_retries(reader));
+    if (samples > 0) {
+        qsort(latencies, samples, sizeof(int64_t), compare_i64);
+        printf("latency p50:       %lld us\n", (long long)latencies[samples / 2]);
+        printf("latency p99:       %lld us\n", (long long)latencies[(samples * 99) / 100]);
+        printf("latency max:       %lld us\n", (long long)latencies[samples - 1]);
+        printf("throughput:        %.1f MB/s\n", (double)bytes / ((double)seconds * 1e6));
+    }
+
+    vfb_reader_close(reader);
+    free(buffer);
+    free(latencies);
+
+    if (synthetic) {
+        __atomic_store_n(&sw.stop, 1, __ATOMIC_RELAXED);
+        pthread_join(writer_thread, NULL);
+        vfb_writer_destroy(sw.writer);
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * vision_framebus - shared-memory frame ring published by the 2852Vision backend.
+ *
+ * Each camera is exposed as a POSIX shared-memory object named "/vision_cam<id>".
+ * The object holds a header, a small ring of slot descriptors and the pixel data.
+ * Every slot is guarded by a seqlock, so readers never block the camera thread:
+ * a reader that races the writer simply retries on the newest slot.
+ *
+ * Timestamps are CLOCK_MONOTONIC microseconds (std::chrono::steady_clock on Linux).
+ */
+#ifndef VISION_FRAMEBUS_H
+#define VISION_FRAMEBUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VFB_MAGIC 0x31424656u /* "VFB1" */
+#define VFB_VERSION 1u
+#define VFB_MAX_SLOTS 16u
+
+enum vfb_format {
+    VFB_FORMAT_Y8 = 1,   /* 8-bit grayscale */
+    VFB_FORMAT_BGR8 = 2  /* 8-bit interleaved BGR */
+};
+
+/* Exposure of the frame when the camera alternates short and long exposures */
+enum vfb_exposure {
+    VFB_EXPOSURE_ANY = 0,    /* Camera is not alternating */
+    VFB_EXPOSURE_SHORT = 1,
+    VFB_EXPOSURE_LONG = 2
+};
+
+enum vfb_status {
+    VFB_OK = 0,
+    VFB_NO_FRAME = 1,        /* No frame newer than the one requested */
+    VFB_ERR_CLOSED = -1,     /* Writer closed the ring; reopen to follow the camera */
+    VFB_ERR_TOO_SMALL = -2,  /* Destination buffer smaller than the frame */
+    VFB_ERR_IO = -3,         /* shm_open/mmap failure */
+    VFB_ERR_FORMAT = -4,     /* Not a framebus object or incompatible version */
+    VFB_ERR_BUSY = -5        /* Writer kept overwriting the slot; try again */
+};
+
+typedef struct vfb_calibration {
+    uint32_t valid;
+    uint32_t dist_count;
+    double camera_matrix[9];  /* Row-major 3x3 */
+    double dist_coeffs[14];   /* OpenCV ordering */
+} vfb_calibration;
+
+typedef struct vfb_frame_info {
+    uint64_t frame_number;    /* Camera frame sequence number */
+    int64_t capture_time_us;  /* CLOCK_MONOTONIC capture time */
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;          /* Bytes per row in the slot (rows are packed) */
+    uint32_t format;          /* enum vfb_format */
+    uint32_t data_size;       /* stride * height */
+    uint32_t exposure;        /* enum vfb_exposure */
+} vfb_frame_info;
+
+/* ---- Shared memory layout ---- */
+
+typedef struct vfb_slot {
+    uint64_t seq;             /* Seqlock: odd while the writer is copying */
+    vfb_frame_info info;
+    uint8_t reserved[16];     /* Pad to one cache line */
+} vfb_slot;
+
+typedef struct vfb_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t camera_id;
+    uint32_t slot_count;
+    uint64_t slot_capacity;   /* Pixel bytes per slot */
+    uint64_t data_offset;     /* Offset of slot 0 pixel data from the header */
+    uint32_t closed;          /* Set when the writer tears the ring down */
+    uint32_t writer_pid;
+    uint64_t write_count;     /* Frames published; newest slot is (write_count - 1) % slot_count */
+    uint64_t calib_seq;       /* Seqlock for calib */
+    vfb_calibration calib;
+    vfb_slot slots[VFB_MAX_SLOTS];
+} vfb_header;
+
+/* ---- Reader API ---- */
+
+typedef struct vfb_reader vfb_reader;
+
+/* Open the ring for a camera. Returns NULL (and sets *status if non-NULL) on failure. */
+vfb_reader* vfb_reader_open(int camera_id, int* status);
+void vfb_reader_close(vfb_reader* reader);
+
+/* Copy the newest frame if it is newer than after_frame (pass 0 for any frame). */
+int vfb_reader_read(vfb_reader* reader, uint64_t after_frame,
+                    void* buffer, size_t buffer_size, vfb_frame_info* info);
+
+/* As vfb_reader_read, but poll until a newer frame arrives or timeout_ms elapses. */
+int vfb_reader_wait(vfb_reader* reader, uint64_t after_frame,
+                    void* buffer, size_t buffer_size, vfb_frame_info* info, int timeout_ms);
+
+/* Latest calibration published with the stream (valid == 0 if uncalibrated). */
+int vfb_reader_calibration(vfb_reader* reader, vfb_calibration* out);
+
+/* Largest frame the ring can carry; size read buffers with this. */
+uint64_t vfb_reader_max_frame_size(const vfb_reader* reader);
+
+/* Number of torn reads retried since open (diagnostic). */
+uint64_t vfb_reader_retries(const vfb_reader* reader);
+
+/* ---- Writer API (used by the backend) ---- */
+
+typedef struct vfb_writer vfb_writer;
+
+vfb_writer* vfb_writer_create(int camera_id, uint32_t slot_count, uint64_t slot_capacity, int* status);
+
+/* Publish one frame; rows are packed to width * bytes-per-pixel in the slot. */
+int vfb_writer_publish(vfb_writer* writer, const void* data,
+                       uint32_t width, uint32_t height, uint32_t src_stride, uint32_t format,
+                       uint32_t exposure, uint64_t frame_number, int64_t capture_time_us);
+
+void vfb_writer_set_calibration(vfb_writer* writer, const vfb_calibration* calib);
+uint64_t vfb_writer_capacity(const vfb_writer* writer);
+
+/* Mark the ring closed and unlink it. Existing readers see VFB_ERR_CLOSED. */
+void vfb_writer_destroy(vfb_writer* writer);
+
+/* ---- Helpers ---- */
+
+int64_t vfb_now_us(void);
+void vfb_shm_name(int camera_id, char* out, size_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VISION_FRAMEBUS_H */
@@ -0,0 +1,333 @@
+#define _GNU_SOURCE
+#include "vision_framebus.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+_Static_assert(sizeof(vfb_slot) == 64, "vfb_slot must be one cache line");
+
+#define VFB_DATA_ALIGN 4096u
+#define VFB_READ_ATTEMPTS 8
+
+struct vfb_reader {
+    int camera_id;
+    vfb_header* header;
+    size_t map_size;
+    uint64_t retries;
+};
+
+struct vfb_writer {
+    int camera_id;
+    char name[64];
+    vfb_header* header;
+    size_t map_size;
+};
+
+static uint64_t load_acquire(const uint64_t* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void store_release(uint64_t* p, uint64_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static uint8_t* slot_data(vfb_header* header, uint32_t index) {
+    return (uint8_t*)header + header->data_offset + (uint64_t)index * header->slot_capacity;
+}
+
+static uint32_t bytes_per_pixel(uint32_t format) {
+    return format == VFB_FORMAT_BGR8 ? 3u : 1u;
+}
+
+int64_t vfb_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void vfb_shm_name(int camera_id, char* out, size_t out_size) {
+    snprintf(out, out_size, "/vision_cam%d", camera_id);
+}
+
+/* ---- Reader ---- */
+
+vfb_reader* vfb_reader_open(int camera_id, int* status) {
+    char name[64];
+    struct stat st;
+    vfb_shm_name(camera_id, name, sizeof(name));
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        if (status) *status = VFB_ERR_IO;
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(vfb_header)) {
+        close(fd);
+        if (status) *status = VFB_ERR_FORMAT;
+        return NULL;
+    }
+
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        if (status) *status = VFB_ERR_IO;
+        return NULL;
+    }
+
+    vfb_header* header = (vfb_header*)map;
+    /* magic is written last by the writer, so a half-initialised ring fails here */
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != VFB_MAGIC ||
+        header->version != VFB_VERSION ||
+        header->slot_count == 0 || header->slot_count > VFB_MAX_SLOTS ||
+        header->data_offset + header->slot_count * header->slot_capacity > (uint64_t)st.st_size) {
+        munmap(map, (size_t)st.st_size);
+        if (status) *status = VFB_ERR_FORMAT;
+        return NULL;
+    }
+
+    vfb_reader* reader = (vfb_reader*)calloc(1, sizeof(vfb_reader));
+    if (!reader) {
+        munmap(map, (size_t)st.st_size);
+        if (status) *status = VFB_ERR_IO;
+        return NULL;
+    }
+    reader->camera_id = camera_id;
+    reader->header = header;
+    reader->map_size = (size_t)st.st_size;
+    if (status) *status = VFB_OK;
+    return reader;
+}
+
+void vfb_reader_close(vfb_reader* reader) {
+    if (!reader) return;
+    munmap(reader->header, reader->map_size);
+    free(reader);
+}
+
+int vfb_reader_read(vfb_reader* reader, uint64_t after_frame,
+                    void* buffer, size_t buffer_size, vfb_frame_info* info) {
+    vfb_header* header = reader->header;
+
+    for (int attempt = 0; attempt < VFB_READ_ATTEMPTS; attempt++) {
+        if (__atomic_load_n(&header->closed, __ATOMIC_ACQUIRE)) {
+            return VFB_ERR_CLOSED;
+        }
+
+        uint64_t count = load_acquire(&header->write_count);
+        if (count == 0) {
+            return VFB_NO_FRAME;
+        }
+
+        uint32_t index = (uint32_t)((count - 1) % header->slot_count);
+        vfb_slot* slot = &header->slots[index];
+
+        uint64_t seq_before = load_acquire(&slot->seq);
+        if (seq_before & 1u) {
+            reader->retries++;
+            continue;
+        }
+
+        vfb_frame_info snapshot = slot->info;
+        if (snapshot.frame_number <= after_frame) {
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq_before) {
+                return VFB_NO_FRAME;
+            }
+            reader->retries++;
+            continue;
+        }
+        if (snapshot.data_size > header->slot_capacity) {
+            reader->retries++;
+            continue;
+        }
+        if (snapshot.data_size > buffer_size) {
+            return VFB_ERR_TOO_SMALL;
+        }
+
+        memcpy(buffer, slot_data(header, index), snapshot.data_size);
+
+        /* Validate that the writer did not touch the slot while we copied */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq_before) {
+            if (info) *info = snapshot;
+            return VFB_OK;
+        }
+        reader->retries++;
+    }
+
+    return VFB_ERR_BUSY;
+}
+
+int vfb_reader_wait(vfb_reader* reader, uint64_t after_frame,
+                    void* buffer, size_t buffer_size, vfb_frame_info* info, int timeout_ms) {
+    int64_t deadline = vfb_now_us() + (int64_t)timeout_ms * 1000;
+    for (;;) {
+        int rc = vfb_reader_read(reader, after_frame, buffer, buffer_size, info);
+        if (rc != VFB_NO_FRAME && rc != VFB_ERR_BUSY) {
+            return rc;
+        }
+        if (vfb_now_us() >= deadline) {
+            return VFB_NO_FRAME;
+        }
+        /* Frames arrive every few ms; a short sleep keeps latency low without spinning */
+        struct timespec ts = {0, 250 * 1000};
+        nanosleep(&ts, NULL);
+    }
+}
+
+int vfb_reader_calibration(vfb_reader* reader, vfb_calibration* out) {
+    vfb_header* header = reader->header;
+    for (int attempt = 0; attempt < VFB_READ_ATTEMPTS; attempt++) {
+        uint64_t seq_before = load_acquire(&header->calib_seq);
+        if (seq_before & 1u) {
+            continue;
+        }
+        memcpy(out, &header->calib, sizeof(vfb_calibration));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&header->calib_seq, __ATOMIC_RELAXED) == seq_before) {
+            return VFB_OK;
+        }
+    }
+    return VFB_ERR_BUSY;
+}
+
+uint64_t vfb_reader_max_frame_size(const vfb_reader* reader) {
+    return reader->header->slot_capacity;
+}
+
+uint64_t vfb_reader_retries(const vfb_reader* reader) {
+    return reader->retries;
+}
+
+/* ---- Writer ---- */
+
+vfb_writer* vfb_writer_create(int camera_id, uint32_t slot_count, uint64_t slot_capacity, int* status) {
+    if (slot_count == 0 || slot_count > VFB_MAX_SLOTS || slot_capacity == 0) {
+        if (status) *status = VFB_ERR_FORMAT;
+        return NULL;
+    }
+
+    vfb_writer* writer = (vfb_writer*)calloc(1, sizeof(vfb_writer));
+    if (!writer) {
+        if (status) *status = VFB_ERR_IO;
+        return NULL;
+    }
+    writer->camera_id = camera_id;
+    vfb_shm_name(camera_id, writer->name, sizeof(writer->name));
+
+    /* Start from a fresh object; readers of a stale ring keep their old mapping */
+    shm_unlink(writer->name);
+    int fd = shm_open(writer->name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        free(writer);
+        if (status) *status = VFB_ERR_IO;
+        return NULL;
+    }
+    fchmod(fd, 0644);
+
+    uint64_t data_offset = (sizeof(vfb_header) + VFB_DATA_ALIGN - 1) & ~(uint64_t)(VFB_DATA_ALIGN - 1);
+    uint64_t capacity = (slot_capacity + 63u) & ~(uint64_t)63u;
+    size_t map_size = (size_t)(data_offset + capacity * slot_count);
+
+    if (ftruncate(fd, (off_t)map_size) != 0) {
+        close(fd);
+        shm_unlink(writer->name);
+        free(writer);
+        if (status) *status = VFB_ERR_IO;
+        return NULL;
+    }
+
+    void* map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(writer->name);
+        free(writer);
+        if (status) *status = VFB_ERR_IO;
+        return NULL;
+    }
+
+    vfb_header* header = (vfb_header*)map;
+    header->version = VFB_VERSION;
+    header->camera_id = (uint32_t)camera_id;
+    header->slot_count = slot_count;
+    header->slot_capacity = capacity;
+    header->data_offset = data_offset;
+    header->writer_pid = (uint32_t)getpid();
+    __atomic_store_n(&header->magic, VFB_MAGIC, __ATOMIC_RELEASE);
+
+    writer->header = header;
+    writer->map_size = map_size;
+    if (status) *status = VFB_OK;
+    return writer;
+}
+
+int vfb_writer_publish(vfb_writer* writer, const void* data,
+                       uint32_t width, uint32_t height, uint32_t src_stride, uint32_t format,
+                       uint32_t exposure, uint64_t frame_number, int64_t capture_time_us) {
+    vfb_header* header = writer->header;
+    uint32_t row_bytes = width * bytes_per_pixel(format);
+    uint64_t data_size = (uint64_t)row_bytes * height;
+    if (data_size > header->slot_capacity) {
+        return VFB_ERR_TOO_SMALL;
+    }
+
+    /* Only this thread writes the header, so plain reads of our own fields are safe */
+    uint64_t count = header->write_count;
+    uint32_t index = (uint32_t)(count % header->slot_count);
+    vfb_slot* slot = &header->slots[index];
+
+    uint64_t seq = slot->seq;
+    __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    uint8_t* dst = slot_data(header, index);
+    const uint8_t* src = (const uint8_t*)data;
+    if (src_stride == row_bytes) {
+        memcpy(dst, src, (size_t)data_size);
+    } else {
+        for (uint32_t row = 0; row < height; row++) {
+            memcpy(dst + (size_t)row * row_bytes, src + (size_t)row * src_stride, row_bytes);
+        }
+    }
+
+    slot->info.frame_number = frame_number;
+    slot->info.capture_time_us = capture_time_us;
+    slot->info.width = width;
+    slot->info.height = height;
+    slot->info.stride = row_bytes;
+    slot->info.format = format;
+    slot->info.data_size = (uint32_t)data_size;
+    slot->info.exposure = exposure;
+
+    store_release(&slot->seq, seq + 2);
+    store_release(&header->write_count, count + 1);
+    return VFB_OK;
+}
+
+void vfb_writer_set_calibration(vfb_writer* writer, const vfb_calibration* calib) {
+    vfb_header* header = writer->header;
+    uint64_t seq = header->calib_seq;
+    __atomic_store_n(&header->calib_seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&header->calib, calib, sizeof(vfb_calibration));
+    store_release(&header->calib_seq, seq + 2);
+}
+
+uint64_t vfb_writer_capacity(const vfb_writer* writer) {
+    return writer->header->slot_capacity;
+}
+
+void vfb_writer_destroy(vfb_writer* writer) {
+    if (!writer) return;
+    __atomic_store_n(&writer->header->closed, 1u, __ATOMIC_RELEASE);
+    munmap(writer->header, writer->map_size);
+    shm_unlink(writer->name);
+    free(writer);
+}
@@ -0,0 +1,177 @@
+// Windows compatibility - must be included before any Drogon headers
+#include "platform/win32_compat.hpp"
+
+#include "perf_clients.hpp"
+#include <drogon/WebSocketClient.h>
+#include <drogon/drogon.h>
+#include <networktables/MultiSubscriber.h>
+#include <networktables/NetworkTableInstance.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <wpi/Logger.h>
+#include <wpinet/NetworkStream.h>
+#include <wpinet/TCPConnector.h>
+#include <chrono>
+#include <string_view>
+
+namespace vision::perf {
+
+namespace {
+    constexpr int CONNECT_TIMEOUT_S = 2;
+    constexpr std::string_view FRAME_MARKER = "image/jpeg";
+}
+
+// ============== MjpegClient ==============
+
+MjpegClient::MjpegClient(uint16_t port, std::string path) : port_(port), path_(std::move(path)) {}
+
+MjpegClient::~MjpegClient() {
+    stop();
+}
+
+void MjpegClient::start() {
+    running_ = true;
+    thread_ = std::thread(&MjpegClient::run, this);
+}
+
+void MjpegClient::stop() {
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void MjpegClient::run() {
+    wpi::Logger logger;
+    std::vector<char> buffer(64 * 1024);
+    std::string tail;
+
+    while (running_) {
+        auto stream = wpi::TCPConnector::connect("127.0.0.1", port_, logger, CONNECT_TIMEOUT_S);
+        if (!stream) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            continue;
+        }
+
+        std::string request = "GET " + path_ + " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+        wpi::NetworkStream::Error err;
+        stream->send(request.data(), request.size(), &err);
+
+        while (running_) {
+            size_t n = stream->receive(buffer.data(), buffer.size(), &err, 1);
+            if (n == 0) {
+                if (err == wpi::NetworkStream::kConnectionTimedOut) continue;
+                break;
+            }
+            bytes_ += n;
+
+            // Count part headers; keep a short tail so markers split across reads are found
+            std::string window = tail + std::string(buffer.data(), n);
+            size_t pos = 0;
+            while ((pos = window.find(FRAME_MARKER, pos)) != std::string::npos) {
+                frames_++;
+                pos += FRAME_MARKER.size();
+            }
+            size_t keep = (std::min)(window.size(), FRAME_MARKER.size() - 1);
+            tail = window.substr(window.size() - keep);
+        }
+        stream->close();
+    }
+}
+
+// ============== WebSocketClient ==============
+
+struct WebSocketClient::Impl {
+    drogon::WebSocketClientPtr client;
+};
+
+WebSocketClient::WebSocketClient(uint16_t httpPort, std::vector<std::pair<int, int>> cameraPipelines)
+    : impl_(std::make_unique<Impl>())
+    , httpPort_(httpPort)
+    , cameraPipelines_(std::move(cameraPipelines))
+    , messages_(std::make_shared<std::atomic<uint64_t>>(0))
+    , connected_(std::make_shared<std::atomic<bool>>(false)) {}
+
+WebSocketClient::~WebSocketClient() {
+    stop();
+}
+
+void WebSocketClient::start() {
+    using namespace drogon;
+
+    impl_->client = drogon::WebSocketClient::newWebSocketClient("127.0.0.1", httpPort_);
+    auto messages = messages_;
+    impl_->client->setMessageHandler(
+        [messages](const std::string&, const WebSocketClientPtr&, const WebSocketMessageType& type) {
+            if (type == WebSocketMessageType::Text) {
+                (*messages)++;
+            }
+        });
+
+    auto req = HttpRequest::newHttpRequest();
+    req->setPath("/ws/vision");
+
+    auto subscriptions = cameraPipelines_;
+    auto connected = connected_;
+    impl_->client->connectToServer(req,
+        [subscriptions, connected](ReqResult result, const HttpResponsePtr&, const WebSocketClientPtr& ws) {
+            if (result != ReqResult::Ok) {
+                spdlog::error("Perf WebSocket client failed to connect");
+                return;
+            }
+            connected->store(true);
+            auto conn = ws->getConnection();
+            conn->send(nlohmann::json{{"type", "subscribe"}, {"topic", "metrics"}}.dump());
+            for (const auto& [cameraId, pipelineId] : subscriptions) {
+                conn->send(nlohmann::json{
+                    {"type", "subscribe"}, {"topic", "pipeline_results"},
+                    {"cameraId", cameraId}, {"pipelineId", pipelineId}}.dump());
+            }
+        });
+}
+
+void WebSocketClient::stop() {
+    if (impl_ && impl_->client) {
+        impl_->client->stop();
+        impl_->client.reset();
+    }
+    connected_->store(false);
+}
+
+// ============== NetworkTablesClient ==============
+
+struct NetworkTablesClient::Impl {
+    nt::NetworkTableInstance inst;
+    std::unique_ptr<nt::MultiSubscriber> subscriber;
+    NT_Listener listener = 0;
+};
+
+NetworkTablesClient::NetworkTablesClient()
+    : impl_(std::make_unique<Impl>())
+    , updates_(std::make_shared<std::atomic<uint64_t>>(0)) {}
+
+NetworkTablesClient::~NetworkTablesClient() {
+    stop();
+}
+
+void NetworkTablesClient::start() {
+    impl_->inst = nt::NetworkTableInstance::Create();
+    impl_->inst.SetServer("127.0.0.1");
+    impl_->inst.StartClient4("vision_perf");
+
+    std::string_view prefixes[] = {"/"};
+    impl_->subscriber = std::make_unique<nt::MultiSubscriber>(impl_->inst, prefixes);
+    auto updates = updates_;
+    impl_->listener = impl_->inst.AddListener(prefixes, nt::EventFlags::kValueAll,
+        [updates](const nt::Event&) { (*updates)++; });
+}
+
+void NetworkTablesClient::stop() {
+    if (!impl_ || !impl_->subscriber) return;
+    impl_->inst.RemoveListener(impl_->listener);
+    impl_->subscriber.reset();
+    impl_->inst.StopClient();
+    nt::NetworkTableInstance::Destroy(impl_->inst);
+}
+
+} // namespace vision::perf
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace vision::perf {
+
+// Reads an MJPEG stream and counts frames, like a dashboard viewer
+class MjpegClient {
+public:
+    MjpegClient(uint16_t port, std::string path);
+    ~MjpegClient();
+
+    void start();
+    void stop();
+
+    uint64_t frames() const { return frames_.load(); }
+    uint64_t bytes() const { return bytes_.load(); }
+    const std::string& path() const { return path_; }
+
+private:
+    void run();
+
+    uint16_t port_;
+    std::string path_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::thread thread_;
+};
+
+// Subscribes to pipeline results and metrics over /ws/vision, like the web UI
+class WebSocketClient {
+public:
+    WebSocketClient(uint16_t httpPort, std::vector<std::pair<int, int>> cameraPipelines);
+    ~WebSocketClient();
+
+    void start();
+    void stop();
+
+    uint64_t messages() const { return messages_->load(); }
+    bool connected() const { return connected_->load(); }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    uint16_t httpPort_;
+    std::vector<std::pair<int, int>> cameraPipelines_;
+    std::shared_ptr<std::atomic<uint64_t>> messages_;
+    std::shared_ptr<std::atomic<bool>> connected_;
+};
+
+// Connects to the local NT server and counts value updates, like the robot program
+class NetworkTablesClient {
+public:
+    NetworkTablesClient();
+    ~NetworkTablesClient();
+
+    void start();
+    void stop();
+
+    uint64_t updates() const { return updates_->load(); }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    std::shared_ptr<std::atomic<uint64_t>> updates_;
+};
+
+} // namespace vision::perf
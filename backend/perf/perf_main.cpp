@@ -0,0 +1,371 @@
+// Windows compatibility - must be included before any Drogon headers
+#include "platform/win32_compat.hpp"
+
+// End-to-end performance harness: boots ThreadManager with replay cameras, a local NT
+// server and headless WebSocket/MJPEG/NT clients, then reports per-stage latency,
+// throughput, CPU and RSS and optionally gates them against a stored baseline.
+
+#include <drogon/drogon.h>
+#include <spdlog/spdlog.h>
+#include <opencv2/core/utils/logger.hpp>
+
+#include "core/config.hpp"
+#include "core/database.hpp"
+#include "metrics/memory.hpp"
+#include "metrics/registry.hpp"
+#include "services/networktables_service.hpp"
+#include "services/streamer_service.hpp"
+#include "threads/thread_manager.hpp"
+#include "vision/field_layout.hpp"
+
+#include "perf_clients.hpp"
+#include "perf_report.hpp"
+
+#include <sys/resource.h>
+#include <unistd.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace vision;
+
+namespace {
+
+struct Options {
+    int cameras = 1;
+    int apriltag = 1;
+    int ml = 0;
+    int flow = 1;
+    int width = 1280;
+    int height = 720;
+    int fps = 60;
+    int durationS = 30;
+    int warmupS = 5;
+    std::string frames = "synthetic";
+    std::string model;
+    uint16_t httpPort = 15001;
+    uint16_t streamPort = 15805;
+    bool viewers = true;
+    std::string reportPath;
+    std::string baselinePath;
+    std::string writeBaselinePath;
+    double threshold = 0.15;
+    bool verbose = false;
+};
+
+void usage() {
+    std::cerr <<
+        "usage: vision_perf [options]\n"
+        "  --cameras N            replay cameras (default 1)\n"
+        "  --apriltag M           AprilTag pipelines per camera (default 1)\n"
+        "  --ml M                 ML pipelines per camera, requires --model (default 0)\n"
+        "  --flow M               optical flow pipelines per camera (default 1)\n"
+        "  --frames SRC           image directory, video file or 'synthetic' (default)\n"
+        "  --model FILE           ONNX model for ML pipelines\n"
+        "  --resolution WxH       synthetic frame size (default 1280x720)\n"
+        "  --fps N                replay framerate (default 60)\n"
+        "  --duration S           measured seconds (default 30)\n"
+        "  --warmup S             unmeasured seconds before measuring (default 5)\n"
+        "  --no-viewers           skip MJPEG viewers\n"
+        "  --report FILE          write the JSON report\n"
+        "  --baseline FILE        fail (exit 1) on regressions against this report;\n"
+        "                         exits 2 if it is missing or used other options\n"
+        "  --threshold PCT        allowed regression in percent (default 15)\n"
+        "  --write-baseline FILE  store this run as the new baseline\n"
+        "  --verbose              keep backend logging at info\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(arg + " needs a value");
+            return argv[++i];
+        };
+
+        if (arg == "--cameras") opts.cameras = std::stoi(next());
+        else if (arg == "--apriltag") opts.apriltag = std::stoi(next());
+        else if (arg == "--ml") opts.ml = std::stoi(next());
+        else if (arg == "--flow") opts.flow = std::stoi(next());
+        else if (arg == "--frames") opts.frames = next();
+        else if (arg == "--model") opts.model = next();
+        else if (arg == "--fps") opts.fps = std::stoi(next());
+        else if (arg == "--duration") opts.durationS = std::stoi(next());
+        else if (arg == "--warmup") opts.warmupS = std::stoi(next());
+        else if (arg == "--no-viewers") opts.viewers = false;
+        else if (arg == "--report") opts.reportPath = next();
+        else if (arg == "--baseline") opts.baselinePath = next();
+        else if (arg == "--threshold") opts.threshold = std::stod(next()) / 100.0;
+        else if (arg == "--write-baseline") opts.writeBaselinePath = next();
+        else if (arg == "--verbose") opts.verbose = true;
+        else if (arg == "--resolution") {
+            std::string value = next();
+            auto x = value.find('x');
+            if (x == std::string::npos) throw std::invalid_argument("resolution must be WxH");
+            opts.width = std::stoi(value.substr(0, x));
+            opts.height = std::stoi(value.substr(x + 1));
+        } else {
+            return false;
+        }
+    }
+
+    if (opts.ml > 0 && opts.model.empty()) {
+        throw std::invalid_argument("--ml requires --model");
+    }
+    return opts.cameras > 0 && opts.durationS > 0 && opts.fps > 0;
+}
+
+double cpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+           usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+std::optional<nlohmann::json> readJson(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return std::nullopt;
+    try {
+        return nlohmann::json::parse(file);
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to parse {}: {}", path, e.what());
+        return std::nullopt;
+    }
+}
+
+// What a baseline must match for its numbers to be comparable
+nlohmann::json runConfig(const Options& opts) {
+    return {
+        {"cameras", opts.cameras}, {"apriltag", opts.apriltag}, {"ml", opts.ml},
+        {"optical_flow", opts.flow}, {"frames", opts.frames},
+        {"resolution", std::to_string(opts.width) + "x" + std::to_string(opts.height)},
+        {"fps", opts.fps}, {"viewers", opts.viewers}, {"hardware_threads", std::thread::hardware_concurrency()}
+    };
+}
+
+// Checked before the run so a missing or mismatched baseline fails in seconds
+std::optional<nlohmann::json> loadBaseline(const Options& opts) {
+    auto baseline = readJson(opts.baselinePath);
+    if (!baseline) {
+        std::cerr << "FAIL: cannot read baseline " << opts.baselinePath << "\n"
+                  << "Record one on this machine with: cmake --build <build> --target perf_baseline\n";
+        return std::nullopt;
+    }
+
+    auto expected = runConfig(opts);
+    const auto& recorded = (*baseline)["config"];
+    if (recorded != expected) {
+        std::cerr << "FAIL: baseline was recorded with a different configuration\n";
+        for (const auto& [key, value] : expected.items()) {
+            auto it = recorded.find(key);
+            std::string was = it == recorded.end() ? "missing" : it->dump();
+            if (was != value.dump()) {
+                std::cerr << "  " << key << ": baseline " << was << ", now " << value.dump() << "\n";
+            }
+        }
+        std::cerr << "Re-record it with the same options, e.g. the perf_baseline target\n";
+        return std::nullopt;
+    }
+    return baseline;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    try {
+        if (!parseArgs(argc, argv, opts)) {
+            usage();
+            return 2;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        usage();
+        return 2;
+    }
+
+    std::optional<nlohmann::json> baseline;
+    if (!opts.baselinePath.empty()) {
+        baseline = loadBaseline(opts);
+        if (!baseline) {
+            return 2;
+        }
+    }
+
+    cv::utils::logging::setLogLevel(cv::utils::logging::LOG_LEVEL_ERROR);
+    spdlog::set_level(opts.verbose ? spdlog::level::info : spdlog::level::warn);
+
+    // Backend services, isolated from the real database and ports
+    auto& config = Config::instance();
+    config.load();
+    auto dbPath = std::filesystem::temp_directory_path() /
+                  ("vision_perf_" + std::to_string(getpid()) + ".db");
+    Database::instance().initialize(dbPath.string());
+    FieldLayoutService::instance().initialize(config.data_directory);
+    StreamerService::instance().initialize(opts.streamPort);
+    NetworkTablesService::instance().startServer();
+
+    drogon::app()
+        .addListener("127.0.0.1", opts.httpPort)
+        .setThreadNum(2)
+        .setLogLevel(trantor::Logger::kWarn);
+    std::thread appThread([]() { drogon::app().run(); });
+    while (!drogon::app().isRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Cameras and pipelines
+    struct PipelineInfo {
+        int id;
+        int cameraId;
+        std::string type;
+    };
+    std::vector<PipelineInfo> pipelines;
+    int nextPipelineId = 1;
+
+    for (int c = 1; c <= opts.cameras; c++) {
+        Camera camera;
+        camera.id = c;
+        camera.name = "replay" + std::to_string(c);
+        camera.camera_type = CameraType::Replay;
+        camera.identifier = opts.frames;
+        camera.resolution_json = nlohmann::json{{"width", opts.width}, {"height", opts.height}}.dump();
+        camera.framerate = opts.fps;
+        if (!ThreadManager::instance().startCamera(camera)) {
+            spdlog::error("Failed to start replay camera {}", c);
+            return 2;
+        }
+
+        auto addPipelines = [&](int count, PipelineType type, const std::string& typeName,
+                                const nlohmann::json& pipelineConfig) {
+            for (int p = 0; p < count; p++) {
+                Pipeline pipeline;
+                pipeline.id = nextPipelineId++;
+                pipeline.name = typeName + std::to_string(pipeline.id);
+                pipeline.pipeline_type = type;
+                pipeline.camera_id = c;
+                pipeline.setConfigJson(pipelineConfig);
+                if (ThreadManager::instance().startPipeline(pipeline, c)) {
+                    pipelines.push_back({pipeline.id, c, typeName});
+                } else {
+                    spdlog::error("Failed to start {} pipeline on camera {}", typeName, c);
+                }
+            }
+        };
+        addPipelines(opts.apriltag, PipelineType::AprilTag, "apriltag", nlohmann::json::object());
+        addPipelines(opts.ml, PipelineType::ObjectDetectionML, "ml",
+                     {{"model_filename", std::filesystem::absolute(opts.model).string()}});
+        addPipelines(opts.flow, PipelineType::OpticalFlow, "optical_flow", nlohmann::json::object());
+    }
+
+    // Headless clients
+    std::vector<std::pair<int, int>> subscriptions;
+    for (const auto& p : pipelines) {
+        subscriptions.push_back({p.cameraId, p.id});
+    }
+    perf::WebSocketClient wsClient(opts.httpPort, subscriptions);
+    perf::NetworkTablesClient ntClient;
+    std::vector<std::unique_ptr<perf::MjpegClient>> viewers;
+    if (opts.viewers) {
+        // One dashboard viewer on the first camera and on the first pipeline
+        viewers.push_back(std::make_unique<perf::MjpegClient>(opts.streamPort, "/camera/1"));
+        if (!pipelines.empty()) {
+            viewers.push_back(std::make_unique<perf::MjpegClient>(
+                opts.streamPort, "/pipeline/" + std::to_string(pipelines.front().id)));
+        }
+    }
+    wsClient.start();
+    ntClient.start();
+    for (auto& viewer : viewers) {
+        viewer->start();
+    }
+
+    std::cerr << "Warming up for " << opts.warmupS << "s...\n";
+    std::this_thread::sleep_for(std::chrono::seconds(opts.warmupS));
+
+    // Measurement window
+    MetricsRegistry::instance().resetStageLatencies();
+    uint64_t mjpegStart = 0;
+    for (auto& viewer : viewers) mjpegStart += viewer->frames();
+    uint64_t wsStart = wsClient.messages();
+    uint64_t ntStart = ntClient.updates();
+    double cpuStart = cpuSeconds();
+    auto wallStart = std::chrono::steady_clock::now();
+
+    std::cerr << "Measuring for " << opts.durationS << "s...\n";
+    std::this_thread::sleep_for(std::chrono::seconds(opts.durationS));
+
+    double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double cpuS = cpuSeconds() - cpuStart;
+
+    perf::RunResult run;
+    run.durationS = wallS;
+    run.config = runConfig(opts);
+    for (const auto& p : pipelines) {
+        auto stages = MetricsRegistry::instance().getStageLatencies(p.id);
+        auto& r = run.pipelineTypes[p.type];
+        r.pipelines++;
+        r.frames += stages.total.count();
+        r.drops += stages.droppedFrames;
+        r.queueWait.merge(stages.queueWait);
+        r.processing.merge(stages.processing);
+        r.publish.merge(stages.publish);
+        r.total.merge(stages.total);
+    }
+    for (auto& viewer : viewers) run.mjpegFrames += viewer->frames();
+    run.mjpegFrames -= mjpegStart;
+    run.wsMessages = wsClient.messages() - wsStart;
+    run.ntUpdates = ntClient.updates() - ntStart;
+    run.cpuPercent = 100.0 * cpuS / wallS;
+    auto memory = MemoryTracker::instance().snapshot();
+    run.rssPeakMb = memory.process_rss_peak_bytes / (1024.0 * 1024.0);
+    run.rssEndMb = memory.process_rss_bytes / (1024.0 * 1024.0);
+
+    // Teardown
+    for (auto& viewer : viewers) viewer->stop();
+    wsClient.stop();
+    ntClient.stop();
+    ThreadManager::instance().shutdown();
+    StreamerService::instance().shutdown();
+    NetworkTablesService::instance().disconnect();
+    drogon::app().quit();
+    appThread.join();
+    std::filesystem::remove(dbPath);
+
+    run.print();
+    auto report = run.toJson();
+
+    if (!opts.reportPath.empty()) {
+        std::ofstream(opts.reportPath) << report.dump(2) << "\n";
+    }
+    if (!opts.writeBaselinePath.empty()) {
+        std::ofstream(opts.writeBaselinePath) << report.dump(2) << "\n";
+        std::cerr << "Baseline written to " << opts.writeBaselinePath << "\n";
+    }
+
+    uint64_t totalFrames = 0;
+    for (const auto& [_, r] : run.pipelineTypes) totalFrames += r.frames;
+    if (!pipelines.empty() && totalFrames == 0) {
+        std::cerr << "FAIL: no frames were processed\n";
+        return 1;
+    }
+
+    if (baseline) {
+        auto regressions = perf::compareToBaseline(report, *baseline, opts.threshold);
+        if (!regressions.empty()) {
+            for (const auto& r : regressions) {
+                std::cerr << "REGRESSION " << r.metric << ": " << r.baseline << " -> " << r.current << "\n";
+            }
+            return 1;
+        }
+        std::cerr << "PASS: within " << opts.threshold * 100.0 << "% of baseline\n";
+    }
+
+    return 0;
+}
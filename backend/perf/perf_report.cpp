@@ -0,0 +1,133 @@
+#include "perf_report.hpp"
+#include <fmt/format.h>
+#include <cmath>
+
+namespace vision::perf {
+
+namespace {
+    // Latency differences below this are scheduler noise, not regressions
+    constexpr double LATENCY_SLACK_MS = 0.25;
+
+    nlohmann::json stageJson(const LatencyHistogram& h) {
+        return {
+            {"count", h.count()},
+            {"mean_ms", h.meanMs()},
+            {"p50_ms", h.percentileMs(0.50)},
+            {"p99_ms", h.percentileMs(0.99)},
+            {"p999_ms", h.percentileMs(0.999)},
+            {"max_ms", h.maxMs()}
+        };
+    }
+
+    const nlohmann::json* lookup(const nlohmann::json& root, const std::vector<std::string>& path) {
+        const nlohmann::json* node = &root;
+        for (const auto& key : path) {
+            if (!node->is_object() || !node->contains(key)) return nullptr;
+            node = &(*node)[key];
+        }
+        return node->is_number() ? node : nullptr;
+    }
+}
+
+nlohmann::json RunResult::toJson() const {
+    nlohmann::json types = nlohmann::json::object();
+    for (const auto& [name, r] : pipelineTypes) {
+        types[name] = {
+            {"pipelines", r.pipelines},
+            {"frames", r.frames},
+            {"fps_per_pipeline", r.pipelines > 0 ? r.frames / durationS / r.pipelines : 0.0},
+            {"drops", r.drops},
+            {"stages", {
+                {"queue_wait", stageJson(r.queueWait)},
+                {"processing", stageJson(r.processing)},
+                {"publish", stageJson(r.publish)},
+                {"total", stageJson(r.total)}
+            }}
+        };
+    }
+
+    return {
+        {"config", config},
+        {"duration_s", durationS},
+        {"pipelines", types},
+        {"clients", {
+            {"mjpeg_frames", mjpegFrames},
+            {"ws_messages", wsMessages},
+            {"nt_updates", ntUpdates}
+        }},
+        {"process", {
+            {"cpu_percent", cpuPercent},
+            {"rss_peak_mb", rssPeakMb},
+            {"rss_end_mb", rssEndMb}
+        }}
+    };
+}
+
+void RunResult::print() const {
+    fmt::print("\n{:<14} {:>6} {:>8} {:>7} {:>11} {:>9} {:>9} {:>9}\n",
+        "pipeline", "count", "fps/pl", "drops", "stage", "p50 ms", "p99 ms", "p999 ms");
+    for (const auto& [name, r] : pipelineTypes) {
+        double fps = r.pipelines > 0 ? r.frames / durationS / r.pipelines : 0.0;
+        const std::pair<const char*, const LatencyHistogram*> stages[] = {
+            {"queue_wait", &r.queueWait}, {"processing", &r.processing},
+            {"publish", &r.publish}, {"total", &r.total}};
+        bool first = true;
+        for (const auto& [stage, h] : stages) {
+            if (first) {
+                fmt::print("{:<14} {:>6} {:>8.1f} {:>7} ", name, r.pipelines, fps, r.drops);
+                first = false;
+            } else {
+                fmt::print("{:<14} {:>6} {:>8} {:>7} ", "", "", "", "");
+            }
+            fmt::print("{:>11} {:>9.2f} {:>9.2f} {:>9.2f}\n",
+                stage, h->percentileMs(0.50), h->percentileMs(0.99), h->percentileMs(0.999));
+        }
+    }
+    fmt::print("\nclients: mjpeg {} frames, websocket {} messages, nt {} updates\n",
+        mjpegFrames, wsMessages, ntUpdates);
+    fmt::print("process: cpu {:.1f}%, rss peak {:.1f} MB, rss end {:.1f} MB\n\n",
+        cpuPercent, rssPeakMb, rssEndMb);
+}
+
+std::vector<Regression> compareToBaseline(const nlohmann::json& current,
+                                          const nlohmann::json& baseline,
+                                          double threshold) {
+    std::vector<Regression> regressions;
+
+    auto check = [&](const std::vector<std::string>& path, bool higherIsWorse, double slack) {
+        auto* cur = lookup(current, path);
+        auto* base = lookup(baseline, path);
+        if (!cur || !base) return;
+
+        double c = cur->get<double>();
+        double b = base->get<double>();
+        bool regressed = higherIsWorse
+            ? c > b * (1.0 + threshold) + slack
+            : c < b * (1.0 - threshold) - slack;
+        if (regressed) {
+            std::string name;
+            for (const auto& key : path) {
+                name += (name.empty() ? "" : ".") + key;
+            }
+            regressions.push_back({name, b, c});
+        }
+    };
+
+    if (current.contains("pipelines") && current["pipelines"].is_object()) {
+        for (const auto& [type, _] : current["pipelines"].items()) {
+            check({"pipelines", type, "fps_per_pipeline"}, false, 0.0);
+            // p999 is reported but not gated; it is too noisy on shared machines
+            for (const char* stage : {"processing", "total"}) {
+                for (const char* pct : {"p50_ms", "p99_ms"}) {
+                    check({"pipelines", type, "stages", stage, pct}, true, LATENCY_SLACK_MS);
+                }
+            }
+        }
+    }
+    check({"process", "cpu_percent"}, true, 2.0);
+    check({"process", "rss_peak_mb"}, true, 8.0);
+
+    return regressions;
+}
+
+} // namespace vision::perf
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "metrics/histogram.hpp"
+#include <nlohmann/json.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vision::perf {
+
+// Aggregated results for all pipelines of one type
+struct PipelineTypeResult {
+    int pipelines = 0;
+    uint64_t frames = 0;
+    uint64_t drops = 0;
+    LatencyHistogram queueWait;
+    LatencyHistogram processing;
+    LatencyHistogram publish;
+    LatencyHistogram total;
+};
+
+struct RunResult {
+    nlohmann::json config;
+    double durationS = 0.0;
+    std::map<std::string, PipelineTypeResult> pipelineTypes;  // "apriltag", "ml", "optical_flow"
+    uint64_t mjpegFrames = 0;
+    uint64_t wsMessages = 0;
+    uint64_t ntUpdates = 0;
+    double cpuPercent = 0.0;   // Process CPU, 100 = one core
+    double rssPeakMb = 0.0;
+    double rssEndMb = 0.0;
+
+    nlohmann::json toJson() const;
+    void print() const;
+};
+
+struct Regression {
+    std::string metric;
+    double baseline = 0.0;
+    double current = 0.0;
+};
+
+// Compare gated metrics against a baseline report; threshold is a fraction (0.15 = 15%)
+std::vector<Regression> compareToBaseline(const nlohmann::json& current,
+                                          const nlohmann::json& baseline,
+                                          double threshold);
+
+} // namespace vision::perf
@@ -127,13 +127,64 @@ void Config::load() {
     // Server configuration
     server.host = getEnv("VISION_HOST", isDevelopment() ? "0.0.0.0" : "0.0.0.0");
     server.port = static_cast<uint16_t>(getEnvInt("VISION_PORT", isDevelopment() ? 5001 : 8080));
+    server.stream_port = static_cast<uint16_t>(getEnvInt("VISION_STREAM_PORT", 5805));
     server.threads = getEnvInt("VISION_THREADS", 4);  // Multiple threads to prevent video stream blocking other endpoints
+    server.compute_threads = getEnvInt("VISION_COMPUTE_THREADS", 2);
+    server.compute_queue = getEnvInt("VISION_COMPUTE_QUEUE", 16);
+    server.max_upload_mb = getEnvInt("VISION_MAX_UPLOAD_MB", 512);
+    server.max_memory_body_kb = getEnvInt("VISION_MAX_MEMORY_BODY_KB", 256);
+
+    // Cluster configuration
+    cluster.role = getEnv("VISION_CLUSTER_ROLE", "standalone");
+    cluster.node_id = getEnv("VISION_NODE_ID", "");
+    cluster.leader_host = getEnv("VISION_CLUSTER_LEADER", "127.0.0.1");
+    cluster.port = static_cast<uint16_t>(getEnvInt("VISION_CLUSTER_PORT", 5810));
+    cluster.sync_interval_ms = getEnvInt("VISION_CLUSTER_SYNC_MS", 500);
+    cluster.fusion_window_ms = getEnvInt("VISION_CLUSTER_FUSION_MS", 50);
+    cluster.node_timeout_ms = getEnvInt("VISION_CLUSTER_TIMEOUT_MS", 3000);
+    cluster.max_stream_relays = getEnvInt("VISION_CLUSTER_MAX_RELAYS", 8);
+
+    // Shared-memory frame bus
+    framebus.enabled = getEnvBool("VISION_FRAMEBUS_ENABLED", false);
+    framebus.format = getEnv("VISION_FRAMEBUS_FORMAT", "y8");
+    framebus.slots = getEnvInt("VISION_FRAMEBUS_SLOTS", 4);
+
+    // Camera capture
+    capture.metadata_orientation = getEnvBool("VISION_METADATA_ORIENTATION", false);
 
     // Metrics configuration
     metrics.enabled = getEnvBool("VISION_METRICS_ENABLED", true);
     metrics.window_seconds = getEnvInt("VISION_METRICS_WINDOW", 300);
     metrics.fps_window_seconds = getEnvInt("VISION_FPS_WINDOW", 10);
     metrics.memory_sample_interval_ms = getEnvInt("VISION_MEMORY_INTERVAL", 2000);
+    metrics.history_enabled = getEnvBool("VISION_METRICS_HISTORY", true);
+    metrics.history_path = getEnv("VISION_METRICS_HISTORY_PATH",
+        (std::filesystem::path(appDataDir) / "metrics.db").string());
+    metrics.history_raw_hours = getEnvInt("VISION_METRICS_RAW_HOURS", 24);
+    metrics.history_minute_days = getEnvInt("VISION_METRICS_MINUTE_DAYS", 30);
+    metrics.history_hour_days = getEnvInt("VISION_METRICS_HOUR_DAYS", 365);
+
+    // Allocator tuning
+    heap.mmap_threshold_kb = getEnvInt("VISION_MALLOC_MMAP_THRESHOLD_KB", 0);
+    heap.arena_max = getEnvInt("VISION_MALLOC_ARENA_MAX", 0);
+
+    // Match-phase power modes
+    power.idle_when_disabled = getEnvBool("VISION_IDLE_WHEN_DISABLED", true);
+    power.idle_fps = getEnvInt("VISION_IDLE_FPS", 5);
+
+    // Thermal governor
+    thermal.enabled = getEnvBool("VISION_THERMAL_GOVERNOR", true);
+    thermal.shed_c = getEnvInt("VISION_THERMAL_SHED_C", 80);
+    thermal.restore_c = getEnvInt("VISION_THERMAL_RESTORE_C", 70);
+    thermal.min_freq_headroom = getEnvInt("VISION_THERMAL_MIN_FREQ_PCT", 95) / 100.0;
+    thermal.interval_ms = getEnvInt("VISION_THERMAL_INTERVAL_MS", 2000);
+    thermal.restore_hold_ms = getEnvInt("VISION_THERMAL_RESTORE_HOLD_MS", 10000);
+
+    // WPILog result logging
+    resultlog.enabled = getEnvBool("VISION_WPILOG_ENABLED", true);
+    resultlog.directory = getEnv("VISION_WPILOG_DIR", (std::filesystem::path(appDataDir) / "logs").string());
+    resultlog.max_file_mb = getEnvInt("VISION_WPILOG_MAX_MB", 256);
+    resultlog.queue_records = getEnvInt("VISION_WPILOG_QUEUE", 8192);
 
     // Thresholds
     thresholds.pipeline_queue_warning = getEnvInt("VISION_QUEUE_WARNING", 1);
@@ -146,6 +197,12 @@ void Config::load() {
     spdlog::info("  Data directory: {}", data_directory);
     spdlog::info("  Database: {}", database_path);
     spdlog::info("  Server: {}:{}", server.host, server.port);
+    if (cluster.role != "standalone") {
+        spdlog::info("  Cluster: {} (leader {}:{})", cluster.role, cluster.leader_host, cluster.port);
+    }
+    if (framebus.enabled) {
+        spdlog::info("  Frame bus: {} ({} slots)", framebus.format, framebus.slots);
+    }
 }
 
 } // namespace vision
\ No newline at end of file
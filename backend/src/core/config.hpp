@@ -10,6 +10,37 @@ struct MetricsConfig {
     int window_seconds = 300;
     int fps_window_seconds = 10;
     int memory_sample_interval_ms = 2000;
+    bool history_enabled = true;    // 1 Hz samples persisted to a separate SQLite database
+    std::string history_path;       // Defaults to <AppData>/metrics.db
+    int history_raw_hours = 24;     // Keep 1-second samples this long
+    int history_minute_days = 30;   // Keep 1-minute rollups this long
+    int history_hour_days = 365;    // Keep 1-hour rollups this long
+};
+
+struct HeapConfig {
+    int mmap_threshold_kb = 0;      // Opt-in: pin glibc's mmap threshold process-wide (0 = glibc default)
+    int arena_max = 0;              // Cap on glibc malloc arenas (0 = glibc default)
+};
+
+struct PowerConfig {
+    bool idle_when_disabled = true;  // Throttle while the robot reports disabled over NT
+    int idle_fps = 5;                // Frames per second each camera forwards while idle
+};
+
+struct ThermalConfig {
+    bool enabled = true;
+    double shed_c = 80.0;             // Shed one step of load per interval at or above this
+    double restore_c = 70.0;          // Restore one step per hold period below this
+    double min_freq_headroom = 0.95;  // Also shed when the cpufreq cap drops below this share of its reference
+    int interval_ms = 2000;
+    int restore_hold_ms = 10000;
+};
+
+struct ResultLogConfig {
+    bool enabled = true;
+    std::string directory;          // Defaults to <AppData>/logs
+    int max_file_mb = 256;          // Rotate to a new file past this size
+    int queue_records = 8192;       // Results buffered for the writer before new ones are dropped
 };
 
 struct ThresholdsConfig {
@@ -22,7 +53,33 @@ struct ThresholdsConfig {
 struct ServerConfig {
     std::string host = "0.0.0.0";
     uint16_t port = 8080;
+    uint16_t stream_port = 5805;
     int threads = 4;
+    int compute_threads = 2;        // Workers for calibration, discovery and other blocking handlers
+    int compute_queue = 16;         // Pending compute tasks before requests get 503
+    int max_upload_mb = 512;        // Largest accepted request body (model uploads)
+    int max_memory_body_kb = 256;   // Bodies above this are spooled to a temp file
+};
+
+struct ClusterConfig {
+    std::string role = "standalone";       // standalone, leader, follower
+    std::string node_id;                   // Defaults to <hostname>-<port>
+    std::string leader_host = "127.0.0.1"; // Leader IP address (followers)
+    uint16_t port = 5810;                  // Leader UDP port
+    int sync_interval_ms = 500;
+    int fusion_window_ms = 50;
+    int node_timeout_ms = 3000;
+    int max_stream_relays = 8;             // Concurrent follower stream viewers proxied by the leader
+};
+
+struct FrameBusConfig {
+    bool enabled = false;           // Publish frames to /dev/shm for external consumers
+    std::string format = "y8";      // y8 or bgr
+    int slots = 4;                  // Ring depth per camera
+};
+
+struct CaptureConfig {
+    bool metadata_orientation = false;  // Carry mount rotation as frame metadata instead of rotating pixels
 };
 
 struct Config {
@@ -31,7 +88,14 @@ struct Config {
     std::string data_directory;
 
     ServerConfig server;
+    ClusterConfig cluster;
+    FrameBusConfig framebus;
+    CaptureConfig capture;
     MetricsConfig metrics;
+    HeapConfig heap;
+    PowerConfig power;
+    ThermalConfig thermal;
+    ResultLogConfig resultlog;
     ThresholdsConfig thresholds;
 
     // Singleton access
@@ -66,6 +66,7 @@ void Database::createSchema() {
             identifier TEXT UNIQUE NOT NULL,
             orientation INTEGER DEFAULT 0,
             exposure_value INTEGER DEFAULT 500,
+            alternate_exposure_value INTEGER,
             gain_value INTEGER DEFAULT 50,
             exposure_mode TEXT DEFAULT 'auto',
             gain_mode TEXT DEFAULT 'auto',
@@ -93,7 +94,22 @@ void Database::createSchema() {
         );
     )");
 
+    // Columns added after the first release; CREATE TABLE IF NOT EXISTS skips existing tables
+    addColumnIfMissing("cameras", "alternate_exposure_value", "INTEGER");
+
     spdlog::debug("Database schema created");
 }
 
+void Database::addColumnIfMissing(const std::string& table, const std::string& column, const std::string& type) {
+    SQLite::Statement query(*db_, "PRAGMA table_info(" + table + ")");
+    while (query.executeStep()) {
+        if (query.getColumn("name").getString() == column) {
+            return;
+        }
+    }
+
+    db_->exec("ALTER TABLE " + table + " ADD COLUMN " + column + " " + type);
+    spdlog::info("Added column {}.{}", table, column);
+}
+
 } // namespace vision
@@ -41,6 +41,7 @@ private:
     Database() = default;
 
     void createSchema();
+    void addColumnIfMissing(const std::string& table, const std::string& column, const std::string& type);
 
     std::unique_ptr<SQLite::Database> db_;
     mutable std::mutex mutex_;
@@ -2,6 +2,7 @@
 #include "drivers/usb_driver.hpp"
 #include "drivers/realsense_driver.hpp"
 #include "drivers/spinnaker_driver.hpp"
+#include "drivers/replay_driver.hpp"
 #include <spdlog/spdlog.h>
 
 namespace vision {
@@ -11,21 +12,27 @@ std::unique_ptr<BaseDriver> BaseDriver::create(const Camera& camera) {
         case CameraType::USB:
             return std::make_unique<USBDriver>(camera);
 
+        // SDKs load in the background from here; the camera thread connects once they are ready
         case CameraType::Spinnaker:
-            if (SpinnakerDriver::isAvailable()) {
-                return std::make_unique<SpinnakerDriver>(camera);
-            } else {
-                spdlog::error("Spinnaker support not compiled in. Rebuild with --spinnaker=y");
-                return nullptr;
-            }
+#ifdef VISION_WITH_SPINNAKER
+            SpinnakerDriver::initializeAsync();
+            return std::make_unique<SpinnakerDriver>(camera);
+#else
+            spdlog::error("Spinnaker support not compiled in. Rebuild with --spinnaker=y");
+            return nullptr;
+#endif
 
         case CameraType::RealSense:
-            if (RealSenseDriver::isAvailable()) {
-                return std::make_unique<RealSenseDriver>(camera);
-            } else {
-                spdlog::error("RealSense support not compiled in. Rebuild with --realsense=y");
-                return nullptr;
-            }
+#ifdef VISION_WITH_REALSENSE
+            RealSenseDriver::initializeAsync();
+            return std::make_unique<RealSenseDriver>(camera);
+#else
+            spdlog::error("RealSense support not compiled in. Rebuild with --realsense=y");
+            return nullptr;
+#endif
+
+        case CameraType::Replay:
+            return std::make_unique<ReplayDriver>(camera);
 
         default:
             spdlog::error("Unknown camera type");
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "models/camera.hpp"
+#include "drivers/capture_mode.hpp"
 #include <opencv2/opencv.hpp>
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <optional>
@@ -13,6 +15,7 @@ namespace vision {
 struct FrameResult {
     cv::Mat color;
     std::optional<cv::Mat> depth;
+    std::optional<int> exposure;  // Exposure this frame was captured with, if the driver reports it
 
     bool empty() const { return color.empty(); }
 };
@@ -21,8 +24,10 @@ class BaseDriver {
 public:
     virtual ~BaseDriver() = default;
 
-    // Connect to the camera
-    virtual bool connect(bool silent = false) = 0;
+    // Connect to the camera. Drivers whose SDK loads lazily wait up to sdkWait for it;
+    // the default never blocks, so only the camera thread passes a timeout.
+    virtual bool connect(bool silent = false,
+                         std::chrono::milliseconds sdkWait = std::chrono::milliseconds(0)) = 0;
 
     // Disconnect from the camera
     virtual void disconnect() = 0;
@@ -45,6 +50,10 @@ public:
     // Get current exposure value
     virtual int getExposure() const { return 0; }
 
+    // Frames between an exposure write and the first frame captured with it.
+    // Used to tag alternating-exposure frames when the driver cannot report exposure.
+    virtual int exposureLatencyFrames() const { return 2; }
+
     // Range metadata
     struct Range {
         int min;
@@ -62,6 +71,10 @@ public:
     // Get gain range
     virtual Range getGainRange() const { return {0, 100, 1, 0}; }
 
+    // Reconfigure the sensor for the merged pipeline requirements. Called from the
+    // capture thread between frames; returns the mode in effect (width 0 = unchanged).
+    virtual CaptureMode negotiate(const CaptureRequirements& requirements) { return {}; }
+
     // Factory method to create appropriate driver
     static std::unique_ptr<BaseDriver> create(const Camera& camera);
 
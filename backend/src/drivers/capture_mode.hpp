@@ -0,0 +1,59 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <algorithm>
+#include <optional>
+#include <string>
+
+namespace vision {
+
+// What a pipeline needs from the sensor. The camera thread merges the
+// requirements of every pipeline on a camera and asks the driver for the
+// cheapest mode that satisfies all of them.
+struct CaptureRequirements {
+    bool fullResolution = true;      // Needs the configured resolution (e.g. calibrated pose)
+    int minWidth = 0;                // Only used when fullResolution is false
+    int minHeight = 0;
+    int targetFps = 0;               // 0 = keep the configured framerate
+    bool monoOk = false;             // Accepts single-channel frames
+    std::optional<cv::Rect2d> roi;   // Normalized [0,1] sensor region, nullopt = full frame
+    int orientation = 0;             // Rotation the camera thread must deliver (0/90/180/270)
+
+    // Combine with another pipeline's needs; the result satisfies both
+    void merge(const CaptureRequirements& other) {
+        fullResolution = fullResolution || other.fullResolution;
+        minWidth = (std::max)(minWidth, other.minWidth);
+        minHeight = (std::max)(minHeight, other.minHeight);
+        targetFps = (std::max)(targetFps, other.targetFps);
+        monoOk = monoOk && other.monoOk;
+        if (roi && other.roi) {
+            roi = *roi | *other.roi;
+        } else {
+            roi.reset();
+        }
+    }
+};
+
+// Mode the driver actually configured in response to a negotiation
+struct CaptureMode {
+    int width = 0;
+    int height = 0;
+    int fps = 0;
+    bool mono = false;
+    int binning = 1;
+    bool roiApplied = false;
+    int offsetX = 0;                   // ROI origin, in binned pixels
+    int offsetY = 0;
+    bool hardwareOrientation = false;  // Sensor already applied the requested orientation
+
+    std::string describe() const {
+        std::string s = std::to_string(width) + "x" + std::to_string(height) +
+                        " @ " + std::to_string(fps) + " fps" + (mono ? " mono" : " color");
+        if (binning > 1) s += " bin" + std::to_string(binning);
+        if (roiApplied) s += " roi+" + std::to_string(offsetX) + "+" + std::to_string(offsetY);
+        if (hardwareOrientation) s += " hw-flip";
+        return s;
+    }
+};
+
+} // namespace vision
@@ -1,5 +1,6 @@
 #include "drivers/realsense_driver.hpp"
 #include "drivers/realsense_loader.hpp"
+#include "drivers/sdk_initializer.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 #include <set>
@@ -24,19 +25,53 @@ RealSenseDriver::~RealSenseDriver() {
     disconnect();
 }
 
+#ifdef VISION_WITH_REALSENSE
+namespace {
+
+// Loading librealsense is deferred to the first RealSense camera or discovery request
+SdkInitializer& realsenseSdk() {
+    static SdkInitializer sdk("RealSense", []() { return RealSenseDriver::initialize(); });
+    return sdk;
+}
+
+} // namespace
+#endif
+
 bool RealSenseDriver::isAvailable() {
 #ifdef VISION_WITH_REALSENSE
-    return RealSenseLoader::isLoaded();
+    return realsenseSdk().wait();
+#else
+    return false;
+#endif
+}
+
+bool RealSenseDriver::isLoaded() {
+#ifdef VISION_WITH_REALSENSE
+    return realsenseSdk().ready();
 #else
     return false;
 #endif
 }
 
-void RealSenseDriver::initialize() {
+SdkInitializer::State RealSenseDriver::sdkState() {
+#ifdef VISION_WITH_REALSENSE
+    return realsenseSdk().state();
+#else
+    return SdkInitializer::State::Unavailable;
+#endif
+}
+
+void RealSenseDriver::initializeAsync() {
+#ifdef VISION_WITH_REALSENSE
+    realsenseSdk().start();
+#endif
+}
+
+bool RealSenseDriver::initialize() {
     std::lock_guard<std::mutex> lock(realsenseInitMutex_);
 
     if (realsenseInitialized_) {
-        return;
+        return true;
     }
 
 #ifdef VISION_WITH_REALSENSE
@@ -44,7 +79,7 @@ void RealSenseDriver::initialize() {
     if (!RealSenseLoader::tryLoad()) {
         spdlog::warn("RealSense SDK not available: {}", RealSenseLoader::getLoadError());
         realsenseInitialized_ = false;
-        return;
+        return false;
     }
 
     realsenseInitialized_ = true;
@@ -52,6 +87,7 @@ void RealSenseDriver::initialize() {
 #else
     spdlog::warn("RealSense support not compiled in");
 #endif
+    return realsenseInitialized_;
 }
 
 void RealSenseDriver::shutdown() {
@@ -76,14 +112,14 @@ void RealSenseDriver::shutdown() {
 // FULL IMPLEMENTATIONS (when RealSense SDK is available)
 // ============================================================================
 
-bool RealSenseDriver::connect(bool silent) {
+bool RealSenseDriver::connect(bool silent, std::chrono::milliseconds sdkWait) {
     if (connected_) {
         return true;
     }
 
-    if (!RealSenseLoader::isLoaded()) {
+    if (!realsenseSdk().wait(sdkWait)) {
         if (!silent) {
-            spdlog::error("RealSense SDK not loaded. Cannot connect to camera.");
+            spdlog::warn("RealSense SDK not ready; camera {} will connect once it is", camera_.identifier);
         }
         return false;
     }
@@ -91,7 +127,8 @@ bool RealSenseDriver::connect(bool silent) {
     try {
         spdlog::info("Connecting to RealSense camera: {}", camera_.identifier);
 
-        configurePipeline();
+        auto [width, height, fps] = configuredMode();
+        configurePipeline(width, height, fps);
 
         // Start the pipeline
         profile_ = pipeline_.start(config_);
@@ -111,12 +148,7 @@ bool RealSenseDriver::connect(bool silent) {
     }
 }
 
-void RealSenseDriver::configurePipeline() {
-    // If we have a specific serial number, use it
-    if (!camera_.identifier.empty() && camera_.identifier != "auto") {
-        config_.enable_device(camera_.identifier);
-    }
-
+std::tuple<int, int, int> RealSenseDriver::configuredMode() const {
     // Parse resolution from camera settings
     int width = 1920;
     int height = 1080;
@@ -136,6 +168,17 @@ void RealSenseDriver::configurePipeline() {
         fps = *camera_.framerate;
     }
 
+    return {width, height, fps};
+}
+
+void RealSenseDriver::configurePipeline(int width, int height, int fps) {
+    config_ = rs2::config();
+
+    // If we have a specific serial number, use it
+    if (!camera_.identifier.empty() && camera_.identifier != "auto") {
+        config_.enable_device(camera_.identifier);
+    }
+
     // Enable color stream
     spdlog::info("Configuring RealSense: Color {}x{} @ {} fps", width, height, fps);
     config_.enable_stream(RS2_STREAM_COLOR, width, height, RS2_FORMAT_BGR8, fps);
@@ -331,10 +374,66 @@ BaseDriver::Range RealSenseDriver::getGainRange() const {
     return {0, 100, 1, 0};
 }
 
+CaptureMode RealSenseDriver::negotiate(const CaptureRequirements& requirements) {
+    CaptureMode mode;
+    if (!connected_ || !colorSensor_) {
+        return mode;
+    }
+
+    auto [width, height, fps] = configuredMode();
+    if (requirements.targetFps > 0) {
+        fps = requirements.targetFps;
+    }
+
+    // Pick the smallest BGR8 color profile that still satisfies every pipeline.
+    // A user-chosen resolution is a ceiling; without one any profile is allowed.
+    if (!requirements.fullResolution) {
+        int bestArea = 0;
+        int bestWidth = width;
+        int bestHeight = height;
+        for (const auto& profile : colorSensor_.get_stream_profiles()) {
+            auto video = profile.as<rs2::video_stream_profile>();
+            if (!video || video.stream_type() != RS2_STREAM_COLOR || video.format() != RS2_FORMAT_BGR8) continue;
+            if (video.fps() != fps) continue;
+            if (video.width() < requirements.minWidth || video.height() < requirements.minHeight) continue;
+            if (camera_.resolution_json && (video.width() > width || video.height() > height)) continue;
+
+            int area = video.width() * video.height();
+            if (bestArea == 0 || area < bestArea) {
+                bestArea = area;
+                bestWidth = video.width();
+                bestHeight = video.height();
+            }
+        }
+        width = bestWidth;
+        height = bestHeight;
+    }
+
+    auto active = profile_.get_stream(RS2_STREAM_COLOR).as<rs2::video_stream_profile>();
+    if (active.width() != width || active.height() != height || active.fps() != fps) {
+        try {
+            pipeline_.stop();
+            configurePipeline(width, height, fps);
+            profile_ = pipeline_.start(config_);
+            findSensors();
+            active = profile_.get_stream(RS2_STREAM_COLOR).as<rs2::video_stream_profile>();
+        } catch (const rs2::error& e) {
+            spdlog::error("RealSense renegotiation failed: {} ({})", e.what(), e.get_failed_function());
+            connected_ = false;
+            return mode;
+        }
+    }
+
+    mode.width = active.width();
+    mode.height = active.height();
+    mode.fps = active.fps();
+    return mode;
+}
+
 std::vector<DeviceInfo> RealSenseDriver::listDevices() {
     std::vector<DeviceInfo> devices;
 
-    if (!RealSenseLoader::isLoaded()) {
+    if (!isAvailable()) {
         spdlog::debug("RealSense SDK not loaded, skipping device enumeration");
         return devices;
     }
@@ -380,7 +479,7 @@ std::vector<DeviceInfo> RealSenseDriver::listDevices() {
 std::vector<CameraProfile> RealSenseDriver::getSupportedProfiles(const std::string& identifier) {
     std::vector<CameraProfile> profiles;
 
-    if (!RealSenseLoader::isLoaded()) {
+    if (!isAvailable()) {
         return profiles;
     }
 
@@ -446,7 +545,7 @@ std::vector<CameraProfile> RealSenseDriver::getSupportedProfiles(const std::stri
 // STUB IMPLEMENTATIONS (when RealSense is not available)
 // ============================================================================
 
-bool RealSenseDriver::connect(bool) {
+bool RealSenseDriver::connect(bool, std::chrono::milliseconds) {
     spdlog::error("RealSense support not compiled in");
     return false;
 }
@@ -469,6 +568,7 @@ int RealSenseDriver::getExposure() const { return 0; }
 int RealSenseDriver::getGain() const { return 0; }
 BaseDriver::Range RealSenseDriver::getExposureRange() const { return {0, 10000, 1, 500}; }
 BaseDriver::Range RealSenseDriver::getGainRange() const { return {0, 100, 1, 0}; }
+CaptureMode RealSenseDriver::negotiate(const CaptureRequirements&) { return {}; }
 
 std::vector<DeviceInfo> RealSenseDriver::listDevices() {
     spdlog::debug("RealSense support not compiled in");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "drivers/base_driver.hpp"
+#include "drivers/sdk_initializer.hpp"
 #include <opencv2/opencv.hpp>
 #include <string>
 #include <vector>
@@ -17,7 +18,8 @@ public:
     explicit RealSenseDriver(const Camera& camera);
     ~RealSenseDriver() override;
 
-    bool connect(bool silent = false) override;
+    bool connect(bool silent = false,
+                 std::chrono::milliseconds sdkWait = std::chrono::milliseconds(0)) override;
     void disconnect() override;
     bool isConnected() const override;
     FrameResult getFrame() override;
@@ -30,15 +32,20 @@ public:
     int getGain() const override;
     Range getExposureRange() const override;
     Range getGainRange() const override;
+    CaptureMode negotiate(const CaptureRequirements& requirements) override;
 
     // Static discovery methods
     static std::vector<DeviceInfo> listDevices();
     static std::vector<CameraProfile> getSupportedProfiles(const std::string& identifier);
 
-    // RealSense system management
-    static void initialize();
+    // RealSense system management. Nothing is loaded at startup: the first camera or
+    // discovery request loads the SDK on a background thread.
+    static bool initialize();
     static void shutdown();
-    static bool isAvailable();
+    static void initializeAsync();  // Start without waiting
+    static bool isAvailable();      // Start if needed and wait for the result
+    static bool isLoaded();         // Initialized successfully; never starts or waits
+    static SdkInitializer::State sdkState();  // Never starts or waits
 
 private:
     Camera camera_;
@@ -55,7 +62,8 @@ private:
     rs2::sensor depthSensor_;
 
     // Helper methods
-    void configurePipeline();
+    void configurePipeline(int width, int height, int fps);
+    std::tuple<int, int, int> configuredMode() const;
     void findSensors();
 #endif
 };
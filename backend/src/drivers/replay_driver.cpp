@@ -0,0 +1,148 @@
+#include "drivers/replay_driver.hpp"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+extern "C" {
+#include <apriltag.h>
+#include <tag36h11.h>
+}
+
+namespace vision {
+
+namespace {
+    constexpr int SYNTHETIC_FRAME_COUNT = 60;
+    constexpr int SYNTHETIC_TAG_COUNT = 4;
+    constexpr size_t MAX_REPLAY_FRAMES = 600;  // Bound memory for long recordings
+}
+
+ReplayDriver::ReplayDriver(const Camera& camera) : camera_(camera) {
+    if (camera_.resolution_json) {
+        try {
+            auto res = nlohmann::json::parse(*camera_.resolution_json);
+            width_ = res["width"].get<int>();
+            height_ = res["height"].get<int>();
+        } catch (const std::exception& e) {
+            spdlog::warn("Failed to parse resolution_json: {}", e.what());
+        }
+    }
+    if (camera_.framerate && *camera_.framerate > 0) {
+        fps_ = *camera_.framerate;
+    }
+}
+
+bool ReplayDriver::connect(bool silent, std::chrono::milliseconds) {
+    frames_.clear();
+    index_ = 0;
+
+    const std::string& source = camera_.identifier;
+    namespace fs = std::filesystem;
+
+    if (source.empty() || source == "synthetic") {
+        generateSyntheticFrames();
+    } else if (fs::is_directory(source)) {
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator(source)) {
+            auto ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp") {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& file : files) {
+            if (frames_.size() >= MAX_REPLAY_FRAMES) break;
+            cv::Mat image = cv::imread(file.string(), cv::IMREAD_COLOR);
+            if (!image.empty()) {
+                frames_.push_back(image);
+            }
+        }
+    } else {
+        cv::VideoCapture video(source);
+        cv::Mat image;
+        while (frames_.size() < MAX_REPLAY_FRAMES && video.read(image)) {
+            frames_.push_back(image.clone());
+        }
+    }
+
+    if (frames_.empty()) {
+        if (!silent) {
+            spdlog::error("Replay camera '{}' has no frames at '{}'", camera_.name, source);
+        }
+        return false;
+    }
+
+    connected_ = true;
+    nextFrameTime_ = std::chrono::steady_clock::now();
+    spdlog::info("Replay camera '{}' loaded {} frames ({}x{} @ {} fps)",
+        camera_.name, frames_.size(), frames_[0].cols, frames_[0].rows, fps_);
+    return true;
+}
+
+void ReplayDriver::disconnect() {
+    connected_ = false;
+    frames_.clear();
+}
+
+FrameResult ReplayDriver::getFrame() {
+    FrameResult result;
+    if (!connected_) {
+        return result;
+    }
+
+    // Pace like a real sensor; fall behind rather than burst if the consumer stalls
+    std::this_thread::sleep_until(nextFrameTime_);
+    auto now = std::chrono::steady_clock::now();
+    nextFrameTime_ = (std::max)(nextFrameTime_ + std::chrono::microseconds(1000000 / fps_), now);
+
+    // Drivers hand out a fresh buffer per frame
+    result.color = frames_[index_].clone();
+    index_ = (index_ + 1) % frames_.size();
+    return result;
+}
+
+void ReplayDriver::generateSyntheticFrames() {
+    apriltag_family_t* family = tag36h11_create();
+
+    // Render tags once at a readable size (8px per module including the white border)
+    std::vector<cv::Mat> tags;
+    for (int id = 0; id < SYNTHETIC_TAG_COUNT; id++) {
+        image_u8_t* img = apriltag_to_image(family, id);
+        cv::Mat tag(img->height, img->width, CV_8UC1, img->buf, img->stride);
+        cv::Mat scaled;
+        cv::resize(tag, scaled, cv::Size(), 12, 12, cv::INTER_NEAREST);
+        cv::copyMakeBorder(scaled, scaled, 12, 12, 12, 12, cv::BORDER_CONSTANT, cv::Scalar(255));
+        cv::Mat bgr;
+        cv::cvtColor(scaled, bgr, cv::COLOR_GRAY2BGR);
+        tags.push_back(bgr);
+        image_u8_destroy(img);
+    }
+    tag36h11_destroy(family);
+
+    for (int i = 0; i < SYNTHETIC_FRAME_COUNT; i++) {
+        cv::Mat frame(height_, width_, CV_8UC3);
+        // Textured background so optical flow has features to track
+        cv::randu(frame, cv::Scalar::all(40), cv::Scalar::all(90));
+        int shift = i * 4;
+        for (int x = -shift % 64; x < width_; x += 64) {
+            cv::line(frame, cv::Point(x, 0), cv::Point(x, height_), cv::Scalar(120, 120, 120), 2);
+        }
+
+        for (size_t t = 0; t < tags.size(); t++) {
+            const cv::Mat& tag = tags[t];
+            int slotWidth = width_ / static_cast<int>(tags.size());
+            int x = static_cast<int>(t) * slotWidth + (slotWidth - tag.cols) / 2 + ((i % 20) - 10) * 2;
+            int y = (height_ - tag.rows) / 2 + ((i % 30) - 15) * 2;
+            cv::Rect roi(x, y, tag.cols, tag.rows);
+            roi &= cv::Rect(0, 0, width_, height_);
+            if (roi.area() > 0) {
+                tag(cv::Rect(0, 0, roi.width, roi.height)).copyTo(frame(roi));
+            }
+        }
+        frames_.push_back(frame);
+    }
+}
+
+} // namespace vision
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "drivers/base_driver.hpp"
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+// Replays recorded frames in a loop at the camera's framerate, with no hardware.
+// The identifier is an image directory, a video file, or "synthetic" for generated
+// frames containing moving tag36h11 markers.
+class ReplayDriver : public BaseDriver {
+public:
+    explicit ReplayDriver(const Camera& camera);
+    ~ReplayDriver() override = default;
+
+    bool connect(bool silent = false,
+                 std::chrono::milliseconds sdkWait = std::chrono::milliseconds(0)) override;
+    void disconnect() override;
+    bool isConnected() const override { return connected_; }
+    FrameResult getFrame() override;
+
+private:
+    void generateSyntheticFrames();
+
+    Camera camera_;
+    bool connected_ = false;
+    int width_ = 1280;
+    int height_ = 720;
+    int fps_ = 30;
+
+    std::vector<cv::Mat> frames_;
+    size_t index_ = 0;
+    std::chrono::steady_clock::time_point nextFrameTime_;
+};
+
+} // namespace vision
@@ -0,0 +1,64 @@
+#include "drivers/sdk_initializer.hpp"
+#include "metrics/registry.hpp"
+#include <spdlog/spdlog.h>
+
+namespace vision {
+
+SdkInitializer::SdkInitializer(std::string name, std::function<bool()> init)
+    : name_(std::move(name)), init_(std::move(init)) {}
+
+void SdkInitializer::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (future_.valid()) return;
+
+    spdlog::info("{} SDK requested; initializing in the background", name_);
+    future_ = std::async(std::launch::async, [this]() {
+        auto start = std::chrono::steady_clock::now();
+        bool available = init_();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        MetricsRegistry::instance().recordSdkInit(name_, ms, available);
+        spdlog::info("{} SDK initialization took {:.0f} ms ({})", name_, ms,
+                     available ? "available" : "unavailable");
+        return available;
+    }).share();
+}
+
+bool SdkInitializer::wait(std::chrono::milliseconds timeout) {
+    start();
+    std::shared_future<bool> future;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        future = future_;
+    }
+    if (timeout != std::chrono::milliseconds::max() &&
+        future.wait_for(timeout) != std::future_status::ready) {
+        return false;
+    }
+    return future.get();
+}
+
+bool SdkInitializer::ready() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return future_.valid() &&
+           future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+           future_.get();
+}
+
+SdkInitializer::State SdkInitializer::state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!future_.valid()) return State::Idle;
+    if (future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return State::Initializing;
+    return future_.get() ? State::Ready : State::Unavailable;
+}
+
+const char* SdkInitializer::toString(State state) {
+    switch (state) {
+        case State::Idle: return "idle";
+        case State::Initializing: return "initializing";
+        case State::Ready: return "ready";
+        case State::Unavailable: return "unavailable";
+    }
+    return "unavailable";
+}
+
+} // namespace vision
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+
+namespace vision {
+
+// Loads a camera SDK on first use instead of at startup. The first caller starts
+// initialization on a background thread; later callers wait for it with a timeout
+// or only check whether it has finished. Robots without that camera type never pay for it.
+class SdkInitializer {
+public:
+    enum class State { Idle, Initializing, Ready, Unavailable };
+
+    SdkInitializer(std::string name, std::function<bool()> init);
+
+    // Begin initialization on a background thread (no-op once started)
+    void start();
+
+    // Start if needed and wait up to timeout; true once initialized successfully
+    bool wait(std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+
+    // Finished and succeeded; never starts or waits
+    bool ready() const;
+
+    // Where initialization stands; never starts or waits
+    State state() const;
+
+    static const char* toString(State state);
+
+private:
+    std::string name_;
+    std::function<bool()> init_;
+    mutable std::mutex mutex_;
+    std::shared_future<bool> future_;
+};
+
+} // namespace vision
@@ -1,5 +1,6 @@
 #include "drivers/spinnaker_driver.hpp"
 #include "drivers/spinnaker_loader.hpp"
+#include "drivers/sdk_initializer.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
 
@@ -84,19 +85,53 @@ SpinnakerDriver::~SpinnakerDriver() {
     disconnect();
 }
 
+#ifdef VISION_WITH_SPINNAKER
+namespace {
+
+// System::GetInstance and interface enumeration take seconds, so they wait for the first camera or discovery
+SdkInitializer& spinnakerSdk() {
+    static SdkInitializer sdk("Spinnaker", []() { return SpinnakerDriver::initialize(); });
+    return sdk;
+}
+
+} // namespace
+#endif
+
 bool SpinnakerDriver::isAvailable() {
 #ifdef VISION_WITH_SPINNAKER
-    return initialized_;
+    return spinnakerSdk().wait();
 #else
     return false;
 #endif
 }
 
-void SpinnakerDriver::initialize() {
+bool SpinnakerDriver::isLoaded() {
+#ifdef VISION_WITH_SPINNAKER
+    return spinnakerSdk().ready();
+#else
+    return false;
+#endif
+}
+
+SdkInitializer::State SpinnakerDriver::sdkState() {
+#ifdef VISION_WITH_SPINNAKER
+    return spinnakerSdk().state();
+#else
+    return SdkInitializer::State::Unavailable;
+#endif
+}
+
+void SpinnakerDriver::initializeAsync() {
+#ifdef VISION_WITH_SPINNAKER
+    spinnakerSdk().start();
+#endif
+}
+
+bool SpinnakerDriver::initialize() {
     std::lock_guard<std::mutex> lock(systemMutex_);
 
     if (initialized_) {
-        return;
+        return true;
     }
 
 #ifdef VISION_WITH_SPINNAKER
@@ -104,7 +139,7 @@ void SpinnakerDriver::initialize() {
     if (!SpinnakerLoader::tryLoad()) {
         spdlog::warn("Spinnaker SDK not available: {}", SpinnakerLoader::getLoadError());
         initialized_ = false;
-        return;
+        return false;
     }
 
 #ifdef _WIN32
@@ -118,6 +153,7 @@ void SpinnakerDriver::initialize() {
 #else
     spdlog::warn("Spinnaker support not compiled in. Rebuild with --spinnaker=y");
 #endif
+    return initialized_;
 }
 
 void SpinnakerDriver::shutdown() {
@@ -151,14 +187,14 @@ void SpinnakerDriver::shutdown() {
 // CONNECTION MANAGEMENT
 // ============================================================================
 
-bool SpinnakerDriver::connect(bool silent) {
+bool SpinnakerDriver::connect(bool silent, std::chrono::milliseconds sdkWait) {
     if (connected_) {
         return true;
     }
 
-    if (!initialized_) {
+    if (!spinnakerSdk().wait(sdkWait)) {
         if (!silent) {
-            spdlog::error("Spinnaker SDK not initialized. Call initialize() first.");
+            spdlog::warn("Spinnaker SDK not ready; camera {} will connect once it is", camera_.identifier);
         }
         return false;
     }
@@ -270,46 +306,7 @@ void SpinnakerDriver::configureCamera() {
         }
 
         // Set pixel format based on camera capabilities
-        Spinnaker::GenApi::CEnumerationPtr pixelFormat = nodeMap.GetNode("PixelFormat");
-        if (Spinnaker::GenApi::IsAvailable(pixelFormat) && Spinnaker::GenApi::IsWritable(pixelFormat)) {
-            // Check if this is a mono-only camera by testing for Mono8
-            Spinnaker::GenApi::CEnumEntryPtr mono8Entry = pixelFormat->GetEntryByName("Mono8");
-            Spinnaker::GenApi::CEnumEntryPtr bgr8Entry = pixelFormat->GetEntryByName("BGR8");
-            Spinnaker::GenApi::CEnumEntryPtr rgb8Entry = pixelFormat->GetEntryByName("RGB8");
-            Spinnaker::GenApi::CEnumEntryPtr bayerEntry = pixelFormat->GetEntryByName("BayerRG8");
-
-            bool hasMono8 = Spinnaker::GenApi::IsAvailable(mono8Entry) && Spinnaker::GenApi::IsReadable(mono8Entry);
-            bool hasBGR8 = Spinnaker::GenApi::IsAvailable(bgr8Entry) && Spinnaker::GenApi::IsReadable(bgr8Entry);
-            bool hasRGB8 = Spinnaker::GenApi::IsAvailable(rgb8Entry) && Spinnaker::GenApi::IsReadable(rgb8Entry);
-            bool hasBayer = Spinnaker::GenApi::IsAvailable(bayerEntry) && Spinnaker::GenApi::IsReadable(bayerEntry);
-
-            // Detect mono camera: has Mono8 but no color formats
-            is_mono_camera_ = hasMono8 && !hasBGR8 && !hasRGB8 && !hasBayer;
-
-            Spinnaker::GenApi::CEnumEntryPtr pixelFormatEntry = nullptr;
-
-            if (is_mono_camera_) {
-                // Mono camera - use Mono8 directly (optimal)
-                pixelFormatEntry = mono8Entry;
-                spdlog::info("Detected mono camera - using Mono8 format (no conversion needed)");
-            } else {
-                // Color camera - try color formats first
-                if (hasBGR8) {
-                    pixelFormatEntry = bgr8Entry;
-                } else if (hasRGB8) {
-                    pixelFormatEntry = rgb8Entry;
-                } else if (hasBayer) {
-                    pixelFormatEntry = bayerEntry;
-                } else if (hasMono8) {
-                    pixelFormatEntry = mono8Entry;
-                }
-            }
-
-            if (pixelFormatEntry) {
-                pixelFormat->SetIntValue(pixelFormatEntry->GetValue());
-                spdlog::debug("Set pixel format to: {}", pixelFormatEntry->GetSymbolic().c_str());
-            }
-        }
+        selectPixelFormat(false);
 
         // Apply resolution if specified
         if (camera_.resolution_json) {
@@ -359,11 +356,78 @@ void SpinnakerDriver::configureCamera() {
         setExposure(camera_.exposure_mode, camera_.exposure_value);
         setGain(camera_.gain_mode, camera_.gain_value);
 
+        // Stamp each image with its exposure time so alternating-exposure frames are tagged exactly
+        hasExposureChunk_ = false;
+        Spinnaker::GenApi::CBooleanPtr chunkModeActive = nodeMap.GetNode("ChunkModeActive");
+        Spinnaker::GenApi::CEnumerationPtr chunkSelector = nodeMap.GetNode("ChunkSelector");
+        if (Spinnaker::GenApi::IsAvailable(chunkModeActive) && Spinnaker::GenApi::IsWritable(chunkModeActive) &&
+            Spinnaker::GenApi::IsAvailable(chunkSelector) && Spinnaker::GenApi::IsWritable(chunkSelector)) {
+            chunkModeActive->SetValue(true);
+            Spinnaker::GenApi::CEnumEntryPtr exposureEntry = chunkSelector->GetEntryByName("ExposureTime");
+            if (Spinnaker::GenApi::IsAvailable(exposureEntry) && Spinnaker::GenApi::IsReadable(exposureEntry)) {
+                chunkSelector->SetIntValue(exposureEntry->GetValue());
+                Spinnaker::GenApi::CBooleanPtr chunkEnable = nodeMap.GetNode("ChunkEnable");
+                if (Spinnaker::GenApi::IsAvailable(chunkEnable) && Spinnaker::GenApi::IsWritable(chunkEnable)) {
+                    chunkEnable->SetValue(true);
+                    hasExposureChunk_ = true;
+                }
+            }
+        }
+
     } catch (Spinnaker::Exception& e) {
         spdlog::warn("Error during camera configuration: {}", e.what());
     }
 }
 
+void SpinnakerDriver::selectPixelFormat(bool preferMono) {
+    Spinnaker::GenApi::INodeMap& nodeMap = cameraPtr_->GetNodeMap();
+    Spinnaker::GenApi::CEnumerationPtr pixelFormat = nodeMap.GetNode("PixelFormat");
+    if (!Spinnaker::GenApi::IsAvailable(pixelFormat) || !Spinnaker::GenApi::IsWritable(pixelFormat)) {
+        return;
+    }
+
+    // Check if this is a mono-only camera by testing for Mono8
+    Spinnaker::GenApi::CEnumEntryPtr mono8Entry = pixelFormat->GetEntryByName("Mono8");
+    Spinnaker::GenApi::CEnumEntryPtr bgr8Entry = pixelFormat->GetEntryByName("BGR8");
+    Spinnaker::GenApi::CEnumEntryPtr rgb8Entry = pixelFormat->GetEntryByName("RGB8");
+    Spinnaker::GenApi::CEnumEntryPtr bayerEntry = pixelFormat->GetEntryByName("BayerRG8");
+
+    bool hasMono8 = Spinnaker::GenApi::IsAvailable(mono8Entry) && Spinnaker::GenApi::IsReadable(mono8Entry);
+    bool hasBGR8 = Spinnaker::GenApi::IsAvailable(bgr8Entry) && Spinnaker::GenApi::IsReadable(bgr8Entry);
+    bool hasRGB8 = Spinnaker::GenApi::IsAvailable(rgb8Entry) && Spinnaker::GenApi::IsReadable(rgb8Entry);
+    bool hasBayer = Spinnaker::GenApi::IsAvailable(bayerEntry) && Spinnaker::GenApi::IsReadable(bayerEntry);
+
+    // Detect mono camera: has Mono8 but no color formats
+    is_mono_camera_ = hasMono8 && !hasBGR8 && !hasRGB8 && !hasBayer;
+
+    Spinnaker::GenApi::CEnumEntryPtr pixelFormatEntry = nullptr;
+
+    if (is_mono_camera_) {
+        // Mono camera - use Mono8 directly (optimal)
+        pixelFormatEntry = mono8Entry;
+        spdlog::info("Detected mono camera - using Mono8 format (no conversion needed)");
+    } else if (preferMono && hasMono8) {
+        // Every consumer accepts grayscale; let the sensor skip debayering
+        pixelFormatEntry = mono8Entry;
+    } else {
+        // Color camera - try color formats first
+        if (hasBGR8) {
+            pixelFormatEntry = bgr8Entry;
+        } else if (hasRGB8) {
+            pixelFormatEntry = rgb8Entry;
+        } else if (hasBayer) {
+            pixelFormatEntry = bayerEntry;
+        } else if (hasMono8) {
+            pixelFormatEntry = mono8Entry;
+        }
+    }
+
+    if (pixelFormatEntry) {
+        pixelFormat->SetIntValue(pixelFormatEntry->GetValue());
+        spdlog::debug("Set pixel format to: {}", pixelFormatEntry->GetSymbolic().c_str());
+    }
+}
+
 void SpinnakerDriver::configureStreamBuffers() {
     try {
         // Configure stream buffer handling for performance
@@ -407,6 +471,10 @@ FrameResult SpinnakerDriver::getFrame() {
         // Convert frame (preserves Mono8 for mono cameras, converts to BGR for color cameras)
         result.color = convertFrame(image);
 
+        if (hasExposureChunk_) {
+            result.exposure = static_cast<int>(image->GetChunkData().GetExposureTime());
+        }
+
         image->Release();
 
     } catch (Spinnaker::Exception& e) {
@@ -604,6 +672,153 @@ BaseDriver::Range SpinnakerDriver::getGainRange() const {
     return {0, 100, 1, 0};
 }
 
+CaptureMode SpinnakerDriver::negotiate(const CaptureRequirements& requirements) {
+    CaptureMode mode;
+    if (!connected_ || !cameraPtr_) return mode;
+
+    Spinnaker::GenApi::INodeMap& nodeMap = cameraPtr_->GetNodeMap();
+
+    auto setInt = [&nodeMap](const char* name, int64_t value) {
+        Spinnaker::GenApi::CIntegerPtr node = nodeMap.GetNode(name);
+        if (!Spinnaker::GenApi::IsAvailable(node) || !Spinnaker::GenApi::IsWritable(node)) return false;
+        int64_t inc = (std::max)(node->GetInc(), int64_t{1});
+        value = (std::max)(node->GetMin(), (std::min)(value - value % inc, node->GetMax()));
+        node->SetValue(value);
+        return true;
+    };
+    auto setBool = [&nodeMap](const char* name, bool value) {
+        Spinnaker::GenApi::CBooleanPtr node = nodeMap.GetNode(name);
+        if (!Spinnaker::GenApi::IsAvailable(node) || !Spinnaker::GenApi::IsWritable(node)) return false;
+        node->SetValue(value);
+        return true;
+    };
+
+    try {
+        // Geometry and pixel format are locked while streaming
+        if (cameraPtr_->IsStreaming()) {
+            cameraPtr_->EndAcquisition();
+        }
+
+        // Reset to the full, unbinned sensor so the maxima below are meaningful
+        setInt("OffsetX", 0);
+        setInt("OffsetY", 0);
+        setInt("BinningHorizontal", 1);
+        setInt("BinningVertical", 1);
+
+        Spinnaker::GenApi::CIntegerPtr widthNode = nodeMap.GetNode("Width");
+        Spinnaker::GenApi::CIntegerPtr heightNode = nodeMap.GetNode("Height");
+        int64_t baseWidth = widthNode->GetMax();
+        int64_t baseHeight = heightNode->GetMax();
+
+        // A user-chosen resolution is the ceiling; pipelines may only ask for less
+        if (camera_.resolution_json) {
+            try {
+                auto res = nlohmann::json::parse(*camera_.resolution_json);
+                baseWidth = (std::min)(baseWidth, res["width"].get<int64_t>());
+                baseHeight = (std::min)(baseHeight, res["height"].get<int64_t>());
+            } catch (const std::exception& e) {
+                spdlog::warn("Failed to parse resolution: {}", e.what());
+            }
+        }
+
+        // Binning keeps the field of view and cuts bandwidth, unlike a crop
+        int binning = 1;
+        if (!requirements.fullResolution) {
+            Spinnaker::GenApi::CIntegerPtr binH = nodeMap.GetNode("BinningHorizontal");
+            int64_t maxBin = Spinnaker::GenApi::IsAvailable(binH) ? binH->GetMax() : 1;
+            for (int candidate : {4, 2}) {
+                if (candidate <= maxBin &&
+                    baseWidth / candidate >= requirements.minWidth &&
+                    baseHeight / candidate >= requirements.minHeight) {
+                    binning = candidate;
+                    break;
+                }
+            }
+            if (binning > 1 && !(setInt("BinningHorizontal", binning) && setInt("BinningVertical", binning))) {
+                setInt("BinningHorizontal", 1);
+                setInt("BinningVertical", 1);
+                binning = 1;
+            }
+        }
+
+        int64_t width = baseWidth / binning;
+        int64_t height = baseHeight / binning;
+        int64_t offsetX = 0;
+        int64_t offsetY = 0;
+
+        // Sensor ROI: only read out the rows and columns some pipeline looks at
+        if (requirements.roi) {
+            const auto& roi = *requirements.roi;
+            int64_t roiWidth = (std::max)(static_cast<int64_t>(roi.width * width), static_cast<int64_t>(requirements.minWidth));
+            int64_t roiHeight = (std::max)(static_cast<int64_t>(roi.height * height), static_cast<int64_t>(requirements.minHeight));
+            offsetX = static_cast<int64_t>(roi.x * width);
+            offsetY = static_cast<int64_t>(roi.y * height);
+            width = (std::min)(roiWidth, width - offsetX);
+            height = (std::min)(roiHeight, height - offsetY);
+            mode.roiApplied = true;
+        }
+
+        // Width/Height first: the offset maxima depend on them
+        setInt("Width", width);
+        setInt("Height", height);
+        if (mode.roiApplied) {
+            setInt("OffsetX", offsetX);
+            setInt("OffsetY", offsetY);
+        }
+
+        selectPixelFormat(requirements.monoOk);
+
+        // A 180 degree mount is a plain readout reversal on the sensor; 90/270 still need cv::rotate
+        bool flip = requirements.orientation == 180;
+        bool flipX = setBool("ReverseX", flip);
+        bool flipY = setBool("ReverseY", flip);
+        mode.hardwareOrientation = flip && flipX && flipY;
+        if (flip && !mode.hardwareOrientation) {
+            setBool("ReverseX", false);
+            setBool("ReverseY", false);
+        }
+
+        int targetFps = requirements.targetFps > 0 ? requirements.targetFps : camera_.framerate.value_or(0);
+        if (targetFps > 0) {
+            Spinnaker::GenApi::CBooleanPtr frameRateEnable = nodeMap.GetNode("AcquisitionFrameRateEnable");
+            if (Spinnaker::GenApi::IsAvailable(frameRateEnable) && Spinnaker::GenApi::IsWritable(frameRateEnable)) {
+                frameRateEnable->SetValue(true);
+            }
+
+            // The maximum depends on the new geometry, so read it after the ROI is set
+            Spinnaker::GenApi::CFloatPtr frameRate = nodeMap.GetNode("AcquisitionFrameRate");
+            if (Spinnaker::GenApi::IsAvailable(frameRate) && Spinnaker::GenApi::IsWritable(frameRate)) {
+                frameRate->SetValue((std::min)(static_cast<double>(targetFps), frameRate->GetMax()));
+            }
+        }
+
+        cameraPtr_->BeginAcquisition();
+
+        Spinnaker::GenApi::CFloatPtr frameRate = nodeMap.GetNode("AcquisitionFrameRate");
+        Spinnaker::GenApi::CEnumerationPtr pixelFormat = nodeMap.GetNode("PixelFormat");
+        mode.width = static_cast<int>(widthNode->GetValue());
+        mode.height = static_cast<int>(heightNode->GetValue());
+        mode.fps = Spinnaker::GenApi::IsReadable(frameRate) ? static_cast<int>(frameRate->GetValue()) : 0;
+        mode.mono = Spinnaker::GenApi::IsReadable(pixelFormat) &&
+                    pixelFormat->GetCurrentEntry()->GetSymbolic() == "Mono8";
+        mode.binning = binning;
+        mode.offsetX = static_cast<int>(offsetX);
+        mode.offsetY = static_cast<int>(offsetY);
+    } catch (Spinnaker::Exception& e) {
+        spdlog::warn("Spinnaker capture negotiation failed: {}", e.what());
+        try {
+            if (!cameraPtr_->IsStreaming()) {
+                cameraPtr_->BeginAcquisition();
+            }
+        } catch (Spinnaker::Exception&) {
+            disconnect();  // Let CameraThread reconnect with the configured mode
+        }
+        return CaptureMode{};
+    }
+
+    return mode;
+}
+
 // ============================================================================
 // DEVICE DISCOVERY
 // ============================================================================
@@ -611,7 +826,7 @@ BaseDriver::Range SpinnakerDriver::getGainRange() const {
 std::vector<DeviceInfo> SpinnakerDriver::listDevices() {
     std::vector<DeviceInfo> devices;
 
-    if (!initialized_) {
+    if (!isAvailable()) {
         return devices;
     }
 
@@ -672,7 +887,7 @@ std::vector<DeviceInfo> SpinnakerDriver::listDevices() {
 std::vector<CameraProfile> SpinnakerDriver::getSupportedProfiles(const std::string& identifier) {
     std::vector<CameraProfile> profiles;
 
-    if (!initialized_) {
+    if (!isAvailable()) {
         return profiles;
     }
 
@@ -962,7 +1177,7 @@ SpinnakerNode SpinnakerDriver::nodeToStruct(Spinnaker::GenApi::INode* node) {
 std::pair<std::vector<SpinnakerNode>, std::string> SpinnakerDriver::getNodeMap(const std::string& identifier) {
     std::vector<SpinnakerNode> nodes;
 
-    if (!initialized_) {
+    if (!isAvailable()) {
         return {nodes, "Spinnaker SDK not initialized"};
     }
 
@@ -1033,7 +1248,7 @@ std::tuple<bool, std::string, int, nlohmann::json> SpinnakerDriver::updateNode(
     const std::string& nodeName,
     const std::string& value
 ) {
-    if (!initialized_) {
+    if (!isAvailable()) {
         return {false, "Spinnaker SDK not initialized", 500, nullptr};
     }
 
@@ -1112,7 +1327,7 @@ std::tuple<bool, std::string, int, nlohmann::json> SpinnakerDriver::updateNode(
 // STUB IMPLEMENTATIONS (when Spinnaker is not available)
 // ============================================================================
 
-bool SpinnakerDriver::connect() {
+bool SpinnakerDriver::connect(bool, std::chrono::milliseconds) {
     spdlog::error("Spinnaker support not compiled in. Rebuild with --spinnaker=y");
     return false;
 }
@@ -1135,6 +1350,7 @@ int SpinnakerDriver::getExposure() const { return 0; }
 int SpinnakerDriver::getGain() const { return 0; }
 BaseDriver::Range SpinnakerDriver::getExposureRange() const { return {0, 10000, 1, 500}; }
 BaseDriver::Range SpinnakerDriver::getGainRange() const { return {0, 100, 1, 0}; }
+CaptureMode SpinnakerDriver::negotiate(const CaptureRequirements&) { return {}; }
 
 std::vector<DeviceInfo> SpinnakerDriver::listDevices() {
     spdlog::warn("Spinnaker support not compiled in");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "drivers/base_driver.hpp"
+#include "drivers/sdk_initializer.hpp"
 #include <opencv2/opencv.hpp>
 #include <string>
 #include <vector>
@@ -41,7 +42,8 @@ public:
     ~SpinnakerDriver() override;
 
     // BaseDriver interface
-    bool connect(bool silent = false) override;
+    bool connect(bool silent = false,
+                 std::chrono::milliseconds sdkWait = std::chrono::milliseconds(0)) override;
     void disconnect() override;
     bool isConnected() const override;
     FrameResult getFrame() override;
@@ -52,15 +54,20 @@ public:
     int getGain() const override;
     Range getExposureRange() const override;
     Range getGainRange() const override;
+    CaptureMode negotiate(const CaptureRequirements& requirements) override;
 
     // Static discovery methods
     static std::vector<DeviceInfo> listDevices();
     static std::vector<CameraProfile> getSupportedProfiles(const std::string& identifier);
 
-    // Spinnaker system management
-    static void initialize();
+    // Spinnaker system management. Nothing is loaded at startup: the first camera or
+    // discovery request initializes the SDK on a background thread.
+    static bool initialize();
     static void shutdown();
-    static bool isAvailable();
+    static void initializeAsync();  // Start without waiting
+    static bool isAvailable();      // Start if needed and wait for the result
+    static bool isLoaded();         // Initialized successfully; never starts or waits
+    static SdkInitializer::State sdkState();  // Never starts or waits
 
     // Node map operations (Spinnaker-compliant)
     static std::pair<std::vector<SpinnakerNode>, std::string> getNodeMap(const std::string& identifier);
@@ -74,6 +81,7 @@ private:
     Camera camera_;
     bool connected_ = false;
     bool is_mono_camera_ = false;  // True if camera only supports mono formats
+    bool hasExposureChunk_ = false;  // Images carry ExposureTime chunk data
 
     // Spinnaker system singleton
     static std::mutex systemMutex_;
@@ -85,6 +93,7 @@ private:
 
     // Helper methods
     void configureCamera();
+    void selectPixelFormat(bool preferMono);
     void configureStreamBuffers();
     cv::Mat convertFrame(const Spinnaker::ImagePtr& image);
 
@@ -1,7 +1,9 @@
 #include "drivers/usb_driver.hpp"
+#include "services/usb_bandwidth_planner.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 #include <algorithm>
+#include <cmath>
 #include <string>
 
 #ifdef _WIN32
@@ -204,7 +206,7 @@ USBDriver::~USBDriver() {
     disconnect();
 }
 
-bool USBDriver::connect(bool silent) {
+bool USBDriver::connect(bool silent, std::chrono::milliseconds) {
     if (isConnected()) {
         return true;
     }
@@ -249,6 +251,30 @@ bool USBDriver::connect(bool silent) {
         reqFps = *camera_.framerate;
     }
 
+    // The bandwidth planner may have lowered the mode so the bus can carry every camera
+    bool planned = false;
+    if (auto alloc = UsbBandwidthPlanner::instance().allocation(camera_.id)) {
+        if (alloc->width != reqWidth || alloc->height != reqHeight || alloc->fps != reqFps) {
+            spdlog::info("USB camera '{}' using planned mode {}x{} @ {} fps (bus bandwidth)",
+                         camera_.name, alloc->width, alloc->height, alloc->fps);
+            planned = true;
+        }
+        reqWidth = alloc->width;
+        reqHeight = alloc->height;
+        reqFps = alloc->fps;
+        if (!alloc->fourcc.empty()) {
+            // FOURCC must be set before the size for V4L2 to pick the matching format
+            const auto& f = alloc->fourcc;
+            cap_.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc(f[0], f[1], f[2], f[3]));
+        }
+    }
+
+    configuredWidth_ = reqWidth;
+    configuredHeight_ = reqHeight;
+    configuredFps_ = reqFps;
+    resolutionPinned_ = camera_.resolution_json.has_value() || planned;
+    bandwidthLimited_ = planned;
+
     // Try to set properties
     cap_.set(cv::CAP_PROP_FRAME_WIDTH, reqWidth);
     cap_.set(cv::CAP_PROP_FRAME_HEIGHT, reqHeight);
@@ -269,6 +295,61 @@ bool USBDriver::connect(bool silent) {
     return true;
 }
 
+bool USBDriver::applyResolution(int width, int height, int fps) {
+    // Setting any property restarts the V4L2 stream; skip when nothing changes
+    if (static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_WIDTH)) == width &&
+        static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_HEIGHT)) == height &&
+        static_cast<int>(cap_.get(cv::CAP_PROP_FPS)) == fps) {
+        return true;
+    }
+
+    cap_.set(cv::CAP_PROP_FRAME_WIDTH, width);
+    cap_.set(cv::CAP_PROP_FRAME_HEIGHT, height);
+    cap_.set(cv::CAP_PROP_FPS, fps);
+    return static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_WIDTH)) == width &&
+           static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_HEIGHT)) == height;
+}
+
+CaptureMode USBDriver::negotiate(const CaptureRequirements& requirements) {
+    CaptureMode mode;
+    if (!cap_.isOpened()) {
+        return mode;
+    }
+
+    // UVC cameras expose neither ROI, binning nor mono; only the resolution ladder is negotiable
+    int fps = requirements.targetFps > 0 ? requirements.targetFps : configuredFps_;
+    if (bandwidthLimited_) {
+        fps = (std::min)(fps, configuredFps_);
+    }
+    bool applied = false;
+
+    if (!requirements.fullResolution) {
+        double aspect = static_cast<double>(configuredWidth_) / configuredHeight_;
+        for (const auto& res : UsbBandwidthPlanner::resolutionLadder()) {
+            if (res.width < requirements.minWidth || res.height < requirements.minHeight) continue;
+            if (resolutionPinned_) {
+                // Never exceed the user's (or the planner's) choice, and keep its aspect
+                // ratio so FOV-based targeting still matches the frame
+                if (res.width > configuredWidth_ || res.height > configuredHeight_) continue;
+                if (std::abs(static_cast<double>(res.width) / res.height - aspect) > 0.01) continue;
+            }
+            if (applyResolution(res.width, res.height, fps)) {
+                applied = true;
+                break;
+            }
+        }
+    }
+
+    if (!applied) {
+        applyResolution(configuredWidth_, configuredHeight_, fps);
+    }
+
+    mode.width = static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_WIDTH));
+    mode.height = static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_HEIGHT));
+    mode.fps = static_cast<int>(cap_.get(cv::CAP_PROP_FPS));
+    return mode;
+}
+
 void USBDriver::disconnect() {
     if (cap_.isOpened()) {
         cap_.release();
@@ -13,7 +13,8 @@ public:
     explicit USBDriver(const Camera& camera);
     ~USBDriver() override;
 
-    bool connect(bool silent = false) override;
+    bool connect(bool silent = false,
+                 std::chrono::milliseconds sdkWait = std::chrono::milliseconds(0)) override;
     void disconnect() override;
     bool isConnected() const override;
     FrameResult getFrame() override;
@@ -24,6 +25,7 @@ public:
     int getGain() const override;
     Range getExposureRange() const override;
     Range getGainRange() const override;
+    CaptureMode negotiate(const CaptureRequirements& requirements) override;
 
     // Extended controls
     void setFocus(bool autoFocus, int value);
@@ -36,8 +38,16 @@ public:
 private:
     Camera camera_;
     cv::VideoCapture cap_;
-    
+
+    // Mode requested by the camera settings; negotiation never exceeds it
+    int configuredWidth_ = 640;
+    int configuredHeight_ = 480;
+    int configuredFps_ = 30;
+    bool resolutionPinned_ = false;  // User chose a resolution; otherwise 640x480 is only a default
+    bool bandwidthLimited_ = false;  // Mode came from the USB bandwidth planner; fps is a ceiling too
+
     // Helper methods
+    bool applyResolution(int width, int height, int fps);
     int findDeviceIndex(bool silent = false) const;
 };
 
@@ -1,8 +1,14 @@
 #include "hw/accel.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <cstdlib>
+#include <set>
+#include <thread>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -10,6 +16,23 @@
 #include <unistd.h>
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VISION_HW_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+#include <sys/auxv.h>
+#endif
+
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
 // ONNX Runtime
 #include <onnxruntime_cxx_api.h>
 
@@ -40,7 +63,9 @@ bool isLinux() {
 #endif
 }
 
-bool hasNvidiaGPU() {
+namespace {
+
+bool probeNvidiaGPU() {
     // Check for nvidia-smi utility
 #ifdef _WIN32
     // Try to run nvidia-smi
@@ -64,7 +89,7 @@ bool hasNvidiaGPU() {
 #endif
 }
 
-bool isOrangePi5() {
+bool probeOrangePi5() {
     // Check environment variable override
     const char* forceOpi5 = std::getenv("VISIONTOOLS_FORCE_OPI5");
     if (forceOpi5 && std::string(forceOpi5) == "1") {
@@ -98,7 +123,7 @@ bool isOrangePi5() {
     return false;
 }
 
-std::vector<std::string> getAvailableOnnxProviders() {
+std::vector<std::string> probeOnnxProviders(bool nvidiaGpu) {
     std::vector<std::string> providers;
 
     try {
@@ -112,7 +137,7 @@ std::vector<std::string> getAvailableOnnxProviders() {
             }
 
             if (provider == "CUDAExecutionProvider" || provider == "TensorrtExecutionProvider") {
-                if (!hasNvidiaGPU()) {
+                if (!nvidiaGpu) {
                     continue;
                 }
             }
@@ -131,19 +156,9 @@ std::vector<std::string> getAvailableOnnxProviders() {
     return providers;
 }
 
-std::vector<std::string> getAvailableTfLiteDelegates() {
-    std::vector<std::string> delegates;
-
-    // TFLite C++ integration is complex and requires separate library
-    // For now, return empty - can be implemented when TFLite is added
-    // delegates.push_back("CPU");
-
-    return delegates;
-}
-
-bool hasRknnSupport() {
+bool probeRknnSupport(bool orangePi5) {
     // RKNN support requires Orange Pi 5 and the RKNN toolkit
-    if (!isOrangePi5()) {
+    if (!orangePi5) {
         return false;
     }
 
@@ -165,6 +180,248 @@ bool hasRknnSupport() {
     return false;
 }
 
+#ifdef VISION_HW_X86
+void cpuid(int leaf, int subleaf, unsigned regs[4]) {
+#ifdef _MSC_VER
+    int out[4];
+    __cpuidex(out, leaf, subleaf);
+    for (int i = 0; i < 4; i++) regs[i] = static_cast<unsigned>(out[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Register state the OS saves on context switch (XCR0)
+unsigned long long xgetbv0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+CpuFeatures probeCpuFeatures() {
+    CpuFeatures features;
+#ifdef VISION_HW_X86
+    unsigned regs[4] = {};
+    cpuid(0, 0, regs);
+    unsigned maxLeaf = regs[0];
+    cpuid(1, 0, regs);
+    bool osxsave = regs[2] & (1u << 27);
+    unsigned long long xcr0 = osxsave ? xgetbv0() : 0;
+    bool avxState = (xcr0 & 0x6) == 0x6;            // XMM and YMM
+    bool avx512State = avxState && (xcr0 & 0xe0) == 0xe0;  // Opmask and ZMM
+    if (maxLeaf >= 7) {
+        cpuid(7, 0, regs);
+        features.avx2 = avxState && (regs[1] & (1u << 5));
+        features.avx512 = avx512State && (regs[1] & (1u << 16));
+        features.avx512vnni = features.avx512 && (regs[2] & (1u << 11));
+        unsigned subleaves = regs[0];
+        if (subleaves >= 1) {
+            cpuid(7, 1, regs);
+            features.avxvnni = avxState && (regs[0] & (1u << 4));
+        }
+    }
+#elif defined(__APPLE__) && defined(__aarch64__)
+    features.neon = true;
+    auto sysctlFlag = [](const char* name) {
+        int value = 0;
+        size_t size = sizeof(value);
+        return sysctlbyname(name, &value, &size, nullptr, 0) == 0 && value != 0;
+    };
+    features.dotprod = sysctlFlag("hw.optional.arm.FEAT_DotProd");
+#elif defined(__linux__) && defined(__aarch64__)
+    // HWCAP_ASIMD, HWCAP_ASIMDDP, HWCAP_SVE from <asm/hwcap.h>
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    features.neon = hwcap & (1ul << 1);
+    features.dotprod = hwcap & (1ul << 20);
+    features.sve = hwcap & (1ul << 22);
+#elif defined(__linux__) && defined(__arm__)
+    features.neon = getauxval(AT_HWCAP) & (1ul << 12);  // HWCAP_NEON
+#elif defined(__ARM_NEON)
+    features.neon = true;
+#endif
+    return features;
+}
+
+CpuTopology probeCpuTopology() {
+    CpuTopology topology;
+    topology.logicalCores = static_cast<int>((std::max)(1u, std::thread::hardware_concurrency()));
+    topology.physicalCores = topology.logicalCores;
+
+#ifdef __linux__
+    namespace fs = std::filesystem;
+    std::set<std::pair<int, int>> cores;  // (package, core)
+    std::vector<std::pair<int, int>> cpuMaxKhz;
+    std::vector<std::pair<int, int>> cpuCapacity;  // Scheduler capacity (arm64, newer x86 hybrids)
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator("/sys/devices/system/cpu", ec)) {
+        auto name = entry.path().filename().string();
+        if (name.size() <= 3 || name.rfind("cpu", 0) != 0 ||
+            !std::all_of(name.begin() + 3, name.end(), ::isdigit)) {
+            continue;
+        }
+        int cpu = std::stoi(name.substr(3));
+        int package = 0, core = cpu, maxKhz = 0, capacity = 0;
+        std::ifstream(entry.path() / "topology/physical_package_id") >> package;
+        std::ifstream(entry.path() / "topology/core_id") >> core;
+        std::ifstream(entry.path() / "cpufreq/cpuinfo_max_freq") >> maxKhz;
+        std::ifstream(entry.path() / "cpu_capacity") >> capacity;
+        cores.emplace(package, core);
+        cpuMaxKhz.emplace_back(cpu, maxKhz);
+        cpuCapacity.emplace_back(cpu, capacity);
+    }
+    if (!cores.empty()) {
+        topology.physicalCores = static_cast<int>(cores.size());
+    }
+
+    std::set<int, std::greater<int>> clusters;
+    for (const auto& [cpu, khz] : cpuMaxKhz) clusters.insert(khz);
+    for (int khz : clusters) {
+        if (khz > 0) topology.clusterMaxMhz.push_back(khz / 1000);
+    }
+    // Binned or boosted cores (Intel TBM3 favored cores, RK3588's two A76 pairs) top out a
+    // little apart, so anything within 10% of the fastest counts. The scheduler's capacity
+    // already folds in microarchitecture and is preferred when the kernel exposes it.
+    bool haveCapacity = std::any_of(cpuCapacity.begin(), cpuCapacity.end(),
+                                    [](const auto& c) { return c.second > 0; });
+    const auto& rank = haveCapacity ? cpuCapacity : cpuMaxKhz;
+    int fastest = 0;
+    for (const auto& [cpu, value] : rank) fastest = (std::max)(fastest, value);
+    for (const auto& [cpu, value] : rank) {
+        if (fastest > 0 && value >= fastest * 0.9) topology.performanceCores.push_back(cpu);
+    }
+    std::sort(topology.performanceCores.begin(), topology.performanceCores.end());
+#endif
+
+    if (topology.performanceCores.empty()) {
+        for (int cpu = 0; cpu < topology.logicalCores; cpu++) {
+            topology.performanceCores.push_back(cpu);
+        }
+    }
+    return topology;
+}
+
+std::string probeCpuModel() {
+#ifdef VISION_HW_X86
+    unsigned regs[4] = {};
+    cpuid(0x80000000, 0, regs);
+    if (regs[0] >= 0x80000004) {
+        char brand[49] = {};
+        for (unsigned leaf = 0; leaf < 3; leaf++) {
+            cpuid(0x80000002 + leaf, 0, regs);
+            std::memcpy(brand + leaf * 16, regs, 16);
+        }
+        std::string model(brand);
+        model.erase(0, model.find_first_not_of(' '));
+        return model;
+    }
+#elif defined(__APPLE__)
+    char brand[256] = {};
+    size_t size = sizeof(brand);
+    if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) == 0) {
+        return brand;
+    }
+#elif defined(__linux__)
+    // ARM kernels have no "model name"; the device tree names the board instead
+    std::ifstream model("/proc/device-tree/model");
+    std::string line;
+    if (std::getline(model, line)) {
+        return line.c_str();  // Drop the trailing NUL
+    }
+#endif
+    return {};
+}
+
+} // namespace
+
+nlohmann::json CpuFeatures::toJson() const {
+    return {
+        {"neon", neon},
+        {"dotprod", dotprod},
+        {"sve", sve},
+        {"avx2", avx2},
+        {"avx512", avx512},
+        {"avx512_vnni", avx512vnni},
+        {"avx_vnni", avxvnni}
+    };
+}
+
+nlohmann::json CpuTopology::toJson() const {
+    return {
+        {"logical_cores", logicalCores},
+        {"physical_cores", physicalCores},
+        {"performance_cores", performanceCores},
+        {"cluster_max_mhz", clusterMaxMhz}
+    };
+}
+
+nlohmann::json HardwareInfo::toJson() const {
+    return {
+        {"cpu_model", cpuModel},
+        {"features", cpu.toJson()},
+        {"topology", topology.toJson()}
+    };
+}
+
+const HardwareInfo& probe() {
+    static const HardwareInfo info = []() {
+        HardwareInfo hw;
+        hw.cpuModel = probeCpuModel();
+        hw.cpu = probeCpuFeatures();
+        hw.topology = probeCpuTopology();
+        hw.nvidiaGpu = probeNvidiaGPU();
+        hw.orangePi5 = probeOrangePi5();
+        hw.rknn = probeRknnSupport(hw.orangePi5);
+        hw.onnxProviders = probeOnnxProviders(hw.nvidiaGpu);
+
+        std::vector<std::string> isa;
+        const std::pair<bool, const char*> flags[] = {
+            {hw.cpu.neon, "NEON"}, {hw.cpu.dotprod, "dotprod"}, {hw.cpu.sve, "SVE"},
+            {hw.cpu.avx2, "AVX2"}, {hw.cpu.avx512, "AVX-512"}, {hw.cpu.avx512vnni, "AVX512-VNNI"},
+            {hw.cpu.avxvnni, "AVX-VNNI"}};
+        std::string isaList;
+        for (const auto& [present, name] : flags) {
+            if (present) isaList += (isaList.empty() ? "" : " ") + std::string(name);
+        }
+        spdlog::info("Hardware: {} ({} logical / {} physical cores, {} performance), ISA: {}",
+                     hw.cpuModel.empty() ? "unknown CPU" : hw.cpuModel, hw.topology.logicalCores,
+                     hw.topology.physicalCores, hw.topology.performanceCores.size(),
+                     isaList.empty() ? "baseline" : isaList);
+        return hw;
+    }();
+    return info;
+}
+
+bool hasNvidiaGPU() {
+    return probe().nvidiaGpu;
+}
+
+bool isOrangePi5() {
+    return probe().orangePi5;
+}
+
+std::vector<std::string> getAvailableOnnxProviders() {
+    return probe().onnxProviders;
+}
+
+std::vector<std::string> getAvailableTfLiteDelegates() {
+    std::vector<std::string> delegates;
+
+    // TFLite C++ integration is complex and requires separate library
+    // For now, return empty - can be implemented when TFLite is added
+    // delegates.push_back("CPU");
+
+    return delegates;
+}
+
+bool hasRknnSupport() {
+    return probe().rknn;
+}
+
 nlohmann::json getMLAvailability() {
     auto onnxProviders = getAvailableOnnxProviders();
     auto tfliteDelegates = getAvailableTfLiteDelegates();
@@ -179,6 +436,7 @@ nlohmann::json getMLAvailability() {
             {"has_nvidia", hasNvidiaGPU()},
             {"is_orangepi5", orangePi5}
         }},
+        {"cpu", probe().toJson()},
         {"onnx", {
             {"providers", onnxProviders}
         }},
@@ -7,6 +7,46 @@
 namespace vision {
 namespace hw {
 
+// CPU instruction set extensions usable by this process (OS support included)
+struct CpuFeatures {
+    bool neon = false;
+    bool dotprod = false;     // ARMv8.2 SDOT/UDOT
+    bool sve = false;
+    bool avx2 = false;
+    bool avx512 = false;      // AVX-512F
+    bool avx512vnni = false;
+    bool avxvnni = false;     // VEX-encoded VNNI (Alder Lake and later)
+
+    nlohmann::json toJson() const;
+};
+
+// Logical CPUs grouped by maximum frequency; on big.LITTLE SoCs (RK3588: 4x A76 + 4x A55)
+// the fastest cluster is where latency-sensitive inference threads belong
+struct CpuTopology {
+    int logicalCores = 1;
+    int physicalCores = 1;
+    std::vector<int> performanceCores;  // CPUs within 10% of the fastest by capacity or max freq (all when uniform)
+    std::vector<int> clusterMaxMhz;     // Distinct maximum frequencies, fastest first
+
+    nlohmann::json toJson() const;
+};
+
+// Probed once at startup; every accessor below reads this cache
+struct HardwareInfo {
+    std::string cpuModel;
+    CpuFeatures cpu;
+    CpuTopology topology;
+    bool nvidiaGpu = false;
+    bool orangePi5 = false;
+    bool rknn = false;
+    std::vector<std::string> onnxProviders;
+
+    nlohmann::json toJson() const;
+};
+
+// Runs the probe on first call (main calls it before any camera or pipeline starts)
+const HardwareInfo& probe();
+
 // Platform detection
 bool isMacOS();
 bool isWindows();
@@ -12,9 +12,19 @@
 #include "vision/field_layout.hpp"
 #include "services/pipeline_service.hpp"
 #include "services/streamer_service.hpp"
+#include "services/cluster_service.hpp"
+#include "services/frame_bus_service.hpp"
+#include "services/usb_bandwidth_planner.hpp"
+#include "services/job_service.hpp"
+#include "services/power_mode_service.hpp"
+#include "services/thermal_governor.hpp"
+#include "services/result_log_service.hpp"
 #include "drivers/realsense_driver.hpp"
 #include "drivers/spinnaker_driver.hpp"
 #include "threads/thread_manager.hpp"
+#include "metrics/memory.hpp"
+#include "metrics/history.hpp"
+#include "hw/accel.hpp"
 
 // Route controllers
 #include "routes/cameras.hpp"
@@ -25,6 +35,9 @@
 #include "routes/database.hpp"
 #include "routes/calibration.hpp"
 #include "routes/networktables.hpp"
+#include "routes/cluster.hpp"
+#include "routes/jobs.hpp"
+#include "routes/logs.hpp"
 #include "routes/vision_ws.hpp"
 
 #include <opencv2/core/utils/logger.hpp>
@@ -42,22 +55,32 @@ int main(int argc, char** argv) {
     auto& config = vision::Config::instance();
     config.load();
 
+    // Opt-in allocator tuning, before any worker threads or frame buffers exist
+    vision::MemoryTracker::configureHeap(config.heap.mmap_threshold_kb, config.heap.arena_max);
+
+    // Probe CPU features, topology and accelerators once; everything else reads the cache
+    vision::hw::probe();
+
     // Initialize database
     vision::Database::instance().initialize(config.database_path);
 
     // Initialize Field Layouts
     vision::FieldLayoutService::instance().initialize(config.data_directory);
 
-    // Initialize camera SDK support
-    vision::RealSenseDriver::initialize();
-    vision::SpinnakerDriver::initialize();
-
     // Initialize MJPEG Streamer
-    vision::StreamerService::instance().initialize(5805);
+    vision::StreamerService::instance().initialize(config.server.stream_port);
 
-    // Initialize NetworkTables if team number is set
+    // Shared-memory frame bus for external consumers (opt-in)
+    vision::FrameBusService::instance().initialize();
+
+    // Join the coprocessor cluster (no-op when standalone)
+    vision::ClusterService::instance().start(config.cluster, config.server.port, config.server.stream_port);
+
+    // Initialize NetworkTables if team number is set (followers leave NT to the leader)
     auto globalSettings = vision::SettingsService::instance().getGlobalSettings();
-    if (globalSettings.team_number > 0) {
+    if (!vision::ClusterService::instance().publishesNetworkTables()) {
+        spdlog::info("Startup: cluster follower, skipping NetworkTables connection");
+    } else if (globalSettings.team_number > 0) {
         spdlog::info("Startup: connecting to NetworkTables for team {}", globalSettings.team_number);
         vision::NetworkTablesService::instance().connect(globalSettings.team_number);
     }
@@ -69,16 +92,52 @@ int main(int argc, char** argv) {
         }
     );
 
+    // Throttle cameras while the robot is disabled; full rate again on enable
+    vision::PowerModeService::instance().configure(config.power.idle_when_disabled, config.power.idle_fps);
+    vision::NetworkTablesService::instance().setRobotStateCallback(
+        [](const vision::RobotState& state) {
+            vision::PowerModeService::instance().setRobotState(state);
+        }
+    );
+    vision::NetworkTablesService::instance().registerStatusCallback(
+        [](const vision::NTStatus& status) {
+            vision::PowerModeService::instance().setConnected(status.connected);
+        }
+    );
+
+    // Log every result to .wpilog, starting a new file for each FMS match
+    vision::ResultLogService::instance().start(config.resultlog);
+    vision::NetworkTablesService::instance().setMatchInfoCallback(
+        [](const vision::MatchInfo& info) {
+            vision::ResultLogService::instance().setMatchInfo(info);
+        }
+    );
+
+    // Let the robot idle pipelines it does not need right now
+    vision::NetworkTablesService::instance().setActivationCallbacks(
+        [](int pipelineId, bool enabled) {
+            vision::ThreadManager::instance().setPipelineEnabled(pipelineId, enabled);
+        },
+        [](int cameraId, const std::vector<int>& pipelineIds) {
+            vision::ThreadManager::instance().setActivePipelines(cameraId, pipelineIds);
+        }
+    );
+
     // Start the status monitor to detect connection changes
     vision::NetworkTablesService::instance().startStatusMonitor();
 
     // Start metrics broadcast via WebSocket
     vision::VisionWebSocket::instance().startMetricsBroadcast();
 
+    // Compute workers keep blocking handlers off the HTTP event loops
+    vision::JobService::instance().start(config.server.compute_threads, config.server.compute_queue);
+
     // Start all configured cameras and pipelines at startup so acquisition/processing is always running
     {
         auto cameras = vision::CameraService::instance().getAllCameras();
         spdlog::info("Startup: found {} cameras in database", cameras.size());
+        // Fit USB camera modes to their buses before any driver connects
+        vision::UsbBandwidthPlanner::instance().plan(cameras);
         for (const auto& cam : cameras) {
             spdlog::info("Startup: starting camera {} (id={}, identifier={})", cam.name, cam.id, cam.identifier);
             if (!vision::ThreadManager::instance().startCamera(cam)) {
@@ -106,6 +165,12 @@ int main(int argc, char** argv) {
         }
     }
 
+    // Shed load before the SoC throttles; restored as it cools
+    vision::ThermalGovernor::instance().start(config.thermal);
+
+    // 1 Hz metrics history with minute and hour rollups
+    vision::MetricsHistory::instance().start(config.metrics);
+
     // Register all route controllers
     vision::CamerasController::registerRoutes(app());
     vision::PipelinesController::registerRoutes(app());
@@ -115,6 +180,9 @@ int main(int argc, char** argv) {
     vision::DatabaseController::registerRoutes(app(), config.database_path);
     vision::CalibrationService::registerRoutes(app());
     vision::NetworkTablesRoutes::registerRoutes(app());
+    vision::ClusterController::registerRoutes(app());
+    vision::JobsController::registerRoutes(app());
+    vision::LogsController::registerRoutes(app());
 
     // Check for static frontend files (www/ folder next to executable)
     std::string exeDir = vision::Config::getExecutableDirectory();
@@ -167,6 +235,8 @@ int main(int argc, char** argv) {
     std::filesystem::create_directories(uploadPath);
 
     app().setUploadPath(uploadPath.string())
+        .setClientMaxBodySize(static_cast<size_t>(config.server.max_upload_mb) * 1024 * 1024)
+        .setClientMaxMemoryBodySize(static_cast<size_t>(config.server.max_memory_body_kb) * 1024)
         .setLogLevel(trantor::Logger::kWarn)
         .addListener(config.server.host, config.server.port)
         .setThreadNum(config.server.threads)
@@ -174,10 +244,16 @@ int main(int argc, char** argv) {
 
     // Stop the status monitor and metrics broadcast
     vision::VisionWebSocket::instance().stopMetricsBroadcast();
+    vision::JobService::instance().stop();
+    vision::ThermalGovernor::instance().stop();
+    vision::MetricsHistory::instance().stop();
     vision::NetworkTablesService::instance().stopStatusMonitor();
 
-    // Shutdown threads on exit
+    // Shutdown threads on exit; the result log drains after the last pipeline stops
     vision::ThreadManager::instance().shutdown();
+    vision::ResultLogService::instance().stop();
+    vision::FrameBusService::instance().closeAll();
+    vision::ClusterService::instance().stop();
 
     // Shutdown camera SDKs
     vision::SpinnakerDriver::shutdown();
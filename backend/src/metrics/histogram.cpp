@@ -0,0 +1,73 @@
+#include "metrics/histogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace vision {
+
+int LatencyHistogram::bucketFor(uint64_t us) {
+    if (us < static_cast<uint64_t>(LINEAR_LIMIT)) {
+        return static_cast<int>(us);
+    }
+    int msb = 63;
+    while (!(us >> msb)) msb--;
+    int shift = msb - SUB_BITS;
+    int sub = static_cast<int>((us >> shift) & (SUB_COUNT - 1));
+    int bucket = LINEAR_LIMIT + (msb - SUB_BITS - 1) * SUB_COUNT + sub;
+    return (std::min)(bucket, BUCKET_COUNT - 1);
+}
+
+double LatencyHistogram::bucketMidUs(int bucket) {
+    if (bucket < LINEAR_LIMIT) {
+        return static_cast<double>(bucket);
+    }
+    int index = bucket - LINEAR_LIMIT;
+    int msb = index / SUB_COUNT + SUB_BITS + 1;
+    int sub = index % SUB_COUNT;
+    int shift = msb - SUB_BITS;
+    uint64_t lower = (static_cast<uint64_t>(SUB_COUNT + sub)) << shift;
+    return static_cast<double>(lower) + static_cast<double>(uint64_t{1} << shift) / 2.0;
+}
+
+void LatencyHistogram::record(double ms) {
+    uint64_t us = ms > 0.0 ? static_cast<uint64_t>(std::llround(ms * 1000.0)) : 0;
+    buckets_[bucketFor(us)]++;
+    count_++;
+    sumUs_ += static_cast<double>(us);
+    maxUs_ = (std::max)(maxUs_, us);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < buckets_.size(); i++) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sumUs_ += other.sumUs_;
+    maxUs_ = (std::max)(maxUs_, other.maxUs_);
+}
+
+void LatencyHistogram::reset() {
+    buckets_.fill(0);
+    count_ = 0;
+    sumUs_ = 0.0;
+    maxUs_ = 0;
+}
+
+double LatencyHistogram::percentileMs(double q) const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    uint64_t target = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count_));
+    target = (std::max)(target, uint64_t{1});
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets_[i];
+        if (seen >= target) {
+            // Report the bucket midpoint, capped at the observed max
+            return (std::min)(bucketMidUs(i), static_cast<double>(maxUs_)) / 1000.0;
+        }
+    }
+    return maxUs_ / 1000.0;
+}
+
+} // namespace vision
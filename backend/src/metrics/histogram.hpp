@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace vision {
+
+// Log-linear latency histogram (8 sub-buckets per power of two, ~6% resolution)
+// covering 1us to ~19 hours. Fixed size, so recording never allocates.
+class LatencyHistogram {
+public:
+    void record(double ms);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return count_; }
+    double maxMs() const { return maxUs_ / 1000.0; }
+    double meanMs() const { return count_ ? (sumUs_ / count_) / 1000.0 : 0.0; }
+
+    // Value at quantile q in [0, 1], in milliseconds
+    double percentileMs(double q) const;
+
+private:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    static constexpr int LINEAR_LIMIT = 2 * SUB_COUNT;  // Exact buckets below 16us
+    static constexpr int BUCKET_COUNT = LINEAR_LIMIT + (46 - SUB_BITS - 1) * SUB_COUNT;
+
+    static int bucketFor(uint64_t us);
+    static double bucketMidUs(int bucket);
+
+    std::array<uint64_t, BUCKET_COUNT> buckets_{};
+    uint64_t count_ = 0;
+    double sumUs_ = 0.0;
+    uint64_t maxUs_ = 0;
+};
+
+} // namespace vision
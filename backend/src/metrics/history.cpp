@@ -0,0 +1,361 @@
+#include "metrics/history.hpp"
+#include "metrics/registry.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
+
+namespace vision {
+
+namespace {
+
+constexpr int kRaw = 1;
+constexpr int kMinute = 60;
+constexpr int kHour = 3600;
+
+// Auto resolution keeps responses to roughly this many rows per series
+constexpr int64_t kTargetPoints = 2000;
+constexpr int kMaxRows = 100000;
+
+int64_t epochSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+nlohmann::json columnJson(const SQLite::Column& column) {
+    if (column.isNull()) return nullptr;
+    if (column.isInteger()) return column.getInt64();
+    return column.getDouble();
+}
+
+} // namespace
+
+MetricsHistory& MetricsHistory::instance() {
+    static MetricsHistory instance;
+    return instance;
+}
+
+MetricsHistory::~MetricsHistory() {
+    stop();
+}
+
+void MetricsHistory::start(const MetricsConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || !config.enabled || !config.history_enabled) return;
+
+    config_ = config;
+    try {
+        auto parent = std::filesystem::path(config.history_path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+
+        std::lock_guard<std::mutex> dbLock(dbMutex_);
+        db_ = std::make_unique<SQLite::Database>(
+            config.history_path, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+        // One small transaction per second. With WAL, queries on the separate read
+        // connection see a snapshot and neither side waits for the other.
+        db_->exec("PRAGMA journal_mode = WAL;");
+        db_->exec("PRAGMA synchronous = NORMAL;");
+        createSchema();
+
+        // Resume rollups where the previous session stopped
+        auto next = [this](int resolution) -> int64_t {
+            SQLite::Statement query(*db_, "SELECT MAX(ts) FROM system_samples WHERE resolution = ?");
+            query.bind(1, resolution);
+            if (query.executeStep() && !query.getColumn(0).isNull()) {
+                return query.getColumn(0).getInt64() + resolution;
+            }
+            return 0;
+        };
+        nextMinute_ = next(kMinute);
+        nextHour_ = next(kHour);
+
+        std::lock_guard<std::mutex> readLock(readMutex_);
+        readDb_ = std::make_unique<SQLite::Database>(config.history_path, SQLite::OPEN_READONLY);
+    } catch (const std::exception& e) {
+        spdlog::error("Metrics history disabled: {}", e.what());
+        db_.reset();
+        std::lock_guard<std::mutex> readLock(readMutex_);
+        readDb_.reset();
+        return;
+    }
+
+    running_ = true;
+    thread_ = std::thread(&MetricsHistory::run, this);
+    spdlog::info("Metrics history: {}", config_.history_path);
+}
+
+void MetricsHistory::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void MetricsHistory::createSchema() {
+    // NOTE: Caller must hold dbMutex_
+    db_->exec(R"(
+        CREATE TABLE IF NOT EXISTS pipeline_samples (
+            resolution INTEGER NOT NULL,
+            ts INTEGER NOT NULL,
+            pipeline_id INTEGER NOT NULL,
+            pipeline_name TEXT,
+            fps REAL,
+            frames INTEGER,
+            dropped INTEGER,
+            latency_p50_ms REAL,
+            latency_p95_ms REAL,
+            latency_p99_ms REAL,
+            latency_max_ms REAL,
+            PRIMARY KEY (resolution, ts, pipeline_id)
+        ) WITHOUT ROWID;
+    )");
+    db_->exec(R"(
+        CREATE TABLE IF NOT EXISTS system_samples (
+            resolution INTEGER NOT NULL,
+            ts INTEGER NOT NULL,
+            cpu_percent REAL,
+            ram_percent REAL,
+            temperature_c REAL,
+            cpu_freq_mhz REAL,
+            power_watts REAL,
+            PRIMARY KEY (resolution, ts)
+        ) WITHOUT ROWID;
+    )");
+}
+
+void MetricsHistory::run() {
+    auto last = std::chrono::steady_clock::now();
+    // Discard counts accumulated before the sampler started
+    MetricsRegistry::instance().takePipelineSamples();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        cv_.wait_until(lock, last + std::chrono::seconds(1), [this]() { return !running_; });
+        if (!running_) break;
+        lock.unlock();
+
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - last).count();
+        last = now;
+        int64_t ts = epochSeconds();
+        try {
+            sample(ts, elapsed);
+            rollup(kRaw, kMinute, ts);
+            rollup(kMinute, kHour, ts);
+            if (ts >= nextPrune_) {
+                prune(ts);
+                nextPrune_ = ts + kMinute;
+            }
+        } catch (const std::exception& e) {
+            spdlog::warn("Metrics history write failed: {}", e.what());
+        }
+
+        lock.lock();
+    }
+}
+
+void MetricsHistory::sample(int64_t now, double elapsedSeconds) {
+    auto pipelines = MetricsRegistry::instance().takePipelineSamples();
+    auto system = MetricsRegistry::instance().getSystemMetrics();
+
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    SQLite::Transaction transaction(*db_);
+
+    SQLite::Statement pipelineStmt(*db_, R"(
+        INSERT OR REPLACE INTO pipeline_samples
+            (resolution, ts, pipeline_id, pipeline_name, fps, frames, dropped,
+             latency_p50_ms, latency_p95_ms, latency_p99_ms, latency_max_ms)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+    )");
+    for (const auto& p : pipelines) {
+        pipelineStmt.bind(1, kRaw);
+        pipelineStmt.bind(2, static_cast<int64_t>(now));
+        pipelineStmt.bind(3, p.pipeline_id);
+        pipelineStmt.bind(4, p.pipeline_name);
+        pipelineStmt.bind(5, elapsedSeconds > 0 ? p.frames / elapsedSeconds : 0.0);
+        pipelineStmt.bind(6, p.frames);
+        pipelineStmt.bind(7, p.dropped);
+        // Latency is left NULL for seconds without frames so rollups ignore them
+        if (p.latency.count() > 0) {
+            pipelineStmt.bind(8, p.latency.percentileMs(0.50));
+            pipelineStmt.bind(9, p.latency.percentileMs(0.95));
+            pipelineStmt.bind(10, p.latency.percentileMs(0.99));
+            pipelineStmt.bind(11, p.latency.maxMs());
+        } else {
+            for (int i = 8; i <= 11; i++) pipelineStmt.bind(i);
+        }
+        pipelineStmt.exec();
+        pipelineStmt.reset();
+        pipelineStmt.clearBindings();
+    }
+
+    SQLite::Statement systemStmt(*db_, R"(
+        INSERT OR REPLACE INTO system_samples
+            (resolution, ts, cpu_percent, ram_percent, temperature_c, cpu_freq_mhz, power_watts)
+        VALUES (?, ?, ?, ?, ?, ?, ?)
+    )");
+    systemStmt.bind(1, kRaw);
+    systemStmt.bind(2, static_cast<int64_t>(now));
+    systemStmt.bind(3, system.cpu_usage_percent);
+    systemStmt.bind(4, system.ram_usage_percent);
+    systemStmt.bind(5, system.cpu_temperature);
+    systemStmt.bind(6, system.cpu_freq_mhz);
+    systemStmt.bind(7, system.power_watts);
+    systemStmt.exec();
+
+    transaction.commit();
+}
+
+void MetricsHistory::rollup(int fromResolution, int toResolution, int64_t now) {
+    int64_t& next = toResolution == kMinute ? nextMinute_ : nextHour_;
+    int64_t end = (now / toResolution) * toResolution;  // Only complete buckets
+    if (end <= next) return;
+
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    SQLite::Transaction transaction(*db_);
+
+    // Percentiles cannot be merged exactly: p50 is frame-weighted, p95/p99/max keep the worst
+    SQLite::Statement pipelineStmt(*db_, R"(
+        INSERT OR REPLACE INTO pipeline_samples
+            (resolution, ts, pipeline_id, pipeline_name, fps, frames, dropped,
+             latency_p50_ms, latency_p95_ms, latency_p99_ms, latency_max_ms)
+        SELECT ?1, (ts / ?1) * ?1 AS bucket, pipeline_id, MAX(pipeline_name), AVG(fps),
+               SUM(frames), SUM(dropped),
+               SUM(latency_p50_ms * frames) / NULLIF(SUM(CASE WHEN latency_p50_ms IS NULL THEN 0 ELSE frames END), 0),
+               MAX(latency_p95_ms), MAX(latency_p99_ms), MAX(latency_max_ms)
+        FROM pipeline_samples
+        WHERE resolution = ?2 AND ts >= ?3 AND ts < ?4
+        GROUP BY bucket, pipeline_id
+    )");
+    pipelineStmt.bind(1, toResolution);
+    pipelineStmt.bind(2, fromResolution);
+    pipelineStmt.bind(3, static_cast<int64_t>(next));
+    pipelineStmt.bind(4, static_cast<int64_t>(end));
+    pipelineStmt.exec();
+
+    SQLite::Statement systemStmt(*db_, R"(
+        INSERT OR REPLACE INTO system_samples
+            (resolution, ts, cpu_percent, ram_percent, temperature_c, cpu_freq_mhz, power_watts)
+        SELECT ?1, (ts / ?1) * ?1 AS bucket, AVG(cpu_percent), AVG(ram_percent), MAX(temperature_c),
+               AVG(cpu_freq_mhz), AVG(power_watts)
+        FROM system_samples
+        WHERE resolution = ?2 AND ts >= ?3 AND ts < ?4
+        GROUP BY bucket
+    )");
+    systemStmt.bind(1, toResolution);
+    systemStmt.bind(2, fromResolution);
+    systemStmt.bind(3, static_cast<int64_t>(next));
+    systemStmt.bind(4, static_cast<int64_t>(end));
+    systemStmt.exec();
+
+    transaction.commit();
+    next = end;
+}
+
+void MetricsHistory::prune(int64_t now) {
+    const std::pair<int, int64_t> retention[] = {
+        {kRaw, static_cast<int64_t>(config_.history_raw_hours) * kHour},
+        {kMinute, static_cast<int64_t>(config_.history_minute_days) * 24 * kHour},
+        {kHour, static_cast<int64_t>(config_.history_hour_days) * 24 * kHour},
+    };
+
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    for (const auto& [resolution, seconds] : retention) {
+        for (const char* table : {"pipeline_samples", "system_samples"}) {
+            SQLite::Statement stmt(*db_, std::string("DELETE FROM ") + table +
+                                         " WHERE resolution = ? AND ts < ?");
+            stmt.bind(1, resolution);
+            stmt.bind(2, static_cast<int64_t>(now - seconds));
+            stmt.exec();
+        }
+    }
+}
+
+nlohmann::json MetricsHistory::query(int64_t from, int64_t to, std::optional<int> pipelineId, int resolution) const {
+    if (resolution == 0) {
+        int64_t rawHours = 0;
+        int64_t minuteDays = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            rawHours = config_.history_raw_hours;
+            minuteDays = config_.history_minute_days;
+        }
+        int64_t now = epochSeconds();
+        int64_t span = (std::max)(to - from, int64_t{0});
+        bool rawCovers = from >= now - rawHours * kHour;
+        bool minuteCovers = from >= now - minuteDays * 24 * kHour;
+        if (rawCovers && span / kRaw <= kTargetPoints) {
+            resolution = kRaw;
+        } else if (minuteCovers && span / kMinute <= kTargetPoints) {
+            resolution = kMinute;
+        } else {
+            resolution = kHour;
+        }
+    }
+
+    nlohmann::json result = {
+        {"from", from},
+        {"to", to},
+        {"resolution", resolution},
+        {"pipelines", nlohmann::json::array()},
+        {"system", nlohmann::json::array()}
+    };
+
+    std::lock_guard<std::mutex> lock(readMutex_);
+    if (!readDb_) return result;
+
+    std::string pipelineSql = R"(
+        SELECT ts, pipeline_id, pipeline_name, fps, frames, dropped,
+               latency_p50_ms, latency_p95_ms, latency_p99_ms, latency_max_ms
+        FROM pipeline_samples
+        WHERE resolution = ? AND ts >= ? AND ts <= ?)";
+    if (pipelineId) pipelineSql += " AND pipeline_id = ?";
+    pipelineSql += " ORDER BY ts, pipeline_id LIMIT " + std::to_string(kMaxRows);
+
+    SQLite::Statement pipelineQuery(*readDb_, pipelineSql);
+    pipelineQuery.bind(1, resolution);
+    pipelineQuery.bind(2, static_cast<int64_t>(from));
+    pipelineQuery.bind(3, static_cast<int64_t>(to));
+    if (pipelineId) pipelineQuery.bind(4, *pipelineId);
+    while (pipelineQuery.executeStep()) {
+        result["pipelines"].push_back({
+            {"ts", pipelineQuery.getColumn(0).getInt64()},
+            {"pipeline_id", pipelineQuery.getColumn(1).getInt()},
+            {"pipeline_name", pipelineQuery.getColumn(2).getString()},
+            {"fps", columnJson(pipelineQuery.getColumn(3))},
+            {"frames", columnJson(pipelineQuery.getColumn(4))},
+            {"dropped", columnJson(pipelineQuery.getColumn(5))},
+            {"latency_p50_ms", columnJson(pipelineQuery.getColumn(6))},
+            {"latency_p95_ms", columnJson(pipelineQuery.getColumn(7))},
+            {"latency_p99_ms", columnJson(pipelineQuery.getColumn(8))},
+            {"latency_max_ms", columnJson(pipelineQuery.getColumn(9))}
+        });
+    }
+
+    SQLite::Statement systemQuery(*readDb_, R"(
+        SELECT ts, cpu_percent, ram_percent, temperature_c, cpu_freq_mhz, power_watts
+        FROM system_samples
+        WHERE resolution = ? AND ts >= ? AND ts <= ?
+        ORDER BY ts LIMIT )" + std::to_string(kMaxRows));
+    systemQuery.bind(1, resolution);
+    systemQuery.bind(2, static_cast<int64_t>(from));
+    systemQuery.bind(3, static_cast<int64_t>(to));
+    while (systemQuery.executeStep()) {
+        result["system"].push_back({
+            {"ts", systemQuery.getColumn(0).getInt64()},
+            {"cpu_percent", columnJson(systemQuery.getColumn(1))},
+            {"ram_percent", columnJson(systemQuery.getColumn(2))},
+            {"temperature_c", columnJson(systemQuery.getColumn(3))},
+            {"cpu_freq_mhz", columnJson(systemQuery.getColumn(4))},
+            {"power_watts", columnJson(systemQuery.getColumn(5))}
+        });
+    }
+
+    return result;
+}
+
+} // namespace vision
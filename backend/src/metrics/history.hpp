@@ -0,0 +1,64 @@
+#pragma once
+
+#include "core/config.hpp"
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace vision {
+
+// Persistent metrics history across sessions. Samples MetricsRegistry once a second
+// into its own SQLite database (so history never contends with the config database),
+// rolls 1-second samples up into 1-minute and 1-hour rows, and prunes each resolution
+// after its retention period. The live path only pays for one histogram record per frame.
+class MetricsHistory {
+public:
+    static MetricsHistory& instance();
+
+    void start(const MetricsConfig& config);
+    void stop();
+
+    // Rows between two epoch-second timestamps. resolution is 1, 60 or 3600 seconds;
+    // 0 picks the finest one that covers the range in a reasonable number of rows.
+    // Can read up to kMaxRows per table; call it from the job pool, not an IO thread.
+    nlohmann::json query(int64_t from, int64_t to, std::optional<int> pipelineId, int resolution) const;
+
+private:
+    MetricsHistory() = default;
+    ~MetricsHistory();
+
+    MetricsHistory(const MetricsHistory&) = delete;
+    MetricsHistory& operator=(const MetricsHistory&) = delete;
+
+    void run();
+    void createSchema();
+    void sample(int64_t now, double elapsedSeconds);
+    void rollup(int fromResolution, int toResolution, int64_t now);
+    void prune(int64_t now);
+
+    MetricsConfig config_;                    // Protected by mutex_; the writer thread reads its copy freely
+    std::unique_ptr<SQLite::Database> db_;    // Writer connection
+    std::mutex dbMutex_;
+
+    // Read-only connection for query(); under WAL it reads a snapshot without blocking the writer
+    std::unique_ptr<SQLite::Database> readDb_;
+    mutable std::mutex readMutex_;
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_ = false;
+
+    // Writer thread only: start of the next bucket to roll up, per target resolution
+    int64_t nextMinute_ = 0;
+    int64_t nextHour_ = 0;
+    int64_t nextPrune_ = 0;
+};
+
+} // namespace vision
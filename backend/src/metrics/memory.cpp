@@ -0,0 +1,228 @@
+#include "metrics/memory.hpp"
+#include <sqlite3.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace vision {
+
+namespace {
+    // Serializes RssGrowthEstimate so overlapping loads do not count each other
+    std::mutex& estimateMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    void updatePeak(std::atomic<int64_t>& peak, int64_t value) {
+        int64_t current = peak.load(std::memory_order_relaxed);
+        while (value > current &&
+               !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+    // Read a "Key:   1234 kB" line from /proc/self/status
+    int64_t readProcStatusKb(const std::string& key) {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':') {
+                std::istringstream iss(line.substr(key.size() + 1));
+                int64_t kb = 0;
+                iss >> kb;
+                return kb;
+            }
+        }
+        return 0;
+    }
+#endif
+}
+
+void MemoryCounter::add(int64_t bytes, int64_t count) {
+    updatePeak(peakBytes_, bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    updatePeak(peakCount_, count_.fetch_add(count, std::memory_order_relaxed) + count);
+}
+
+void MemoryCounter::sub(int64_t bytes, int64_t count) {
+    bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    count_.fetch_sub(count, std::memory_order_relaxed);
+}
+
+MemoryTracker& MemoryTracker::instance() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+const char* MemoryTracker::name(MemorySubsystem subsystem) {
+    switch (subsystem) {
+        case MemorySubsystem::Frames: return "frames";
+        case MemorySubsystem::JpegCache: return "jpeg_cache";
+        case MemorySubsystem::FrameQueues: return "frame_queues";
+        case MemorySubsystem::StreamerQueue: return "streamer_queue";
+        case MemorySubsystem::Models: return "models";
+        case MemorySubsystem::TagFamilies: return "tag_families";
+        case MemorySubsystem::TagArenas: return "tag_arenas";
+        default: return "unknown";
+    }
+}
+
+bool MemoryTracker::isEstimated(MemorySubsystem subsystem) {
+    return subsystem == MemorySubsystem::Models;
+}
+
+RssGrowthEstimate::RssGrowthEstimate()
+    : lock_(estimateMutex(), std::try_to_lock)
+{
+    if (lock_.owns_lock()) {
+        before_ = MemoryTracker::residentBytes();
+    }
+}
+
+int64_t RssGrowthEstimate::bytes() const {
+    if (!lock_.owns_lock()) {
+        return 0;
+    }
+    return (std::max)(int64_t{0}, MemoryTracker::residentBytes() - before_);
+}
+
+int64_t MemoryTracker::residentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return static_cast<int64_t>(pmc.WorkingSetSize);
+    }
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return static_cast<int64_t>(info.resident_size);
+    }
+    return 0;
+#else
+    return readProcStatusKb("VmRSS") * 1024;
+#endif
+}
+
+void MemoryTracker::configureHeap(int mmapThresholdKb, int arenaMax) {
+#if defined(__GLIBC__)
+    // A fixed threshold keeps decimated/threshold images and detection buffers
+    // (hundreds of KB) in the arenas; glibc otherwise maps and unmaps them each
+    // frame until its dynamic threshold catches up. Trim at twice the threshold,
+    // as glibc does when it adjusts on its own, so freed frames are not returned
+    // to the kernel and faulted back in on the next one.
+    if (mmapThresholdKb > 0) {
+        int bytes = mmapThresholdKb * 1024;
+        if (mallopt(M_MMAP_THRESHOLD, bytes) == 1 && mallopt(M_TRIM_THRESHOLD, bytes * 2) == 1) {
+            spdlog::info("malloc mmap threshold set to {} KB", mmapThresholdKb);
+        } else {
+            spdlog::warn("malloc rejected mmap threshold of {} KB", mmapThresholdKb);
+        }
+    }
+    // Detector worker threads each get an arena by default; capping them trades
+    // some lock contention for less fragmentation on small boards
+    if (arenaMax > 0 && mallopt(M_ARENA_MAX, arenaMax) == 1) {
+        spdlog::info("malloc arena limit set to {}", arenaMax);
+    }
+#else
+    (void)mmapThresholdKb;
+    (void)arenaMax;
+#endif
+}
+
+MemoryMetrics MemoryTracker::snapshot() const {
+    MemoryMetrics metrics;
+
+    for (size_t i = 0; i < counters_.size(); i++) {
+        const auto& counter = counters_[i];
+        SubsystemMemory entry;
+        entry.name = name(static_cast<MemorySubsystem>(i));
+        entry.bytes = counter.bytes();
+        entry.peak_bytes = counter.peakBytes();
+        entry.count = counter.count();
+        entry.peak_count = counter.peakCount();
+        entry.estimated = isEstimated(static_cast<MemorySubsystem>(i));
+        metrics.subsystems.push_back(entry);
+    }
+
+    metrics.process_rss_bytes = residentBytes();
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        metrics.process_rss_peak_bytes = static_cast<int64_t>(pmc.PeakWorkingSetSize);
+    }
+#elif defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        metrics.process_rss_peak_bytes = static_cast<int64_t>(usage.ru_maxrss);  // bytes on macOS
+    }
+#else
+    metrics.process_rss_peak_bytes = readProcStatusKb("VmHWM") * 1024;
+#endif
+
+    sqlite3_int64 current = 0, highwater = 0;
+    if (sqlite3_status64(SQLITE_STATUS_MEMORY_USED, &current, &highwater, 0) == SQLITE_OK) {
+        metrics.sqlite_bytes = current;
+        metrics.sqlite_peak_bytes = highwater;
+    }
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    // Totals across all arenas; walks them under their locks, so only per sample
+    struct mallinfo2 heap = mallinfo2();
+    metrics.heap_in_use_bytes = static_cast<int64_t>(heap.uordblks + heap.hblkhd);
+    metrics.heap_free_bytes = static_cast<int64_t>(heap.fordblks);
+    metrics.heap_mmap_bytes = static_cast<int64_t>(heap.hblkhd);
+    metrics.heap_mmap_chunks = static_cast<int64_t>(heap.hblks);
+#endif
+
+    return metrics;
+}
+
+nlohmann::json SubsystemMemory::toJson() const {
+    return {
+        {"name", name},
+        {"bytes", bytes},
+        {"peak_bytes", peak_bytes},
+        {"count", count},
+        {"peak_count", peak_count},
+        {"estimated", estimated}
+    };
+}
+
+nlohmann::json MemoryMetrics::toJson() const {
+    nlohmann::json subsystemsJson = nlohmann::json::array();
+    for (const auto& s : subsystems) {
+        subsystemsJson.push_back(s.toJson());
+    }
+
+    return {
+        {"subsystems", subsystemsJson},
+        {"process_rss_bytes", process_rss_bytes},
+        {"process_rss_peak_bytes", process_rss_peak_bytes},
+        {"sqlite_bytes", sqlite_bytes},
+        {"sqlite_peak_bytes", sqlite_peak_bytes},
+        {"heap_in_use_bytes", heap_in_use_bytes},
+        {"heap_free_bytes", heap_free_bytes},
+        {"heap_mmap_bytes", heap_mmap_bytes},
+        {"heap_mmap_chunks", heap_mmap_chunks}
+    };
+}
+
+} // namespace vision
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <opencv2/core.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+// Subsystems whose heap usage is tracked explicitly
+enum class MemorySubsystem {
+    Frames,          // Live RefCountedFrame pixel buffers (color + depth)
+    JpegCache,       // Per-frame cached JPEG encodings
+    FrameQueues,     // Frames waiting in pipeline queues (shares buffers with Frames)
+    StreamerQueue,   // Frame clones waiting for MJPEG encoding
+    Models,          // ONNX Runtime sessions (estimated from RSS growth, see RssGrowthEstimate)
+    TagFamilies,     // Shared AprilTag families and quick-decode tables (computed table size)
+    TagArenas,       // AprilTag detector arenas (chunks reserved, one object per detector)
+    Count
+};
+
+// Current/peak bytes and object count for one subsystem
+class MemoryCounter {
+public:
+    void add(int64_t bytes, int64_t count = 1);
+    void sub(int64_t bytes, int64_t count = 1);
+
+    int64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+    int64_t peakBytes() const { return peakBytes_.load(std::memory_order_relaxed); }
+    int64_t count() const { return count_.load(std::memory_order_relaxed); }
+    int64_t peakCount() const { return peakCount_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> bytes_{0};
+    std::atomic<int64_t> peakBytes_{0};
+    std::atomic<int64_t> count_{0};
+    std::atomic<int64_t> peakCount_{0};
+};
+
+struct SubsystemMemory {
+    std::string name;
+    int64_t bytes = 0;
+    int64_t peak_bytes = 0;
+    int64_t count = 0;
+    int64_t peak_count = 0;
+    bool estimated = false;  // Bytes come from RSS growth rather than counted allocations
+
+    nlohmann::json toJson() const;
+};
+
+struct MemoryMetrics {
+    std::vector<SubsystemMemory> subsystems;
+    int64_t process_rss_bytes = 0;
+    int64_t process_rss_peak_bytes = 0;
+    int64_t sqlite_bytes = 0;        // SQLite heap including page cache
+    int64_t sqlite_peak_bytes = 0;
+    int64_t heap_in_use_bytes = 0;   // malloc'd and not yet freed, including mmap'd chunks (glibc only)
+    int64_t heap_free_bytes = 0;     // Freed but still held by malloc arenas
+    int64_t heap_mmap_bytes = 0;     // Live allocations served by mmap
+    int64_t heap_mmap_chunks = 0;
+
+    nlohmann::json toJson() const;
+};
+
+class MemoryTracker {
+public:
+    static MemoryTracker& instance();
+
+    MemoryCounter& counter(MemorySubsystem subsystem) {
+        return counters_[static_cast<size_t>(subsystem)];
+    }
+
+    MemoryMetrics snapshot() const;
+
+    // Resident set size of this process (0 where unsupported)
+    static int64_t residentBytes();
+
+    static const char* name(MemorySubsystem subsystem);
+
+    // Whether a subsystem's bytes are RSS-growth estimates
+    static bool isEstimated(MemorySubsystem subsystem);
+
+    // Opt-in process-wide glibc malloc tuning; no-op on other allocators and when both are 0
+    static void configureHeap(int mmapThresholdKb, int arenaMax);
+
+private:
+    MemoryTracker() = default;
+
+    std::array<MemoryCounter, static_cast<size_t>(MemorySubsystem::Count)> counters_;
+};
+
+// Estimates what one load allocates from process RSS growth across it, for
+// libraries (ONNX Runtime) that expose no allocation stats. Only one estimate
+// runs at a time; a load that starts while another is being measured is not
+// measured at all (bytes() stays 0), since each would count the other's growth.
+// Frame buffers allocated by running pipelines still land in the figure.
+class RssGrowthEstimate {
+public:
+    RssGrowthEstimate();
+
+    RssGrowthEstimate(const RssGrowthEstimate&) = delete;
+    RssGrowthEstimate& operator=(const RssGrowthEstimate&) = delete;
+
+    bool measuring() const { return lock_.owns_lock(); }
+
+    // Growth since construction; 0 if not measuring or RSS shrank
+    int64_t bytes() const;
+
+private:
+    std::unique_lock<std::mutex> lock_;
+    int64_t before_ = 0;
+};
+
+// Bytes held by a cv::Mat's pixel data
+inline int64_t matBytes(const cv::Mat& mat) {
+    return mat.empty() ? 0 : static_cast<int64_t>(mat.total() * mat.elemSize());
+}
+
+} // namespace vision
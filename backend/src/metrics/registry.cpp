@@ -1,7 +1,13 @@
 #include "metrics/registry.hpp"
 #include "core/config.hpp"
+#include <spdlog/spdlog.h>
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <numeric>
+#include <optional>
+#include <sstream>
+#include <utility>
 
 #ifdef _WIN32
 #ifndef NOMINMAX
@@ -13,6 +19,90 @@
 
 namespace vision {
 
+namespace {
+
+// Static initialization runs before main(), so this stands in for process start
+const auto kProcessStart = std::chrono::steady_clock::now();
+
+#ifdef __linux__
+// First line of a sysfs attribute as a number; nullopt when missing
+std::optional<double> readSysfsNumber(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    double value = 0;
+    if (!(file >> value)) return std::nullopt;
+    return value;
+}
+
+// Hottest thermal zone in degrees C (sysfs reports millidegrees)
+double readCpuTemperature() {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    double hottest = 0.0;
+    for (const auto& entry : fs::directory_iterator("/sys/class/thermal", ec)) {
+        if (entry.path().filename().string().rfind("thermal_zone", 0) != 0) continue;
+        if (auto milli = readSysfsNumber(entry.path() / "temp")) {
+            hottest = (std::max)(hottest, *milli / 1000.0);
+        }
+    }
+    return hottest;
+}
+
+// Sum of hwmon power sensors, else battery/supply draw, in watts (sysfs reports microwatts)
+double readPowerWatts() {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    double microwatts = 0.0;
+    for (const auto& hwmon : fs::directory_iterator("/sys/class/hwmon", ec)) {
+        std::error_code inner;
+        for (const auto& attr : fs::directory_iterator(hwmon.path(), inner)) {
+            auto name = attr.path().filename().string();
+            if (name.rfind("power", 0) == 0 && name.size() > 6 &&
+                name.compare(name.size() - 6, 6, "_input") == 0) {
+                microwatts += readSysfsNumber(attr.path()).value_or(0.0);
+            }
+        }
+    }
+    if (microwatts <= 0.0) {
+        for (const auto& supply : fs::directory_iterator("/sys/class/power_supply", ec)) {
+            microwatts += readSysfsNumber(supply.path() / "power_now").value_or(0.0);
+        }
+    }
+    return microwatts / 1e6;
+}
+
+// Lowest ratio of each policy's current cpufreq cap to its reference cap.
+// Cooling devices throttle by lowering scaling_max_freq at runtime, so the
+// reference is the cap first seen (raised whenever a higher one appears), not
+// cpuinfo_max_freq: a board whose cap is set below hardware max by its image
+// or governor reads 1.0 until something lowers it further.
+void readCpuFrequency(double& currentMhz, double& headroom,
+                      std::map<std::string, double>& referenceCapKhz) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    double sumKhz = 0.0;
+    int policies = 0;
+    headroom = 1.0;
+    for (const auto& policy : fs::directory_iterator("/sys/devices/system/cpu/cpufreq", ec)) {
+        std::string name = policy.path().filename().string();
+        if (name.rfind("policy", 0) != 0) continue;
+        auto cur = readSysfsNumber(policy.path() / "scaling_cur_freq");
+        auto cap = readSysfsNumber(policy.path() / "scaling_max_freq");
+        if (cur) {
+            sumKhz += *cur;
+            policies++;
+        }
+        if (cap && *cap > 0) {
+            double& reference = referenceCapKhz[name];
+            reference = (std::max)(reference, *cap);
+            headroom = (std::min)(headroom, *cap / reference);
+        }
+    }
+    currentMhz = policies > 0 ? sumKhz / policies / 1000.0 : 0.0;
+}
+#endif
+
+} // namespace
+
 MetricsRegistry& MetricsRegistry::instance() {
     static MetricsRegistry instance;
     return instance;
@@ -46,6 +136,20 @@ void MetricsRegistry::recordFrame(int pipelineId, double processingTimeMs, doubl
     }
 
     data.totalFrames++;
+    data.sample.frames++;
+}
+
+void MetricsRegistry::recordFrame(int pipelineId, const FrameTimings& timings) {
+    recordFrame(pipelineId, timings.processingMs, timings.queueWaitMs);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& data = pipelineData_[pipelineId];
+    auto& stages = data.stages;
+    stages.queueWait.record(timings.queueWaitMs);
+    stages.processing.record(timings.processingMs);
+    stages.publish.record(timings.publishMs);
+    stages.total.record(timings.totalMs);
+    data.sample.latency.record(timings.totalMs);
 }
 
 void MetricsRegistry::recordDrop(int pipelineId) {
@@ -53,6 +157,70 @@ void MetricsRegistry::recordDrop(int pipelineId) {
     auto& data = pipelineData_[pipelineId];
     data.droppedFrames++;
     data.droppedFramesWindow++;
+    data.stages.droppedFrames++;
+    data.sample.dropped++;
+}
+
+StageLatencies MetricsRegistry::getStageLatencies(int pipelineId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pipelineData_.find(pipelineId);
+    return it != pipelineData_.end() ? it->second.stages : StageLatencies{};
+}
+
+void MetricsRegistry::resetStageLatencies() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [id, data] : pipelineData_) {
+        data.stages = StageLatencies{};
+    }
+}
+
+void MetricsRegistry::recordSdkInit(const std::string& sdk, double durationMs, bool available) {
+    double startedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - kProcessStart).count() - durationMs;
+    std::lock_guard<std::mutex> lock(bootMutex_);
+    sdkInit_[sdk] = {
+        {"started_ms", startedMs},
+        {"duration_ms", durationMs},
+        {"available", available}
+    };
+}
+
+void MetricsRegistry::recordFirstFrame(int cameraId) {
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - kProcessStart).count();
+    std::lock_guard<std::mutex> lock(bootMutex_);
+    if (!firstFrameMs_.emplace(cameraId, ms).second) return;
+    spdlog::info("Camera {} first frame {:.0f} ms after process start", cameraId, ms);
+}
+
+nlohmann::json MetricsRegistry::getBootTimings() {
+    std::lock_guard<std::mutex> lock(bootMutex_);
+    nlohmann::json cameras = nlohmann::json::object();
+    std::optional<double> first;
+    for (const auto& [cameraId, ms] : firstFrameMs_) {
+        cameras[std::to_string(cameraId)] = ms;
+        first = first ? (std::min)(*first, ms) : ms;
+    }
+    return {
+        {"uptime_ms", std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - kProcessStart).count()},
+        {"first_frame_ms", first ? nlohmann::json(*first) : nlohmann::json(nullptr)},
+        {"camera_first_frame_ms", cameras},
+        {"sdk_init", sdkInit_}
+    };
+}
+
+std::vector<PipelineSample> MetricsRegistry::takePipelineSamples() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<PipelineSample> samples;
+    samples.reserve(pipelineData_.size());
+    for (auto& [id, data] : pipelineData_) {
+        auto sample = std::exchange(data.sample, PipelineSample{});
+        sample.pipeline_id = id;
+        sample.pipeline_name = data.name;
+        samples.push_back(std::move(sample));
+    }
+    return samples;
 }
 
 PipelineMetrics MetricsRegistry::getPipelineMetricsLocked(int pipelineId) {
@@ -127,11 +295,17 @@ void MetricsRegistry::removePipeline(int pipelineId) {
 }
 
 SystemMetrics MetricsRegistry::getSystemMetrics() {
-    updateSystemMetrics();
+    std::lock_guard<std::mutex> lock(systemMutex_);
+    updateSystemMetricsLocked();
     return systemMetrics_;
 }
 
 void MetricsRegistry::updateSystemMetrics() {
+    std::lock_guard<std::mutex> lock(systemMutex_);
+    updateSystemMetricsLocked();
+}
+
+void MetricsRegistry::updateSystemMetricsLocked() {
     auto now = std::chrono::steady_clock::now();
 
     // Only update every 2 seconds
@@ -178,8 +352,49 @@ void MetricsRegistry::updateSystemMetrics() {
         lastKernelTime = kernel;
         lastUserTime = user;
     }
+#elif defined(__linux__)
+    // CPU usage from the aggregate /proc/stat line since the last sample
+    {
+        std::ifstream stat("/proc/stat");
+        std::string cpu;
+        uint64_t user = 0, nice = 0, system = 0, idle = 0, iowait = 0, irq = 0, softirq = 0, steal = 0;
+        if (stat >> cpu >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal) {
+            uint64_t idleAll = idle + iowait;
+            uint64_t total = idleAll + user + nice + system + irq + softirq + steal;
+            if (lastCpuTotal_ > 0 && total > lastCpuTotal_) {
+                double totalDiff = static_cast<double>(total - lastCpuTotal_);
+                double idleDiff = static_cast<double>(idleAll - lastCpuIdle_);
+                systemMetrics_.cpu_usage_percent = 100.0 * (1.0 - idleDiff / totalDiff);
+            }
+            lastCpuTotal_ = total;
+            lastCpuIdle_ = idleAll;
+        }
+    }
+
+    // RAM from /proc/meminfo (kB)
+    {
+        std::ifstream meminfo("/proc/meminfo");
+        std::string line;
+        int64_t totalKb = 0, availableKb = 0;
+        while (std::getline(meminfo, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            int64_t value = 0;
+            if (!(fields >> key >> value)) continue;
+            if (key == "MemTotal:") totalKb = value;
+            else if (key == "MemAvailable:") availableKb = value;
+        }
+        if (totalKb > 0) {
+            systemMetrics_.ram_total_mb = totalKb / 1024;
+            systemMetrics_.ram_used_mb = (totalKb - availableKb) / 1024;
+            systemMetrics_.ram_usage_percent = 100.0 * (totalKb - availableKb) / totalKb;
+        }
+    }
+
+    systemMetrics_.cpu_temperature = readCpuTemperature();
+    systemMetrics_.power_watts = readPowerWatts();
+    readCpuFrequency(systemMetrics_.cpu_freq_mhz, systemMetrics_.cpu_freq_headroom, cpuCapReferenceKhz_);
 #else
-    // Linux implementation would go here
     systemMetrics_.cpu_usage_percent = 0.0;
     systemMetrics_.ram_usage_percent = 0.0;
 #endif
@@ -189,6 +404,11 @@ void MetricsRegistry::updateSystemMetrics() {
     systemMetrics_.active_pipelines = static_cast<int>(pipelineData_.size());
 }
 
+void MetricsRegistry::setPowerMode(bool idle) {
+    std::lock_guard<std::mutex> lock(systemMutex_);
+    systemMetrics_.power_idle = idle;
+}
+
 MetricsSummary MetricsRegistry::getSummary() {
     MetricsSummary summary;
     summary.pipelines = getAllPipelineMetrics();
@@ -199,6 +419,7 @@ MetricsSummary MetricsRegistry::getSummary() {
     summary.thresholds.queue_critical = config.thresholds.pipeline_queue_critical;
     summary.thresholds.latency_warning_ms = config.thresholds.latency_warning_ms;
     summary.thresholds.latency_critical_ms = config.thresholds.latency_critical_ms;
+    summary.memory = MemoryTracker::instance().snapshot();
 
     return summary;
 }
@@ -229,6 +450,10 @@ nlohmann::json SystemMetrics::toJson() const {
         {"ram_used_mb", ram_used_mb},
         {"ram_total_mb", ram_total_mb},
         {"cpu_temperature", cpu_temperature},
+        {"cpu_freq_mhz", cpu_freq_mhz},
+        {"cpu_freq_headroom", cpu_freq_headroom},
+        {"power_watts", power_watts},
+        {"power_mode", power_idle ? "idle" : "full"},
         {"active_pipelines", active_pipelines}
     };
 }
@@ -251,8 +476,78 @@ nlohmann::json MetricsSummary::toJson() const {
     return {
         {"pipelines", pipelinesJson},
         {"system", system.toJson()},
-        {"thresholds", thresholds.toJson()}
+        {"thresholds", thresholds.toJson()},
+        {"memory", memory.toJson()}
+    };
+}
+
+std::string MetricsSummary::toPrometheus() const {
+    std::ostringstream out;
+
+    auto header = [&out](const char* name, const char* type, const char* help) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
     };
+
+    header("vision_pipeline_fps", "gauge", "Frames processed per second");
+    for (const auto& p : pipelines) {
+        out << "vision_pipeline_fps{pipeline=\"" << p.pipeline_id << "\"} " << p.fps << "\n";
+    }
+    header("vision_pipeline_latency_p95_ms", "gauge", "95th percentile pipeline latency");
+    for (const auto& p : pipelines) {
+        out << "vision_pipeline_latency_p95_ms{pipeline=\"" << p.pipeline_id << "\"} " << p.latency_p95_ms << "\n";
+    }
+    header("vision_pipeline_frames_processed_total", "counter", "Frames processed since start");
+    for (const auto& p : pipelines) {
+        out << "vision_pipeline_frames_processed_total{pipeline=\"" << p.pipeline_id << "\"} " << p.frames_processed << "\n";
+    }
+    header("vision_pipeline_dropped_frames_total", "counter", "Frames dropped since start");
+    for (const auto& p : pipelines) {
+        out << "vision_pipeline_dropped_frames_total{pipeline=\"" << p.pipeline_id << "\"} " << p.dropped_frames_total << "\n";
+    }
+
+    header("vision_memory_bytes", "gauge", "Bytes held by tracked subsystem (models is an RSS-growth estimate)");
+    for (const auto& s : memory.subsystems) {
+        out << "vision_memory_bytes{subsystem=\"" << s.name << "\"} " << s.bytes << "\n";
+    }
+    out << "vision_memory_bytes{subsystem=\"sqlite\"} " << memory.sqlite_bytes << "\n";
+    header("vision_memory_peak_bytes", "gauge", "Peak bytes held by tracked subsystem");
+    for (const auto& s : memory.subsystems) {
+        out << "vision_memory_peak_bytes{subsystem=\"" << s.name << "\"} " << s.peak_bytes << "\n";
+    }
+    out << "vision_memory_peak_bytes{subsystem=\"sqlite\"} " << memory.sqlite_peak_bytes << "\n";
+    header("vision_memory_objects", "gauge", "Live objects held by tracked subsystem");
+    for (const auto& s : memory.subsystems) {
+        out << "vision_memory_objects{subsystem=\"" << s.name << "\"} " << s.count << "\n";
+    }
+    header("vision_process_resident_bytes", "gauge", "Process resident set size");
+    out << "vision_process_resident_bytes " << memory.process_rss_bytes << "\n";
+    header("vision_process_resident_peak_bytes", "gauge", "Peak process resident set size");
+    out << "vision_process_resident_peak_bytes " << memory.process_rss_peak_bytes << "\n";
+
+    header("vision_heap_bytes", "gauge", "malloc heap bytes by state (glibc)");
+    out << "vision_heap_bytes{state=\"in_use\"} " << memory.heap_in_use_bytes << "\n";
+    out << "vision_heap_bytes{state=\"free\"} " << memory.heap_free_bytes << "\n";
+    out << "vision_heap_bytes{state=\"mmap\"} " << memory.heap_mmap_bytes << "\n";
+    header("vision_heap_mmap_chunks", "gauge", "Live allocations served by mmap (glibc)");
+    out << "vision_heap_mmap_chunks " << memory.heap_mmap_chunks << "\n";
+
+    header("vision_cpu_usage_percent", "gauge", "System CPU usage");
+    out << "vision_cpu_usage_percent " << system.cpu_usage_percent << "\n";
+    header("vision_cpu_temperature_celsius", "gauge", "Hottest thermal zone");
+    out << "vision_cpu_temperature_celsius " << system.cpu_temperature << "\n";
+    header("vision_cpu_frequency_mhz", "gauge", "Mean current CPU frequency");
+    out << "vision_cpu_frequency_mhz " << system.cpu_freq_mhz << "\n";
+    header("vision_cpu_frequency_headroom", "gauge", "Allowed over hardware maximum frequency (below 1 when throttled)");
+    out << "vision_cpu_frequency_headroom " << system.cpu_freq_headroom << "\n";
+    header("vision_power_watts", "gauge", "Board power draw (0 without a sensor)");
+    out << "vision_power_watts " << system.power_watts << "\n";
+    header("vision_power_idle", "gauge", "1 while cameras are throttled for a disabled robot");
+    out << "vision_power_idle " << (system.power_idle ? 1 : 0) << "\n";
+    header("vision_active_pipelines", "gauge", "Pipelines with recorded metrics");
+    out << "vision_active_pipelines " << system.active_pipelines << "\n";
+
+    return out.str();
 }
 
 } // namespace vision
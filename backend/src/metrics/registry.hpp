@@ -1,8 +1,11 @@
 #pragma once
 
+#include "metrics/histogram.hpp"
+#include "metrics/memory.hpp"
 #include <nlohmann/json.hpp>
 #include <mutex>
 #include <deque>
+#include <map>
 #include <unordered_map>
 #include <chrono>
 #include <atomic>
@@ -35,6 +38,32 @@ struct PipelineMetrics {
     nlohmann::json toJson() const;
 };
 
+// Per-stage timings for one processed frame
+struct FrameTimings {
+    double queueWaitMs = 0.0;    // Queued until picked up by the vision thread
+    double processingMs = 0.0;   // Pipeline process()
+    double publishMs = 0.0;      // MJPEG, WebSocket, cluster and NT publishing
+    double totalMs = 0.0;        // Capture to published
+};
+
+// Cumulative latency histograms for each stage
+struct StageLatencies {
+    LatencyHistogram queueWait;
+    LatencyHistogram processing;
+    LatencyHistogram publish;
+    LatencyHistogram total;
+    int droppedFrames = 0;
+};
+
+// Counts and latency for one pipeline since the previous sample (metrics history)
+struct PipelineSample {
+    int pipeline_id = 0;
+    std::string pipeline_name;
+    int frames = 0;
+    int dropped = 0;
+    LatencyHistogram latency;  // Capture to published
+};
+
 // System resource metrics
 struct SystemMetrics {
     double cpu_usage_percent = 0.0;
@@ -42,6 +71,10 @@ struct SystemMetrics {
     int64_t ram_used_mb = 0;
     int64_t ram_total_mb = 0;
     double cpu_temperature = 0.0;
+    double cpu_freq_mhz = 0.0;      // Mean current frequency across cpufreq policies
+    double cpu_freq_headroom = 1.0; // Lowest cpufreq cap relative to the cap first seen (< 1 = throttled)
+    double power_watts = 0.0;       // Board power from hwmon/power_supply (0 = no sensor)
+    bool power_idle = false;        // Cameras throttled while the robot is disabled
     int active_pipelines = 0;
 
     nlohmann::json toJson() const;
@@ -62,8 +95,12 @@ struct MetricsSummary {
     std::vector<PipelineMetrics> pipelines;
     SystemMetrics system;
     MetricsThresholds thresholds;
+    MemoryMetrics memory;
 
     nlohmann::json toJson() const;
+
+    // Prometheus text exposition format (version 0.0.4)
+    std::string toPrometheus() const;
 };
 
 // Metrics registry singleton
@@ -73,6 +110,7 @@ public:
 
     // Record a processed frame for a pipeline
     void recordFrame(int pipelineId, double processingTimeMs, double queueWaitMs);
+    void recordFrame(int pipelineId, const FrameTimings& timings);
 
     // Record a dropped frame
     void recordDrop(int pipelineId);
@@ -89,6 +127,13 @@ public:
     // Get metrics summary
     MetricsSummary getSummary();
 
+    // Stage histograms since start (or the last reset)
+    StageLatencies getStageLatencies(int pipelineId);
+    void resetStageLatencies();
+
+    // Per-pipeline counts since the previous call; independent of the UI windows
+    std::vector<PipelineSample> takePipelineSamples();
+
     // Set pipeline info
     void setPipelineInfo(int pipelineId, const std::string& name);
 
@@ -98,6 +143,15 @@ public:
     // Update system metrics
     void updateSystemMetrics();
 
+    // Current match-phase power mode
+    void setPowerMode(bool idle);
+
+    // Cold-boot timings, measured from process start: camera SDK initialization
+    // and each camera's first frame (later reconnects are not counted)
+    void recordSdkInit(const std::string& sdk, double durationMs, bool available);
+    void recordFirstFrame(int cameraId);
+    nlohmann::json getBootTimings();
+
 private:
     MetricsRegistry() = default;
 
@@ -112,13 +166,26 @@ private:
         int droppedFrames = 0;
         int droppedFramesWindow = 0;
         double maxLatency = 0.0;
+        StageLatencies stages;
+        PipelineSample sample;
     };
 
     std::unordered_map<int, PipelineData> pipelineData_;
     std::mutex mutex_;
 
+    // Sampled by the WebSocket broadcast, routes and the thermal governor
+    void updateSystemMetricsLocked();
     SystemMetrics systemMetrics_;
     std::chrono::steady_clock::time_point lastSystemUpdate_;
+    uint64_t lastCpuTotal_ = 0;
+    uint64_t lastCpuIdle_ = 0;
+    std::map<std::string, double> cpuCapReferenceKhz_;  // Per cpufreq policy, highest cap seen
+    std::mutex systemMutex_;
+
+    // Boot timings (protected by bootMutex_)
+    nlohmann::json sdkInit_ = nlohmann::json::object();
+    std::map<int, double> firstFrameMs_;
+    std::mutex bootMutex_;
 
     // Configuration
     static constexpr int WINDOW_SIZE = 100;  // Number of samples to keep
@@ -11,6 +11,7 @@ nlohmann::json Camera::toJson() const {
     j["identifier"] = identifier;
     j["orientation"] = orientation;
     j["exposure_value"] = exposure_value;
+    j["alternate_exposure_value"] = alternate_exposure_value.has_value() ? nlohmann::json(alternate_exposure_value.value()) : nlohmann::json(nullptr);
     j["gain_value"] = gain_value;
     j["exposure_mode"] = exposure_mode;
     j["gain_mode"] = gain_mode;
@@ -34,6 +35,9 @@ Camera Camera::fromJson(const nlohmann::json& j) {
     cam.identifier = j.at("identifier").get<std::string>();
     cam.orientation = j.value("orientation", 0);
     cam.exposure_value = j.value("exposure_value", 500);
+    if (j.contains("alternate_exposure_value") && !j["alternate_exposure_value"].is_null()) {
+        cam.alternate_exposure_value = j["alternate_exposure_value"].get<int>();
+    }
     cam.gain_value = j.value("gain_value", 50);
     cam.exposure_mode = j.value("exposure_mode", ExposureMode::Auto);
     cam.gain_mode = j.value("gain_mode", GainMode::Auto);
@@ -76,10 +80,14 @@ Camera Camera::fromRow(const SQLite::Statement& query) {
     if (typeStr == "USB") cam.camera_type = CameraType::USB;
     else if (typeStr == "Spinnaker") cam.camera_type = CameraType::Spinnaker;
     else if (typeStr == "RealSense") cam.camera_type = CameraType::RealSense;
+    else if (typeStr == "Replay") cam.camera_type = CameraType::Replay;
 
     cam.identifier = query.getColumn("identifier").getString();
     cam.orientation = query.getColumn("orientation").getInt();
     cam.exposure_value = query.getColumn("exposure_value").getInt();
+    if (!query.getColumn("alternate_exposure_value").isNull()) {
+        cam.alternate_exposure_value = query.getColumn("alternate_exposure_value").getInt();
+    }
     cam.gain_value = query.getColumn("gain_value").getInt();
     cam.exposure_mode = query.getColumn("exposure_mode").getString() == "auto" ? ExposureMode::Auto : ExposureMode::Manual;
     cam.gain_mode = query.getColumn("gain_mode").getString() == "auto" ? GainMode::Auto : GainMode::Manual;
@@ -121,11 +129,14 @@ void Camera::bindToStatement(SQLite::Statement& stmt) const {
         case CameraType::USB: typeStr = "USB"; break;
         case CameraType::Spinnaker: typeStr = "Spinnaker"; break;
         case CameraType::RealSense: typeStr = "RealSense"; break;
+        case CameraType::Replay: typeStr = "Replay"; break;
     }
     stmt.bind(":camera_type", typeStr);
     stmt.bind(":identifier", identifier);
     stmt.bind(":orientation", orientation);
     stmt.bind(":exposure_value", exposure_value);
+    if (alternate_exposure_value) stmt.bind(":alternate_exposure_value", *alternate_exposure_value);
+    else stmt.bind(":alternate_exposure_value");
     stmt.bind(":gain_value", gain_value);
     stmt.bind(":exposure_mode", exposure_mode == ExposureMode::Auto ? "auto" : "manual");
     stmt.bind(":gain_mode", gain_mode == GainMode::Auto ? "auto" : "manual");
@@ -14,13 +14,15 @@ namespace vision {
 enum class CameraType {
     USB,
     Spinnaker,
-    RealSense
+    RealSense,
+    Replay      // Recorded or synthetic frames, for testing without hardware
 };
 
 NLOHMANN_JSON_SERIALIZE_ENUM(CameraType, {
     {CameraType::USB, "USB"},
     {CameraType::Spinnaker, "Spinnaker"},
-    {CameraType::RealSense, "RealSense"}
+    {CameraType::RealSense, "RealSense"},
+    {CameraType::Replay, "Replay"}
 })
 
 enum class ExposureMode {
@@ -57,6 +59,7 @@ struct Camera {
     std::string identifier;
     int orientation = 0;  // 0, 90, 180, 270
     int exposure_value = 500;
+    std::optional<int> alternate_exposure_value;  // Manual mode: alternate frames use this exposure
     int gain_value = 50;
     ExposureMode exposure_mode = ExposureMode::Auto;
     GainMode gain_mode = GainMode::Auto;
@@ -3,10 +3,55 @@
 
 namespace vision {
 
+// AprilTagFamilyConfig
+nlohmann::json AprilTagFamilyConfig::toJson() const {
+    nlohmann::json j = {{"family", family}};
+    if (tag_size_m) j["tag_size_m"] = *tag_size_m;
+    if (!field.empty()) j["field"] = field;
+    return j;
+}
+
+AprilTagFamilyConfig AprilTagFamilyConfig::fromJson(const nlohmann::json& j) {
+    AprilTagFamilyConfig cfg;
+    if (j.is_string()) {
+        cfg.family = j.get<std::string>();
+        return cfg;
+    }
+    cfg.family = j.value("family", "tag36h11");
+    if (j.contains("tag_size_m") && j["tag_size_m"].is_number()) {
+        cfg.tag_size_m = j["tag_size_m"].get<double>();
+    }
+    cfg.field = j.value("field", "");
+    return cfg;
+}
+
 // AprilTagConfig
+std::vector<AprilTagFamilyConfig> AprilTagConfig::resolvedFamilies() const {
+    std::vector<AprilTagFamilyConfig> resolved;
+    const auto& source = families.empty() ? std::vector<AprilTagFamilyConfig>{{family}} : families;
+    for (const auto& fam : source) {
+        // A family can only be added to a detector once
+        bool duplicate = false;
+        for (const auto& existing : resolved) {
+            if (existing.family == fam.family) duplicate = true;
+        }
+        if (duplicate) continue;
+
+        AprilTagFamilyConfig entry = fam;
+        if (!entry.tag_size_m) entry.tag_size_m = tag_size_m;
+        resolved.push_back(entry);
+    }
+    return resolved;
+}
+
 nlohmann::json AprilTagConfig::toJson() const {
+    nlohmann::json familiesJson = nlohmann::json::array();
+    for (const auto& fam : families) {
+        familiesJson.push_back(fam.toJson());
+    }
     return {
         {"family", family},
+        {"families", familiesJson},
         {"tag_size_m", tag_size_m},
         {"threads", threads},
         {"decimate", decimate},
@@ -21,7 +66,22 @@ nlohmann::json AprilTagConfig::toJson() const {
 
 AprilTagConfig AprilTagConfig::fromJson(const nlohmann::json& j) {
     AprilTagConfig cfg;
-    cfg.family = j.value("family", "tag36h11");
+    // "family" may be one name or a list; "families" also carries per-family size and field
+    if (j.contains("family") && j["family"].is_array()) {
+        for (const auto& name : j["family"]) {
+            cfg.families.push_back(AprilTagFamilyConfig::fromJson(name));
+        }
+    } else {
+        cfg.family = j.value("family", "tag36h11");
+    }
+    if (j.contains("families") && j["families"].is_array()) {
+        for (const auto& fam : j["families"]) {
+            cfg.families.push_back(AprilTagFamilyConfig::fromJson(fam));
+        }
+    }
+    if (!cfg.families.empty() && !(j.contains("family") && j["family"].is_string())) {
+        cfg.family = cfg.families.front().family;
+    }
     cfg.tag_size_m = j.value("tag_size_m", 0.1524);
     cfg.threads = j.value("threads", 4);
     cfg.decimate = j.value("decimate", 2.0);
@@ -45,7 +105,12 @@ nlohmann::json ObjectDetectionMLConfig::toJson() const {
         {"img_size", img_size},
         {"max_detections", max_detections},
         {"accelerator", accelerator},
-        {"target_classes", target_classes}
+        {"provider_threads", provider_threads},
+        {"provider_fp16", provider_fp16},
+        {"target_classes", target_classes},
+        {"mask_top_k", mask_top_k},
+        {"mask_threshold", mask_threshold},
+        {"contour_epsilon_px", contour_epsilon_px}
     };
 }
 
@@ -59,9 +124,14 @@ ObjectDetectionMLConfig ObjectDetectionMLConfig::fromJson(const nlohmann::json&
     cfg.img_size = j.value("img_size", 640);
     cfg.max_detections = j.value("max_detections", 100);
     cfg.accelerator = j.value("accelerator", "none");
+    cfg.provider_threads = j.value("provider_threads", 0);
+    cfg.provider_fp16 = j.value("provider_fp16", false);
     if (j.contains("target_classes")) {
         cfg.target_classes = j["target_classes"].get<std::vector<std::string>>();
     }
+    cfg.mask_top_k = j.value("mask_top_k", 10);
+    cfg.mask_threshold = j.value("mask_threshold", 0.5);
+    cfg.contour_epsilon_px = j.value("contour_epsilon_px", 2.0);
     return cfg;
 }
 
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <optional>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 // Forward declaration
@@ -35,8 +36,19 @@ NLOHMANN_JSON_SERIALIZE_ENUM(OpticalFlowAlgorithm, {
 })
 
 // AprilTag configuration
+// One tag family decoded by an AprilTag pipeline
+struct AprilTagFamilyConfig {
+    std::string family = "tag36h11";
+    std::optional<double> tag_size_m;  // nullopt = the pipeline's tag_size_m
+    std::string field;                 // Field layout for this family; empty = the selected field
+
+    nlohmann::json toJson() const;
+    static AprilTagFamilyConfig fromJson(const nlohmann::json& j);
+};
+
 struct AprilTagConfig {
     std::string family = "tag36h11";
+    std::vector<AprilTagFamilyConfig> families;  // Decoded together in one pass; empty = just `family`
     double tag_size_m = 0.1524;  // 6 inches default
     int threads = 4;
     double decimate = 2.0;
@@ -47,6 +59,9 @@ struct AprilTagConfig {
     double ransac_reproj_threshold = 0.1;
     std::string selected_field;
 
+    // Families to decode, with tag sizes resolved; never empty
+    std::vector<AprilTagFamilyConfig> resolvedFamilies() const;
+
     nlohmann::json toJson() const;
     static AprilTagConfig fromJson(const nlohmann::json& j);
 };
@@ -60,9 +75,16 @@ struct ObjectDetectionMLConfig {
     double nms_iou_threshold = 0.45;
     int img_size = 640;
     int max_detections = 100;
-    std::string accelerator = "none";
+    std::string accelerator = "none";    // none, cuda, tensorrt, coreml, xnnpack, openvino, auto
+    int provider_threads = 0;            // Inference threads (0 = provider default)
+    bool provider_fp16 = false;          // Reduced precision on OpenVINO/TensorRT
     std::vector<std::string> target_classes;
 
+    // Segmentation models (YOLO-seg): masks are only decoded for the top detections
+    int mask_top_k = 10;
+    double mask_threshold = 0.5;
+    double contour_epsilon_px = 2.0;     // Polygon simplification tolerance in image pixels
+
     nlohmann::json toJson() const;
     static ObjectDetectionMLConfig fromJson(const nlohmann::json& j);
 };
@@ -0,0 +1,118 @@
+#include "pipelines/apriltag_family_cache.hpp"
+#include "metrics/memory.hpp"
+#include <spdlog/spdlog.h>
+
+extern "C" {
+#include <tag36h11.h>
+#include <tag16h5.h>
+#include <tag25h9.h>
+#include <tagCircle21h7.h>
+#include <tagStandard41h12.h>
+}
+
+namespace vision {
+
+namespace {
+
+apriltag_family_t* createFamily(const std::string& familyName) {
+    if (familyName == "tag36h11") return tag36h11_create();
+    if (familyName == "tag16h5") return tag16h5_create();
+    if (familyName == "tag25h9") return tag25h9_create();
+    if (familyName == "tagCircle21h7") return tagCircle21h7_create();
+    if (familyName == "tagStandard41h12") return tagStandard41h12_create();
+    return nullptr;
+}
+
+void destroyFamily(const std::string& familyName, apriltag_family_t* family) {
+    if (familyName == "tag36h11") tag36h11_destroy(family);
+    else if (familyName == "tag16h5") tag16h5_destroy(family);
+    else if (familyName == "tag25h9") tag25h9_destroy(family);
+    else if (familyName == "tagCircle21h7") tagCircle21h7_destroy(family);
+    else if (familyName == "tagStandard41h12") tagStandard41h12_destroy(family);
+}
+
+// Size of the quick-decode hash table libapriltag builds for a family
+// (3x the number of codewords within hammingBits; 16-byte entries)
+int64_t decodeTableBytes(const apriltag_family_t* family, int hammingBits) {
+    int64_t ncodes = family->ncodes;
+    int64_t nbits = family->nbits;
+    int64_t capacity = ncodes;
+    if (hammingBits >= 1) capacity += ncodes * nbits;
+    if (hammingBits >= 2) capacity += ncodes * nbits * (nbits - 1);
+    if (hammingBits >= 3) capacity += ncodes * nbits * (nbits - 1) * (nbits - 2);
+    return capacity * 3 * 16;
+}
+
+} // namespace
+
+AprilTagFamilyCache& AprilTagFamilyCache::instance() {
+    static AprilTagFamilyCache instance;
+    return instance;
+}
+
+std::shared_ptr<apriltag_family_t> AprilTagFamilyCache::acquire(const std::string& familyName, int hammingBits) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto key = std::make_pair(familyName, hammingBits);
+    auto it = families_.find(key);
+    if (it != families_.end()) {
+        if (auto existing = it->second.lock()) {
+            return existing;
+        }
+    }
+
+    apriltag_family_t* raw = createFamily(familyName);
+    if (!raw) {
+        return nullptr;
+    }
+
+    // Build the decode table once through a scratch detector, under the lock,
+    // so concurrent pipelines never race to initialize family->impl
+    apriltag_detector_t* scratch = apriltag_detector_create();
+    apriltag_detector_add_family_bits(scratch, raw, hammingBits);
+    destroySharedDetector(scratch);
+
+    int64_t tableBytes = decodeTableBytes(raw, hammingBits);
+    MemoryTracker::instance().counter(MemorySubsystem::TagFamilies).add(tableBytes);
+    spdlog::info("AprilTag family {} decode table built (hamming {}, ~{} MB)",
+                 familyName, hammingBits, tableBytes / (1024 * 1024));
+
+    std::shared_ptr<apriltag_family_t> family(raw, [familyName, hammingBits, tableBytes](apriltag_family_t* fam) {
+        // Free the decode table through libapriltag, then the family itself
+        apriltag_detector_t* scratch = apriltag_detector_create();
+        apriltag_detector_add_family_bits(scratch, fam, hammingBits);
+        apriltag_detector_remove_family(scratch, fam);
+        apriltag_detector_destroy(scratch);
+        destroyFamily(familyName, fam);
+
+        MemoryTracker::instance().counter(MemorySubsystem::TagFamilies).sub(tableBytes);
+        spdlog::debug("AprilTag family {} released", familyName);
+    });
+
+    families_[key] = family;
+    return family;
+}
+
+size_t AprilTagFamilyCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t alive = 0;
+    for (const auto& [key, weak] : families_) {
+        if (!weak.expired()) alive++;
+    }
+    return alive;
+}
+
+void addSharedFamily(apriltag_detector_t* detector, const std::shared_ptr<apriltag_family_t>& family,
+                     int hammingBits) {
+    // family->impl is already set, so this only registers the family
+    apriltag_detector_add_family_bits(detector, family.get(), hammingBits);
+}
+
+void destroySharedDetector(apriltag_detector_t* detector) {
+    if (!detector) return;
+    // apriltag_detector_destroy would free every family's decode table; detach them first
+    zarray_clear(detector->tag_families);
+    apriltag_detector_destroy(detector);
+}
+
+} // namespace vision
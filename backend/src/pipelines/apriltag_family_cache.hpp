@@ -0,0 +1,47 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+extern "C" {
+#include <apriltag.h>
+}
+
+namespace vision {
+
+// Process-wide cache of AprilTag families. libapriltag keeps a family's
+// quick-decode table on the family itself (family->impl) and only builds it
+// when absent, so detectors that share one family object share one read-only
+// table. The cache builds the table once and tears it down when the last
+// detector lets go.
+class AprilTagFamilyCache {
+public:
+    static AprilTagFamilyCache& instance();
+
+    // Shared family with its decode table built; nullptr for an unknown name
+    std::shared_ptr<apriltag_family_t> acquire(const std::string& familyName, int hammingBits = 2);
+
+    // Families currently alive
+    size_t size() const;
+
+private:
+    AprilTagFamilyCache() = default;
+
+    AprilTagFamilyCache(const AprilTagFamilyCache&) = delete;
+    AprilTagFamilyCache& operator=(const AprilTagFamilyCache&) = delete;
+
+    mutable std::mutex mutex_;
+    std::map<std::pair<std::string, int>, std::weak_ptr<apriltag_family_t>> families_;
+};
+
+// Add a cached family to a detector; the existing decode table is reused
+void addSharedFamily(apriltag_detector_t* detector, const std::shared_ptr<apriltag_family_t>& family,
+                     int hammingBits = 2);
+
+// Destroy a detector whose families are cache-owned (detaches them first so
+// the shared decode tables survive)
+void destroySharedDetector(apriltag_detector_t* detector);
+
+} // namespace vision
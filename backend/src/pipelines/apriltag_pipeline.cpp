@@ -1,103 +1,114 @@
 #define _USE_MATH_DEFINES
 #include "pipelines/apriltag_pipeline.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <cmath>
 #include "utils/coordinate_system.hpp"
+#include "utils/orientation.hpp"
+#include "metrics/memory.hpp"
 #include "services/settings_service.hpp"
 #include "vision/field_layout.hpp"
 
 namespace vision {
 
-// Implementation of AprilTagFamilyDeleter
-void AprilTagFamilyDeleter::operator()(apriltag_family_t* family) const {
-    if (!family) return;
-
-    if (familyName == "tag36h11") {
-        tag36h11_destroy(family);
-    } else if (familyName == "tag16h5") {
-        tag16h5_destroy(family);
-    } else if (familyName == "tag25h9") {
-        tag25h9_destroy(family);
-    } else if (familyName == "tagCircle21h7") {
-        tagCircle21h7_destroy(family);
-    } else if (familyName == "tagStandard41h12") {
-        tagStandard41h12_destroy(family);
-    } else {
-        // Default case
-        tag36h11_destroy(family);
-    }
-}
-
-AprilTagPipeline::AprilTagPipeline() {
+AprilTagPipeline::AprilTagPipeline()
+    : arena_(apriltag_arena_create(0)) {
+    MemoryTracker::instance().counter(MemorySubsystem::TagArenas).add(0);
     initializeDetector();
 }
 
 AprilTagPipeline::AprilTagPipeline(const AprilTagConfig& config)
-    : config_(config) {
+    : config_(config)
+    , arena_(apriltag_arena_create(0)) {
+    MemoryTracker::instance().counter(MemorySubsystem::TagArenas).add(0);
     initializeDetector();
 }
 
 AprilTagPipeline::~AprilTagPipeline() {
-    // Remove family from detector before destruction (order matters)
-    if (detector_ && family_) {
-        apriltag_detector_remove_family(detector_.get(), family_.get());
-    }
-    // Smart pointers handle destruction automatically
-}
-
-AprilTagFamilyPtr AprilTagPipeline::createFamily(const std::string& familyName) {
-    apriltag_family_t* rawFamily = nullptr;
-
-    if (familyName == "tag36h11") {
-        rawFamily = tag36h11_create();
-    } else if (familyName == "tag16h5") {
-        rawFamily = tag16h5_create();
-    } else if (familyName == "tag25h9") {
-        rawFamily = tag25h9_create();
-    } else if (familyName == "tagCircle21h7") {
-        rawFamily = tagCircle21h7_create();
-    } else if (familyName == "tagStandard41h12") {
-        rawFamily = tagStandard41h12_create();
-    } else {
-        // Default to tag36h11
-        spdlog::warn("Unknown tag family '{}', defaulting to tag36h11", familyName);
-        rawFamily = tag36h11_create();
-    }
-
-    return AprilTagFamilyPtr(rawFamily, AprilTagFamilyDeleter{familyName});
+    // The detector deleter detaches the shared families; the arena outlives the detector
+    MemoryTracker::instance().counter(MemorySubsystem::TagArenas).sub(arenaReservedBytes_);
 }
 
-void AprilTagPipeline::initializeDetector() {
-    // Create tag family
-    family_ = createFamily(config_.family);
-    if (!family_) {
-        spdlog::error("Failed to create AprilTag family: {}", config_.family);
-        throw std::runtime_error("Failed to create AprilTag family: " + config_.family);
+AprilTagDetectorPtr AprilTagPipeline::buildDetector(const AprilTagConfig& config,
+                                                    AprilTagFamilySet& families) {
+    // Create tag families
+    for (const auto& famConfig : config.resolvedFamilies()) {
+        AprilTagFamilySlot slot;
+        slot.name = famConfig.family;
+        slot.primary = famConfig.family == config.family;
+        slot.family = AprilTagFamilyCache::instance().acquire(famConfig.family);
+        if (!slot.family) {
+            spdlog::warn("Unknown tag family '{}', defaulting to tag36h11", famConfig.family);
+            slot.name = "tag36h11";
+            slot.family = AprilTagFamilyCache::instance().acquire(slot.name);
+            bool present = std::any_of(families.begin(), families.end(),
+                                       [&](const AprilTagFamilySlot& f) { return f.name == slot.name; });
+            if (present) continue;
+        }
+        slot.tagSize = famConfig.tag_size_m.value_or(config.tag_size_m);
+
+        // Tag-local corners (z=0) and the annotation cube, so detections don't rebuild them
+        float half = static_cast<float>(slot.tagSize / 2.0);
+        float size = static_cast<float>(slot.tagSize);
+        slot.objectPoints = {
+            {-half,  half, 0}, // Bottom-Left
+            { half,  half, 0}, // Bottom-Right
+            { half, -half, 0}, // Top-Right
+            {-half, -half, 0}  // Top-Left
+        };
+        slot.cubePoints = {
+            {-half, -half, 0}, { half, -half, 0}, { half,  half, 0}, {-half,  half, 0},
+            {-half, -half, -size}, { half, -half, -size}, { half,  half, -size}, {-half,  half, -size}
+        };
+
+        if (!famConfig.field.empty()) {
+            slot.fieldLayout = FieldLayoutService::instance().getFieldLayout(famConfig.field);
+            if (!slot.fieldLayout) {
+                spdlog::warn("Field layout '{}' for family {} not found; {}", famConfig.field, famConfig.family,
+                             slot.primary ? "using the selected field" : "its tags are left out of the field pose");
+            }
+        }
+        families.push_back(std::move(slot));
     }
 
-    // Create detector
-    detector_.reset(apriltag_detector_create());
-    if (!detector_) {
+    // Create detector; its state and any worker threads it starts allocate from the arena
+    AprilTagArenaScope arenaScope(arena_.get());
+    AprilTagDetectorPtr detector(apriltag_detector_create());
+    if (!detector) {
         spdlog::error("Failed to create AprilTag detector");
-        family_.reset();  // Clean up family on failure
         throw std::runtime_error("Failed to create AprilTag detector");
     }
 
-    // Add family to detector
-    apriltag_detector_add_family(detector_.get(), family_.get());
+    // All families share one quad detection pass; each quad is decoded against every family.
+    // Decode tables come prebuilt from the cache, so this is cheap.
+    for (auto& slot : families) {
+        addSharedFamily(detector.get(), slot.family);
+    }
 
     // Configure detector parameters
-    detector_->nthreads = config_.threads;
+    detector->nthreads = config.threads;
+
+    detector->quad_decimate = config.decimate;
+    detector->quad_sigma = config.blur;
+    detector->refine_edges = config.refine_edges ? 1 : 0;
+    detector->decode_sharpening = 0.25;
+
+    return detector;
+}
 
-    detector_->quad_decimate = config_.decimate;
-    detector_->quad_sigma = config_.blur;
-    detector_->refine_edges = config_.refine_edges ? 1 : 0;
-    detector_->decode_sharpening = 0.25;
+void AprilTagPipeline::initializeDetector() {
+    AprilTagFamilySet families;
+    detector_ = buildDetector(config_, families);
+    families_ = std::make_shared<const AprilTagFamilySet>(std::move(families));
 
-    spdlog::info("AprilTag detector initialized - family: {}, threads: {}, decimate: {:.1f}",
-                 config_.family, detector_->nthreads, config_.decimate);
+    std::string names;
+    for (const auto& slot : *families_) {
+        names += (names.empty() ? "" : ", ") + slot.name;
+    }
+    spdlog::info("AprilTag detector initialized - families: {}, threads: {}, decimate: {:.1f}",
+                 names, detector_->nthreads, config_.decimate);
 
     // Set initial field layout from global settings
     std::string selectedField = SettingsService::instance().getSelectedField();
@@ -122,26 +133,36 @@ void AprilTagPipeline::setCalibration(double fx, double fy, double cx, double cy
 
 PipelineResult AprilTagPipeline::process(const cv::Mat& frame,
                                          const std::optional<cv::Mat>& depth) {
+    return finishStage(detectStage(frame, depth));
+}
+
+std::unique_ptr<StagedFrame> AprilTagPipeline::detectStage(const cv::Mat& frame,
+                                                           const std::optional<cv::Mat>& depth) {
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    PipelineResult result;
-    result.detections = nlohmann::json::array();
+    auto staged = std::make_unique<AprilTagStagedFrame>();
+    staged->frame = frame;
 
     // Lock for thread safety
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (!detector_ || !family_) {
+    staged->families = families_;
+    staged->ransacReprojThreshold = config_.ransac_reproj_threshold;
+    staged->orientation = frameOrientation_;
+
+    if (!detector_ || !families_ || families_->empty()) {
         spdlog::warn("AprilTag detector not initialized");
-        result.annotatedFrame = frame.clone();
-        auto endTime = std::chrono::high_resolution_clock::now();
-        result.processingTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
-        return result;
+        return staged;
     }
 
-    // Convert to grayscale for detection
+    // Thermal load shedding decimates harder; applied per frame so it lifts immediately
+    detector_->quad_decimate = static_cast<float>(config_.decimate + loadShedding_.load());
+
+    // Convert to grayscale for detection; gray_ keeps its buffer while the size holds
     cv::Mat gray;
     if (frame.channels() == 3) {
-        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        cv::cvtColor(frame, gray_, cv::COLOR_BGR2GRAY);
+        gray = gray_;
     } else {
         gray = frame;
     }
@@ -150,23 +171,17 @@ PipelineResult AprilTagPipeline::process(const cv::Mat& frame,
     image_u8_t im = {
         .width = static_cast<int32_t>(gray.cols),
         .height = static_cast<int32_t>(gray.rows),
-        .stride = static_cast<int32_t>(gray.cols),
+        .stride = static_cast<int32_t>(gray.step[0]),
         .buf = gray.data
     };
 
-    // Run detection
+    // Run detection; everything it allocates, including the detections, comes from the arena
+    AprilTagArenaScope arenaScope(arena_.get());
+    apriltag_arena_frame_begin(arena_.get());
     zarray_t* detections = apriltag_detector_detect(detector_.get(), &im);
 
-    // Clone frame for annotation
-    if (frame.channels() == 1) {
-        cv::cvtColor(frame, result.annotatedFrame, cv::COLOR_GRAY2BGR);
-    } else {
-        result.annotatedFrame = frame.clone();
-    }
-
-    // Collect valid detections for global solver
-    std::vector<TagDetection> validDetectionsForSolver;
-
+    // Copy out what the finish stage needs so the zarray is freed here
+    staged->tags.reserve(zarray_size(detections));
     for (int i = 0; i < zarray_size(detections); i++) {
         apriltag_detection_t* det;
         zarray_get(detections, i, &det);
@@ -176,46 +191,119 @@ PipelineResult AprilTagPipeline::process(const cv::Mat& frame,
             continue;
         }
 
+        TagDetection tag;
+        tag.id = det->id;
+        tag.decisionMargin = det->decision_margin;
+        tag.hamming = det->hamming;
+        tag.center = cv::Point2d(det->c[0], det->c[1]);
+
+        // Map the decoded family back to its slot for size and layout
+        for (size_t f = 0; f < families_->size(); f++) {
+            if ((*families_)[f].family.get() == det->family) {
+                tag.familyIndex = f;
+                break;
+            }
+        }
+
+        tag.corners.reserve(4);
+        for (int j = 0; j < 4; j++) {
+            tag.corners.push_back(cv::Point2f(static_cast<float>(det->p[j][0]), static_cast<float>(det->p[j][1])));
+        }
+
+        // Sensor-oriented frame: move the corners into the upright image the calibration
+        // was taken in. Rotations keep the corner winding, so solvePnP needs no other change.
+        if (staged->orientation != 0) {
+            for (auto& corner : tag.corners) {
+                corner = orientation::toUpright(corner, staged->orientation, gray.size());
+            }
+            tag.center = orientation::toUpright(tag.center, staged->orientation, gray.size());
+        }
+        staged->tags.push_back(std::move(tag));
+    }
+
+    // Cleanup detections
+    apriltag_detections_destroy(detections);
+
+    apriltag_arena_get_stats(arena_.get(), &staged->arenaStats);
+    int64_t reserved = staged->arenaStats.reserved_bytes;
+    if (reserved != arenaReservedBytes_) {
+        auto& counter = MemoryTracker::instance().counter(MemorySubsystem::TagArenas);
+        if (reserved > arenaReservedBytes_) {
+            counter.add(reserved - arenaReservedBytes_, 0);
+        } else {
+            counter.sub(arenaReservedBytes_ - reserved, 0);
+        }
+        arenaReservedBytes_ = reserved;
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    staged->detectMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    return staged;
+}
+
+PipelineResult AprilTagPipeline::finishStage(std::unique_ptr<StagedFrame> stagedFrame) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    PipelineResult result;
+    result.detections = nlohmann::json::array();
+
+    auto* staged = static_cast<AprilTagStagedFrame*>(stagedFrame.get());
+    const cv::Mat& frame = staged->frame;
+
+    // Clone frame for annotation, turning a sensor-oriented frame upright in the same pass
+    if (frame.channels() == 1) {
+        cv::cvtColor(staged->orientation != 0 ? orientation::uprightCopy(frame, staged->orientation) : frame,
+                     result.annotatedFrame, cv::COLOR_GRAY2BGR);
+    } else {
+        result.annotatedFrame = orientation::uprightCopy(frame, staged->orientation);
+    }
+
+    if (!staged->families || staged->families->empty()) {
+        result.processingTimeMs = staged->detectMs;
+        return result;
+    }
+    const AprilTagFamilySet& families = *staged->families;
+
+    std::lock_guard<std::mutex> lock(solveMutex_);
+
+    // Collect valid detections for global solver
+    std::vector<TagDetection> validDetectionsForSolver;
+    validDetectionsForSolver.reserve(staged->tags.size());
+
+    for (const auto& tag : staged->tags) {
+        const auto& slot = families[tag.familyIndex];
+
         // Draw visuals
-        std::vector<cv::Point> drawCorners;
+        cv::Point drawCorners[4];
         for (int j = 0; j < 4; j++) {
-            drawCorners.push_back(cv::Point(static_cast<int>(det->p[j][0]), static_cast<int>(det->p[j][1])));
+            drawCorners[j] = cv::Point(static_cast<int>(tag.corners[j].x), static_cast<int>(tag.corners[j].y));
         }
-        cv::polylines(result.annotatedFrame, drawCorners, true, cv::Scalar(0, 255, 0), 2);
-        cv::circle(result.annotatedFrame, cv::Point(static_cast<int>(det->c[0]), static_cast<int>(det->c[1])), 5, cv::Scalar(0, 0, 255), -1);
-        cv::putText(result.annotatedFrame, std::to_string(det->id), cv::Point(static_cast<int>(det->c[0] - 10), static_cast<int>(det->c[1] - 10)), cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(255, 0, 0), 2);
+        const cv::Point* polygon = drawCorners;
+        int polygonSize = 4;
+        cv::polylines(result.annotatedFrame, &polygon, &polygonSize, 1, true, cv::Scalar(0, 255, 0), 2);
+        cv::circle(result.annotatedFrame, cv::Point(static_cast<int>(tag.center.x), static_cast<int>(tag.center.y)), 5, cv::Scalar(0, 0, 255), -1);
+        cv::putText(result.annotatedFrame, std::to_string(tag.id), cv::Point(static_cast<int>(tag.center.x - 10), static_cast<int>(tag.center.y - 10)), cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(255, 0, 0), 2);
 
         // Build basic detection JSON
         nlohmann::json detection;
-        detection["id"] = det->id;
-        detection["decision_margin"] = det->decision_margin;
-        detection["hamming"] = det->hamming;
-        detection["center"] = {det->c[0], det->c[1]};
-        
+        detection["id"] = tag.id;
+        detection["family"] = slot.name;
+        detection["decision_margin"] = tag.decisionMargin;
+        detection["hamming"] = tag.hamming;
+        detection["center"] = {tag.center.x, tag.center.y};
+
         nlohmann::json cornersJson = nlohmann::json::array();
-        for (int j = 0; j < 4; j++) {
-            cornersJson.push_back({det->p[j][0], det->p[j][1]});
+        for (const auto& corner : tag.corners) {
+            cornersJson.push_back({corner.x, corner.y});
         }
         detection["corners"] = cornersJson;
 
         // --- PART A: Individual Tag Solve (Tag-Relative) ---
         if (hasCalibration_) {
-            // 3D Object Points for the tag (centered at origin, z=0)
-            double halfSize = config_.tag_size_m / 2.0;
-            std::vector<cv::Point3f> objectPoints = {
-                cv::Point3f(-halfSize,  halfSize, 0), // Bottom-Left
-                cv::Point3f( halfSize,  halfSize, 0), // Bottom-Right
-                cv::Point3f( halfSize, -halfSize, 0), // Top-Right
-                cv::Point3f(-halfSize, -halfSize, 0)  // Top-Left
-            };
-
-            std::vector<cv::Point2f> imagePoints;
-            for (int j = 0; j < 4; j++) {
-                imagePoints.push_back(cv::Point2f(static_cast<float>(det->p[j][0]), static_cast<float>(det->p[j][1])));
-            }
+            imagePoints_.assign(tag.corners.begin(), tag.corners.end());
 
             cv::Vec3d rvec, tvec;
-            bool success = cv::solvePnP(objectPoints, imagePoints, cameraMatrix_, distCoeffs_, rvec, tvec, false, cv::SOLVEPNP_SQPNP);
+            bool success = cv::solvePnP(slot.objectPoints, imagePoints_, cameraMatrix_, distCoeffs_, rvec, tvec, false, cv::SOLVEPNP_SQPNP);
 
             if (success) {
                 // Convert to Pose3d (Camera-Relative)
@@ -224,19 +312,11 @@ PipelineResult AprilTagPipeline::process(const cv::Mat& frame,
                 detection["pose_relative"] = tagPose.toJson();
 
                 // Draw 3D Cube
-                double size = config_.tag_size_m;
-                std::vector<cv::Point3f> cubePoints = {
-                    cv::Point3f(-halfSize, -halfSize, 0), cv::Point3f( halfSize, -halfSize, 0),
-                    cv::Point3f( halfSize,  halfSize, 0), cv::Point3f(-halfSize,  halfSize, 0),
-                    cv::Point3f(-halfSize, -halfSize, -size), cv::Point3f( halfSize, -halfSize, -size),
-                    cv::Point3f( halfSize,  halfSize, -size), cv::Point3f(-halfSize,  halfSize, -size)
-                };
-                std::vector<cv::Point2f> imagePointsCube;
-                cv::projectPoints(cubePoints, rvec, tvec, cameraMatrix_, distCoeffs_, imagePointsCube);
+                cv::projectPoints(slot.cubePoints, rvec, tvec, cameraMatrix_, distCoeffs_, cubeImagePoints_);
                 cv::Scalar cubeColor(0, 255, 0);
                 for (int k = 0; k < 4; k++) {
-                    cv::line(result.annotatedFrame, imagePointsCube[k], imagePointsCube[k+4], cubeColor, 2);
-                    cv::line(result.annotatedFrame, imagePointsCube[k+4], imagePointsCube[((k+1)%4)+4], cubeColor, 2);
+                    cv::line(result.annotatedFrame, cubeImagePoints_[k], cubeImagePoints_[k+4], cubeColor, 2);
+                    cv::line(result.annotatedFrame, cubeImagePoints_[k+4], cubeImagePoints_[((k+1)%4)+4], cubeColor, 2);
                 }
             }
         }
@@ -244,30 +324,35 @@ PipelineResult AprilTagPipeline::process(const cv::Mat& frame,
         result.detections.push_back(detection);
 
         // --- PART B: Prep for Global Solve (Field-Relative) ---
-        if (fieldLayout_ && fieldLayout_->hasTag(det->id)) {
-            TagDetection tagData;
-            tagData.id = det->id;
-            for (int j = 0; j < 4; j++) {
-                tagData.corners.push_back(cv::Point2f(static_cast<float>(det->p[j][0]), static_cast<float>(det->p[j][1])));
-            }
-            validDetectionsForSolver.push_back(tagData);
+        const FieldLayout* layout = layoutFor(families, tag.familyIndex);
+        if (layout && layout->hasTag(tag.id)) {
+            validDetectionsForSolver.push_back(tag);
         }
     }
 
     // --- PART C: Global Solve (Multi-Tag Logic) ---
     if (hasCalibration_ && !validDetectionsForSolver.empty()) {
-        MultiTagResult globalPose = solveMultiTagPose(validDetectionsForSolver, frame.size());
+        MultiTagResult globalPose = solveMultiTagPose(families, validDetectionsForSolver,
+                                                      staged->ransacReprojThreshold);
         if (globalPose.valid) {
             result.robotPose = globalPose.robotPose;
             result.tagsUsed = globalPose.tagsUsed;
         }
     }
 
-    // Cleanup detections
-    apriltag_detections_destroy(detections);
+    // Detector heap use for this frame
+    const auto& arena = staged->arenaStats;
+    result.extras["arena"] = {
+        {"allocs", arena.frame_allocs},
+        {"bytes", arena.frame_bytes},
+        {"reserved_bytes", arena.reserved_bytes},
+        {"chunk_mallocs", arena.chunk_mallocs},
+        {"large_allocs", arena.large_allocs}
+    };
 
     auto endTime = std::chrono::high_resolution_clock::now();
-    result.processingTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    result.processingTimeMs = staged->detectMs +
+        std::chrono::duration<double, std::milli>(endTime - startTime).count();
 
     return result;
 }
@@ -276,43 +361,22 @@ void AprilTagPipeline::updateConfig(const nlohmann::json& config) {
     // Parse new config first (may throw)
     AprilTagConfig newConfig = AprilTagConfig::fromJson(config);
 
-    // Create new detector and family before modifying state (exception safety)
-    AprilTagFamilyPtr newFamily = createFamily(newConfig.family);
-    if (!newFamily) {
-        throw std::runtime_error("Failed to create AprilTag family: " + newConfig.family);
-    }
-
-    AprilTagDetectorPtr newDetector(apriltag_detector_create());
-    if (!newDetector) {
-        throw std::runtime_error("Failed to create AprilTag detector");
-    }
-
-    // Configure new detector
-    apriltag_detector_add_family(newDetector.get(), newFamily.get());
-
-    newDetector->nthreads = newConfig.threads;
-
-    newDetector->quad_decimate = newConfig.decimate;
-    newDetector->quad_sigma = newConfig.blur;
-    newDetector->refine_edges = newConfig.refine_edges ? 1 : 0;
-    newDetector->decode_sharpening = 0.25;
+    // Create new detector and families before modifying state (exception safety)
+    AprilTagFamilySet newFamilies;
+    AprilTagDetectorPtr newDetector = buildDetector(newConfig, newFamilies);
 
     // Now swap - this won't throw
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        
-        // Remove family from old detector before destruction
-        if (detector_ && family_) {
-            apriltag_detector_remove_family(detector_.get(), family_.get());
-        }
 
-        config_ = std::move(newConfig);
-        family_ = std::move(newFamily);
+        // Shared families and their decode tables outlive the old detector in the cache
         detector_ = std::move(newDetector);
+        families_ = std::make_shared<const AprilTagFamilySet>(std::move(newFamilies));
+        config_ = std::move(newConfig);
     }
 
-    spdlog::info("AprilTag config updated - family: {}, threads: {}, decimate: {:.1f}",
-                 config_.family, detector_->nthreads, config_.decimate);
+    spdlog::info("AprilTag config updated - families: {}, threads: {}, decimate: {:.1f}",
+                 families_->size(), detector_->nthreads, config_.decimate);
 }
 
 void AprilTagPipeline::setFieldLayout(const FieldLayout& layout) {
@@ -320,21 +384,41 @@ void AprilTagPipeline::setFieldLayout(const FieldLayout& layout) {
     spdlog::info("AprilTag field layout set: {} tags", layout.size());
 }
 
-std::vector<cv::Point3f> AprilTagPipeline::getTagCornersInField(int tagId) const {
+CaptureRequirements AprilTagPipeline::captureRequirements() const {
+    CaptureRequirements req;
+    req.monoOk = true;
+    return req;
+}
+
+const FieldLayout* AprilTagPipeline::layoutFor(const AprilTagFamilySet& families, size_t familyIndex) const {
+    if (familyIndex >= families.size()) {
+        return nullptr;
+    }
+    const auto& slot = families[familyIndex];
+    if (slot.fieldLayout) {
+        return &*slot.fieldLayout;
+    }
+    // IDs of another family would alias the selected field's tags
+    return slot.primary && fieldLayout_ ? &*fieldLayout_ : nullptr;
+}
+
+std::vector<cv::Point3f> AprilTagPipeline::getTagCornersInField(const AprilTagFamilySet& families,
+                                                                size_t familyIndex, int tagId) const {
     std::vector<cv::Point3f> corners;
 
-    if (!fieldLayout_) {
+    const FieldLayout* layout = layoutFor(families, familyIndex);
+    if (!layout || familyIndex >= families.size()) {
         return corners;
     }
 
-    auto tagPose = fieldLayout_->getTagPose(tagId);
+    auto tagPose = layout->getTagPose(tagId);
     if (!tagPose) {
         return corners;
     }
 
     // Tag corners in tag-local coordinates (centered at origin)
     // Order: bottom-left, bottom-right, top-right, top-left (CCW from camera view)
-    double halfSize = config_.tag_size_m / 2.0;
+    double halfSize = families[familyIndex].tagSize / 2.0;
     std::vector<Eigen::Vector3d> localCorners = {
         {-halfSize,  halfSize, 0.0},  // Bottom-left
         { halfSize,  halfSize, 0.0},  // Bottom-right
@@ -355,11 +439,12 @@ std::vector<cv::Point3f> AprilTagPipeline::getTagCornersInField(int tagId) const
     return corners;
 }
 
-MultiTagResult AprilTagPipeline::solveMultiTagPose(const std::vector<TagDetection>& detections,
-                                                    const cv::Size& imageSize) {
+MultiTagResult AprilTagPipeline::solveMultiTagPose(const AprilTagFamilySet& families,
+                                                    const std::vector<TagDetection>& detections,
+                                                    double ransacReprojThreshold) {
     MultiTagResult result;
 
-    if (!hasCalibration_ || !fieldLayout_ || detections.empty()) {
+    if (!hasCalibration_ || detections.empty()) {
         return result;
     }
 
@@ -370,7 +455,7 @@ MultiTagResult AprilTagPipeline::solveMultiTagPose(const std::vector<TagDetectio
 
     for (const auto& det : detections) {
         // Get tag corners in field coordinates
-        auto fieldCorners = getTagCornersInField(det.id);
+        auto fieldCorners = getTagCornersInField(families, det.familyIndex, det.id);
         if (fieldCorners.empty()) {
             continue;  // Tag not in field layout
         }
@@ -402,7 +487,7 @@ MultiTagResult AprilTagPipeline::solveMultiTagPose(const std::vector<TagDetectio
             rvec, tvec,
             hasPrevPose_, // Use previous frame as guess
             100,  // iterations
-            static_cast<float>(config_.ransac_reproj_threshold),
+            static_cast<float>(ransacReprojThreshold),
             0.99,  // confidence
             inliers,
             cv::SOLVEPNP_SQPNP
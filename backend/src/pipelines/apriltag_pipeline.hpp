@@ -4,39 +4,48 @@
 #include "models/pipeline.hpp"
 #include "vision/field_layout.hpp"
 #include "utils/geometry.hpp"
+#include "pipelines/apriltag_family_cache.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 
 extern "C" {
 #include <apriltag.h>
-#include <tag36h11.h>
-#include <tag16h5.h>
-#include <tag25h9.h>
-#include <tagCircle21h7.h>
-#include <tagStandard41h12.h>
 #include <apriltag_pose.h>
 }
+#include <apriltag_arena.h>
 
 namespace vision {
 
-// RAII deleter for apriltag_detector_t
+// RAII deleter for apriltag_detector_t; families belong to AprilTagFamilyCache
 struct AprilTagDetectorDeleter {
     void operator()(apriltag_detector_t* detector) const {
-        if (detector) {
-            apriltag_detector_destroy(detector);
-        }
+        destroySharedDetector(detector);
     }
 };
 
-// RAII deleter for apriltag_family_t
-struct AprilTagFamilyDeleter {
-    std::string familyName;
+using AprilTagDetectorPtr = std::unique_ptr<apriltag_detector_t, AprilTagDetectorDeleter>;
 
-    void operator()(apriltag_family_t* family) const;
+// RAII owner of a detector's allocation arena; the arena itself lives until its
+// last allocation is freed
+struct AprilTagArenaDeleter {
+    void operator()(apriltag_arena_t* arena) const {
+        apriltag_arena_destroy(arena);
+    }
 };
 
-using AprilTagDetectorPtr = std::unique_ptr<apriltag_detector_t, AprilTagDetectorDeleter>;
-using AprilTagFamilyPtr = std::unique_ptr<apriltag_family_t, AprilTagFamilyDeleter>;
+using AprilTagArenaPtr = std::unique_ptr<apriltag_arena_t, AprilTagArenaDeleter>;
+
+// Serves the calling thread's apriltag allocations from an arena for the scope
+class AprilTagArenaScope {
+public:
+    explicit AprilTagArenaScope(apriltag_arena_t* arena) { apriltag_arena_bind(arena); }
+    ~AprilTagArenaScope() { apriltag_arena_bind(nullptr); }
+
+    AprilTagArenaScope(const AprilTagArenaScope&) = delete;
+    AprilTagArenaScope& operator=(const AprilTagArenaScope&) = delete;
+};
 
 // RAII wrapper for apriltag_pose_t matrices
 class PoseMatrixGuard {
@@ -57,7 +66,9 @@ private:
 // Structure to hold a single tag detection with pose info
 struct TagDetection {
     int id;
+    size_t familyIndex = 0;            // Index into the pipeline's decoded families
     double decisionMargin;
+    int hamming = 0;
     std::vector<cv::Point2f> corners;  // Image corners
     cv::Point2d center;
     std::optional<Pose3d> cameraPose;  // Pose of tag in camera frame
@@ -73,6 +84,29 @@ struct MultiTagResult {
     std::vector<int> tagIds;    // IDs of tags used
 };
 
+// A family registered with the detector, with its physical size and field layout
+struct AprilTagFamilySlot {
+    std::string name;
+    std::shared_ptr<apriltag_family_t> family;  // Shared with other pipelines via the cache
+    double tagSize = 0.1524;
+    std::optional<FieldLayout> fieldLayout;  // Family-specific layout
+    bool primary = false;                    // The config's `family`; only it falls back to the selected field
+    std::vector<cv::Point3f> objectPoints;   // Tag corners for solvePnP, sized once at build
+    std::vector<cv::Point3f> cubePoints;     // Annotation cube, sized once at build
+};
+
+using AprilTagFamilySet = std::vector<AprilTagFamilySlot>;
+
+// Detect-stage output: decoded tags plus the families they were decoded against,
+// so a reconfiguration between the stages cannot mismatch sizes or layouts
+struct AprilTagStagedFrame : StagedFrame {
+    cv::Mat frame;
+    std::shared_ptr<const AprilTagFamilySet> families;
+    std::vector<TagDetection> tags;
+    double ransacReprojThreshold = 0;
+    apriltag_arena_stats_t arenaStats{};
+};
+
 class AprilTagPipeline : public BasePipeline {
 public:
     AprilTagPipeline();
@@ -82,6 +116,13 @@ public:
     PipelineResult process(const cv::Mat& frame,
                           const std::optional<cv::Mat>& depth = std::nullopt) override;
 
+    // Detection runs under the detector lock; per-tag PnP, annotation and the
+    // multi-tag solve run under a separate lock, so the two overlap across frames
+    bool isStaged() const override { return true; }
+    std::unique_ptr<StagedFrame> detectStage(const cv::Mat& frame,
+                                             const std::optional<cv::Mat>& depth) override;
+    PipelineResult finishStage(std::unique_ptr<StagedFrame> staged) override;
+
     void updateConfig(const nlohmann::json& config) override;
 
     PipelineType type() const override { return PipelineType::AprilTag; }
@@ -93,16 +134,36 @@ public:
     // Set field layout for multi-tag pose estimation
     void setFieldLayout(const FieldLayout& layout);
 
+    // Detection runs on grayscale; pose needs the calibrated resolution
+    CaptureRequirements captureRequirements() const override;
+    ExposureClass preferredExposure() const override { return ExposureClass::Short; }
+
+    // Each level adds 1.0 to quad_decimate
+    void setLoadShedding(int level) override { loadShedding_.store((std::max)(0, level)); }
+
 private:
     AprilTagConfig config_;
 
-    // AprilTag detector and family (RAII managed)
+    // Serves the detector's allocations, including its worker threads'; declared
+    // first so it outlives the detector
+    AprilTagArenaPtr arena_;
+    int64_t arenaReservedBytes_ = 0;  // Last reserved size reported to MemoryTracker
+
+    // AprilTag detector and its families (RAII managed); all families decode in one pass
     AprilTagDetectorPtr detector_;
-    AprilTagFamilyPtr family_;
+    std::shared_ptr<const AprilTagFamilySet> families_;
 
-    // Mutex for thread safety during reconfiguration
+    // Guards the detector, families, config and gray_ (detect stage and reconfiguration)
     std::mutex mutex_;
+    // Guards the pose scratch and previous pose (finish stage)
+    std::mutex solveMutex_;
+
+    std::atomic<int> loadShedding_{0};
 
+    // Per-frame scratch reused across frames
+    cv::Mat gray_;
+    std::vector<cv::Point2f> imagePoints_;
+    std::vector<cv::Point2f> cubeImagePoints_;
 
     // Field layout for multi-tag pose
     std::optional<FieldLayout> fieldLayout_;
@@ -112,14 +173,21 @@ private:
     bool hasPrevPose_ = false;
 
     void initializeDetector();
-    AprilTagFamilyPtr createFamily(const std::string& familyName);
+
+    // Build a configured detector with every family in the config added
+    AprilTagDetectorPtr buildDetector(const AprilTagConfig& config, AprilTagFamilySet& families);
+
+    // Layout used for a family: its own, the selected field for the primary family, else none
+    const FieldLayout* layoutFor(const AprilTagFamilySet& families, size_t familyIndex) const;
 
     // Multi-tag pose estimation
-    MultiTagResult solveMultiTagPose(const std::vector<TagDetection>& detections,
-                                     const cv::Size& imageSize);
+    MultiTagResult solveMultiTagPose(const AprilTagFamilySet& families,
+                                     const std::vector<TagDetection>& detections,
+                                     double ransacReprojThreshold);
 
     // Get 3D corners of a tag in field coordinates
-    std::vector<cv::Point3f> getTagCornersInField(int tagId) const;
+    std::vector<cv::Point3f> getTagCornersInField(const AprilTagFamilySet& families,
+                                                  size_t familyIndex, int tagId) const;
 };
 
 } // namespace vision
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "utils/geometry.hpp"
+#include "drivers/capture_mode.hpp"
 #include "models/pipeline.hpp"
 #include "utils/frame_buffer.hpp"
 #include "vision/field_layout.hpp"
@@ -17,6 +18,14 @@ struct PipelineResult {
     double processingTimeMs = 0;
     std::optional<Pose3d> robotPose; // Global robot pose (if available)
     int tagsUsed = 0;           // Number of tags used for pose estimation
+    nlohmann::json extras;      // Pipeline-specific fields merged into the published results
+};
+
+// Work handed from a pipeline's detect stage to its finish stage
+struct StagedFrame {
+    virtual ~StagedFrame() = default;
+    double detectMs = 0;
+    int orientation = 0;  // Frame orientation at detect time, for the finish stage
 };
 
 class BasePipeline {
@@ -27,6 +36,21 @@ public:
     virtual PipelineResult process(const cv::Mat& frame,
                                    const std::optional<cv::Mat>& depth = std::nullopt) = 0;
 
+    // Staged pipelines split process() in two so the vision thread can detect
+    // frame N+1 while frame N is solved and published on a second thread.
+    // finishStage() is called once per detectStage(), in the same order.
+    virtual bool isStaged() const { return false; }
+    virtual std::unique_ptr<StagedFrame> detectStage(const cv::Mat& frame,
+                                                     const std::optional<cv::Mat>& depth) {
+        (void)frame;
+        (void)depth;
+        return nullptr;
+    }
+    virtual PipelineResult finishStage(std::unique_ptr<StagedFrame> staged) {
+        (void)staged;
+        return {};
+    }
+
     // Update pipeline configuration
     virtual void updateConfig(const nlohmann::json& config) = 0;
 
@@ -56,6 +80,21 @@ public:
     // Set field layout (for global pose estimation)
     virtual void setFieldLayout(const FieldLayout& layout) {}
 
+    // What this pipeline needs from the sensor; defaults to the configured color mode
+    virtual CaptureRequirements captureRequirements() const { return {}; }
+
+    // Frames to receive when the camera alternates exposures
+    virtual ExposureClass preferredExposure() const { return ExposureClass::Any; }
+
+    // Thermal governor: trade accuracy for CPU time at level > 0 (0 = as configured)
+    virtual void setLoadShedding(int level) { (void)level; }
+
+    // Rotation (0/90/180/270) still to apply to the next frame when the camera carries
+    // orientation as metadata. The pixels stay in sensor coordinates; pipelines report
+    // outputs and draw annotations in upright coordinates, where calibration lives.
+    // Set by the vision thread before each process() or detectStage().
+    void setFrameOrientation(int degrees) { frameOrientation_ = degrees; }
+
     bool hasCalibration() const { return hasCalibration_; }
 
     // Factory method
@@ -70,6 +109,7 @@ protected:
     cv::Mat cameraMatrix_;
     cv::Mat distCoeffs_;
     bool hasCalibration_ = false;
+    int frameOrientation_ = 0;
 };
 
 } // namespace vision
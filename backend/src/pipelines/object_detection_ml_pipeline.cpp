@@ -1,14 +1,45 @@
 #include "pipelines/object_detection_ml_pipeline.hpp"
+#include "pipelines/onnx_provider_selector.hpp"
+#include "metrics/memory.hpp"
+#include "hw/accel.hpp"
+#include "utils/orientation.hpp"
 #include <spdlog/spdlog.h>
 #include <filesystem>
 #include <fstream>
 #include <chrono>
 #include <algorithm>
 #include <numeric>
+#include <optional>
 #include <cmath>
+#include <cstring>
 
 namespace vision {
 
+namespace {
+
+// Largest YOLO downsampling stride (P5 models); dynamic input sides must be multiples of it
+constexpr int kYoloStride = 32;
+// Input shapes kept bound at once
+constexpr size_t kMaxInputBindings = 4;
+
+// Boxes, outlines and centroids from sensor to upright image coordinates
+void mapToUpright(Detection& det, int rotation, cv::Size sensor) {
+    cv::Point a = orientation::toUpright(cv::Point(det.x1, det.y1), rotation, sensor);
+    cv::Point b = orientation::toUpright(cv::Point(det.x2, det.y2), rotation, sensor);
+    det.x1 = (std::min)(a.x, b.x);
+    det.y1 = (std::min)(a.y, b.y);
+    det.x2 = (std::max)(a.x, b.x);
+    det.y2 = (std::max)(a.y, b.y);
+    for (auto& pt : det.contour) {
+        pt = orientation::toUpright(pt, rotation, sensor);
+    }
+    if (det.centroid) {
+        det.centroid = orientation::toUpright(*det.centroid, rotation, sensor);
+    }
+}
+
+} // namespace
+
 nlohmann::json Detection::toJson() const {
     nlohmann::json j = {
         {"label", label},
@@ -22,6 +53,16 @@ nlohmann::json Detection::toJson() const {
     if (td.has_value()) {
         j["td"] = td.value();
     }
+    if (!contour.empty()) {
+        nlohmann::json points = nlohmann::json::array();
+        for (const auto& pt : contour) {
+            points.push_back({pt.x, pt.y});
+        }
+        j["contour"] = points;
+    }
+    if (centroid.has_value()) {
+        j["centroid"] = {centroid->x, centroid->y};
+    }
     return j;
 }
 
@@ -35,32 +76,94 @@ OnnxYoloBackend::OnnxYoloBackend(
     float nmsIouThreshold,
     int maxDetections,
     const std::vector<std::string>& classNames,
-    const std::vector<std::string>& targetClasses)
-    : env_(ORT_LOGGING_LEVEL_WARNING, "ObjectDetection")
-    , imgSize_(imgSize)
+    const std::vector<std::string>& targetClasses,
+    int maskTopK,
+    float maskThreshold,
+    float contourEpsilon,
+    const OnnxProviderOptions& providerOptions)
+    : imgSize_(imgSize)
     , confThreshold_(confThreshold)
     , nmsIouThreshold_(nmsIouThreshold)
     , maxDetections_(maxDetections)
     , classNames_(classNames)
     , targetClasses_(targetClasses.begin(), targetClasses.end())
+    , maskTopK_(maskTopK)
+    , maskThreshold_(maskThreshold)
+    , contourEpsilon_(contourEpsilon)
 {
     Ort::SessionOptions sessionOptions;
     sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+    configureProvider(sessionOptions, provider, providerOptions);
+
+    // Create session; ORT 1.18 has no arena stats API, so RSS growth is the best estimate
+    RssGrowthEstimate loadEstimate;
+    // On Windows, Ort::Session requires wide string path
+#ifdef _WIN32
+    std::wstring wideModelPath(modelPath.begin(), modelPath.end());
+    session_ = std::make_unique<Ort::Session>(sharedEnv(), wideModelPath.c_str(), sessionOptions);
+#else
+    session_ = std::make_unique<Ort::Session>(sharedEnv(), modelPath.c_str(), sessionOptions);
+#endif
+    trackedBytes_ = loadEstimate.bytes();
+    if (!loadEstimate.measuring()) {
+        spdlog::debug("Another model was loading; {} not included in the model memory estimate", modelPath);
+    }
+    MemoryTracker::instance().counter(MemorySubsystem::Models).add(trackedBytes_);
+
+    // Get input name and shape
+    Ort::AllocatorWithDefaultOptions allocator;
+    auto inputNamePtr = session_->GetInputNameAllocated(0, allocator);
+    inputName_ = inputNamePtr.get();
+
+    auto inputTypeInfo = session_->GetInputTypeInfo(0);
+    auto tensorInfo = inputTypeInfo.GetTensorTypeAndShapeInfo();
+    inputShape_ = tensorInfo.GetShape();
 
-    // Configure execution provider
-    std::vector<std::string> providers;
-    providers.push_back(provider);
-    if (provider != "CPUExecutionProvider") {
-        providers.push_back("CPUExecutionProvider");
+    // Segmentation models add a 4D prototype output next to the detections
+    for (size_t i = 0; i < session_->GetOutputCount(); i++) {
+        auto outputNamePtr = session_->GetOutputNameAllocated(i, allocator);
+        outputNames_.push_back(outputNamePtr.get());
+        auto outputShape = session_->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+        if (i > 0 && outputShape.size() == 4 && protoOutput_ < 0) {
+            protoOutput_ = static_cast<int>(i);
+        }
     }
 
-    // Set up providers
+    spdlog::info("ONNX model loaded: {} with provider {}{}", modelPath, provider,
+                 isSegmentation() ? " (segmentation)" : "");
+    spdlog::debug("Input shape: [{}, {}, {}, {}]",
+                  inputShape_[0], inputShape_[1], inputShape_[2], inputShape_[3]);
+}
+
+Ort::Env& OnnxYoloBackend::sharedEnv() {
+    // Never destroyed: sessions owned by static singletons may be released after it would be
+    static Ort::Env* env = new Ort::Env(ORT_LOGGING_LEVEL_WARNING, "ObjectDetection");
+    return *env;
+}
+
+void OnnxYoloBackend::configureProvider(Ort::SessionOptions& sessionOptions,
+                                        const std::string& provider,
+                                        const OnnxProviderOptions& options) {
     if (provider == "CUDAExecutionProvider") {
         OrtCUDAProviderOptions cudaOptions;
         sessionOptions.AppendExecutionProvider_CUDA(cudaOptions);
     } else if (provider == "TensorrtExecutionProvider") {
-        OrtTensorRTProviderOptions trtOptions;
+        OrtTensorRTProviderOptions trtOptions{};
+        trtOptions.trt_fp16_enable = options.fp16 ? 1 : 0;
         sessionOptions.AppendExecutionProvider_TensorRT(trtOptions);
+    } else if (provider == "XnnpackExecutionProvider") {
+        // XNNPACK runs its own thread pool; ORT's intra-op pool would only spin against it.
+        // By default one thread per big core: on big.LITTLE the little cores hold the big ones back.
+        int threads = options.threads > 0 ? options.threads
+                                          : static_cast<int>(hw::probe().topology.performanceCores.size());
+        sessionOptions.SetIntraOpNumThreads(1);
+        sessionOptions.AddConfigEntry("session.intra_op.allow_spinning", "0");
+        sessionOptions.AppendExecutionProvider("XNNPACK", {{"intra_op_num_threads", std::to_string(threads)}});
+    } else if (provider == "OpenVINOExecutionProvider") {
+        OrtOpenVINOProviderOptions ovOptions{};
+        ovOptions.device_type = options.fp16 ? "CPU_FP16" : "CPU_FP32";
+        ovOptions.num_of_threads = static_cast<size_t>((std::max)(0, options.threads));
+        sessionOptions.AppendExecutionProvider_OpenVINO(ovOptions);
     }
 #ifdef __APPLE__
     else if (provider == "CoreMLExecutionProvider") {
@@ -70,45 +173,57 @@ OnnxYoloBackend::OnnxYoloBackend(
     }
 #endif
     // CPUExecutionProvider is always available as fallback
+    if (provider == "CPUExecutionProvider" && options.threads > 0) {
+        sessionOptions.SetIntraOpNumThreads(options.threads);
+    }
+}
 
-    // Create session
-    // On Windows, Ort::Session requires wide string path
-#ifdef _WIN32
-    std::wstring wideModelPath(modelPath.begin(), modelPath.end());
-    session_ = std::make_unique<Ort::Session>(env_, wideModelPath.c_str(), sessionOptions);
-#else
-    session_ = std::make_unique<Ort::Session>(env_, modelPath.c_str(), sessionOptions);
-#endif
+std::string OnnxYoloBackend::providerForAccelerator(const std::string& accelerator) {
+    if (accelerator == "cuda") return "CUDAExecutionProvider";
+    if (accelerator == "tensorrt") return "TensorrtExecutionProvider";
+    if (accelerator == "coreml") return "CoreMLExecutionProvider";
+    if (accelerator == "xnnpack") return "XnnpackExecutionProvider";
+    if (accelerator == "openvino") return "OpenVINOExecutionProvider";
+    return "CPUExecutionProvider";
+}
 
-    // Get input name and shape
-    Ort::AllocatorWithDefaultOptions allocator;
-    auto inputNamePtr = session_->GetInputNameAllocated(0, allocator);
-    inputName_ = inputNamePtr.get();
+OnnxYoloBackend::~OnnxYoloBackend() {
+    MemoryTracker::instance().counter(MemorySubsystem::Models).sub(trackedBytes_);
+}
 
-    auto inputTypeInfo = session_->GetInputTypeInfo(0);
-    auto tensorInfo = inputTypeInfo.GetTensorTypeAndShapeInfo();
-    inputShape_ = tensorInfo.GetShape();
+cv::Size OnnxYoloBackend::inputSizeFor(int frameWidth, int frameHeight) const {
+    int fixedHeight = inputShape_.size() == 4 ? static_cast<int>(inputShape_[2]) : imgSize_;
+    int fixedWidth = inputShape_.size() == 4 ? static_cast<int>(inputShape_[3]) : imgSize_;
+    if (fixedWidth > 0 && fixedHeight > 0) {
+        return {fixedWidth, fixedHeight};
+    }
 
-    spdlog::info("ONNX model loaded: {} with provider {}", modelPath, provider);
-    spdlog::debug("Input shape: [{}, {}, {}, {}]",
-                  inputShape_[0], inputShape_[1], inputShape_[2], inputShape_[3]);
+    // Long side to imgSize_, short side rounded up to the network stride (640x384 for 16:9)
+    float scale = (std::min)(static_cast<float>(imgSize_) / frameHeight,
+                             static_cast<float>(imgSize_) / frameWidth);
+    auto align = [](float v) {
+        return (std::max)(kYoloStride, static_cast<int>(std::ceil(v / kYoloStride)) * kYoloStride);
+    };
+    return {fixedWidth > 0 ? fixedWidth : align(frameWidth * scale),
+            fixedHeight > 0 ? fixedHeight : align(frameHeight * scale)};
 }
 
-std::tuple<cv::Mat, float, float, float> OnnxYoloBackend::letterboxImage(const cv::Mat& image) {
+std::tuple<cv::Mat, float, float, float> OnnxYoloBackend::letterboxImage(const cv::Mat& image,
+                                                                         const cv::Size& inputSize) {
     int origHeight = image.rows;
     int origWidth = image.cols;
 
-    float scale = std::min(static_cast<float>(imgSize_) / origHeight,
-                          static_cast<float>(imgSize_) / origWidth);
+    float scale = std::min(static_cast<float>(inputSize.height) / origHeight,
+                          static_cast<float>(inputSize.width) / origWidth);
 
-    int newWidth = static_cast<int>(origWidth * scale);
-    int newHeight = static_cast<int>(origHeight * scale);
+    int newWidth = (std::min)(inputSize.width, static_cast<int>(origWidth * scale));
+    int newHeight = (std::min)(inputSize.height, static_cast<int>(origHeight * scale));
 
     cv::Mat resized;
     cv::resize(image, resized, cv::Size(newWidth, newHeight), 0, 0, cv::INTER_LINEAR);
 
-    int padW = imgSize_ - newWidth;
-    int padH = imgSize_ - newHeight;
+    int padW = inputSize.width - newWidth;
+    int padH = inputSize.height - newHeight;
     float padLeft = padW / 2.0f;
     float padTop = padH / 2.0f;
 
@@ -123,6 +238,33 @@ std::tuple<cv::Mat, float, float, float> OnnxYoloBackend::letterboxImage(const c
     return {padded, scale, padLeft, padTop};
 }
 
+OnnxYoloBackend::InputBinding& OnnxYoloBackend::bindingFor(const cv::Size& inputSize) {
+    auto key = std::make_pair(inputSize.width, inputSize.height);
+    auto it = bindings_.find(key);
+    if (it != bindings_.end()) {
+        return it->second;
+    }
+
+    // One shape per camera resolution in practice; bound the cache if a camera keeps renegotiating
+    if (bindings_.size() >= kMaxInputBindings) {
+        bindings_.clear();
+    }
+
+    InputBinding& binding = bindings_[key];
+    binding.shape = {1, 3, inputSize.height, inputSize.width};
+    binding.data.resize(static_cast<size_t>(3) * inputSize.width * inputSize.height);
+    Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    binding.tensor = Ort::Value::CreateTensor<float>(
+        memInfo,
+        binding.data.data(),
+        binding.data.size(),
+        binding.shape.data(),
+        binding.shape.size()
+    );
+    spdlog::debug("ONNX input bound at {}x{}", inputSize.width, inputSize.height);
+    return binding;
+}
+
 std::vector<int> OnnxYoloBackend::nonMaxSuppression(
     const std::vector<cv::Rect>& boxes,
     const std::vector<float>& scores,
@@ -172,12 +314,14 @@ std::vector<Detection> OnnxYoloBackend::postprocessYolo(
     float padX,
     float padY,
     int origWidth,
-    int origHeight)
+    int origHeight,
+    int numMaskCoeffs,
+    std::vector<const float*>* maskCoeffs)
 {
-    // YOLOv5 output shape: [1, num_detections, 5 + num_classes]
-    // Each detection: [x, y, w, h, objectness, class_scores...]
+    // YOLOv5 output shape: [1, num_detections, 5 + num_classes (+ num_mask_coeffs)]
+    // Each detection: [x, y, w, h, objectness, class_scores..., mask_coeffs...]
     int numDetections = static_cast<int>(outputShape[1]);
-    int numClasses = static_cast<int>(outputShape[2]) - 5;
+    int numClasses = static_cast<int>(outputShape[2]) - 5 - numMaskCoeffs;
 
     if (numClasses <= 0) {
         spdlog::warn("Invalid output shape for YOLO postprocessing");
@@ -187,6 +331,7 @@ std::vector<Detection> OnnxYoloBackend::postprocessYolo(
     std::vector<cv::Rect> boxes;
     std::vector<float> scores;
     std::vector<int> classIds;
+    std::vector<const float*> coeffs;   // Points into the output; nothing is copied until NMS
 
     for (int i = 0; i < numDetections; ++i) {
         const float* det = output + i * outputShape[2];
@@ -238,6 +383,9 @@ std::vector<Detection> OnnxYoloBackend::postprocessYolo(
         ));
         scores.push_back(confidence);
         classIds.push_back(bestClass);
+        if (numMaskCoeffs > 0) {
+            coeffs.push_back(det + 5 + numClasses);
+        }
     }
 
     // Apply NMS
@@ -257,84 +405,185 @@ std::vector<Detection> OnnxYoloBackend::postprocessYolo(
         }
 
         const cv::Rect& box = boxes[idx];
-        detections.push_back({
-            label,
-            scores[idx],
-            box.x,
-            box.y,
-            box.x + box.width,
-            box.y + box.height
-        });
+        Detection detection;
+        detection.label = label;
+        detection.confidence = scores[idx];
+        detection.x1 = box.x;
+        detection.y1 = box.y;
+        detection.x2 = box.x + box.width;
+        detection.y2 = box.y + box.height;
+        detections.push_back(std::move(detection));
+        if (maskCoeffs && numMaskCoeffs > 0) {
+            maskCoeffs->push_back(coeffs[idx]);
+        }
     }
 
     return detections;
 }
 
 std::vector<Detection> OnnxYoloBackend::predict(const cv::Mat& frame) {
-    // Convert to RGB
+    // Convert to RGB (mono frames can still arrive while the camera renegotiates)
     cv::Mat rgb;
-    cv::cvtColor(frame, rgb, cv::COLOR_BGR2RGB);
+    cv::cvtColor(frame, rgb, frame.channels() == 1 ? cv::COLOR_GRAY2RGB : cv::COLOR_BGR2RGB);
 
-    // Letterbox
-    auto [padded, scale, padX, padY] = letterboxImage(rgb);
+    // Letterbox into the smallest input the model accepts for this frame size
+    cv::Size inputSize = inputSizeFor(frame.cols, frame.rows);
+    lastInputSize_ = inputSize;
+    auto [padded, scale, padX, padY] = letterboxImage(rgb, inputSize);
 
     // Normalize to [0, 1] and convert to float
     cv::Mat blob;
     padded.convertTo(blob, CV_32F, 1.0 / 255.0);
 
-    // Convert HWC to CHW
-    std::vector<cv::Mat> channels(3);
-    cv::split(blob, channels);
-
-    // Create input tensor
-    std::vector<float> inputTensor;
-    inputTensor.reserve(3 * imgSize_ * imgSize_);
+    // Convert HWC to CHW straight into the bound tensor's planes
+    InputBinding& binding = bindingFor(inputSize);
+    size_t planeSize = static_cast<size_t>(inputSize.width) * inputSize.height;
+    std::vector<cv::Mat> channels;
     for (int c = 0; c < 3; ++c) {
-        inputTensor.insert(inputTensor.end(),
-                          channels[c].begin<float>(),
-                          channels[c].end<float>());
+        channels.emplace_back(inputSize.height, inputSize.width, CV_32F, binding.data.data() + c * planeSize);
     }
-
-    // Create ONNX tensor
-    std::vector<int64_t> inputShape = {1, 3, imgSize_, imgSize_};
-    Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-    Ort::Value inputOrt = Ort::Value::CreateTensor<float>(
-        memInfo,
-        inputTensor.data(),
-        inputTensor.size(),
-        inputShape.data(),
-        inputShape.size()
-    );
+    cv::split(blob, channels);
+    Ort::Value& inputOrt = binding.tensor;
 
     // Run inference
     const char* inputNames[] = {inputName_.c_str()};
-    Ort::AllocatorWithDefaultOptions allocator;
-    auto outputNamePtr = session_->GetOutputNameAllocated(0, allocator);
-    const char* outputNames[] = {outputNamePtr.get()};
+    std::vector<const char*> outputNames;
+    outputNames.push_back(outputNames_[0].c_str());
+    if (isSegmentation()) {
+        outputNames.push_back(outputNames_[protoOutput_].c_str());
+    }
 
+    std::optional<RssGrowthEstimate> firstRunEstimate;
+    if (!firstRunMeasured_) {
+        firstRunEstimate.emplace();
+    }
     auto outputs = session_->Run(
         Ort::RunOptions{nullptr},
         inputNames,
         &inputOrt,
         1,
-        outputNames,
-        1
+        outputNames.data(),
+        outputNames.size()
     );
 
+    // The arena grows on the first run; count that growth against the model
+    if (!firstRunMeasured_) {
+        firstRunMeasured_ = true;
+        int64_t growth = firstRunEstimate->bytes();
+        firstRunEstimate.reset();
+        trackedBytes_ += growth;
+        MemoryTracker::instance().counter(MemorySubsystem::Models).add(growth, 0);
+    }
+
     // Get output data
     float* outputData = outputs[0].GetTensorMutableData<float>();
     auto outputShape = outputs[0].GetTensorTypeAndShapeInfo().GetShape();
 
-    // Postprocess
-    return postprocessYolo(
+    if (!isSegmentation()) {
+        // Postprocess
+        return postprocessYolo(
+            outputData,
+            outputShape,
+            scale,
+            padX,
+            padY,
+            frame.cols,
+            frame.rows
+        );
+    }
+
+    // Boxes and NMS first; masks only for what survives
+    const float* protoData = outputs[1].GetTensorData<float>();
+    auto protoShape = outputs[1].GetTensorTypeAndShapeInfo().GetShape();
+    std::vector<const float*> maskCoeffs;
+    auto detections = postprocessYolo(
         outputData,
         outputShape,
         scale,
         padX,
         padY,
         frame.cols,
-        frame.rows
+        frame.rows,
+        static_cast<int>(protoShape[1]),
+        &maskCoeffs
     );
+    decodeMasks(detections, maskCoeffs, protoData, protoShape, inputSize, scale, padX, padY);
+    return detections;
+}
+
+void OnnxYoloBackend::decodeMasks(
+    std::vector<Detection>& detections,
+    const std::vector<const float*>& maskCoeffs,
+    const float* protos,
+    const std::vector<int64_t>& protoShape,
+    const cv::Size& inputSize,
+    float scale,
+    float padX,
+    float padY)
+{
+    // Detections are in descending score order after NMS
+    int count = (std::min)(maskTopK_, static_cast<int>(detections.size()));
+    if (count <= 0 || protoShape.size() != 4) return;
+
+    int numCoeffs = static_cast<int>(protoShape[1]);
+    int maskH = static_cast<int>(protoShape[2]);
+    int maskW = static_cast<int>(protoShape[3]);
+
+    // All kept masks in one GEMM: [count x nm] * [nm x mh*mw]
+    cv::Mat coeffs(count, numCoeffs, CV_32F);
+    for (int i = 0; i < count; i++) {
+        std::memcpy(coeffs.ptr<float>(i), maskCoeffs[i], numCoeffs * sizeof(float));
+    }
+    cv::Mat protoMat(numCoeffs, maskH * maskW, CV_32F, const_cast<float*>(protos));
+    cv::Mat logits;
+    cv::gemm(coeffs, protoMat, 1.0, cv::noArray(), 0.0, logits);
+
+    // sigmoid(x) > t is x > log(t / (1 - t)), so the sigmoid is never evaluated
+    float t = std::clamp(maskThreshold_, 1e-4f, 1.0f - 1e-4f);
+    double logitThreshold = std::log(t / (1.0f - t));
+
+    // Prototype pixels to letterboxed input pixels
+    float sx = static_cast<float>(inputSize.width) / maskW;
+    float sy = static_cast<float>(inputSize.height) / maskH;
+    auto toImage = [&](float px, float py) {
+        return cv::Point2f(((px + 0.5f) * sx - padX) / scale, ((py + 0.5f) * sy - padY) / scale);
+    };
+
+    for (int i = 0; i < count; i++) {
+        auto& det = detections[i];
+
+        // Mask pixels outside the box are discarded, so only the box is thresholded
+        int bx1 = static_cast<int>(std::floor((det.x1 * scale + padX) / sx));
+        int by1 = static_cast<int>(std::floor((det.y1 * scale + padY) / sy));
+        int bx2 = static_cast<int>(std::ceil((det.x2 * scale + padX) / sx));
+        int by2 = static_cast<int>(std::ceil((det.y2 * scale + padY) / sy));
+        cv::Rect protoBox = cv::Rect(bx1, by1, bx2 - bx1, by2 - by1) & cv::Rect(0, 0, maskW, maskH);
+        if (protoBox.empty()) continue;
+
+        cv::Mat mask;
+        cv::compare(logits.row(i).reshape(1, maskH)(protoBox), logitThreshold, mask, cv::CMP_GT);
+
+        std::vector<std::vector<cv::Point>> contours;
+        cv::findContours(mask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE, protoBox.tl());
+        if (contours.empty()) continue;
+
+        auto largest = std::max_element(contours.begin(), contours.end(),
+            [](const auto& a, const auto& b) { return cv::contourArea(a) < cv::contourArea(b); });
+
+        cv::Moments m = cv::moments(*largest);
+        if (m.m00 > 0) {
+            det.centroid = toImage(static_cast<float>(m.m10 / m.m00), static_cast<float>(m.m01 / m.m00));
+        }
+
+        // Tolerance is given in image pixels; simplify at prototype resolution
+        std::vector<cv::Point> approx;
+        cv::approxPolyDP(*largest, approx, contourEpsilon_ * scale / sx, true);
+        det.contour.reserve(approx.size());
+        for (const auto& pt : approx) {
+            cv::Point2f p = toImage(static_cast<float>(pt.x), static_cast<float>(pt.y));
+            det.contour.emplace_back(cvRound(p.x), cvRound(p.y));
+        }
+    }
 }
 
 // ================== ObjectDetectionMLPipeline ==================
@@ -355,6 +604,15 @@ void ObjectDetectionMLPipeline::setFov(double horizontalFov, double verticalFov)
     verticalFov_ = verticalFov;
 }
 
+CaptureRequirements ObjectDetectionMLPipeline::captureRequirements() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The letterbox scales the long side to img_size, so anything wider is discarded
+    CaptureRequirements req;
+    req.fullResolution = false;
+    req.minWidth = config_.img_size;
+    return req;
+}
+
 std::optional<float> ObjectDetectionMLPipeline::sampleDepthAtPoint(const cv::Mat& depth, int x, int y) {
     if (depth.empty()) return std::nullopt;
 
@@ -382,11 +640,19 @@ std::optional<float> ObjectDetectionMLPipeline::sampleDepthAtPoint(const cv::Mat
     return std::nullopt;
 }
 
-void ObjectDetectionMLPipeline::calculateTargetingData(Detection& det, int frameWidth, int frameHeight,
+void ObjectDetectionMLPipeline::calculateTargetingData(Detection& det, cv::Size sensorSize, int rotation,
                                                          const std::optional<cv::Mat>& depth) {
-    // Calculate center of bounding box
+    cv::Size upright = orientation::uprightSize(sensorSize, rotation);
+    int frameWidth = upright.width;
+    int frameHeight = upright.height;
+
+    // Aim at the mask centroid when the model is segmenting, else the box center
     int cx = (det.x1 + det.x2) / 2;
     int cy = (det.y1 + det.y2) / 2;
+    if (det.centroid) {
+        cx = static_cast<int>(det.centroid->x);
+        cy = static_cast<int>(det.centroid->y);
+    }
 
     // Normalized offset from center (-1 to 1)
     float nx = (cx - frameWidth / 2.0f) / (frameWidth / 2.0f);
@@ -408,7 +674,8 @@ void ObjectDetectionMLPipeline::calculateTargetingData(Detection& det, int frame
 
     // Sample depth at center point if depth frame available
     if (depth.has_value()) {
-        det.td = sampleDepthAtPoint(depth.value(), cx, cy);
+        cv::Point sensor = orientation::toSensor(cv::Point(cx, cy), rotation, sensorSize);
+        det.td = sampleDepthAtPoint(depth.value(), sensor.x, sensor.y);
     }
 }
 
@@ -494,15 +761,14 @@ void ObjectDetectionMLPipeline::createBackend() {
     }
 
     try {
-        // Determine provider
-        std::string provider = "CPUExecutionProvider";
-        if (config_.accelerator == "cuda") {
-            provider = "CUDAExecutionProvider";
-        } else if (config_.accelerator == "tensorrt") {
-            provider = "TensorrtExecutionProvider";
-        } else if (config_.accelerator == "coreml") {
-            provider = "CoreMLExecutionProvider";
-        }
+        OnnxProviderOptions providerOptions;
+        providerOptions.threads = config_.provider_threads;
+        providerOptions.fp16 = config_.provider_fp16;
+
+        // Determine provider; "auto" benchmarks the available ones once per model
+        std::string provider = config_.accelerator == "auto"
+            ? OnnxProviderSelector::instance().select(modelPath, config_.img_size, providerOptions)
+            : providerForAccelerator(config_.accelerator);
 
         backend_ = std::make_unique<OnnxYoloBackend>(
             modelPath,
@@ -512,7 +778,11 @@ void ObjectDetectionMLPipeline::createBackend() {
             static_cast<float>(config_.nms_iou_threshold),
             config_.max_detections,
             classNames_,
-            config_.target_classes
+            config_.target_classes,
+            config_.mask_top_k,
+            static_cast<float>(config_.mask_threshold),
+            static_cast<float>(config_.contour_epsilon_px),
+            providerOptions
         );
 
         spdlog::info("Object Detection ML pipeline initialized successfully");
@@ -525,6 +795,16 @@ void ObjectDetectionMLPipeline::createBackend() {
 
 void ObjectDetectionMLPipeline::drawDetections(cv::Mat& frame, const std::vector<Detection>& detections) {
     for (const auto& det : detections) {
+        // Draw segmentation outline
+        if (!det.contour.empty()) {
+            const cv::Point* outline = det.contour.data();
+            int outlineSize = static_cast<int>(det.contour.size());
+            cv::polylines(frame, &outline, &outlineSize, 1, true, cv::Scalar(255, 0, 255), 2);
+        }
+        if (det.centroid) {
+            cv::circle(frame, *det.centroid, 4, cv::Scalar(255, 0, 255), -1);
+        }
+
         // Draw bounding box
         cv::rectangle(frame,
                      cv::Point(det.x1, det.y1),
@@ -553,9 +833,11 @@ PipelineResult ObjectDetectionMLPipeline::process(const cv::Mat& frame,
     PipelineResult result;
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    // Clone frame for annotation
-    result.annotatedFrame = frame.clone();
+    // Clone frame for annotation, turning a sensor-oriented frame upright in the same pass
+    int rotation = frameOrientation_;
+    result.annotatedFrame = orientation::uprightCopy(frame, rotation);
 
+    std::lock_guard<std::mutex> lock(mutex_);
     if (!backend_) {
         result.detections = nlohmann::json::array();
         if (!initError_.empty()) {
@@ -568,11 +850,12 @@ PipelineResult ObjectDetectionMLPipeline::process(const cv::Mat& frame,
         // Run detection
         std::vector<Detection> detections = backend_->predict(frame);
 
-        // Calculate targeting data for each detection
-        int frameWidth = frame.cols;
-        int frameHeight = frame.rows;
+        // Calculate targeting data for each detection, in upright coordinates
         for (auto& det : detections) {
-            calculateTargetingData(det, frameWidth, frameHeight, depth);
+            if (rotation != 0) {
+                mapToUpright(det, rotation, frame.size());
+            }
+            calculateTargetingData(det, frame.size(), rotation, depth);
         }
 
         // Convert to JSON
@@ -585,6 +868,21 @@ PipelineResult ObjectDetectionMLPipeline::process(const cv::Mat& frame,
         // Draw on annotated frame
         drawDetections(result.annotatedFrame, detections);
 
+        // Compute saved by not padding to the square input (convolutions scale with pixels).
+        // A fixed-shape model always runs its exported shape, so there is nothing to compare.
+        cv::Size input = backend_->lastInputSize();
+        bool dynamic = backend_->dynamicInput();
+        result.extras["inference"] = {
+            {"input_size", {input.width, input.height}},
+            {"dynamic", dynamic}
+        };
+        if (dynamic) {
+            int square = backend_->squareSize();
+            double savedPct = 100.0 * (1.0 - static_cast<double>(input.area()) / (static_cast<double>(square) * square));
+            result.extras["inference"]["square_size"] = square;
+            result.extras["inference"]["compute_saved_pct"] = (std::max)(0.0, savedPct);
+        }
+
     } catch (const std::exception& e) {
         spdlog::error("Error during ML inference: {}", e.what());
         result.detections = nlohmann::json::array();
@@ -597,9 +895,15 @@ PipelineResult ObjectDetectionMLPipeline::process(const cv::Mat& frame,
 }
 
 void ObjectDetectionMLPipeline::updateConfig(const nlohmann::json& configJson) {
-    config_ = ObjectDetectionMLConfig::fromJson(configJson);
-    loadLabels();
-    createBackend();
+    // Load the new model outside the lock so inference keeps running during a hot reload
+    ObjectDetectionMLPipeline staged(ObjectDetectionMLConfig::fromJson(configJson),
+                                     horizontalFov_, verticalFov_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = std::move(staged.config_);
+    classNames_ = std::move(staged.classNames_);
+    backend_ = std::move(staged.backend_);
+    initError_ = std::move(staged.initError_);
 }
 
 } // namespace vision
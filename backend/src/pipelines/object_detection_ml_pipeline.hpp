@@ -5,9 +5,11 @@
 #include <opencv2/opencv.hpp>
 #include <nlohmann/json.hpp>
 #include <onnxruntime_cxx_api.h>
+#include <map>
 #include <vector>
 #include <string>
 #include <memory>
+#include <mutex>
 
 namespace vision {
 
@@ -26,9 +28,19 @@ struct Detection {
     // Depth data (optional, for RealSense cameras)
     std::optional<float> td;  // Distance to target in meters
 
+    // Segmentation data (YOLO-seg models, top detections only)
+    std::vector<cv::Point> contour;         // Simplified outline in image pixels
+    std::optional<cv::Point2f> centroid;    // Mask centroid in image pixels
+
     nlohmann::json toJson() const;
 };
 
+// Execution provider tuning from the pipeline config
+struct OnnxProviderOptions {
+    int threads = 0;      // Inference threads (0 = provider default)
+    bool fp16 = false;    // Reduced precision where the provider supports it (OpenVINO, TensorRT)
+};
+
 // ONNX YOLO backend
 class OnnxYoloBackend {
 public:
@@ -39,15 +51,55 @@ public:
                     float nmsIouThreshold,
                     int maxDetections,
                     const std::vector<std::string>& classNames,
-                    const std::vector<std::string>& targetClasses);
+                    const std::vector<std::string>& targetClasses,
+                    int maskTopK = 10,
+                    float maskThreshold = 0.5f,
+                    float contourEpsilon = 2.0f,
+                    const OnnxProviderOptions& providerOptions = {});
+    ~OnnxYoloBackend();
+
+    // Process-wide ONNX Runtime environment shared by every session, benchmarks included
+    static Ort::Env& sharedEnv();
+
+    // Register a provider (and its options) on session options; CPU stays the fallback
+    static void configureProvider(Ort::SessionOptions& sessionOptions,
+                                  const std::string& provider,
+                                  const OnnxProviderOptions& options);
+
+    // ONNX Runtime provider name for an accelerator config value ("auto" excluded)
+    static std::string providerForAccelerator(const std::string& accelerator);
+
+    // Model has a prototype-mask output (YOLO-seg)
+    bool isSegmentation() const { return protoOutput_ >= 0; }
 
     std::vector<Detection> predict(const cv::Mat& frame);
 
+    // Network input used for a frame size: the configured square for fixed-shape models,
+    // or the smallest stride-aligned rectangle that fits the frame for dynamic ones
+    cv::Size inputSizeFor(int frameWidth, int frameHeight) const;
+
+    // Input shape of the last predict() and the square it replaced
+    cv::Size lastInputSize() const { return lastInputSize_; }
+    int squareSize() const { return imgSize_; }
+
+    // Model takes a per-frame height or width; fixed-shape models always run their exported shape
+    bool dynamicInput() const {
+        return inputShape_.size() != 4 || inputShape_[2] <= 0 || inputShape_[3] <= 0;
+    }
+
 private:
+    // Preallocated input tensor for one input shape, reused across frames
+    struct InputBinding {
+        std::vector<float> data;
+        std::vector<int64_t> shape;
+        Ort::Value tensor{nullptr};
+    };
+
     std::unique_ptr<Ort::Session> session_;
-    Ort::Env env_;
     std::string inputName_;
     std::vector<int64_t> inputShape_;
+    std::vector<std::string> outputNames_;
+    int protoOutput_ = -1;      // Index of the [1, nm, mh, mw] prototype output, -1 for box-only models
 
     int imgSize_;
     float confThreshold_;
@@ -55,11 +107,23 @@ private:
     int maxDetections_;
     std::vector<std::string> classNames_;
     std::set<std::string> targetClasses_;
+    int maskTopK_;
+    float maskThreshold_;
+    float contourEpsilon_;
+
+    std::map<std::pair<int, int>, InputBinding> bindings_;  // Keyed by (width, height)
+    cv::Size lastInputSize_;
+
+    // Estimated session memory (RSS growth at load and first run) reported to MemoryTracker
+    int64_t trackedBytes_ = 0;
+    bool firstRunMeasured_ = false;
 
     // Preprocessing
-    std::tuple<cv::Mat, float, float, float> letterboxImage(const cv::Mat& image);
+    std::tuple<cv::Mat, float, float, float> letterboxImage(const cv::Mat& image, const cv::Size& inputSize);
+    InputBinding& bindingFor(const cv::Size& inputSize);
 
-    // Postprocessing
+    // Postprocessing; maskCoeffs receives each kept detection's mask coefficients
+    // when numMaskCoeffs > 0
     std::vector<Detection> postprocessYolo(
         const float* output,
         const std::vector<int64_t>& outputShape,
@@ -67,7 +131,20 @@ private:
         float padX,
         float padY,
         int origWidth,
-        int origHeight);
+        int origHeight,
+        int numMaskCoeffs = 0,
+        std::vector<const float*>* maskCoeffs = nullptr);
+
+    // Masks for the first maskTopK_ detections at prototype resolution, reduced to contours
+    void decodeMasks(
+        std::vector<Detection>& detections,
+        const std::vector<const float*>& maskCoeffs,
+        const float* protos,
+        const std::vector<int64_t>& protoShape,
+        const cv::Size& inputSize,
+        float scale,
+        float padX,
+        float padY);
 
     // Non-maximum suppression
     std::vector<int> nonMaxSuppression(
@@ -93,6 +170,10 @@ public:
     // Update FOV settings (called when camera FOV changes)
     void setFov(double horizontalFov, double verticalFov);
 
+    // Needs color, but never more pixels than the letterboxed input
+    CaptureRequirements captureRequirements() const override;
+    ExposureClass preferredExposure() const override { return ExposureClass::Long; }
+
 private:
     ObjectDetectionMLConfig config_;
     std::unique_ptr<OnnxYoloBackend> backend_;
@@ -100,6 +181,7 @@ private:
     std::string initError_;
     double horizontalFov_ = 60.0;  // degrees
     double verticalFov_ = 45.0;    // degrees
+    mutable std::mutex mutex_;     // Guards backend_/config_ against hot reloads
 
     void loadLabels();
     void createBackend();
@@ -109,8 +191,9 @@ private:
     // Draw detections on frame
     void drawDetections(cv::Mat& frame, const std::vector<Detection>& detections);
 
-    // Calculate targeting data for a detection
-    void calculateTargetingData(Detection& det, int frameWidth, int frameHeight,
+    // Calculate targeting data for a detection already in upright coordinates;
+    // depth is sampled back in the sensor coordinates it shares with the frame
+    void calculateTargetingData(Detection& det, cv::Size sensorSize, int rotation,
                                  const std::optional<cv::Mat>& depth);
 
     // Sample depth at a point (returns distance in meters, or nullopt if invalid)
@@ -0,0 +1,232 @@
+#include "pipelines/onnx_provider_selector.hpp"
+#include "services/job_service.hpp"
+#include "services/pipeline_service.hpp"
+#include "services/settings_service.hpp"
+#include "hw/accel.hpp"
+#include "utils/sha256.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+namespace vision {
+
+namespace {
+
+constexpr int kWarmupRuns = 2;
+constexpr int kTimedRuns = 5;
+
+// Settings key for a model file, its input size, the options and the providers on offer.
+// Replacing the model or installing a new provider invalidates the decision.
+std::string cacheKey(const std::string& modelPath, int imgSize, const OnnxProviderOptions& options,
+                     const std::vector<std::string>& providers) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(modelPath, ec);
+    auto mtime = std::filesystem::last_write_time(modelPath, ec).time_since_epoch().count();
+
+    std::string identity = modelPath + "|" + std::to_string(size) + "|" + std::to_string(mtime) + "|" +
+                           std::to_string(imgSize) + "|" + std::to_string(options.threads) + "|" +
+                           (options.fp16 ? "fp16" : "fp32");
+    for (const auto& provider : providers) {
+        identity += "|" + provider;
+    }
+
+    Sha256 hash;
+    hash.update(identity.data(), identity.size());
+    return "onnx_provider." + hash.hexDigest().substr(0, 16);
+}
+
+} // namespace
+
+nlohmann::json ProviderBenchmark::toJson() const {
+    return {
+        {"model", std::filesystem::path(modelPath).filename().string()},
+        {"img_size", imgSize},
+        {"provider", provider},
+        {"median_ms", medianMs}
+    };
+}
+
+OnnxProviderSelector& OnnxProviderSelector::instance() {
+    static OnnxProviderSelector instance;
+    return instance;
+}
+
+std::string OnnxProviderSelector::select(const std::string& modelPath, int imgSize,
+                                         const OnnxProviderOptions& options) {
+    // TensorRT engine builds take minutes; it is only used when chosen explicitly
+    std::vector<std::string> providers;
+    for (const auto& provider : hw::getAvailableOnnxProviders()) {
+        if (provider != "TensorrtExecutionProvider") {
+            providers.push_back(provider);
+        }
+    }
+
+    std::string key = cacheKey(modelPath, imgSize, options, providers);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+        return it->second.provider;
+    }
+
+    // Decided on a previous run
+    if (auto stored = SettingsService::instance().get(key)) {
+        try {
+            auto j = nlohmann::json::parse(*stored);
+            ProviderBenchmark result;
+            result.modelPath = modelPath;
+            result.imgSize = imgSize;
+            result.provider = j.at("provider").get<std::string>();
+            result.medianMs = j.value("median_ms", std::map<std::string, double>{});
+            cache_[key] = result;
+            spdlog::info("Using cached provider {} for {}", result.provider, modelPath);
+            return result.provider;
+        } catch (const std::exception& e) {
+            spdlog::warn("Ignoring cached provider decision for {}: {}", modelPath, e.what());
+        }
+    }
+
+    // Loading and timing a session per provider takes seconds; never do it on the caller's thread
+    if (pending_.insert(key).second) {
+        auto jobId = JobService::instance().submit(
+            "provider_benchmark",
+            [this, key, modelPath, imgSize, options, providers](JobContext& job) {
+                job.progress(0.0, "Benchmarking " + std::filesystem::path(modelPath).filename().string());
+                runBenchmark(key, modelPath, imgSize, options, providers);
+                std::lock_guard<std::mutex> lock(mutex_);
+                return cache_.at(key).toJson();
+            });
+        if (jobId) {
+            spdlog::info("Benchmarking providers for {} (job {}); using CPU until it finishes", modelPath, *jobId);
+        } else {
+            pending_.erase(key);
+            spdlog::warn("Job queue full; {} uses CPU until it is next loaded", modelPath);
+        }
+    }
+    return "CPUExecutionProvider";
+}
+
+void OnnxProviderSelector::runBenchmark(const std::string& key, const std::string& modelPath, int imgSize,
+                                        const OnnxProviderOptions& options,
+                                        const std::vector<std::string>& providers) {
+    ProviderBenchmark result;
+    {
+        std::lock_guard<std::mutex> lock(benchmarkMutex_);
+        result = benchmark(modelPath, imgSize, options, providers);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_[key] = result;
+        pending_.erase(key);
+    }
+    SettingsService::instance().set(key, nlohmann::json{
+        {"provider", result.provider},
+        {"median_ms", result.medianMs}
+    }.dump());
+
+    // Pipelines started on the interim CPU provider pick up the decision
+    auto filename = std::filesystem::path(modelPath).filename().string();
+    for (const auto& pipeline : PipelineService::instance().getAllPipelines()) {
+        if (pipeline.pipeline_type != PipelineType::ObjectDetectionML) {
+            continue;
+        }
+        auto config = pipeline.getObjectDetectionMLConfig();
+        if (config.accelerator == "auto" &&
+            std::filesystem::path(config.model_filename).filename().string() == filename &&
+            result.provider != "CPUExecutionProvider") {
+            PipelineService::instance().reloadPipeline(pipeline.id);
+        }
+    }
+}
+
+ProviderBenchmark OnnxProviderSelector::benchmark(const std::string& modelPath, int imgSize,
+                                                  const OnnxProviderOptions& options,
+                                                  const std::vector<std::string>& providers) {
+    ProviderBenchmark result;
+    result.modelPath = modelPath;
+    result.imgSize = imgSize;
+    result.provider = "CPUExecutionProvider";
+
+    Ort::Env& env = OnnxYoloBackend::sharedEnv();
+    double bestMs = 0;
+
+    for (const auto& provider : providers) {
+        try {
+            Ort::SessionOptions sessionOptions;
+            sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+            OnnxYoloBackend::configureProvider(sessionOptions, provider, options);
+#ifdef _WIN32
+            std::wstring wideModelPath(modelPath.begin(), modelPath.end());
+            Ort::Session session(env, wideModelPath.c_str(), sessionOptions);
+#else
+            Ort::Session session(env, modelPath.c_str(), sessionOptions);
+#endif
+
+            // Constant input at the configured size; dynamic dims become 1 x 3 x size x size
+            auto shape = session.GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+            if (shape.size() == 4) {
+                if (shape[0] <= 0) shape[0] = 1;
+                if (shape[1] <= 0) shape[1] = 3;
+                if (shape[2] <= 0) shape[2] = imgSize;
+                if (shape[3] <= 0) shape[3] = imgSize;
+            } else {
+                shape = {1, 3, imgSize, imgSize};
+            }
+            size_t elements = 1;
+            for (auto dim : shape) elements *= static_cast<size_t>(dim);
+            std::vector<float> input(elements, 0.5f);
+
+            Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+            Ort::Value inputOrt = Ort::Value::CreateTensor<float>(
+                memInfo, input.data(), input.size(), shape.data(), shape.size());
+
+            Ort::AllocatorWithDefaultOptions allocator;
+            auto inputNamePtr = session.GetInputNameAllocated(0, allocator);
+            const char* inputNames[] = {inputNamePtr.get()};
+            std::vector<Ort::AllocatedStringPtr> outputNamePtrs;
+            std::vector<const char*> outputNames;
+            for (size_t i = 0; i < session.GetOutputCount(); i++) {
+                outputNamePtrs.push_back(session.GetOutputNameAllocated(i, allocator));
+                outputNames.push_back(outputNamePtrs.back().get());
+            }
+
+            std::vector<double> timings;
+            for (int run = 0; run < kWarmupRuns + kTimedRuns; run++) {
+                auto start = std::chrono::steady_clock::now();
+                session.Run(Ort::RunOptions{nullptr}, inputNames, &inputOrt, 1,
+                            outputNames.data(), outputNames.size());
+                auto end = std::chrono::steady_clock::now();
+                if (run >= kWarmupRuns) {
+                    timings.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                }
+            }
+
+            std::nth_element(timings.begin(), timings.begin() + timings.size() / 2, timings.end());
+            double median = timings[timings.size() / 2];
+            result.medianMs[provider] = median;
+            spdlog::info("Provider benchmark {}: {} {:.1f} ms", modelPath, provider, median);
+
+            if (bestMs == 0 || median < bestMs) {
+                bestMs = median;
+                result.provider = provider;
+            }
+        } catch (const std::exception& e) {
+            spdlog::warn("Provider {} unavailable for {}: {}", provider, modelPath, e.what());
+        }
+    }
+
+    spdlog::info("Selected {} for {}", result.provider, modelPath);
+    return result;
+}
+
+nlohmann::json OnnxProviderSelector::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json decisions = nlohmann::json::array();
+    for (const auto& [key, result] : cache_) {
+        decisions.push_back(result.toJson());
+    }
+    return decisions;
+}
+
+} // namespace vision
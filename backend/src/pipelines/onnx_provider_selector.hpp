@@ -0,0 +1,52 @@
+#pragma once
+
+#include "pipelines/object_detection_ml_pipeline.hpp"
+#include <nlohmann/json.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+// Outcome of benchmarking one model across the available providers
+struct ProviderBenchmark {
+    std::string modelPath;
+    int imgSize = 0;
+    std::string provider;                      // Fastest provider
+    std::map<std::string, double> medianMs;    // Per provider; providers that failed to load are absent
+
+    nlohmann::json toJson() const;
+};
+
+// Picks the fastest ONNX Runtime provider for a model with a short micro-benchmark.
+// Decisions are cached in memory and in settings, so each model is only measured once.
+class OnnxProviderSelector {
+public:
+    static OnnxProviderSelector& instance();
+
+    // Fastest available provider for the model. An unmeasured model gets the CPU provider
+    // while a benchmark job runs on the job pool; "auto" pipelines using it reload once decided.
+    std::string select(const std::string& modelPath, int imgSize, const OnnxProviderOptions& options);
+
+    nlohmann::json toJson() const;
+
+private:
+    OnnxProviderSelector() = default;
+
+    ProviderBenchmark benchmark(const std::string& modelPath, int imgSize,
+                                const OnnxProviderOptions& options,
+                                const std::vector<std::string>& providers);
+
+    // Benchmark on the job pool, store the decision and reload the pipelines waiting for it
+    void runBenchmark(const std::string& key, const std::string& modelPath, int imgSize,
+                      const OnnxProviderOptions& options, const std::vector<std::string>& providers);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, ProviderBenchmark> cache_;
+    std::set<std::string> pending_;   // Keys with a benchmark job queued or running
+    std::mutex benchmarkMutex_;       // Serializes benchmarks so they don't skew each other
+};
+
+} // namespace vision
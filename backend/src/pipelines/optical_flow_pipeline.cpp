@@ -1,4 +1,5 @@
 #include "pipelines/optical_flow_pipeline.hpp"
+#include "utils/orientation.hpp"
 #include <spdlog/spdlog.h>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -11,6 +12,20 @@
 
 namespace vision {
 
+namespace {
+
+// Tracked features in the upright annotation frame
+std::vector<cv::Point2f> uprightPoints(const std::vector<cv::Point2f>& points, int rotation, cv::Size sensor) {
+    std::vector<cv::Point2f> out;
+    out.reserve(points.size());
+    for (const auto& pt : points) {
+        out.push_back(orientation::toUpright(pt, rotation, sensor));
+    }
+    return out;
+}
+
+} // namespace
+
 OpticalFlowPipeline::OpticalFlowPipeline() : config_() {
     spdlog::info("OpticalFlowPipeline created with default config");
 }
@@ -32,6 +47,12 @@ OpticalFlowResult OpticalFlowPipeline::getFlowResult() const {
     return lastResult_;
 }
 
+CaptureRequirements OpticalFlowPipeline::captureRequirements() const {
+    CaptureRequirements req;
+    req.monoOk = true;
+    return req;
+}
+
 void OpticalFlowPipeline::detectFeatures(const cv::Mat& gray) {
     prevPoints_.clear();
     cv::goodFeaturesToTrack(
@@ -295,7 +316,9 @@ void OpticalFlowPipeline::drawVisualization(cv::Mat& frame,
 PipelineResult OpticalFlowPipeline::process(const cv::Mat& frame,
                                              const std::optional<cv::Mat>& /*depth*/) {
     PipelineResult result;
-    result.annotatedFrame = frame.clone();
+    // Turn a sensor-oriented frame upright in the annotation copy; flow stays in sensor pixels
+    int rotation = frameOrientation_;
+    result.annotatedFrame = orientation::uprightCopy(frame, rotation);
 
     auto now = std::chrono::steady_clock::now();
     frameCount_++;
@@ -328,7 +351,7 @@ PipelineResult OpticalFlowPipeline::process(const cv::Mat& frame,
         };
         result.processingTimeMs = 0;
 
-        drawVisualization(result.annotatedFrame, prevPoints_, 0, 0, 0, false);
+        drawVisualization(result.annotatedFrame, uprightPoints(prevPoints_, rotation, frame.size()), 0, 0, 0, false);
 
         std::lock_guard<std::mutex> lock(mutex_);
         lastResult_ = OpticalFlowResult{};
@@ -381,8 +404,11 @@ PipelineResult OpticalFlowPipeline::process(const cv::Mat& frame,
     double vx_mps = 0.0, vy_mps = 0.0;
 
     if (valid) {
+        // Mean flow into the upright image the calibration and mounting yaw refer to
+        cv::Point2d flow = orientation::vectorToUpright(cv::Point2d(dx_px, dy_px), rotation);
+
         // Convert pixel displacement to robot-frame velocity
-        pixelToRobotVelocity(dx_px, dy_px, dt, vx_mps, vy_mps);
+        pixelToRobotVelocity(flow.x, flow.y, dt, vx_mps, vy_mps);
 
         // Check velocity magnitude
         double speed = std::sqrt(vx_mps * vx_mps + vy_mps * vy_mps);
@@ -405,7 +431,8 @@ PipelineResult OpticalFlowPipeline::process(const cv::Mat& frame,
     prevTimestamp_ = now;
 
     // Draw visualization
-    drawVisualization(result.annotatedFrame, prevPoints_, vx_mps, vy_mps, validVectors, valid);
+    drawVisualization(result.annotatedFrame, uprightPoints(prevPoints_, rotation, frame.size()),
+                      vx_mps, vy_mps, validVectors, valid);
 
     // Build result JSON
     result.detections = {
@@ -35,6 +35,11 @@ public:
     // Get latest flow result (thread-safe)
     OpticalFlowResult getFlowResult() const;
 
+    // Tracks grayscale features; pixel scale is tied to the focal length
+    CaptureRequirements captureRequirements() const override;
+    // Brightness must not change between tracked frames; short exposure also blurs less
+    ExposureClass preferredExposure() const override { return ExposureClass::Short; }
+
 private:
     OpticalFlowConfig config_;
     mutable std::mutex mutex_;
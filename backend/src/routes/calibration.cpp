@@ -2,7 +2,9 @@
 #include "platform/win32_compat.hpp"
 
 #include "routes/calibration.hpp"
+#include "routes/jobs.hpp"
 #include "services/camera_service.hpp"
+#include "services/job_service.hpp"
 #include "threads/thread_manager.hpp"
 #include <spdlog/spdlog.h>
 #include <opencv2/objdetect/aruco_detector.hpp>
@@ -228,7 +230,8 @@ nlohmann::json CalibrationService::calibrate(
     const std::vector<std::vector<int>>& allIds,
     const cv::Size& imageSize,
     int squaresX, int squaresY,
-    float squareLength, float markerLength) {
+    float squareLength, float markerLength,
+    const std::function<void(double, const std::string&)>& progress) {
 
     nlohmann::json result;
     result["success"] = false;
@@ -247,6 +250,8 @@ nlohmann::json CalibrationService::calibrate(
         dict
     );
 
+    if (progress) progress(0.1, "Matching board points");
+
     // Collect object points and image points
     std::vector<std::vector<cv::Point3f>> allObjPoints;
     std::vector<std::vector<cv::Point2f>> allImgPoints;
@@ -267,6 +272,11 @@ nlohmann::json CalibrationService::calibrate(
         return result;
     }
 
+    // calibrateCamera has no progress hook; report the solve as one step
+    if (progress) {
+        progress(0.3, "Solving camera model from " + std::to_string(allObjPoints.size()) + " frames");
+    }
+
     // Calibrate camera
     cv::Mat cameraMatrix, distCoeffs;
     std::vector<cv::Mat> rvecs, tvecs;
@@ -399,23 +409,30 @@ void CalibrationService::registerRoutes(drogon::HttpAppFramework& app) {
                 marginMm = std::stof(param);
             }
 
-            auto pdfBuffer = generateBoardPdf(squaresX, squaresY, squareLength, markerLength,
-                                               pageWidthMm, pageHeightMm, marginMm, dictionary);
+            // Rendering a print-resolution board takes a while; keep it off the IO loop
+            bool queued = JobService::instance().post(
+                [=]() {
+                    auto pdfBuffer = generateBoardPdf(squaresX, squaresY, squareLength, markerLength,
+                                                       pageWidthMm, pageHeightMm, marginMm, dictionary);
 
-            if (pdfBuffer.empty()) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(R"({"error": "Failed to generate PDF"})");
-                callback(resp);
-                return;
-            }
+                    if (pdfBuffer.empty()) {
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k500InternalServerError);
+                        resp->setContentTypeCode(CT_APPLICATION_JSON);
+                        resp->setBody(R"({"error": "Failed to generate PDF"})");
+                        callback(resp);
+                        return;
+                    }
 
-            auto resp = HttpResponse::newHttpResponse();
-            resp->setStatusCode(k200OK);
-            resp->setContentTypeString("application/pdf");
-            resp->setBody(std::string(pdfBuffer.begin(), pdfBuffer.end()));
-            callback(resp);
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k200OK);
+                    resp->setContentTypeString("application/pdf");
+                    resp->setBody(std::string(pdfBuffer.begin(), pdfBuffer.end()));
+                    callback(resp);
+                });
+            if (!queued) {
+                callback(JobsController::busyResponse());
+            }
         },
         {Get});
 
@@ -424,73 +441,91 @@ void CalibrationService::registerRoutes(drogon::HttpAppFramework& app) {
         "/api/calibration/detect",
         [](const HttpRequestPtr& req,
            std::function<void(const HttpResponsePtr&)>&& callback) {
+            nlohmann::json body;
             try {
-                auto body = nlohmann::json::parse(req->getBody());
+                body = nlohmann::json::parse(req->getBody());
+            } catch (const std::exception& e) {
+                nlohmann::json error = {{"error", e.what()}};
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k400BadRequest);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(error.dump());
+                callback(resp);
+                return;
+            }
 
-                // Check if camera_id is provided
-                cv::Mat image;
-                if (body.contains("camera_id")) {
-                    int cameraId = body.at("camera_id").get<int>();
-                    auto frame = ThreadManager::instance().getCameraFrame(cameraId);
-                    if (!frame || frame->empty()) {
+            // Charuco detection plus JPEG/base64 encoding runs on a compute thread
+            bool queued = JobService::instance().post([body, callback]() {
+                try {
+                    // Check if camera_id is provided
+                    cv::Mat image;
+                    if (body.contains("camera_id")) {
+                        int cameraId = body.at("camera_id").get<int>();
+                        auto frame = ThreadManager::instance().getCameraFrame(cameraId);
+                        if (!frame || frame->empty()) {
+                            auto resp = HttpResponse::newHttpResponse();
+                            resp->setStatusCode(k400BadRequest);
+                            resp->setContentTypeCode(CT_APPLICATION_JSON);
+                            resp->setBody(R"({"error": "Failed to capture frame from camera. Is it running?"})");
+                            callback(resp);
+                            return;
+                        }
+                        image = frame->upright().clone();
+                    } else {
                         auto resp = HttpResponse::newHttpResponse();
                         resp->setStatusCode(k400BadRequest);
                         resp->setContentTypeCode(CT_APPLICATION_JSON);
-                        resp->setBody(R"({"error": "Failed to capture frame from camera. Is it running?"})");
+                        resp->setBody(R"({"error": "Missing camera_id parameter"})");
                         callback(resp);
                         return;
                     }
-                    image = frame->color().clone();
-                } else {
+
+                    if (image.empty()) {
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k400BadRequest);
+                        resp->setContentTypeCode(CT_APPLICATION_JSON);
+                        resp->setBody(R"({"error": "Failed to decode image"})");
+                        callback(resp);
+                        return;
+                    }
+
+                    int squaresX = body.value("squaresX", 7);
+                    int squaresY = body.value("squaresY", 5);
+
+                    auto result = detectMarkers(image, squaresX, squaresY);
+
+                    // If we captured from camera, include the original image in the response
+                    if (body.contains("camera_id")) {
+                        std::vector<uchar> buffer;
+                        cv::imencode(".jpg", image, buffer);
+                        std::string bufferStr(buffer.begin(), buffer.end());
+                        result["original_image_base64"] = drogon::utils::base64Encode(
+                            reinterpret_cast<const unsigned char*>(bufferStr.data()), bufferStr.size());
+                    }
+
                     auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k400BadRequest);
+                    resp->setStatusCode(k200OK);
                     resp->setContentTypeCode(CT_APPLICATION_JSON);
-                    resp->setBody(R"({"error": "Missing camera_id parameter"})");
+                    resp->setBody(result.dump());
                     callback(resp);
-                    return;
-                }
 
-                if (image.empty()) {
+                } catch (const std::exception& e) {
+                    nlohmann::json error = {{"error", e.what()}};
                     auto resp = HttpResponse::newHttpResponse();
                     resp->setStatusCode(k400BadRequest);
                     resp->setContentTypeCode(CT_APPLICATION_JSON);
-                    resp->setBody(R"({"error": "Failed to decode image"})");
+                    resp->setBody(error.dump());
                     callback(resp);
-                    return;
                 }
-
-                int squaresX = body.value("squaresX", 7);
-                int squaresY = body.value("squaresY", 5);
-
-                auto result = detectMarkers(image, squaresX, squaresY);
-
-                // If we captured from camera, include the original image in the response
-                if (body.contains("camera_id")) {
-                    std::vector<uchar> buffer;
-                    cv::imencode(".jpg", image, buffer);
-                    std::string bufferStr(buffer.begin(), buffer.end());
-                    result["original_image_base64"] = drogon::utils::base64Encode(
-                        reinterpret_cast<const unsigned char*>(bufferStr.data()), bufferStr.size());
-                }
-
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k200OK);
-                resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(result.dump());
-                callback(resp);
-
-            } catch (const std::exception& e) {
-                nlohmann::json error = {{"error", e.what()}};
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k400BadRequest);
-                resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(error.dump());
-                callback(resp);
+            });
+            if (!queued) {
+                callback(JobsController::busyResponse());
             }
         },
         {Post});
 
-    // POST /api/calibration/calibrate - Perform calibration
+    // POST /api/calibration/calibrate - Start a calibration job; returns 202 with its ID.
+    // Progress and the result are pushed on the WebSocket "job" topic and via GET /api/jobs/{id}.
     app.registerHandler(
         "/api/calibration/calibrate",
         [](const HttpRequestPtr& req,
@@ -528,13 +563,24 @@ void CalibrationService::registerRoutes(drogon::HttpAppFramework& app) {
                 float squareLength = body.value("square_length", 0.04f);
                 float markerLength = body.value("marker_length", 0.03f);
 
-                auto result = calibrate(allCorners, allIds, imageSize,
-                                        squaresX, squaresY, squareLength, markerLength);
+                auto jobId = JobService::instance().submit(
+                    "calibration",
+                    [=](JobContext& job) {
+                        return calibrate(allCorners, allIds, imageSize,
+                                         squaresX, squaresY, squareLength, markerLength,
+                                         [&job](double fraction, const std::string& message) {
+                                             job.progress(fraction, message);
+                                         });
+                    });
+                if (!jobId) {
+                    callback(JobsController::busyResponse());
+                    return;
+                }
 
                 auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k200OK);
+                resp->setStatusCode(k202Accepted);
                 resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(result.dump());
+                resp->setBody(nlohmann::json{{"job_id", *jobId}}.dump());
                 callback(resp);
 
             } catch (const std::exception& e) {
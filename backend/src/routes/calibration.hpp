@@ -3,6 +3,8 @@
 #include <drogon/drogon.h>
 #include <opencv2/opencv.hpp>
 #include <nlohmann/json.hpp>
+#include <functional>
+#include <string>
 #include <vector>
 
 namespace vision {
@@ -26,12 +28,13 @@ public:
                                         int squaresX, int squaresY,
                                         const std::string& dictionary = "DICT_6X6_250");
 
-    // Calibrate camera from multiple detections
+    // Calibrate camera from multiple detections; progress receives (fraction, message)
     static nlohmann::json calibrate(const std::vector<std::vector<cv::Point2f>>& allCorners,
                                     const std::vector<std::vector<int>>& allIds,
                                     const cv::Size& imageSize,
                                     int squaresX, int squaresY,
-                                    float squareLength, float markerLength);
+                                    float squareLength, float markerLength,
+                                    const std::function<void(double, const std::string&)>& progress = nullptr);
 
     // Register calibration routes
     static void registerRoutes(drogon::HttpAppFramework& app);
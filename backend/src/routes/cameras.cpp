@@ -2,8 +2,11 @@
 #include "platform/win32_compat.hpp"
 
 #include "routes/cameras.hpp"
+#include "routes/jobs.hpp"
 #include "services/camera_service.hpp"
 #include "services/pipeline_service.hpp"
+#include "services/job_service.hpp"
+#include "services/usb_bandwidth_planner.hpp"
 #include "threads/thread_manager.hpp"
 #include "drivers/usb_driver.hpp"
 #include "drivers/spinnaker_driver.hpp"
@@ -13,6 +16,23 @@
 
 namespace vision {
 
+namespace {
+
+// Re-fit USB modes after the camera set changed and restart running cameras whose
+// allocation moved (skipCameraId is restarted by the caller)
+void replanUsbBandwidth(int skipCameraId = 0) {
+    auto changed = UsbBandwidthPlanner::instance().plan(CameraService::instance().getAllCameras());
+    for (int id : changed) {
+        if (id == skipCameraId || !ThreadManager::instance().isCameraRunning(id)) continue;
+        if (auto camera = CameraService::instance().getCameraById(id)) {
+            spdlog::info("USB bandwidth plan changed for camera '{}'; restarting", camera->name);
+            ThreadManager::instance().restartCamera(*camera);
+        }
+    }
+}
+
+} // namespace
+
 void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
     using namespace drogon;
     using json = nlohmann::json;
@@ -67,26 +87,32 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
             if (typeStr == "Spinnaker") type = CameraType::Spinnaker;
             else if (typeStr == "RealSense") type = CameraType::RealSense;
 
-            auto devices = CameraService::instance().discoverCameras(type);
-            json result = json::array();
-            for (const auto& dev : devices) {
-                // Filter out existing cameras
-                bool isExisting = false;
-                for (const auto& existingId : existingIdentifiers) {
-                    if (dev.identifier == existingId) {
-                        isExisting = true;
-                        break;
+            // Probing opens every device index; run it on a compute thread
+            bool queued = JobService::instance().post([type, existingIdentifiers, callback]() {
+                auto devices = CameraService::instance().discoverCameras(type);
+                json result = json::array();
+                for (const auto& dev : devices) {
+                    // Filter out existing cameras
+                    bool isExisting = false;
+                    for (const auto& existingId : existingIdentifiers) {
+                        if (dev.identifier == existingId) {
+                            isExisting = true;
+                            break;
+                        }
+                    }
+                    if (!isExisting) {
+                        result.push_back(dev.toJson());
                     }
                 }
-                if (!isExisting) {
-                    result.push_back(dev.toJson());
-                }
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k200OK);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(result.dump());
+                callback(resp);
+            });
+            if (!queued) {
+                callback(JobsController::busyResponse());
             }
-            auto resp = HttpResponse::newHttpResponse();
-            resp->setStatusCode(k200OK);
-            resp->setContentTypeCode(CT_APPLICATION_JSON);
-            resp->setBody(result.dump());
-            callback(resp);
         },
         {Get});
 
@@ -112,29 +138,48 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
             if (typeStr == "Spinnaker") type = CameraType::Spinnaker;
             else if (typeStr == "RealSense") type = CameraType::RealSense;
 
-            std::vector<CameraProfile> profiles;
-            
-            // Check if camera exists in DB to potentially pause it
-            auto cameraOpt = CameraService::instance().getCameraByIdentifier(identifier);
-            if (cameraOpt) {
-                // If camera exists, use executeWithCameraPaused to safely query
-                // This handles stopping/restarting the camera thread if it's running
-                ThreadManager::instance().executeWithCameraPaused(cameraOpt->id, [&]() {
+            // Profile probing reopens the device (and may pause its thread); keep it off the IO loop
+            bool queued = JobService::instance().post([identifier, type, callback]() {
+                std::vector<CameraProfile> profiles;
+
+                // Check if camera exists in DB to potentially pause it
+                auto cameraOpt = CameraService::instance().getCameraByIdentifier(identifier);
+                if (cameraOpt) {
+                    // If camera exists, use executeWithCameraPaused to safely query
+                    // This handles stopping/restarting the camera thread if it's running
+                    ThreadManager::instance().executeWithCameraPaused(cameraOpt->id, [&]() {
+                        profiles = CameraService::instance().getCameraProfiles(identifier, type);
+                    });
+                } else {
+                    // Camera not in DB, just query directly
                     profiles = CameraService::instance().getCameraProfiles(identifier, type);
-                });
-            } else {
-                // Camera not in DB, just query directly
-                profiles = CameraService::instance().getCameraProfiles(identifier, type);
-            }
+                }
 
-            json result = json::array();
-            for (const auto& profile : profiles) {
-                result.push_back(profile.toJson());
+                json result = json::array();
+                for (const auto& profile : profiles) {
+                    result.push_back(profile.toJson());
+                }
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k200OK);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(result.dump());
+                callback(resp);
+            });
+            if (!queued) {
+                callback(JobsController::busyResponse());
             }
+        },
+        {Get});
+
+    // GET /api/cameras/usb_plan - USB bus budgets and the mode planned for each camera
+    app.registerHandler(
+        "/api/cameras/usb_plan",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback) {
             auto resp = HttpResponse::newHttpResponse();
             resp->setStatusCode(k200OK);
             resp->setContentTypeCode(CT_APPLICATION_JSON);
-            resp->setBody(result.dump());
+            resp->setBody(UsbBandwidthPlanner::instance().toJson().dump());
             callback(resp);
         },
         {Get});
@@ -152,17 +197,6 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
                 camera.camera_type = body.at("camera_type").get<CameraType>();
                 camera.identifier = body.at("identifier").get<std::string>();
 
-                // If name is generic "USB", try to use the discovered device name
-                if (camera.name == "USB" || camera.name == "USB Camera") {
-                    auto devices = CameraService::instance().discoverCameras(camera.camera_type);
-                    for (const auto& dev : devices) {
-                        if (dev.identifier == camera.identifier && !dev.name.empty() && dev.name != "USB Camera") {
-                            camera.name = dev.name;
-                            break;
-                        }
-                    }
-                }
-
                 if (body.contains("resolution")) {
                     camera.resolution_json = body["resolution"].dump();
                 }
@@ -173,24 +207,51 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
                     camera.depth_enabled = body["depth_enabled"].get<bool>();
                 }
 
-                auto created = CameraService::instance().createCamera(camera);
-
-                // Create a default pipeline (AprilTag) for the new camera
-                Pipeline defaultPipeline;
-                defaultPipeline.name = "Default AprilTag";
-                defaultPipeline.pipeline_type = PipelineType::AprilTag;
-                defaultPipeline.camera_id = created.id;
-                auto createdPipeline = PipelineService::instance().createPipeline(defaultPipeline);
-
-                // Start camera and default pipeline threads so processing is active immediately
-                ThreadManager::instance().startCamera(created);
-                ThreadManager::instance().startPipeline(createdPipeline, created.id);
+                // Discovery, the bandwidth replan and camera start all block; run them on a compute thread
+                bool queued = JobService::instance().post([camera, callback]() mutable {
+                    try {
+                        // If name is generic "USB", try to use the discovered device name
+                        if (camera.name == "USB" || camera.name == "USB Camera") {
+                            auto devices = CameraService::instance().discoverCameras(camera.camera_type);
+                            for (const auto& dev : devices) {
+                                if (dev.identifier == camera.identifier && !dev.name.empty() && dev.name != "USB Camera") {
+                                    camera.name = dev.name;
+                                    break;
+                                }
+                            }
+                        }
 
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k201Created);
-                resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(created.toJson().dump());
-                callback(resp);
+                        auto created = CameraService::instance().createCamera(camera);
+                        replanUsbBandwidth(created.id);
+
+                        // Create a default pipeline (AprilTag) for the new camera
+                        Pipeline defaultPipeline;
+                        defaultPipeline.name = "Default AprilTag";
+                        defaultPipeline.pipeline_type = PipelineType::AprilTag;
+                        defaultPipeline.camera_id = created.id;
+                        auto createdPipeline = PipelineService::instance().createPipeline(defaultPipeline);
+
+                        // Start camera and default pipeline threads so processing is active immediately
+                        ThreadManager::instance().startCamera(created);
+                        ThreadManager::instance().startPipeline(createdPipeline, created.id);
+
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k201Created);
+                        resp->setContentTypeCode(CT_APPLICATION_JSON);
+                        resp->setBody(created.toJson().dump());
+                        callback(resp);
+                    } catch (const std::exception& e) {
+                        spdlog::error("Failed to add camera: {}", e.what());
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k400BadRequest);
+                        resp->setContentTypeCode(CT_APPLICATION_JSON);
+                        resp->setBody(json{{"error", e.what()}}.dump());
+                        callback(resp);
+                    }
+                });
+                if (!queued) {
+                    callback(JobsController::busyResponse());
+                }
             } catch (const std::exception& e) {
                 spdlog::error("Failed to add camera: {}", e.what());
                 auto resp = HttpResponse::newHttpResponse();
@@ -255,9 +316,23 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
                 }
 
                 if (CameraService::instance().updateCamera(camera)) {
-                    // Restart camera if resolution/framerate changed
+                    // Restart camera if resolution/framerate changed. Restarts (of this camera and of
+                    // any whose USB allocation moved) block, so they run on a compute thread.
                     if (needsRestart) {
-                         ThreadManager::instance().restartCamera(camera);
+                        bool queued = JobService::instance().post([camera, callback]() {
+                            replanUsbBandwidth(camera.id);
+                            ThreadManager::instance().restartCamera(camera);
+
+                            auto resp = HttpResponse::newHttpResponse();
+                            resp->setStatusCode(k200OK);
+                            resp->setContentTypeCode(CT_APPLICATION_JSON);
+                            resp->setBody(R"({"success": true})");
+                            callback(resp);
+                        });
+                        if (!queued) {
+                            callback(JobsController::busyResponse());
+                        }
+                        return;
                     }
 
                     auto resp = HttpResponse::newHttpResponse();
@@ -288,28 +363,37 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
         [](const HttpRequestPtr& req,
            std::function<void(const HttpResponsePtr&)>&& callback,
            int id) {
-            // Stop pipelines for this camera and remove them from the database
-            auto pipelines = PipelineService::instance().getPipelinesForCamera(id);
-            for (const auto& pipeline : pipelines) {
-                ThreadManager::instance().stopPipeline(pipeline.id);
-                PipelineService::instance().deletePipeline(pipeline.id);
-            }
+            // Stopping threads joins them and the replan may restart other cameras; run on a compute thread
+            bool queued = JobService::instance().post([id, callback]() {
+                // Stop pipelines for this camera and remove them from the database
+                auto pipelines = PipelineService::instance().getPipelinesForCamera(id);
+                for (const auto& pipeline : pipelines) {
+                    ThreadManager::instance().stopPipeline(pipeline.id);
+                    PipelineService::instance().deletePipeline(pipeline.id);
+                }
 
-            // Stop camera thread
-            ThreadManager::instance().stopCamera(id);
+                // Stop camera thread
+                ThreadManager::instance().stopCamera(id);
 
-            if (CameraService::instance().deleteCamera(id)) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k200OK);
-                resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(R"({"success": true})");
-                callback(resp);
-            } else {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k404NotFound);
-                resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(R"({"error": "Camera not found"})");
-                callback(resp);
+                if (CameraService::instance().deleteCamera(id)) {
+                    // Freed bandwidth may let the remaining cameras on the bus run richer modes
+                    replanUsbBandwidth();
+
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k200OK);
+                    resp->setContentTypeCode(CT_APPLICATION_JSON);
+                    resp->setBody(R"({"success": true})");
+                    callback(resp);
+                } else {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k404NotFound);
+                    resp->setContentTypeCode(CT_APPLICATION_JSON);
+                    resp->setBody(R"({"error": "Camera not found"})");
+                    callback(resp);
+                }
+            });
+            if (!queued) {
+                callback(JobsController::busyResponse());
             }
         },
         {Post});
@@ -351,6 +435,8 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
                 {"orientation", camera->orientation},
                 {"exposure_mode", camera->exposure_mode},
                 {"exposure_value", exposureValue},
+                {"alternate_exposure_value", camera->alternate_exposure_value.has_value()
+                    ? json(*camera->alternate_exposure_value) : json(nullptr)},
                 {"gain_mode", camera->gain_mode},
                 {"gain_value", gainValue},
                 {"exposure_min", expRange.min},
@@ -385,8 +471,14 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
                 GainMode gainMode = body.value("gain_mode", GainMode::Auto);
                 int gainValue = body.value("gain_value", 50);
 
+                // Second exposure for alternating capture; null or absent disables it
+                std::optional<int> alternateExposure;
+                if (body.contains("alternate_exposure_value") && !body["alternate_exposure_value"].is_null()) {
+                    alternateExposure = body["alternate_exposure_value"].get<int>();
+                }
+
                 if (CameraService::instance().updateCameraControls(
-                        id, orientation, exposureMode, exposureValue, gainMode, gainValue)) {
+                        id, orientation, exposureMode, exposureValue, gainMode, gainValue, alternateExposure)) {
                     
                     // Notify thread manager of update
                     auto cameraOpt = CameraService::instance().getCameraById(id);
@@ -450,21 +542,32 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
             bool running = ThreadManager::instance().isCameraRunning(cameraId);
 
             // Check if physical camera is connected
+            // SDK cameras are only enumerated once their SDK has loaded; until then the
+            // request starts it and reports the SDK state instead of waiting
             bool physicallyConnected = false;
             std::vector<DeviceInfo> devices;
+            std::optional<SdkInitializer::State> sdkState;
 
             switch (camera->camera_type) {
                 case CameraType::USB:
                     devices = USBDriver::listDevices();
                     break;
                 case CameraType::Spinnaker:
-                    if (SpinnakerDriver::isAvailable()) {
+                    sdkState = SpinnakerDriver::sdkState();
+                    if (*sdkState == SdkInitializer::State::Ready) {
                         devices = SpinnakerDriver::listDevices();
+                    } else if (*sdkState == SdkInitializer::State::Idle) {
+                        SpinnakerDriver::initializeAsync();
+                        sdkState = SdkInitializer::State::Initializing;
                     }
                     break;
                 case CameraType::RealSense:
-                    if (RealSenseDriver::isAvailable()) {
+                    sdkState = RealSenseDriver::sdkState();
+                    if (*sdkState == SdkInitializer::State::Ready) {
                         devices = RealSenseDriver::listDevices();
+                    } else if (*sdkState == SdkInitializer::State::Idle) {
+                        RealSenseDriver::initializeAsync();
+                        sdkState = SdkInitializer::State::Initializing;
                     }
                     break;
                 default:
@@ -483,6 +586,9 @@ void CamerasController::registerRoutes(drogon::HttpAppFramework& app) {
                 {"connected", physicallyConnected},
                 {"streaming", running}
             };
+            if (sdkState) {
+                result["sdk"] = SdkInitializer::toString(*sdkState);
+            }
             auto resp = HttpResponse::newHttpResponse();
             resp->setStatusCode(k200OK);
             resp->setContentTypeCode(CT_APPLICATION_JSON);
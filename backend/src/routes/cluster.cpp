@@ -0,0 +1,209 @@
+// Windows compatibility - must be included before any Drogon headers
+#include "platform/win32_compat.hpp"
+
+#include "routes/cluster.hpp"
+#include "core/config.hpp"
+#include "services/cluster_service.hpp"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+#include <wpi/Logger.h>
+#include <wpinet/NetworkStream.h>
+#include <wpinet/TCPConnector.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace vision {
+
+namespace {
+    constexpr int CONNECT_TIMEOUT_S = 2;
+    constexpr size_t RELAY_CHUNK = 64 * 1024;
+
+    // Each relay holds a thread for as long as its viewer watches, so they are capped
+    std::atomic<int> activeRelays{0};
+
+    // One viewer's claim on the relay budget, released when the relay thread ends
+    struct RelaySlot {
+        ~RelaySlot() { activeRelays.fetch_sub(1); }
+    };
+
+    std::shared_ptr<RelaySlot> acquireRelaySlot() {
+        int limit = Config::instance().cluster.max_stream_relays;
+        if (activeRelays.fetch_add(1) >= limit) {
+            activeRelays.fetch_sub(1);
+            return nullptr;
+        }
+        return std::make_shared<RelaySlot>();
+    }
+
+    // Relay a follower's MJPEG stream to one viewer; runs on its own thread per viewer
+    void proxyStream(const std::string& address, uint16_t port, const std::string& path,
+                     std::shared_ptr<RelaySlot> slot,
+                     std::function<void(const drogon::HttpResponsePtr&)> callback) {
+        using namespace drogon;
+
+        wpi::Logger logger;
+        std::shared_ptr<wpi::NetworkStream> upstream =
+            wpi::TCPConnector::connect(address, port, logger, CONNECT_TIMEOUT_S);
+
+        auto fail = [&callback](const std::string& error) {
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setStatusCode(k502BadGateway);
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            resp->setBody(nlohmann::json{{"error", error}}.dump());
+            callback(resp);
+        };
+
+        if (!upstream) {
+            fail("Failed to connect to node stream");
+            return;
+        }
+
+        std::string request = "GET " + path + " HTTP/1.1\r\nHost: " + address +
+                              "\r\nConnection: keep-alive\r\n\r\n";
+        wpi::NetworkStream::Error err;
+        if (upstream->send(request.data(), request.size(), &err) != request.size()) {
+            fail("Failed to request node stream");
+            return;
+        }
+
+        // Read upstream headers to learn the multipart boundary
+        std::string headers;
+        std::vector<char> buffer(RELAY_CHUNK);
+        size_t headerEnd = std::string::npos;
+        while (headerEnd == std::string::npos && headers.size() < 16 * 1024) {
+            size_t n = upstream->receive(buffer.data(), buffer.size(), &err, CONNECT_TIMEOUT_S);
+            if (n == 0) {
+                fail("Node stream closed before headers");
+                return;
+            }
+            headers.append(buffer.data(), n);
+            headerEnd = headers.find("\r\n\r\n");
+        }
+        if (headerEnd == std::string::npos || headers.compare(0, 12, "HTTP/1.1 200") != 0) {
+            fail("Node stream unavailable");
+            return;
+        }
+
+        std::string contentType = "multipart/x-mixed-replace";
+        auto ctPos = headers.find("Content-Type:");
+        if (ctPos != std::string::npos && ctPos < headerEnd) {
+            auto valueStart = headers.find_first_not_of(' ', ctPos + 13);
+            contentType = headers.substr(valueStart, headers.find("\r\n", valueStart) - valueStart);
+        }
+        auto leftover = std::make_shared<std::string>(headers.substr(headerEnd + 4));
+
+        auto resp = HttpResponse::newAsyncStreamResponse(
+            [upstream, leftover, slot](ResponseStreamPtr stream) {
+                std::shared_ptr<ResponseStream> downstream(std::move(stream));
+                std::thread([upstream, leftover, downstream, slot]() {
+                    std::vector<char> chunk(RELAY_CHUNK);
+                    bool ok = leftover->empty() || downstream->send(*leftover);
+                    while (ok) {
+                        wpi::NetworkStream::Error recvErr;
+                        size_t n = upstream->receive(chunk.data(), chunk.size(), &recvErr, CONNECT_TIMEOUT_S);
+                        if (n == 0) {
+                            // Idle streams time out between frames; anything else is a disconnect
+                            if (recvErr == wpi::NetworkStream::kConnectionTimedOut) {
+                                continue;
+                            }
+                            break;
+                        }
+                        // send() fails once the viewer disconnects
+                        ok = downstream->send(std::string(chunk.data(), n));
+                    }
+                    upstream->close();
+                    downstream->close();
+                }).detach();
+            },
+            true);
+        resp->setContentTypeCodeAndCustomString(CT_CUSTOM, contentType);
+        callback(resp);
+    }
+}
+
+void ClusterController::registerRoutes(drogon::HttpAppFramework& app) {
+    using namespace drogon;
+
+    // GET /api/cluster/status - Role, clock sync and connected nodes
+    app.registerHandler(
+        "/api/cluster/status",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback) {
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setStatusCode(k200OK);
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            auto status = ClusterService::instance().getStatus();
+            status["stream_relays"] = {
+                {"active", activeRelays.load()},
+                {"max", Config::instance().cluster.max_stream_relays}
+            };
+            resp->setBody(status.dump());
+            callback(resp);
+        },
+        {Get});
+
+    // GET /api/cluster/nodes/{nodeId}/results - Latest results received from a follower
+    app.registerHandler(
+        "/api/cluster/nodes/{nodeId}/results",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback,
+           const std::string& nodeId) {
+            auto results = ClusterService::instance().getNodeResults(nodeId);
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            if (results.is_null()) {
+                resp->setStatusCode(k404NotFound);
+                resp->setBody(R"({"error": "Node not found"})");
+            } else {
+                resp->setStatusCode(k200OK);
+                resp->setBody(results.dump());
+            }
+            callback(resp);
+        },
+        {Get});
+
+    // GET /api/cluster/nodes/{nodeId}/stream/{kind}/{id} - Proxy a follower's MJPEG stream
+    app.registerHandler(
+        "/api/cluster/nodes/{nodeId}/stream/{kind}/{id}",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback,
+           const std::string& nodeId, const std::string& kind, int streamId) {
+            if (kind != "camera" && kind != "pipeline") {
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k400BadRequest);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(R"({"error": "Stream kind must be camera or pipeline"})");
+                callback(resp);
+                return;
+            }
+
+            auto endpoint = ClusterService::instance().getStreamEndpoint(nodeId);
+            if (!endpoint) {
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k404NotFound);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(R"({"error": "Node not found"})");
+                callback(resp);
+                return;
+            }
+
+            auto slot = acquireRelaySlot();
+            if (!slot) {
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k503ServiceUnavailable);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(R"({"error": "Too many proxied streams open"})");
+                callback(resp);
+                return;
+            }
+
+            // Connect off the event loop; the upstream connect may block for the timeout
+            std::string path = "/" + kind + "/" + std::to_string(streamId);
+            std::thread(proxyStream, endpoint->first, endpoint->second, path, std::move(slot),
+                        std::move(callback)).detach();
+        },
+        {Get});
+}
+
+} // namespace vision
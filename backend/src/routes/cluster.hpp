@@ -0,0 +1,13 @@
+#pragma once
+
+#include <drogon/drogon.h>
+
+namespace vision {
+
+class ClusterController {
+public:
+    // Register cluster status and follower proxy routes
+    static void registerRoutes(drogon::HttpAppFramework& app);
+};
+
+} // namespace vision
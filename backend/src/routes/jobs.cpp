@@ -0,0 +1,45 @@
+// Windows compatibility - must be included before any Drogon headers
+#include "platform/win32_compat.hpp"
+
+#include "routes/jobs.hpp"
+#include "services/job_service.hpp"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+namespace vision {
+
+drogon::HttpResponsePtr JobsController::busyResponse() {
+    auto resp = drogon::HttpResponse::newHttpResponse();
+    resp->setStatusCode(drogon::k503ServiceUnavailable);
+    resp->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+    resp->setBody(R"({"error": "Server busy, try again"})");
+    return resp;
+}
+
+void JobsController::registerRoutes(drogon::HttpAppFramework& app) {
+    using namespace drogon;
+
+    // GET /api/jobs/{id} - Status (and result, once done) of a background job
+    app.registerHandler(
+        "/api/jobs/{id}",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback,
+           const std::string& id) {
+            auto job = JobService::instance().get(id);
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            if (!job) {
+                resp->setStatusCode(k404NotFound);
+                resp->setBody(R"({"error": "Job not found"})");
+            } else {
+                resp->setStatusCode(k200OK);
+                resp->setBody(job->toJson().dump());
+            }
+            callback(resp);
+        },
+        {Get});
+
+    spdlog::info("Job routes registered");
+}
+
+} // namespace vision
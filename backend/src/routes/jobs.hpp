@@ -0,0 +1,16 @@
+#pragma once
+
+#include <drogon/drogon.h>
+
+namespace vision {
+
+class JobsController {
+public:
+    // Register background job status routes
+    static void registerRoutes(drogon::HttpAppFramework& app);
+
+    // 503 for handlers whose work was rejected by the full compute queue
+    static drogon::HttpResponsePtr busyResponse();
+};
+
+} // namespace vision
@@ -0,0 +1,50 @@
+// Windows compatibility - must be included before any Drogon headers
+#include "platform/win32_compat.hpp"
+
+#include "routes/logs.hpp"
+#include "services/result_log_service.hpp"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+namespace vision {
+
+void LogsController::registerRoutes(drogon::HttpAppFramework& app) {
+    using namespace drogon;
+
+    // GET /api/logs - WPILog result files, newest first
+    app.registerHandler(
+        "/api/logs",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback) {
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setStatusCode(k200OK);
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            resp->setBody(ResultLogService::instance().toJson().dump());
+            callback(resp);
+        },
+        {Get});
+
+    // GET /api/logs/{name} - Download a log for AdvantageScope
+    app.registerHandler(
+        "/api/logs/{name}",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback,
+           const std::string& name) {
+            auto path = ResultLogService::instance().pathFor(name);
+            if (!path) {
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k404NotFound);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(R"({"error": "Log not found"})");
+                callback(resp);
+                return;
+            }
+            auto resp = HttpResponse::newFileResponse(path->string(), name, CT_APPLICATION_OCTET_STREAM);
+            callback(resp);
+        },
+        {Get});
+
+    spdlog::info("Log routes registered");
+}
+
+} // namespace vision
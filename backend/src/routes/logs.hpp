@@ -0,0 +1,12 @@
+#pragma once
+
+#include <drogon/drogon.h>
+
+namespace vision {
+
+class LogsController {
+public:
+    static void registerRoutes(drogon::HttpAppFramework& app);
+};
+
+} // namespace vision
@@ -4,8 +4,13 @@
 #include "routes/pipelines.hpp"
 #include "services/camera_service.hpp"
 #include "services/pipeline_service.hpp"
+#include "services/model_store.hpp"
+#include "services/job_service.hpp"
+#include "routes/jobs.hpp"
 #include "threads/thread_manager.hpp"
 #include "hw/accel.hpp"
+#include "pipelines/onnx_provider_selector.hpp"
+#include <drogon/MultiPart.h>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 #include <filesystem>
@@ -23,6 +28,7 @@ void PipelinesController::registerRoutes(drogon::HttpAppFramework& app) {
         [](const HttpRequestPtr& req,
            std::function<void(const HttpResponsePtr&)>&& callback) {
             auto availability = hw::getMLAvailability();
+            availability["onnx"]["auto_selection"] = OnnxProviderSelector::instance().toJson();
             auto resp = HttpResponse::newHttpResponse();
             resp->setStatusCode(k200OK);
             resp->setContentTypeCode(CT_APPLICATION_JSON);
@@ -88,7 +94,7 @@ void PipelinesController::registerRoutes(drogon::HttpAppFramework& app) {
         },
         {Get});
 
-    // POST /api/pipelines/{id}/files - Upload model/labels files
+    // POST /api/pipelines/{id}/files - Upload model/labels files (multipart: file, type)
     app.registerHandler(
         "/api/pipelines/{id}/files",
         [](const HttpRequestPtr& req,
@@ -104,67 +110,73 @@ void PipelinesController::registerRoutes(drogon::HttpAppFramework& app) {
                 return;
             }
 
-            // Create models directory
-            std::filesystem::path modelsDir = std::filesystem::current_path() / "data" / "models";
-            std::filesystem::create_directories(modelsDir);
+            // Large bodies are spooled to disk by Drogon, so file content is a view, not a copy
+            MultiPartParser parser;
+            if (parser.parse(req) != 0 || parser.getFiles().empty()) {
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k400BadRequest);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(R"({"error": "Expected multipart/form-data with a 'file' field"})");
+                callback(resp);
+                return;
+            }
 
-            try {
-                auto body = json::parse(req->getBody());
+            const auto& params = parser.getParameters();
+            std::string fileType;
+            if (auto it = params.find("type"); it != params.end()) {
+                fileType = it->second;
+            } else if (auto it2 = params.find("file_type"); it2 != params.end()) {
+                fileType = it2->second;
+            }
 
-                std::string fileType = body.at("file_type").get<std::string>();
-                std::string filename = body.at("filename").get<std::string>();
-                std::string content = body.at("content").get<std::string>();
+            const auto& upload = parser.getFiles().front();
 
-                // Save file
-                std::filesystem::path filePath = modelsDir / filename;
-                std::ofstream file(filePath, std::ios::binary);
-                if (!file.is_open()) {
-                    auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k500InternalServerError);
-                    resp->setContentTypeCode(CT_APPLICATION_JSON);
-                    resp->setBody(R"({"error": "Failed to create file"})");
-                    callback(resp);
-                    return;
-                }
-                file << content;
+            try {
+                auto result = ModelStore::instance().install(
+                    upload.getFileName(), fileType, upload.fileContent());
 
-                if (!file.good()) {
-                    file.close();
-                    auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k500InternalServerError);
-                    resp->setContentTypeCode(CT_APPLICATION_JSON);
-                    resp->setBody(R"({"error": "Failed to write file content"})");
-                    callback(resp);
-                    return;
+                // Point the pipeline at the installed file and reload it if running
+                auto configJson = pipeline->getConfigJson();
+                if (fileType == "model") {
+                    configJson["model_filename"] = result.filename;
+                } else {
+                    configJson["labels_filename"] = result.filename;
                 }
-                file.close();
-                if (file.fail()) {
-                    auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k500InternalServerError);
-                    resp->setContentTypeCode(CT_APPLICATION_JSON);
-                    resp->setBody(R"({"error": "Failed to close file properly"})");
-                    callback(resp);
-                    return;
+                auto generation = PipelineService::instance().savePipelineConfig(pipelineId, configJson);
+                if (!generation) {
+                    throw std::runtime_error("Pipeline not found");
                 }
 
-                // Update pipeline config
-                auto configJson = pipeline->getConfigJson();
-                if (fileType == "model") {
-                    configJson["model_filename"] = filename;
-                } else if (fileType == "labels") {
-                    configJson["labels_filename"] = filename;
+                // Model loads run on the job pool; the job result lists the reloaded pipelines
+                auto jobId = JobService::instance().submit(
+                    "model_reload",
+                    [pipelineId, configJson, generation = *generation,
+                     filename = result.filename, replaced = result.replaced](JobContext&) {
+                        std::vector<int> reloaded;
+                        // Other pipelines sharing an overwritten file pick up the new content too
+                        if (replaced) {
+                            reloaded = ModelStore::instance().reloadPipelinesUsing(filename, pipelineId);
+                        }
+                        if (ThreadManager::instance().isPipelineRunning(pipelineId) &&
+                            PipelineService::instance().applyPipelineConfig(pipelineId, configJson, generation)) {
+                            reloaded.push_back(pipelineId);
+                        }
+                        return json{{"reloaded_pipelines", reloaded}};
+                    });
+                if (!jobId) {
+                    callback(JobsController::busyResponse());
+                    return;
                 }
-                pipeline->setConfigJson(configJson);
-                PipelineService::instance().updatePipeline(*pipeline);
+
+                auto body = result.toJson();
+                body["success"] = true;
+                body["path"] = (ModelStore::instance().modelsDir() / result.filename).string();
+                body["job_id"] = *jobId;
 
                 auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k200OK);
+                resp->setStatusCode(k202Accepted);
                 resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(json{
-                    {"success", true},
-                    {"filename", filename},
-                    {"path", filePath.string()}
-                }.dump());
+                resp->setBody(body.dump());
                 callback(resp);
             } catch (const std::exception& e) {
                 auto resp = HttpResponse::newHttpResponse();
@@ -207,17 +219,17 @@ void PipelinesController::registerRoutes(drogon::HttpAppFramework& app) {
                     configJson.erase("labels_filename");
                 }
 
-                // Delete file
-                if (!filename.empty()) {
-                    std::filesystem::path filePath = std::filesystem::current_path() / "data" / "models" / filename;
+                // Delete file unless another pipeline shares it (uploads are deduplicated)
+                if (!filename.empty() && !ModelStore::instance().isReferenced(filename, pipelineId)) {
+                    std::filesystem::path filePath =
+                        ModelStore::instance().modelsDir() / ModelStore::sanitizeFilename(filename);
                     if (std::filesystem::exists(filePath)) {
                         std::filesystem::remove(filePath);
                     }
                 }
 
                 // Update pipeline config
-                pipeline->setConfigJson(configJson);
-                PipelineService::instance().updatePipeline(*pipeline);
+                PipelineService::instance().updatePipelineConfig(pipelineId, configJson);
 
                 auto resp = HttpResponse::newHttpResponse();
                 resp->setStatusCode(k200OK);
@@ -375,19 +387,33 @@ void PipelinesController::registerRoutes(drogon::HttpAppFramework& app) {
             try {
                 auto config = json::parse(req->getBody());
 
-                if (PipelineService::instance().updatePipelineConfig(id, config)) {
-                    auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k200OK);
-                    resp->setContentTypeCode(CT_APPLICATION_JSON);
-                    resp->setBody(R"({"success": true})");
-                    callback(resp);
-                } else {
+                auto generation = PipelineService::instance().savePipelineConfig(id, config);
+                if (!generation) {
                     auto resp = HttpResponse::newHttpResponse();
                     resp->setStatusCode(k404NotFound);
                     resp->setContentTypeCode(CT_APPLICATION_JSON);
                     resp->setBody(R"({"error": "Pipeline not found"})");
                     callback(resp);
+                    return;
+                }
+
+                // Applying may reload a model, so the running thread is updated on the job pool
+                auto jobId = JobService::instance().submit(
+                    "pipeline_config",
+                    [id, config, generation = *generation](JobContext&) {
+                        bool applied = PipelineService::instance().applyPipelineConfig(id, config, generation);
+                        return json{{"pipeline_id", id}, {"applied", applied}};
+                    });
+                if (!jobId) {
+                    callback(JobsController::busyResponse());
+                    return;
                 }
+
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setStatusCode(k202Accepted);
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setBody(json{{"success", true}, {"job_id", *jobId}}.dump());
+                callback(resp);
             } catch (const std::exception& e) {
                 auto resp = HttpResponse::newHttpResponse();
                 resp->setStatusCode(k400BadRequest);
@@ -37,7 +37,8 @@ void SettingsController::registerRoutes(drogon::HttpAppFramework& app) {
                     {"selected_field", settingsService.getSelectedField()},
                     {"available_fields", fields}
                 };
-                result["spinnaker_available"] = SpinnakerDriver::isAvailable();
+                // Reported without loading the SDK; /api/spinnaker/status loads it
+                result["spinnaker_available"] = SpinnakerDriver::isLoaded();
 
                 auto resp = HttpResponse::newHttpResponse();
                 resp->setStatusCode(k200OK);
@@ -9,6 +9,32 @@
 
 namespace vision {
 
+namespace {
+
+// The SDK loads in the background and can take seconds, so routes on the IO thread
+// never wait for it. Returns nullptr once it is ready; otherwise starts it and answers
+// 503 while it initializes, or 500 when it isn't available.
+drogon::HttpResponsePtr sdkNotReadyResponse() {
+    using namespace drogon;
+
+    auto state = SpinnakerDriver::sdkState();
+    if (state == SdkInitializer::State::Ready) return nullptr;
+
+    auto resp = HttpResponse::newHttpResponse();
+    resp->setContentTypeCode(CT_APPLICATION_JSON);
+    if (state == SdkInitializer::State::Unavailable) {
+        resp->setStatusCode(k500InternalServerError);
+        resp->setBody(R"({"error": "Spinnaker SDK is not available"})");
+    } else {
+        SpinnakerDriver::initializeAsync();
+        resp->setStatusCode(k503ServiceUnavailable);
+        resp->setBody(R"({"error": "Spinnaker SDK is initializing, try again shortly", "state": "initializing"})");
+    }
+    return resp;
+}
+
+} // namespace
+
 void SpinnakerController::registerRoutes(drogon::HttpAppFramework& app) {
     using namespace drogon;
     using json = nlohmann::json;
@@ -38,11 +64,7 @@ void SpinnakerController::registerRoutes(drogon::HttpAppFramework& app) {
                 return;
             }
 
-            if (!SpinnakerDriver::isAvailable()) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setContentTypeCode(CT_APPLICATION_JSON);
-                resp->setBody(R"({"error": "Spinnaker support not compiled in"})");
+            if (auto resp = sdkNotReadyResponse()) {
                 callback(resp);
                 return;
             }
@@ -95,11 +117,7 @@ void SpinnakerController::registerRoutes(drogon::HttpAppFramework& app) {
                     return;
                 }
 
-                if (!SpinnakerDriver::isAvailable()) {
-                    auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k500InternalServerError);
-                    resp->setContentTypeCode(CT_APPLICATION_JSON);
-                    resp->setBody(R"({"error": "Spinnaker support not compiled in"})");
+                if (auto resp = sdkNotReadyResponse()) {
                     callback(resp);
                     return;
                 }
@@ -138,8 +156,15 @@ void SpinnakerController::registerRoutes(drogon::HttpAppFramework& app) {
         "/api/spinnaker/status",
         [](const HttpRequestPtr& req,
            std::function<void(const HttpResponsePtr&)>&& callback) {
+            // Reports progress instead of waiting; the first request starts the SDK
+            auto state = SpinnakerDriver::sdkState();
+            if (state == SdkInitializer::State::Idle) {
+                SpinnakerDriver::initializeAsync();
+                state = SdkInitializer::State::Initializing;
+            }
             json result = {
-                {"available", SpinnakerDriver::isAvailable()},
+                {"available", state == SdkInitializer::State::Ready},
+                {"state", SdkInitializer::toString(state)},
                 {"sdk", "Spinnaker"}
             };
             auto resp = HttpResponse::newHttpResponse();
@@ -2,7 +2,12 @@
 #include "platform/win32_compat.hpp"
 
 #include "routes/system.hpp"
+#include "routes/jobs.hpp"
 #include "metrics/registry.hpp"
+#include "metrics/history.hpp"
+#include "services/job_service.hpp"
+#include "services/power_mode_service.hpp"
+#include "services/thermal_governor.hpp"
 #include "utils/network_utils.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
@@ -113,6 +118,20 @@ void SystemController::registerRoutes(drogon::HttpAppFramework& app) {
         },
         {Get});
 
+    // GET /metrics - Prometheus scrape endpoint
+    app.registerHandler(
+        "/metrics",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback) {
+            auto summary = MetricsRegistry::instance().getSummary();
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setStatusCode(k200OK);
+            resp->setContentTypeCodeAndCustomString(CT_CUSTOM, "text/plain; version=0.0.4; charset=utf-8");
+            resp->setBody(summary.toPrometheus());
+            callback(resp);
+        },
+        {Get});
+
     // GET /api/metrics/system - Get system metrics only
     app.registerHandler(
         "/api/metrics/system",
@@ -127,6 +146,94 @@ void SystemController::registerRoutes(drogon::HttpAppFramework& app) {
         },
         {Get});
 
+    // GET /api/metrics/history - Persisted samples by time range
+    // Query: from, to (epoch seconds; default the last hour), pipeline_id, resolution (1, 60, 3600)
+    app.registerHandler(
+        "/api/metrics/history",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback) {
+            try {
+                auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                auto param = req->getParameter("to");
+                int64_t to = param.empty() ? now : std::stoll(param);
+                param = req->getParameter("from");
+                int64_t from = param.empty() ? to - 3600 : std::stoll(param);
+                param = req->getParameter("pipeline_id");
+                std::optional<int> pipelineId;
+                if (!param.empty()) pipelineId = std::stoi(param);
+                param = req->getParameter("resolution");
+                int resolution = param.empty() ? 0 : std::stoi(param);
+                if (from > to || (resolution != 0 && resolution != 1 && resolution != 60 && resolution != 3600)) {
+                    throw std::invalid_argument("range");
+                }
+
+                // A wide range reads and serializes up to 100k rows per table; keep it off the IO loop
+                bool queued = JobService::instance().post([from, to, pipelineId, resolution, callback]() {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setContentTypeCode(CT_APPLICATION_JSON);
+                    try {
+                        resp->setStatusCode(k200OK);
+                        resp->setBody(MetricsHistory::instance().query(from, to, pipelineId, resolution).dump());
+                    } catch (const std::exception& e) {
+                        resp->setStatusCode(k500InternalServerError);
+                        resp->setBody(json{{"error", e.what()}}.dump());
+                    }
+                    callback(resp);
+                });
+                if (!queued) {
+                    callback(JobsController::busyResponse());
+                }
+            } catch (const std::logic_error&) {
+                // std::stoll/stoi and the range check
+                auto resp = HttpResponse::newHttpResponse();
+                resp->setContentTypeCode(CT_APPLICATION_JSON);
+                resp->setStatusCode(k400BadRequest);
+                resp->setBody(R"({"error": "Invalid from, to, pipeline_id or resolution"})");
+                callback(resp);
+            }
+        },
+        {Get});
+
+    // GET /api/system/boot - Cold-boot timings: camera SDK initialization and first frames
+    app.registerHandler(
+        "/api/system/boot",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback) {
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setStatusCode(k200OK);
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            resp->setBody(MetricsRegistry::instance().getBootTimings().dump());
+            callback(resp);
+        },
+        {Get});
+
+    // GET /api/system/power - Match-phase power mode and robot state
+    app.registerHandler(
+        "/api/system/power",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback) {
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setStatusCode(k200OK);
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            resp->setBody(PowerModeService::instance().toJson().dump());
+            callback(resp);
+        },
+        {Get});
+
+    // GET /api/system/thermal - Governor level and timestamped shed/restore actions
+    app.registerHandler(
+        "/api/system/thermal",
+        [](const HttpRequestPtr& req,
+           std::function<void(const HttpResponsePtr&)>&& callback) {
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setStatusCode(k200OK);
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            resp->setBody(ThermalGovernor::instance().toJson().dump());
+            callback(resp);
+        },
+        {Get});
+
     // GET /api/network - Get network information
     app.registerHandler(
         "/api/network",
@@ -3,6 +3,7 @@
 
 #include "routes/vision_ws.hpp"
 #include "services/networktables_service.hpp"
+#include "services/job_service.hpp"
 #include "threads/thread_manager.hpp"
 #include "metrics/registry.hpp"
 #include <spdlog/spdlog.h>
@@ -154,6 +155,22 @@ void VisionWebSocket::handleSubscribe(
                 };
                 shouldSend = true;
             }
+        } else if (topic == "job") {
+            std::string jobId = msg.value("jobId", "");
+            if (!jobId.empty()) {
+                subs.jobs.insert(jobId);
+                spdlog::debug("VisionWebSocket: Client subscribed to job {}", jobId);
+
+                // Send the current state so a job that finished before the subscription isn't missed
+                if (auto job = JobService::instance().get(jobId)) {
+                    response = {
+                        {"type", "job"},
+                        {"jobId", jobId},
+                        {"data", job->toJson()}
+                    };
+                    shouldSend = true;
+                }
+            }
         }
     } // Lock released here
 
@@ -190,6 +207,8 @@ void VisionWebSocket::handleUnsubscribe(
         if (cameraId >= 0 && pipelineId >= 0) {
             subs.pipelineResults.erase({cameraId, pipelineId});
         }
+    } else if (topic == "job") {
+        subs.jobs.erase(msg.value("jobId", ""));
     }
 }
 
@@ -269,6 +288,22 @@ void VisionWebSocket::broadcastNTStatus(const nlohmann::json& status) {
     }
 }
 
+void VisionWebSocket::broadcastJob(const std::string& jobId, const nlohmann::json& job) {
+    nlohmann::json msg = {
+        {"type", "job"},
+        {"jobId", jobId},
+        {"data", job}
+    };
+    std::string payload = msg.dump();
+
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    for (const auto& [conn, subs] : clients_) {
+        if (subs.jobs.count(jobId) > 0 && conn->connected()) {
+            conn->send(payload);
+        }
+    }
+}
+
 bool VisionWebSocket::hasMetricsSubscribers() const {
     std::lock_guard<std::mutex> lock(clientsMutex_);
     for (const auto& [conn, subs] : clients_) {
@@ -2,6 +2,7 @@
 
 #include <drogon/WebSocketController.h>
 #include <set>
+#include <string>
 #include <map>
 #include <mutex>
 #include <thread>
@@ -16,6 +17,7 @@ struct ClientSubscriptions {
     bool ntStatus = false;
     std::set<int> cameraStatus;                          // camera IDs
     std::set<std::pair<int, int>> pipelineResults;       // (cameraId, pipelineId) pairs
+    std::set<std::string> jobs;                          // job IDs
 };
 
 class VisionWebSocket : public drogon::WebSocketController<VisionWebSocket> {
@@ -38,6 +40,7 @@ public:
     void broadcastCameraStatus(int cameraId, bool connected, bool streaming);
     void broadcastPipelineResults(int cameraId, int pipelineId, const nlohmann::json& results);
     void broadcastNTStatus(const nlohmann::json& status);
+    void broadcastJob(const std::string& jobId, const nlohmann::json& job);
 
     // Check if any client is subscribed to a topic
     bool hasMetricsSubscribers() const;
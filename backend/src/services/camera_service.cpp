@@ -69,13 +69,13 @@ Camera CameraService::createCamera(Camera& camera) {
         SQLite::Statement stmt(sqlDb, R"(
             INSERT INTO cameras (
                 name, camera_type, identifier, orientation,
-                exposure_value, gain_value, exposure_mode, gain_mode,
+                exposure_value, alternate_exposure_value, gain_value, exposure_mode, gain_mode,
                 camera_matrix_json, dist_coeffs_json, reprojection_error,
                 device_info_json, resolution_json, framerate, depth_enabled,
                 horizontal_fov, vertical_fov
             ) VALUES (
                 :name, :camera_type, :identifier, :orientation,
-                :exposure_value, :gain_value, :exposure_mode, :gain_mode,
+                :exposure_value, :alternate_exposure_value, :gain_value, :exposure_mode, :gain_mode,
                 :camera_matrix_json, :dist_coeffs_json, :reprojection_error,
                 :device_info_json, :resolution_json, :framerate, :depth_enabled,
                 :horizontal_fov, :vertical_fov
@@ -99,7 +99,7 @@ bool CameraService::updateCamera(const Camera& camera) {
             UPDATE cameras SET
                 name = :name, camera_type = :camera_type, identifier = :identifier,
                 orientation = :orientation, exposure_value = :exposure_value,
-                gain_value = :gain_value, exposure_mode = :exposure_mode,
+                alternate_exposure_value = :alternate_exposure_value, gain_value = :gain_value, exposure_mode = :exposure_mode,
                 gain_mode = :gain_mode, camera_matrix_json = :camera_matrix_json,
                 dist_coeffs_json = :dist_coeffs_json, reprojection_error = :reprojection_error,
                 device_info_json = :device_info_json, resolution_json = :resolution_json,
@@ -164,13 +164,15 @@ bool CameraService::deleteCamera(int id) {
 }
 
 bool CameraService::updateCameraControls(int id, int orientation, ExposureMode exposureMode,
-                                          int exposureValue, GainMode gainMode, int gainValue) {
+                                          int exposureValue, GainMode gainMode, int gainValue,
+                                          std::optional<int> alternateExposureValue) {
     auto& db = Database::instance();
-    return db.withLock([id, orientation, exposureMode, exposureValue, gainMode, gainValue](SQLite::Database& sqlDb) {
+    return db.withLock([id, orientation, exposureMode, exposureValue, gainMode, gainValue,
+                        alternateExposureValue](SQLite::Database& sqlDb) {
         SQLite::Statement stmt(sqlDb, R"(
             UPDATE cameras SET
                 orientation = ?, exposure_mode = ?, exposure_value = ?,
-                gain_mode = ?, gain_value = ?
+                gain_mode = ?, gain_value = ?, alternate_exposure_value = ?
             WHERE id = ?
         )");
 
@@ -179,7 +181,9 @@ bool CameraService::updateCameraControls(int id, int orientation, ExposureMode e
         stmt.bind(3, exposureValue);
         stmt.bind(4, gainMode == GainMode::Auto ? "auto" : "manual");
         stmt.bind(5, gainValue);
-        stmt.bind(6, id);
+        if (alternateExposureValue) stmt.bind(6, *alternateExposureValue);
+        else stmt.bind(6);
+        stmt.bind(7, id);
 
         return stmt.exec() > 0;
     });
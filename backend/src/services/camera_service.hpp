@@ -24,7 +24,8 @@ public:
 
     // Camera controls
     bool updateCameraControls(int id, int orientation, ExposureMode exposureMode,
-                              int exposureValue, GainMode gainMode, int gainValue);
+                              int exposureValue, GainMode gainMode, int gainValue,
+                              std::optional<int> alternateExposureValue = std::nullopt);
 
     // Calibration
     bool saveCalibration(int id, const std::string& cameraMatrixJson,
@@ -0,0 +1,464 @@
+#include "services/cluster_protocol.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace vision {
+namespace cluster {
+
+namespace {
+    class Writer {
+    public:
+        explicit Writer(MessageType type) {
+            u32(MAGIC);
+            u8(PROTOCOL_VERSION);
+            u8(static_cast<uint8_t>(type));
+        }
+
+        void u8(uint8_t v) { buf_.push_back(v); }
+        void u16(uint16_t v) { raw(v); }
+        void i16(int16_t v) { raw(v); }
+        void u32(uint32_t v) { raw(v); }
+        void i32(int32_t v) { raw(v); }
+        void i64(int64_t v) { raw(v); }
+        void f32(float v) { raw(v); }
+
+        void str(const std::string& s) {
+            size_t n = std::min<size_t>(s.size(), 255);
+            u8(static_cast<uint8_t>(n));
+            buf_.insert(buf_.end(), s.begin(), s.begin() + n);
+        }
+
+        std::vector<uint8_t> take() { return std::move(buf_); }
+
+    private:
+        template <typename T>
+        void raw(T v) {
+            uint8_t bytes[sizeof(T)];
+            std::memcpy(bytes, &v, sizeof(T));
+            // Host is little-endian on every supported target (x86_64, aarch64)
+            buf_.insert(buf_.end(), bytes, bytes + sizeof(T));
+        }
+
+        std::vector<uint8_t> buf_;
+    };
+
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t length) : data_(data), length_(length) {}
+
+        bool header(MessageType expected) {
+            uint32_t magic = 0;
+            uint8_t version = 0, type = 0;
+            return u32(magic) && magic == MAGIC && u8(version) && version == PROTOCOL_VERSION &&
+                   u8(type) && type == static_cast<uint8_t>(expected);
+        }
+
+        bool u8(uint8_t& v) { return raw(v); }
+        bool u16(uint16_t& v) { return raw(v); }
+        bool i16(int16_t& v) { return raw(v); }
+        bool u32(uint32_t& v) { return raw(v); }
+        bool i32(int32_t& v) { return raw(v); }
+        bool i64(int64_t& v) { return raw(v); }
+        bool f32(float& v) { return raw(v); }
+
+        bool str(std::string& s) {
+            uint8_t n = 0;
+            if (!u8(n) || pos_ + n > length_) {
+                return false;
+            }
+            s.assign(reinterpret_cast<const char*>(data_ + pos_), n);
+            pos_ += n;
+            return true;
+        }
+
+    private:
+        template <typename T>
+        bool raw(T& v) {
+            if (pos_ + sizeof(T) > length_) {
+                return false;
+            }
+            std::memcpy(&v, data_ + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return true;
+        }
+
+        const uint8_t* data_;
+        size_t length_;
+        size_t pos_ = 0;
+    };
+
+    void writePose(Writer& w, const Pose3d& pose) {
+        auto q = pose.rotation.toQuaternion();
+        for (double v : {pose.translation.x, pose.translation.y, pose.translation.z, q.w, q.x, q.y, q.z}) {
+            w.f32(static_cast<float>(v));
+        }
+    }
+
+    bool readPose(Reader& r, Pose3d& pose) {
+        float v[7];
+        for (auto& f : v) {
+            if (!r.f32(f)) return false;
+        }
+        pose = Pose3d(Translation3d(v[0], v[1], v[2]), Rotation3d(Quaternion(v[3], v[4], v[5], v[6])));
+        return true;
+    }
+
+    int16_t clampI16(int v) {
+        return static_cast<int16_t>(std::clamp(v, -32768, 32767));
+    }
+}
+
+int64_t toMicros(std::chrono::steady_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+}
+
+int64_t nowMicros() {
+    return toMicros(std::chrono::steady_clock::now());
+}
+
+ResultMessage ResultMessage::fromResult(const std::string& nodeId, const Pipeline& pipeline,
+                                        const PipelineResult& result, int64_t captureTimeUs) {
+    ResultMessage msg;
+    msg.nodeId = nodeId;
+    msg.pipelineId = pipeline.id;
+    msg.cameraId = pipeline.camera_id;
+    msg.pipelineType = pipeline.pipeline_type;
+    msg.captureTimeUs = captureTimeUs;
+    msg.processingMs = static_cast<float>(result.processingTimeMs);
+    msg.robotPose = result.robotPose;
+    msg.tagsUsed = result.tagsUsed;
+
+    const auto& dets = result.detections;
+    switch (pipeline.pipeline_type) {
+        case PipelineType::AprilTag:
+            if (!dets.is_array()) break;
+            for (const auto& d : dets) {
+                TagRecord tag;
+                tag.id = d.value("id", 0);
+                tag.family = d.value("family", "");
+                tag.decisionMargin = d.value("decision_margin", 0.0f);
+                tag.hamming = static_cast<uint8_t>(std::clamp(d.value("hamming", 0), 0, 255));
+                if (d.contains("corners")) {
+                    for (size_t i = 0; i < 4 && i < d["corners"].size(); i++) {
+                        tag.corners[i * 2] = d["corners"][i][0].get<float>();
+                        tag.corners[i * 2 + 1] = d["corners"][i][1].get<float>();
+                    }
+                }
+                if (d.contains("pose_relative")) {
+                    auto pose = Pose3d::fromJson(d["pose_relative"]);
+                    auto q = pose.rotation.toQuaternion();
+                    tag.pose = std::array<float, 7>{
+                        static_cast<float>(pose.translation.x), static_cast<float>(pose.translation.y),
+                        static_cast<float>(pose.translation.z), static_cast<float>(q.w),
+                        static_cast<float>(q.x), static_cast<float>(q.y), static_cast<float>(q.z)};
+                }
+                msg.tags.push_back(tag);
+            }
+            break;
+
+        case PipelineType::ObjectDetectionML:
+            if (!dets.is_array()) break;
+            for (const auto& d : dets) {
+                DetectionRecord det;
+                det.label = d.value("label", "");
+                det.confidence = d.value("confidence", 0.0f);
+                if (d.contains("box") && d["box"].size() == 4) {
+                    for (size_t i = 0; i < 4; i++) {
+                        det.box[i] = clampI16(d["box"][i].get<int>());
+                    }
+                }
+                det.tx = d.value("tx", 0.0f);
+                det.ty = d.value("ty", 0.0f);
+                det.ta = d.value("ta", 0.0f);
+                if (d.contains("td")) {
+                    det.td = d["td"].get<float>();
+                }
+                if (d.contains("contour")) {
+                    for (const auto& pt : d["contour"]) {
+                        if (det.contour.size() >= MAX_CONTOUR_POINTS) break;
+                        det.contour.push_back({clampI16(pt[0].get<int>()), clampI16(pt[1].get<int>())});
+                    }
+                }
+                if (d.contains("centroid")) {
+                    det.centroid = std::array<float, 2>{d["centroid"][0].get<float>(), d["centroid"][1].get<float>()};
+                }
+                msg.detections.push_back(det);
+            }
+            break;
+
+        case PipelineType::OpticalFlow:
+            if (!dets.is_object()) break;
+            msg.flow = FlowRecord{
+                dets.value("vx_mps", 0.0f),
+                dets.value("vy_mps", 0.0f),
+                static_cast<uint16_t>(std::clamp(dets.value("features", 0), 0, 65535)),
+                dets.value("valid", false)
+            };
+            break;
+    }
+
+    return msg;
+}
+
+nlohmann::json ResultMessage::detectionsJson() const {
+    if (pipelineType == PipelineType::OpticalFlow) {
+        if (!flow) return nlohmann::json::object();
+        return {
+            {"valid", flow->valid},
+            {"vx_mps", flow->vxMps},
+            {"vy_mps", flow->vyMps},
+            {"features", flow->features},
+            {"timestamp_us", captureTimeUs}
+        };
+    }
+
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto& tag : tags) {
+        nlohmann::json j = {
+            {"id", tag.id},
+            {"family", tag.family},
+            {"decision_margin", tag.decisionMargin},
+            {"hamming", tag.hamming},
+            {"center", {(tag.corners[0] + tag.corners[2] + tag.corners[4] + tag.corners[6]) / 4.0f,
+                        (tag.corners[1] + tag.corners[3] + tag.corners[5] + tag.corners[7]) / 4.0f}},
+            {"corners", {{tag.corners[0], tag.corners[1]}, {tag.corners[2], tag.corners[3]},
+                         {tag.corners[4], tag.corners[5]}, {tag.corners[6], tag.corners[7]}}}
+        };
+        if (tag.pose) {
+            const auto& p = *tag.pose;
+            j["pose_relative"] = Pose3d(Translation3d(p[0], p[1], p[2]),
+                                        Rotation3d(Quaternion(p[3], p[4], p[5], p[6]))).toJson();
+        }
+        arr.push_back(j);
+    }
+    for (const auto& det : detections) {
+        nlohmann::json j = {
+            {"label", det.label},
+            {"confidence", det.confidence},
+            {"box", {det.box[0], det.box[1], det.box[2], det.box[3]}},
+            {"tx", det.tx},
+            {"ty", det.ty},
+            {"ta", det.ta},
+            {"tv", 1}
+        };
+        if (det.td) {
+            j["td"] = *det.td;
+        }
+        if (!det.contour.empty()) {
+            nlohmann::json points = nlohmann::json::array();
+            for (const auto& pt : det.contour) {
+                points.push_back({pt[0], pt[1]});
+            }
+            j["contour"] = points;
+        }
+        if (det.centroid) {
+            j["centroid"] = {(*det.centroid)[0], (*det.centroid)[1]};
+        }
+        arr.push_back(j);
+    }
+    return arr;
+}
+
+std::vector<uint8_t> encode(const Hello& msg) {
+    Writer w(MessageType::Hello);
+    w.str(msg.nodeId);
+    w.u16(msg.httpPort);
+    w.u16(msg.streamPort);
+    return w.take();
+}
+
+std::vector<uint8_t> encode(const SyncRequest& msg) {
+    Writer w(MessageType::SyncRequest);
+    w.str(msg.nodeId);
+    w.i64(msg.t0);
+    return w.take();
+}
+
+std::vector<uint8_t> encode(const SyncResponse& msg) {
+    Writer w(MessageType::SyncResponse);
+    w.i64(msg.t0);
+    w.i64(msg.t1);
+    w.i64(msg.t2);
+    return w.take();
+}
+
+std::vector<uint8_t> encode(const ResultMessage& msg) {
+    Writer w(MessageType::Result);
+    w.str(msg.nodeId);
+    w.i32(msg.pipelineId);
+    w.i32(msg.cameraId);
+    w.u8(static_cast<uint8_t>(msg.pipelineType));
+    w.i64(msg.captureTimeUs);
+    w.f32(msg.processingMs);
+
+    w.u16(static_cast<uint16_t>(std::min<size_t>(msg.tags.size(), 1024)));
+    for (size_t i = 0; i < msg.tags.size() && i < 1024; i++) {
+        const auto& tag = msg.tags[i];
+        w.i32(tag.id);
+        w.str(tag.family);
+        w.f32(tag.decisionMargin);
+        w.u8(tag.hamming);
+        for (float c : tag.corners) w.f32(c);
+        w.u8(tag.pose ? 1 : 0);
+        if (tag.pose) {
+            for (float v : *tag.pose) w.f32(v);
+        }
+    }
+
+    w.u16(static_cast<uint16_t>(std::min<size_t>(msg.detections.size(), 1024)));
+    for (size_t i = 0; i < msg.detections.size() && i < 1024; i++) {
+        const auto& det = msg.detections[i];
+        w.str(det.label);
+        w.f32(det.confidence);
+        for (int16_t b : det.box) w.i16(b);
+        w.f32(det.tx);
+        w.f32(det.ty);
+        w.f32(det.ta);
+        w.f32(det.td.value_or(std::nanf("")));
+        size_t points = std::min(det.contour.size(), MAX_CONTOUR_POINTS);
+        w.u16(static_cast<uint16_t>(points));
+        for (size_t p = 0; p < points; p++) {
+            w.i16(det.contour[p][0]);
+            w.i16(det.contour[p][1]);
+        }
+        w.u8(det.centroid ? 1 : 0);
+        if (det.centroid) {
+            w.f32((*det.centroid)[0]);
+            w.f32((*det.centroid)[1]);
+        }
+    }
+
+    w.u8(msg.flow ? 1 : 0);
+    if (msg.flow) {
+        w.f32(msg.flow->vxMps);
+        w.f32(msg.flow->vyMps);
+        w.u16(msg.flow->features);
+        w.u8(msg.flow->valid ? 1 : 0);
+    }
+
+    w.u8(msg.robotPose ? 1 : 0);
+    if (msg.robotPose) {
+        writePose(w, *msg.robotPose);
+    }
+    w.i32(msg.tagsUsed);
+    return w.take();
+}
+
+std::optional<MessageType> peekType(const uint8_t* data, size_t length) {
+    if (length < 6) {
+        return std::nullopt;
+    }
+    uint32_t magic;
+    std::memcpy(&magic, data, sizeof(magic));
+    if (magic != MAGIC || data[4] != PROTOCOL_VERSION) {
+        return std::nullopt;
+    }
+    uint8_t type = data[5];
+    if (type < static_cast<uint8_t>(MessageType::Hello) || type > static_cast<uint8_t>(MessageType::Result)) {
+        return std::nullopt;
+    }
+    return static_cast<MessageType>(type);
+}
+
+bool decode(const uint8_t* data, size_t length, Hello& out) {
+    Reader r(data, length);
+    return r.header(MessageType::Hello) && r.str(out.nodeId) &&
+           r.u16(out.httpPort) && r.u16(out.streamPort);
+}
+
+bool decode(const uint8_t* data, size_t length, SyncRequest& out) {
+    Reader r(data, length);
+    return r.header(MessageType::SyncRequest) && r.str(out.nodeId) && r.i64(out.t0);
+}
+
+bool decode(const uint8_t* data, size_t length, SyncResponse& out) {
+    Reader r(data, length);
+    return r.header(MessageType::SyncResponse) && r.i64(out.t0) && r.i64(out.t1) && r.i64(out.t2);
+}
+
+bool decode(const uint8_t* data, size_t length, ResultMessage& out) {
+    Reader r(data, length);
+    uint8_t type = 0;
+    if (!r.header(MessageType::Result) || !r.str(out.nodeId) || !r.i32(out.pipelineId) ||
+        !r.i32(out.cameraId) || !r.u8(type) || !r.i64(out.captureTimeUs) || !r.f32(out.processingMs)) {
+        return false;
+    }
+    if (type > static_cast<uint8_t>(PipelineType::OpticalFlow)) {
+        return false;
+    }
+    out.pipelineType = static_cast<PipelineType>(type);
+
+    uint16_t tagCount = 0;
+    if (!r.u16(tagCount)) return false;
+    out.tags.resize(tagCount);
+    for (auto& tag : out.tags) {
+        uint8_t hasPose = 0;
+        if (!r.i32(tag.id) || !r.str(tag.family) || !r.f32(tag.decisionMargin) || !r.u8(tag.hamming)) {
+            return false;
+        }
+        for (float& c : tag.corners) {
+            if (!r.f32(c)) return false;
+        }
+        if (!r.u8(hasPose)) return false;
+        if (hasPose) {
+            std::array<float, 7> pose{};
+            for (float& v : pose) {
+                if (!r.f32(v)) return false;
+            }
+            tag.pose = pose;
+        }
+    }
+
+    uint16_t detCount = 0;
+    if (!r.u16(detCount)) return false;
+    out.detections.resize(detCount);
+    for (auto& det : out.detections) {
+        float td = 0.0f;
+        if (!r.str(det.label) || !r.f32(det.confidence)) return false;
+        for (int16_t& b : det.box) {
+            if (!r.i16(b)) return false;
+        }
+        if (!r.f32(det.tx) || !r.f32(det.ty) || !r.f32(det.ta) || !r.f32(td)) return false;
+        if (!std::isnan(td)) {
+            det.td = td;
+        }
+
+        uint16_t points = 0;
+        if (!r.u16(points) || points > MAX_CONTOUR_POINTS) return false;
+        det.contour.resize(points);
+        for (auto& pt : det.contour) {
+            if (!r.i16(pt[0]) || !r.i16(pt[1])) return false;
+        }
+        uint8_t hasCentroid = 0;
+        if (!r.u8(hasCentroid)) return false;
+        if (hasCentroid) {
+            std::array<float, 2> centroid{};
+            if (!r.f32(centroid[0]) || !r.f32(centroid[1])) return false;
+            det.centroid = centroid;
+        }
+    }
+
+    uint8_t hasFlow = 0;
+    if (!r.u8(hasFlow)) return false;
+    if (hasFlow) {
+        FlowRecord flow;
+        uint8_t valid = 0;
+        if (!r.f32(flow.vxMps) || !r.f32(flow.vyMps) || !r.u16(flow.features) || !r.u8(valid)) return false;
+        flow.valid = valid != 0;
+        out.flow = flow;
+    }
+
+    uint8_t hasPose = 0;
+    if (!r.u8(hasPose)) return false;
+    if (hasPose) {
+        Pose3d pose;
+        if (!readPose(r, pose)) return false;
+        out.robotPose = pose;
+    }
+    return r.i32(out.tagsUsed);
+}
+
+} // namespace cluster
+} // namespace vision
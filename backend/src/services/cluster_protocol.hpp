@@ -0,0 +1,116 @@
+#pragma once
+
+#include "pipelines/base_pipeline.hpp"
+#include "models/pipeline.hpp"
+#include "utils/geometry.hpp"
+#include <nlohmann/json.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vision {
+namespace cluster {
+
+// Wire format: little-endian, one message per UDP datagram
+constexpr uint32_t MAGIC = 0x4C433256;  // "V2CL"
+constexpr uint8_t PROTOCOL_VERSION = 2;
+constexpr size_t MAX_DATAGRAM = 65000;
+constexpr size_t MAX_CONTOUR_POINTS = 256;  // Per detection; outlines are already simplified
+
+enum class MessageType : uint8_t {
+    Hello = 1,         // follower -> leader: announce node and its ports
+    SyncRequest = 2,   // follower -> leader: clock sync probe
+    SyncResponse = 3,  // leader -> follower: clock sync reply
+    Result = 4         // follower -> leader: pipeline result
+};
+
+struct Hello {
+    std::string nodeId;
+    uint16_t httpPort = 0;
+    uint16_t streamPort = 0;
+};
+
+// NTP-style exchange: t0 follower send, t1 leader receive, t2 leader send
+struct SyncRequest {
+    std::string nodeId;
+    int64_t t0 = 0;
+};
+
+struct SyncResponse {
+    int64_t t0 = 0;
+    int64_t t1 = 0;
+    int64_t t2 = 0;
+};
+
+struct TagRecord {
+    int32_t id = 0;
+    std::string family;
+    float decisionMargin = 0.0f;
+    uint8_t hamming = 0;
+    std::array<float, 8> corners{};               // x0,y0 .. x3,y3
+    std::optional<std::array<float, 7>> pose;     // camera-relative x,y,z,qw,qx,qy,qz
+};
+
+struct DetectionRecord {
+    std::string label;
+    float confidence = 0.0f;
+    std::array<int16_t, 4> box{};                 // x1,y1,x2,y2
+    float tx = 0.0f;
+    float ty = 0.0f;
+    float ta = 0.0f;
+    std::optional<float> td;
+    std::vector<std::array<int16_t, 2>> contour;  // Segmentation outline (YOLO-seg)
+    std::optional<std::array<float, 2>> centroid;
+};
+
+struct FlowRecord {
+    float vxMps = 0.0f;
+    float vyMps = 0.0f;
+    uint16_t features = 0;
+    bool valid = false;
+};
+
+struct ResultMessage {
+    std::string nodeId;
+    int32_t pipelineId = 0;
+    int32_t cameraId = 0;
+    PipelineType pipelineType = PipelineType::AprilTag;
+    int64_t captureTimeUs = 0;   // Capture time in the leader's clock
+    float processingMs = 0.0f;
+
+    std::vector<TagRecord> tags;
+    std::vector<DetectionRecord> detections;
+    std::optional<FlowRecord> flow;
+    std::optional<Pose3d> robotPose;
+    int32_t tagsUsed = 0;
+
+    // Pack a local pipeline result (detections in the pipeline's JSON schema)
+    static ResultMessage fromResult(const std::string& nodeId, const Pipeline& pipeline,
+                                    const PipelineResult& result, int64_t captureTimeUs);
+
+    // Detections in the same JSON schema the originating pipeline produces
+    nlohmann::json detectionsJson() const;
+};
+
+// Monotonic clock shared by capture timestamps and clock sync (microseconds)
+int64_t nowMicros();
+int64_t toMicros(std::chrono::steady_clock::time_point tp);
+
+std::vector<uint8_t> encode(const Hello& msg);
+std::vector<uint8_t> encode(const SyncRequest& msg);
+std::vector<uint8_t> encode(const SyncResponse& msg);
+std::vector<uint8_t> encode(const ResultMessage& msg);
+
+// Validate the header and return the message type, or nullopt for foreign/corrupt datagrams
+std::optional<MessageType> peekType(const uint8_t* data, size_t length);
+
+bool decode(const uint8_t* data, size_t length, Hello& out);
+bool decode(const uint8_t* data, size_t length, SyncRequest& out);
+bool decode(const uint8_t* data, size_t length, SyncResponse& out);
+bool decode(const uint8_t* data, size_t length, ResultMessage& out);
+
+} // namespace cluster
+} // namespace vision
@@ -0,0 +1,452 @@
+#include "services/cluster_service.hpp"
+#include "services/networktables_service.hpp"
+#include "utils/network_utils.hpp"
+#include <spdlog/spdlog.h>
+#include <wpi/Logger.h>
+#include <wpi/SmallString.h>
+#include <wpinet/UDPClient.h>
+#include <algorithm>
+#include <span>
+
+namespace vision {
+
+namespace {
+    constexpr size_t MAX_SYNC_SAMPLES = 16;
+
+    const char* roleName(ClusterRole role) {
+        switch (role) {
+            case ClusterRole::Leader: return "leader";
+            case ClusterRole::Follower: return "follower";
+            default: return "standalone";
+        }
+    }
+
+    int64_t ageMs(std::chrono::steady_clock::time_point tp) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - tp).count();
+    }
+}
+
+nlohmann::json ClusterNode::toJson(int timeoutMs) const {
+    nlohmann::json pipelines = nlohmann::json::array();
+    for (const auto& [pipelineId, result] : latestResults) {
+        std::string base = "/api/cluster/nodes/" + nodeId + "/stream/";
+        pipelines.push_back({
+            {"pipeline_id", pipelineId},
+            {"camera_id", result.cameraId},
+            {"pipeline_type", result.pipelineType},
+            {"stream", base + "pipeline/" + std::to_string(pipelineId)},
+            {"camera_stream", base + "camera/" + std::to_string(result.cameraId)}
+        });
+    }
+
+    auto lastSeenMs = ageMs(lastSeen);
+    return {
+        {"node_id", nodeId},
+        {"address", address},
+        {"http_port", httpPort},
+        {"stream_port", streamPort},
+        {"online", lastSeenMs < timeoutMs},
+        {"last_seen_ms", lastSeenMs},
+        {"results_received", resultsReceived},
+        {"pipelines", pipelines}
+    };
+}
+
+ClusterService& ClusterService::instance() {
+    static ClusterService instance;
+    return instance;
+}
+
+ClusterService::ClusterService() = default;
+
+ClusterService::~ClusterService() {
+    stop();
+}
+
+void ClusterService::start(const ClusterConfig& config, uint16_t httpPort, uint16_t streamPort) {
+    if (running_.load()) {
+        return;
+    }
+
+    config_ = config;
+    httpPort_ = httpPort;
+    streamPort_ = streamPort;
+
+    if (config.role == "leader") {
+        role_ = ClusterRole::Leader;
+    } else if (config.role == "follower") {
+        role_ = ClusterRole::Follower;
+    } else {
+        role_ = ClusterRole::Standalone;
+        return;
+    }
+
+    // Port suffix keeps node IDs unique when several nodes share one host
+    nodeId_ = config.node_id.empty()
+        ? network::getHostname() + "-" + std::to_string(httpPort)
+        : config.node_id;
+
+    logger_ = std::make_unique<wpi::Logger>();
+    udp_ = std::make_unique<wpi::UDPClient>(*logger_);
+    int rc = isLeader() ? udp_->start(config.port) : udp_->start();
+    if (rc != 0) {
+        spdlog::error("Cluster: failed to open UDP socket{} (rc={})",
+                      isLeader() ? " on port " + std::to_string(config.port) : "", rc);
+        udp_.reset();
+        return;
+    }
+    udp_->set_timeout(0.2);
+
+    running_.store(true);
+    receiveThread_ = std::thread(&ClusterService::receiveLoop, this);
+    if (isFollower()) {
+        followerThread_ = std::thread(&ClusterService::followerLoop, this);
+    }
+
+    spdlog::info("Cluster: node '{}' running as {}{}", nodeId_, roleName(role_),
+                 isFollower() ? " -> " + config.leader_host + ":" + std::to_string(config.port)
+                              : " on UDP port " + std::to_string(config.port));
+}
+
+void ClusterService::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (receiveThread_.joinable()) {
+        receiveThread_.join();
+    }
+    if (followerThread_.joinable()) {
+        followerThread_.join();
+    }
+    if (udp_) {
+        udp_->shutdown();
+        udp_.reset();
+    }
+    spdlog::info("Cluster: stopped");
+}
+
+int64_t ClusterService::toClusterTime(std::chrono::steady_clock::time_point localTime) const {
+    int64_t local = cluster::toMicros(localTime);
+    return isFollower() ? local + clockOffsetUs_.load() : local;
+}
+
+void ClusterService::send(const std::vector<uint8_t>& data, const std::string& address, int port) {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    if (udp_) {
+        udp_->send(std::span<const uint8_t>(data.data(), data.size()), address, port);
+    }
+}
+
+void ClusterService::submitResult(const Pipeline& pipeline, const PipelineResult& result,
+                                  std::chrono::steady_clock::time_point captureTime) {
+    if (role_ == ClusterRole::Standalone) {
+        return;
+    }
+
+    int64_t captureUs = toClusterTime(captureTime);
+
+    if (isLeader()) {
+        if (result.robotPose) {
+            fuseAndPublishPose("local/" + std::to_string(pipeline.id), *result.robotPose,
+                               result.tagsUsed, captureUs);
+        }
+        return;
+    }
+
+    auto msg = cluster::ResultMessage::fromResult(nodeId_, pipeline, result, captureUs);
+    auto data = cluster::encode(msg);
+    if (data.size() > cluster::MAX_DATAGRAM) {
+        // Outlines are the bulk of a large result; the boxes and poses still fit without them
+        for (auto& det : msg.detections) {
+            det.contour.clear();
+        }
+        data = cluster::encode(msg);
+    }
+    if (data.size() > cluster::MAX_DATAGRAM) {
+        spdlog::warn("Cluster: result for pipeline {} too large ({} bytes), dropped", pipeline.id, data.size());
+        return;
+    }
+    send(data, config_.leader_host, config_.port);
+    resultsSent_.fetch_add(1);
+}
+
+void ClusterService::receiveLoop() {
+    std::vector<uint8_t> buffer(cluster::MAX_DATAGRAM);
+
+    while (running_.load()) {
+        wpi::SmallString<64> addr;
+        int port = 0;
+        int n = udp_->receive(buffer.data(), static_cast<int>(buffer.size()), &addr, &port);
+        int64_t receivedUs = cluster::nowMicros();
+        if (n <= 0) {
+            continue;
+        }
+
+        auto type = cluster::peekType(buffer.data(), static_cast<size_t>(n));
+        if (!type) {
+            continue;
+        }
+        std::string address(addr.data(), addr.size());
+
+        switch (*type) {
+            case cluster::MessageType::Hello: {
+                cluster::Hello hello;
+                if (isLeader() && cluster::decode(buffer.data(), n, hello)) {
+                    handleHello(hello, address);
+                }
+                break;
+            }
+            case cluster::MessageType::SyncRequest: {
+                cluster::SyncRequest req;
+                if (isLeader() && cluster::decode(buffer.data(), n, req)) {
+                    handleSyncRequest(req, receivedUs, address, port);
+                }
+                break;
+            }
+            case cluster::MessageType::SyncResponse: {
+                cluster::SyncResponse resp;
+                if (isFollower() && cluster::decode(buffer.data(), n, resp)) {
+                    handleSyncResponse(resp, receivedUs);
+                }
+                break;
+            }
+            case cluster::MessageType::Result: {
+                cluster::ResultMessage msg;
+                if (isLeader() && cluster::decode(buffer.data(), n, msg)) {
+                    handleResult(std::move(msg), address);
+                }
+                break;
+            }
+        }
+    }
+}
+
+void ClusterService::followerLoop() {
+    auto interval = std::chrono::milliseconds(std::max(50, config_.sync_interval_ms));
+
+    while (running_.load()) {
+        send(cluster::encode(cluster::Hello{nodeId_, httpPort_, streamPort_}),
+             config_.leader_host, config_.port);
+        send(cluster::encode(cluster::SyncRequest{nodeId_, cluster::nowMicros()}),
+             config_.leader_host, config_.port);
+
+        // Sleep in small steps so stop() is not delayed by a long interval
+        auto deadline = std::chrono::steady_clock::now() + interval;
+        while (running_.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+}
+
+void ClusterService::handleHello(const cluster::Hello& hello, const std::string& address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = nodes_.try_emplace(hello.nodeId);
+    auto& node = it->second;
+    bool wasOffline = !inserted && ageMs(node.lastSeen) >= config_.node_timeout_ms;
+
+    node.nodeId = hello.nodeId;
+    node.address = address;
+    node.httpPort = hello.httpPort;
+    node.streamPort = hello.streamPort;
+    node.lastSeen = std::chrono::steady_clock::now();
+
+    if (inserted || wasOffline) {
+        spdlog::info("Cluster: node '{}' joined from {} (http {}, stream {})",
+                     hello.nodeId, address, hello.httpPort, hello.streamPort);
+    }
+}
+
+void ClusterService::handleSyncRequest(const cluster::SyncRequest& req, int64_t receivedUs,
+                                       const std::string& address, int port) {
+    cluster::SyncResponse resp{req.t0, receivedUs, cluster::nowMicros()};
+    send(cluster::encode(resp), address, port);
+}
+
+void ClusterService::handleSyncResponse(const cluster::SyncResponse& resp, int64_t receivedUs) {
+    int64_t rtt = (receivedUs - resp.t0) - (resp.t2 - resp.t1);
+    if (rtt < 0) {
+        return;
+    }
+    int64_t offset = ((resp.t1 - resp.t0) + (resp.t2 - receivedUs)) / 2;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    syncSamples_.push_back({offset, rtt});
+    if (syncSamples_.size() > MAX_SYNC_SAMPLES) {
+        syncSamples_.pop_front();
+    }
+
+    // The lowest-RTT sample has the least queuing asymmetry, so trust its offset
+    auto best = std::min_element(syncSamples_.begin(), syncSamples_.end(),
+        [](const SyncSample& a, const SyncSample& b) { return a.rttUs < b.rttUs; });
+    clockOffsetUs_.store(best->offsetUs);
+    clockRttUs_.store(best->rttUs);
+    lastSyncUs_.store(receivedUs);
+}
+
+void ClusterService::handleResult(cluster::ResultMessage msg, const std::string& address) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& node = nodes_[msg.nodeId];
+        if (node.nodeId.empty()) {
+            node.nodeId = msg.nodeId;
+            node.address = address;
+        }
+        node.lastSeen = std::chrono::steady_clock::now();
+        node.resultsReceived++;
+        node.latestResults[msg.pipelineId] = msg;
+    }
+
+    auto& nt = NetworkTablesService::instance();
+    if (msg.pipelineType == PipelineType::OpticalFlow) {
+        if (msg.flow) {
+            nt.publishRemoteOpticalFlowVelocity(msg.nodeId, msg.cameraId,
+                                                msg.flow->vxMps, msg.flow->vyMps, msg.captureTimeUs,
+                                                msg.flow->features, msg.flow->valid);
+        }
+    } else {
+        nt.publishRemoteDetections(msg.nodeId, msg.cameraId, msg.detectionsJson());
+    }
+
+    if (msg.robotPose) {
+        fuseAndPublishPose(msg.nodeId + "/" + std::to_string(msg.pipelineId), *msg.robotPose,
+                           msg.tagsUsed, msg.captureTimeUs);
+    }
+}
+
+void ClusterService::fuseAndPublishPose(const std::string& sourceKey, const Pose3d& pose,
+                                        int tagsUsed, int64_t captureUs) {
+    PoseEstimate fused;
+    int totalTags = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        poseEstimates_[sourceKey] = PoseEstimate{pose, tagsUsed, captureUs};
+
+        int64_t newest = 0;
+        for (const auto& [key, est] : poseEstimates_) {
+            newest = std::max(newest, est.captureUs);
+        }
+
+        // Late arrivals older than the window would move the published pose backwards in time
+        int64_t windowUs = static_cast<int64_t>(config_.fusion_window_ms) * 1000;
+        if (newest - captureUs > windowUs) {
+            return;
+        }
+
+        // Tag-count weighted mean of translations and sign-aligned quaternions
+        Eigen::Vector3d translation = Eigen::Vector3d::Zero();
+        Eigen::Vector4d quat = Eigen::Vector4d::Zero();
+        std::optional<Eigen::Vector4d> reference;
+        double totalWeight = 0.0;
+        int sources = 0;
+
+        for (const auto& [key, est] : poseEstimates_) {
+            if (newest - est.captureUs > windowUs) {
+                continue;
+            }
+            double weight = std::max(1, est.tagsUsed);
+            auto q = est.pose.rotation.toQuaternion();
+            Eigen::Vector4d qv(q.w, q.x, q.y, q.z);
+            if (!reference) {
+                reference = qv;
+            } else if (reference->dot(qv) < 0) {
+                qv = -qv;
+            }
+
+            translation += weight * est.pose.translation.toVector();
+            quat += weight * qv;
+            totalWeight += weight;
+            totalTags += est.tagsUsed;
+            sources++;
+        }
+
+        quat.normalize();
+        fused.pose = Pose3d(Translation3d::fromVector(translation / totalWeight),
+                            Rotation3d(Quaternion(quat[0], quat[1], quat[2], quat[3])));
+        fused.tagsUsed = totalTags;
+        fused.captureUs = newest;
+        fusedPose_ = fused;
+        fusedSources_ = sources;
+    }
+
+    NetworkTablesService::instance().publishRobotPose(fused.pose, fused.captureUs / 1e6, totalTags);
+}
+
+nlohmann::json ClusterService::getStatus() const {
+    nlohmann::json status = {
+        {"role", roleName(role_)},
+        {"node_id", nodeId_},
+        {"running", running_.load()}
+    };
+
+    if (role_ == ClusterRole::Standalone) {
+        return status;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isLeader()) {
+        nlohmann::json nodes = nlohmann::json::array();
+        for (const auto& [id, node] : nodes_) {
+            nodes.push_back(node.toJson(config_.node_timeout_ms));
+        }
+        status["port"] = config_.port;
+        status["nodes"] = nodes;
+        if (fusedPose_) {
+            status["fused_pose"] = {
+                {"pose", fusedPose_->pose.toJson()},
+                {"tags_used", fusedPose_->tagsUsed},
+                {"sources", fusedSources_},
+                {"age_ms", (cluster::nowMicros() - fusedPose_->captureUs) / 1000}
+            };
+        } else {
+            status["fused_pose"] = nullptr;
+        }
+    } else {
+        int64_t lastSync = lastSyncUs_.load();
+        status["leader"] = config_.leader_host + ":" + std::to_string(config_.port);
+        status["results_sent"] = resultsSent_.load();
+        status["clock"] = {
+            {"synced", lastSync > 0},
+            {"offset_us", clockOffsetUs_.load()},
+            {"rtt_us", clockRttUs_.load()},
+            {"last_sync_age_ms", lastSync > 0 ? (cluster::nowMicros() - lastSync) / 1000 : -1}
+        };
+    }
+    return status;
+}
+
+nlohmann::json ClusterService::getNodeResults(const std::string& nodeId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = nodes_.find(nodeId);
+    if (it == nodes_.end()) {
+        return nullptr;
+    }
+
+    int64_t now = cluster::nowMicros();
+    nlohmann::json results = nlohmann::json::array();
+    for (const auto& [pipelineId, msg] : it->second.latestResults) {
+        results.push_back({
+            {"pipeline_id", pipelineId},
+            {"camera_id", msg.cameraId},
+            {"pipeline_type", msg.pipelineType},
+            {"capture_time_us", msg.captureTimeUs},
+            {"age_ms", (now - msg.captureTimeUs) / 1000},
+            {"processing_time_ms", msg.processingMs},
+            {"detections", msg.detectionsJson()},
+            {"robot_pose", msg.robotPose ? msg.robotPose->toJson() : nlohmann::json(nullptr)},
+            {"tags_used", msg.tagsUsed}
+        });
+    }
+    return results;
+}
+
+std::optional<std::pair<std::string, uint16_t>> ClusterService::getStreamEndpoint(const std::string& nodeId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = nodes_.find(nodeId);
+    if (it == nodes_.end() || it->second.streamPort == 0) {
+        return std::nullopt;
+    }
+    return std::make_pair(it->second.address, it->second.streamPort);
+}
+
+} // namespace vision
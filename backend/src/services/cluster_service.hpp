@@ -0,0 +1,135 @@
+#pragma once
+
+#include "core/config.hpp"
+#include "services/cluster_protocol.hpp"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace wpi {
+class Logger;
+class UDPClient;
+}
+
+namespace vision {
+
+enum class ClusterRole {
+    Standalone,  // Single node, publishes its own results to NT
+    Leader,      // Aggregates follower results, fuses poses, sole NT publisher
+    Follower     // Streams results to the leader, never publishes to NT
+};
+
+// Leader's view of a follower node
+struct ClusterNode {
+    std::string nodeId;
+    std::string address;
+    uint16_t httpPort = 0;
+    uint16_t streamPort = 0;
+    std::chrono::steady_clock::time_point lastSeen;
+    uint64_t resultsReceived = 0;
+    std::map<int, cluster::ResultMessage> latestResults;  // pipeline_id -> result
+
+    nlohmann::json toJson(int timeoutMs) const;
+};
+
+class ClusterService {
+public:
+    // Singleton access
+    static ClusterService& instance();
+
+    // Start networking for the configured role (no-op when standalone)
+    void start(const ClusterConfig& config, uint16_t httpPort, uint16_t streamPort);
+    void stop();
+
+    ClusterRole role() const { return role_; }
+    bool isLeader() const { return role_ == ClusterRole::Leader; }
+    bool isFollower() const { return role_ == ClusterRole::Follower; }
+    const std::string& nodeId() const { return nodeId_; }
+
+    // Only one node may own the Vision NT topics
+    bool publishesNetworkTables() const { return role_ != ClusterRole::Follower; }
+
+    // Convert a local steady_clock time to the leader's clock (identity on leader/standalone)
+    int64_t toClusterTime(std::chrono::steady_clock::time_point localTime) const;
+
+    // Called by VisionThread after each processed frame
+    void submitResult(const Pipeline& pipeline, const PipelineResult& result,
+                      std::chrono::steady_clock::time_point captureTime);
+
+    nlohmann::json getStatus() const;
+    nlohmann::json getNodeResults(const std::string& nodeId) const;
+
+    // Address and MJPEG port of a follower, for stream proxying
+    std::optional<std::pair<std::string, uint16_t>> getStreamEndpoint(const std::string& nodeId) const;
+
+private:
+    ClusterService();
+    ~ClusterService();
+
+    void receiveLoop();
+    void followerLoop();
+
+    void send(const std::vector<uint8_t>& data, const std::string& address, int port);
+
+    // Leader message handlers
+    void handleHello(const cluster::Hello& hello, const std::string& address);
+    void handleSyncRequest(const cluster::SyncRequest& req, int64_t receivedUs,
+                           const std::string& address, int port);
+    void handleResult(cluster::ResultMessage msg, const std::string& address);
+
+    // Follower message handlers
+    void handleSyncResponse(const cluster::SyncResponse& resp, int64_t receivedUs);
+
+    // Fuse the latest robot pose from every source within the fusion window and publish it
+    void fuseAndPublishPose(const std::string& sourceKey, const Pose3d& pose,
+                            int tagsUsed, int64_t captureUs);
+
+    ClusterConfig config_;
+    ClusterRole role_ = ClusterRole::Standalone;
+    std::string nodeId_;
+    uint16_t httpPort_ = 0;
+    uint16_t streamPort_ = 0;
+
+    std::unique_ptr<wpi::Logger> logger_;
+    std::unique_ptr<wpi::UDPClient> udp_;
+    std::mutex sendMutex_;
+
+    std::atomic<bool> running_{false};
+    std::thread receiveThread_;
+    std::thread followerThread_;
+
+    // Follower clock sync (offset = leader - local)
+    struct SyncSample {
+        int64_t offsetUs;
+        int64_t rttUs;
+    };
+    std::deque<SyncSample> syncSamples_;
+    std::atomic<int64_t> clockOffsetUs_{0};
+    std::atomic<int64_t> clockRttUs_{-1};
+    std::atomic<uint64_t> resultsSent_{0};
+    std::atomic<int64_t> lastSyncUs_{0};
+
+    // Leader state
+    std::unordered_map<std::string, ClusterNode> nodes_;
+
+    struct PoseEstimate {
+        Pose3d pose;
+        int tagsUsed = 0;
+        int64_t captureUs = 0;
+    };
+    std::unordered_map<std::string, PoseEstimate> poseEstimates_;  // source -> latest
+    std::optional<PoseEstimate> fusedPose_;
+    int fusedSources_ = 0;
+
+    mutable std::mutex mutex_;
+};
+
+} // namespace vision
@@ -0,0 +1,168 @@
+#include "services/frame_bus_service.hpp"
+#include "core/config.hpp"
+#include <opencv2/imgproc.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+#ifdef VISION_WITH_FRAMEBUS
+#include <vision_framebus.h>
+#endif
+
+namespace vision {
+
+FrameBusService& FrameBusService::instance() {
+    static FrameBusService instance;
+    return instance;
+}
+
+FrameBusService::~FrameBusService() {
+    closeAll();
+}
+
+void FrameBusService::initialize() {
+    const auto& config = Config::instance().framebus;
+#ifdef VISION_WITH_FRAMEBUS
+    enabled_ = config.enabled;
+    gray_ = config.format != "bgr";
+    slots_ = std::clamp(config.slots, 2, static_cast<int>(VFB_MAX_SLOTS));
+    if (enabled_) {
+        spdlog::info("Frame bus enabled ({} format, {} slots)", gray_ ? "y8" : "bgr", slots_);
+    }
+#else
+    if (config.enabled) {
+        spdlog::warn("Frame bus requested but not available on this platform");
+    }
+#endif
+}
+
+std::shared_ptr<FrameBusService::Ring> FrameBusService::getRing(int cameraId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& ring = rings_[cameraId];
+    if (!ring) {
+        ring = std::make_shared<Ring>();
+    }
+    return ring;
+}
+
+#ifdef VISION_WITH_FRAMEBUS
+
+void FrameBusService::publish(int cameraId, const cv::Mat& frame,
+                              std::chrono::steady_clock::time_point captureTime, uint64_t sequence,
+                              ExposureClass exposure) {
+    if (!enabled_ || frame.empty() || frame.depth() != CV_8U) return;
+
+    auto ring = getRing(cameraId);
+    std::lock_guard<std::mutex> lock(ring->mutex);
+
+    const cv::Mat* source = &frame;
+    uint32_t format = frame.channels() == 1 ? VFB_FORMAT_Y8 : VFB_FORMAT_BGR8;
+    if (gray_ && frame.channels() == 3) {
+        cv::cvtColor(frame, ring->scratch, cv::COLOR_BGR2GRAY);
+        source = &ring->scratch;
+        format = VFB_FORMAT_Y8;
+    } else if (frame.channels() != 1 && frame.channels() != 3) {
+        return;
+    }
+
+    uint64_t frameBytes = static_cast<uint64_t>(source->cols) * source->rows * source->elemSize();
+
+    // (Re)create the ring when the camera first streams or its resolution grows
+    if (!ring->writer || vfb_writer_capacity(ring->writer) < frameBytes) {
+        if (ring->writer) {
+            vfb_writer_destroy(ring->writer);
+        }
+        int status = VFB_OK;
+        ring->writer = vfb_writer_create(cameraId, static_cast<uint32_t>(slots_), frameBytes, &status);
+        if (!ring->writer) {
+            spdlog::warn("Failed to create frame bus ring for camera {} (status {})", cameraId, status);
+            return;
+        }
+        applyCalibration(*ring);
+        spdlog::info("Frame bus ring created for camera {} ({}x{}, {} bytes/slot)",
+            cameraId, source->cols, source->rows, frameBytes);
+    }
+
+    int64_t captureUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        captureTime.time_since_epoch()).count();
+    uint32_t exposureTag = exposure == ExposureClass::Short ? VFB_EXPOSURE_SHORT
+                         : exposure == ExposureClass::Long ? VFB_EXPOSURE_LONG
+                         : VFB_EXPOSURE_ANY;
+    vfb_writer_publish(ring->writer, source->data,
+        static_cast<uint32_t>(source->cols), static_cast<uint32_t>(source->rows),
+        static_cast<uint32_t>(source->step[0]), format, exposureTag, sequence, captureUs);
+}
+
+void FrameBusService::setCalibration(int cameraId, const cv::Mat& cameraMatrix, const cv::Mat& distCoeffs) {
+    if (!enabled_) return;
+
+    auto ring = getRing(cameraId);
+    std::lock_guard<std::mutex> lock(ring->mutex);
+    ring->hasCalibration = !cameraMatrix.empty();
+    cameraMatrix.convertTo(ring->cameraMatrix, CV_64F);
+    distCoeffs.convertTo(ring->distCoeffs, CV_64F);
+    applyCalibration(*ring);
+}
+
+void FrameBusService::applyCalibration(Ring& ring) {
+    if (!ring.writer) return;
+
+    vfb_calibration calib{};
+    if (ring.hasCalibration && ring.cameraMatrix.total() == 9) {
+        calib.valid = 1;
+        for (int i = 0; i < 9; i++) {
+            calib.camera_matrix[i] = ring.cameraMatrix.at<double>(i / 3, i % 3);
+        }
+        size_t count = std::min<size_t>(ring.distCoeffs.total(), 14);
+        calib.dist_count = static_cast<uint32_t>(count);
+        for (size_t i = 0; i < count; i++) {
+            calib.dist_coeffs[i] = ring.distCoeffs.ptr<double>()[i];
+        }
+    }
+    vfb_writer_set_calibration(ring.writer, &calib);
+}
+
+void FrameBusService::close(int cameraId) {
+    std::shared_ptr<Ring> ring;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = rings_.find(cameraId);
+        if (it == rings_.end()) return;
+        ring = it->second;
+        rings_.erase(it);
+    }
+
+    std::lock_guard<std::mutex> lock(ring->mutex);
+    if (ring->writer) {
+        vfb_writer_destroy(ring->writer);
+        ring->writer = nullptr;
+    }
+}
+
+void FrameBusService::closeAll() {
+    std::unordered_map<int, std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings.swap(rings_);
+    }
+
+    for (auto& [cameraId, ring] : rings) {
+        std::lock_guard<std::mutex> lock(ring->mutex);
+        if (ring->writer) {
+            vfb_writer_destroy(ring->writer);
+            ring->writer = nullptr;
+        }
+    }
+}
+
+#else
+
+// Stub implementation when shared memory is not available (Windows)
+void FrameBusService::publish(int, const cv::Mat&, std::chrono::steady_clock::time_point, uint64_t, ExposureClass) {}
+void FrameBusService::setCalibration(int, const cv::Mat&, const cv::Mat&) {}
+void FrameBusService::applyCalibration(Ring&) {}
+void FrameBusService::close(int) {}
+void FrameBusService::closeAll() {}
+
+#endif
+
+} // namespace vision
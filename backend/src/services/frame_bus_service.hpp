@@ -0,0 +1,64 @@
+#pragma once
+
+#include "utils/frame_buffer.hpp"
+#include <opencv2/core.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct vfb_writer;
+
+namespace vision {
+
+// Publishes camera frames to per-camera shared-memory rings (/dev/shm/vision_cam<id>)
+// so external processes can read them without going through MJPEG.
+class FrameBusService {
+public:
+    static FrameBusService& instance();
+
+    // Read settings from Config; publishing is a no-op unless enabled
+    void initialize();
+    bool isEnabled() const { return enabled_; }
+
+    // Called from the camera thread after each capture; never blocks on readers
+    void publish(int cameraId, const cv::Mat& frame,
+                 std::chrono::steady_clock::time_point captureTime, uint64_t sequence,
+                 ExposureClass exposure = ExposureClass::Any);
+
+    // Publish intrinsics alongside the stream (empty matrix clears them)
+    void setCalibration(int cameraId, const cv::Mat& cameraMatrix, const cv::Mat& distCoeffs);
+
+    void close(int cameraId);
+    void closeAll();
+
+private:
+    FrameBusService() = default;
+    ~FrameBusService();
+
+    FrameBusService(const FrameBusService&) = delete;
+    FrameBusService& operator=(const FrameBusService&) = delete;
+
+    struct Ring {
+        std::mutex mutex;
+        vfb_writer* writer = nullptr;
+        cv::Mat scratch;              // Y8 conversion buffer
+        bool hasCalibration = false;
+        cv::Mat cameraMatrix;
+        cv::Mat distCoeffs;
+    };
+
+    std::shared_ptr<Ring> getRing(int cameraId);
+    void applyCalibration(Ring& ring);
+
+    bool enabled_ = false;
+    bool gray_ = true;
+    int slots_ = 4;
+
+    std::unordered_map<int, std::shared_ptr<Ring>> rings_;
+    std::mutex mutex_;
+};
+
+} // namespace vision
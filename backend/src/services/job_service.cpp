@@ -0,0 +1,190 @@
+// Windows compatibility - must be included before any Drogon headers
+#include "platform/win32_compat.hpp"
+
+#include "services/job_service.hpp"
+#include "routes/vision_ws.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace vision {
+
+namespace {
+
+// Finished jobs kept around for late GET /api/jobs/{id} polls
+constexpr size_t kFinishedJobsRetained = 64;
+
+} // namespace
+
+nlohmann::json JobInfo::toJson() const {
+    nlohmann::json j = {
+        {"id", id},
+        {"kind", kind},
+        {"state", state},
+        {"progress", progress},
+        {"message", message},
+        {"created", std::chrono::duration_cast<std::chrono::milliseconds>(
+                        created.time_since_epoch()).count()}
+    };
+    if (state == JobState::Done) {
+        j["result"] = result;
+    }
+    if (state == JobState::Failed) {
+        j["error"] = error;
+    }
+    return j;
+}
+
+void JobContext::progress(double fraction, const std::string& message) {
+    service_.update(id_, [&](JobInfo& job) {
+        job.progress = (std::clamp)(fraction, 0.0, 1.0);
+        job.message = message;
+    });
+}
+
+JobService& JobService::instance() {
+    static JobService instance;
+    return instance;
+}
+
+JobService::~JobService() {
+    stop();
+}
+
+void JobService::start(int threads, int maxQueued) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) return;
+
+    running_ = true;
+    maxQueued_ = static_cast<size_t>((std::max)(1, maxQueued));
+    int count = (std::max)(1, threads);
+    for (int i = 0; i < count; i++) {
+        workers_.emplace_back(&JobService::workerLoop, this);
+    }
+    spdlog::info("Job service started with {} compute threads (queue limit {})", count, maxQueued_);
+}
+
+void JobService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+        queue_.clear();
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+bool JobService::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || queue_.size() >= maxQueued_) {
+            return false;
+        }
+        queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+    return true;
+}
+
+std::optional<std::string> JobService::submit(const std::string& kind,
+                                              std::function<nlohmann::json(JobContext&)> work) {
+    std::string id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || queue_.size() >= maxQueued_) {
+            return std::nullopt;
+        }
+
+        id = kind + "-" + std::to_string(nextId_++);
+        JobInfo job;
+        job.id = id;
+        job.kind = kind;
+        job.message = "Queued";
+        job.created = std::chrono::system_clock::now();
+        jobs_[id] = job;
+
+        queue_.push_back([this, id, work = std::move(work)]() {
+            update(id, [](JobInfo& job) {
+                job.state = JobState::Running;
+                job.message = "Running";
+            });
+
+            JobContext context(*this, id);
+            try {
+                auto result = work(context);
+                update(id, [&](JobInfo& job) {
+                    job.state = JobState::Done;
+                    job.progress = 1.0;
+                    job.message = "Done";
+                    job.result = std::move(result);
+                });
+            } catch (const std::exception& e) {
+                spdlog::error("Job {} failed: {}", id, e.what());
+                update(id, [&](JobInfo& job) {
+                    job.state = JobState::Failed;
+                    job.message = "Failed";
+                    job.error = e.what();
+                });
+            }
+        });
+    }
+    cv_.notify_one();
+    return id;
+}
+
+std::optional<JobInfo> JobService::get(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(id);
+    if (it == jobs_.end()) return std::nullopt;
+    return it->second;
+}
+
+void JobService::update(const std::string& id, const std::function<void(JobInfo&)>& fn) {
+    nlohmann::json snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(id);
+        if (it == jobs_.end()) return;
+        fn(it->second);
+        if (it->second.state == JobState::Done || it->second.state == JobState::Failed) {
+            finished_.push_back(id);
+            pruneLocked();
+        }
+        snapshot = it->second.toJson();
+    }
+    // Broadcast outside the lock; the WebSocket takes its own
+    VisionWebSocket::instance().broadcastJob(id, snapshot);
+}
+
+void JobService::pruneLocked() {
+    while (finished_.size() > kFinishedJobsRetained) {
+        jobs_.erase(finished_.front());
+        finished_.pop_front();
+    }
+}
+
+void JobService::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+            if (!running_) return;
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            spdlog::error("Compute task threw: {}", e.what());
+        }
+    }
+}
+
+} // namespace vision
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vision {
+
+enum class JobState {
+    Queued,
+    Running,
+    Done,
+    Failed
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(JobState, {
+    {JobState::Queued, "queued"},
+    {JobState::Running, "running"},
+    {JobState::Done, "done"},
+    {JobState::Failed, "failed"}
+})
+
+// Snapshot of a tracked job, as returned by GET /api/jobs/{id} and pushed over the WebSocket
+struct JobInfo {
+    std::string id;
+    std::string kind;
+    JobState state = JobState::Queued;
+    double progress = 0.0;      // 0..1
+    std::string message;
+    nlohmann::json result;      // Set when done
+    std::string error;          // Set when failed
+    std::chrono::system_clock::time_point created;
+
+    nlohmann::json toJson() const;
+};
+
+// Handed to tracked work so it can report progress
+class JobContext {
+public:
+    JobContext(class JobService& service, std::string id) : service_(service), id_(std::move(id)) {}
+
+    void progress(double fraction, const std::string& message);
+    const std::string& id() const { return id_; }
+
+private:
+    JobService& service_;
+    std::string id_;
+};
+
+// Bounded compute executor for CPU-heavy or blocking request handlers, so they
+// never run on (and stall) the Drogon IO event loops.
+class JobService {
+public:
+    static JobService& instance();
+
+    void start(int threads, int maxQueued);
+    void stop();
+
+    // Run a task on a compute thread; false when the queue is full
+    bool post(std::function<void()> task);
+
+    // Run a tracked job; returns its ID, or nullopt when the queue is full.
+    // The work's return value becomes the job result; an exception fails the job.
+    std::optional<std::string> submit(const std::string& kind,
+                                      std::function<nlohmann::json(JobContext&)> work);
+
+    std::optional<JobInfo> get(const std::string& id) const;
+
+private:
+    friend class JobContext;
+
+    JobService() = default;
+    ~JobService();
+
+    JobService(const JobService&) = delete;
+    JobService& operator=(const JobService&) = delete;
+
+    void workerLoop();
+    void update(const std::string& id, const std::function<void(JobInfo&)>& fn);
+    void pruneLocked();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_ = false;
+    size_t maxQueued_ = 16;
+
+    std::map<std::string, JobInfo> jobs_;
+    std::deque<std::string> finished_;   // Oldest first, for pruning
+    uint64_t nextId_ = 1;
+};
+
+} // namespace vision
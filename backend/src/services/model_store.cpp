@@ -0,0 +1,263 @@
+#include "services/model_store.hpp"
+#include "services/pipeline_service.hpp"
+#include "threads/thread_manager.hpp"
+#include "utils/sha256.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+namespace vision {
+
+namespace {
+    constexpr size_t CHUNK_SIZE = 1 << 20;  // 1 MiB write/hash granularity
+    constexpr const char* TEMP_PREFIX = ".upload-";
+
+    // Read a protobuf varint, returns false if truncated or overlong
+    bool readVarint(std::string_view data, size_t& pos, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos < data.size(); shift += 7) {
+            uint8_t byte = static_cast<uint8_t>(data[pos++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+nlohmann::json ModelInstallResult::toJson() const {
+    return nlohmann::json{
+        {"filename", filename},
+        {"sha256", sha256},
+        {"size", size},
+        {"deduplicated", deduplicated},
+        {"replaced", replaced}
+    };
+}
+
+ModelStore& ModelStore::instance() {
+    static ModelStore instance;
+    return instance;
+}
+
+std::filesystem::path ModelStore::modelsDir() const {
+    return std::filesystem::current_path() / "data" / "models";
+}
+
+std::string ModelStore::sanitizeFilename(const std::string& filename) {
+    std::string name = std::filesystem::path(filename).filename().string();
+    if (name.empty() || name == "." || name == ".." || name.rfind(TEMP_PREFIX, 0) == 0) {
+        throw std::runtime_error("Invalid filename");
+    }
+    return name;
+}
+
+void ModelStore::validateOnnxHeader(std::string_view content) {
+    // ONNX files are a serialized ModelProto; serializers emit ir_version (field 1, varint) first
+    if (content.size() < 16 || static_cast<uint8_t>(content[0]) != 0x08) {
+        throw std::runtime_error("File is not an ONNX model (missing ir_version header)");
+    }
+
+    size_t pos = 1;
+    uint64_t irVersion = 0;
+    if (!readVarint(content, pos, irVersion) || irVersion == 0 || irVersion > 64) {
+        throw std::runtime_error("File is not an ONNX model (invalid ir_version)");
+    }
+
+    // The following field must be a well-formed ModelProto tag
+    uint64_t tag = 0;
+    if (!readVarint(content, pos, tag)) {
+        throw std::runtime_error("File is not an ONNX model (truncated header)");
+    }
+    uint64_t fieldNumber = tag >> 3;
+    uint64_t wireType = tag & 0x7;
+    if (fieldNumber == 0 || fieldNumber > 32 || (wireType != 0 && wireType != 2)) {
+        throw std::runtime_error("File is not an ONNX model (unexpected field after ir_version)");
+    }
+}
+
+void ModelStore::validateLabels(std::string_view content) {
+    std::string_view head = content.substr(0, std::min<size_t>(content.size(), 4096));
+    if (head.find('\0') != std::string_view::npos) {
+        throw std::runtime_error("Labels file must be plain text");
+    }
+}
+
+std::string ModelStore::hashFile(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hashFileLocked(path);
+}
+
+std::string ModelStore::hashFileLocked(const std::filesystem::path& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return "";
+    }
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return "";
+    }
+
+    auto key = path.string();
+    auto it = hashCache_.find(key);
+    if (it != hashCache_.end() && it->second.size == size && it->second.mtime == mtime) {
+        return it->second.sha256;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return "";
+    }
+
+    Sha256 hasher;
+    std::vector<char> buffer(CHUNK_SIZE);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        auto count = file.gcount();
+        if (count > 0) {
+            hasher.update(buffer.data(), static_cast<size_t>(count));
+        }
+    }
+
+    std::string digest = hasher.hexDigest();
+    hashCache_[key] = HashEntry{size, mtime, digest};
+    return digest;
+}
+
+std::string ModelStore::findByHash(const std::string& sha256, const std::string& extension) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(modelsDir(), ec)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        auto name = entry.path().filename().string();
+        if (name.rfind(TEMP_PREFIX, 0) == 0 || entry.path().extension().string() != extension) {
+            continue;
+        }
+        if (hashFileLocked(entry.path()) == sha256) {
+            return name;
+        }
+    }
+    return "";
+}
+
+ModelInstallResult ModelStore::install(const std::string& filename,
+                                       const std::string& fileType,
+                                       std::string_view content) {
+    std::string name = sanitizeFilename(filename);
+
+    if (fileType == "model") {
+        validateOnnxHeader(content);
+    } else if (fileType == "labels") {
+        validateLabels(content);
+    } else {
+        throw std::runtime_error("Unknown file type: " + fileType);
+    }
+
+    auto dir = modelsDir();
+    std::filesystem::create_directories(dir);
+
+    // Stream to a temp file in the same directory so the final rename is atomic
+    static std::atomic<uint64_t> uploadCounter{0};
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    auto tempPath = dir / (std::string(TEMP_PREFIX) + std::to_string(stamp) + "-" +
+                           std::to_string(uploadCounter.fetch_add(1)) + ".part");
+
+    Sha256 hasher;
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to create file");
+        }
+        for (size_t offset = 0; offset < content.size(); offset += CHUNK_SIZE) {
+            auto chunk = content.substr(offset, CHUNK_SIZE);
+            hasher.update(chunk.data(), chunk.size());
+            file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            if (!file.good()) {
+                file.close();
+                std::filesystem::remove(tempPath);
+                throw std::runtime_error("Failed to write file content");
+            }
+        }
+        file.close();
+        if (file.fail()) {
+            std::filesystem::remove(tempPath);
+            throw std::runtime_error("Failed to close file properly");
+        }
+    }
+
+    ModelInstallResult result;
+    result.filename = name;
+    result.sha256 = hasher.hexDigest();
+    result.size = content.size();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto target = dir / name;
+
+    std::error_code ec;
+    if (std::filesystem::exists(target) && hashFileLocked(target) == result.sha256) {
+        // Same name, same bytes - nothing to install
+        std::filesystem::remove(tempPath, ec);
+        result.deduplicated = true;
+    } else if (auto existing = findByHash(result.sha256, target.extension().string());
+               !existing.empty() && !std::filesystem::exists(target)) {
+        // Identical content already installed under another name - reuse it
+        std::filesystem::remove(tempPath, ec);
+        result.filename = existing;
+        result.deduplicated = true;
+    } else {
+        result.replaced = std::filesystem::exists(target);
+        std::filesystem::rename(tempPath, target, ec);
+        if (ec) {
+            std::filesystem::remove(tempPath);
+            throw std::runtime_error("Failed to install file: " + ec.message());
+        }
+        auto mtime = std::filesystem::last_write_time(target, ec);
+        hashCache_[target.string()] = HashEntry{result.size, mtime, result.sha256};
+    }
+
+    spdlog::info("Installed {} '{}' ({} bytes, sha256 {}){}", fileType, result.filename,
+                 result.size, result.sha256.substr(0, 12),
+                 result.deduplicated ? " [deduplicated]" : "");
+    return result;
+}
+
+std::vector<int> ModelStore::reloadPipelinesUsing(const std::string& filename, int excludePipelineId) {
+    std::vector<int> reloaded;
+    for (const auto& pipeline : PipelineService::instance().getAllPipelines()) {
+        if (pipeline.id == excludePipelineId || pipeline.pipeline_type != PipelineType::ObjectDetectionML) {
+            continue;
+        }
+        auto config = pipeline.getConfigJson();
+        if (config.value("model_filename", "") != filename &&
+            config.value("labels_filename", "") != filename) {
+            continue;
+        }
+        if (ThreadManager::instance().isPipelineRunning(pipeline.id)) {
+            ThreadManager::instance().updatePipelineConfig(pipeline.id, config);
+            reloaded.push_back(pipeline.id);
+        }
+    }
+    return reloaded;
+}
+
+bool ModelStore::isReferenced(const std::string& filename, int excludePipelineId) {
+    for (const auto& pipeline : PipelineService::instance().getAllPipelines()) {
+        if (pipeline.id == excludePipelineId) {
+            continue;
+        }
+        auto config = pipeline.getConfigJson();
+        if (config.value("model_filename", "") == filename ||
+            config.value("labels_filename", "") == filename) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace vision
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vision {
+
+// Outcome of installing an uploaded model/labels file
+struct ModelInstallResult {
+    std::string filename;       // Name the pipeline config should reference
+    std::string sha256;
+    uint64_t size = 0;
+    bool deduplicated = false;  // Identical content already existed on disk
+    bool replaced = false;      // An existing file with this name was overwritten
+
+    nlohmann::json toJson() const;
+};
+
+// Owns data/models: streams uploads to disk, validates and installs them atomically
+class ModelStore {
+public:
+    // Singleton access
+    static ModelStore& instance();
+
+    std::filesystem::path modelsDir() const;
+
+    // Stream content to a temp file while hashing, validate, then rename into place.
+    // Throws std::runtime_error if the content is rejected.
+    ModelInstallResult install(const std::string& filename,
+                               const std::string& fileType,
+                               std::string_view content);
+
+    // Push the current config to every running pipeline that references filename
+    std::vector<int> reloadPipelinesUsing(const std::string& filename, int excludePipelineId = -1);
+
+    // True if any pipeline other than excludePipelineId references filename
+    bool isReferenced(const std::string& filename, int excludePipelineId = -1);
+
+    // Cached SHA-256 of a file (recomputed when size or mtime changes)
+    std::string hashFile(const std::filesystem::path& path);
+
+    // Reject names that would escape the models directory
+    static std::string sanitizeFilename(const std::string& filename);
+
+private:
+    ModelStore() = default;
+
+    // Returns an installed file with the given hash, or empty
+    std::string findByHash(const std::string& sha256, const std::string& extension);
+    std::string hashFileLocked(const std::filesystem::path& path);
+
+    static void validateOnnxHeader(std::string_view content);
+    static void validateLabels(std::string_view content);
+
+    struct HashEntry {
+        uintmax_t size = 0;
+        std::filesystem::file_time_type mtime;
+        std::string sha256;
+    };
+
+    std::unordered_map<std::string, HashEntry> hashCache_;
+    std::mutex mutex_;
+};
+
+} // namespace vision
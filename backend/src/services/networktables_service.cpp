@@ -1,9 +1,47 @@
 #include "services/networktables_service.hpp"
 #include <spdlog/spdlog.h>
+#include <charconv>
 #include <sstream>
+#include <string_view>
 
 namespace vision {
 
+namespace {
+
+constexpr std::string_view kControlPrefix = "/Vision/control/";
+constexpr std::string_view kFmsPrefix = "/FMSInfo/";
+constexpr std::string_view kFmsControlDataTopic = "/FMSInfo/FMSControlData";
+constexpr std::string_view kFmsEventNameTopic = "/FMSInfo/EventName";
+constexpr std::string_view kFmsMatchTypeTopic = "/FMSInfo/MatchType";
+constexpr std::string_view kFmsMatchNumberTopic = "/FMSInfo/MatchNumber";
+constexpr std::string_view kFmsReplayNumberTopic = "/FMSInfo/ReplayNumber";
+
+// FMSControlData bits (see frc::DriverStation)
+constexpr int64_t kControlEnabled = 0x01;
+constexpr int64_t kControlAutonomous = 0x02;
+constexpr int64_t kControlTest = 0x04;
+constexpr int64_t kControlEStop = 0x08;
+constexpr int64_t kControlFmsAttached = 0x10;
+constexpr int64_t kControlDsAttached = 0x20;
+
+// "pipeline12/enabled" with prefix "pipeline" and suffix "/enabled" -> 12
+std::optional<int> parseIndexedKey(std::string_view key, std::string_view prefix, std::string_view suffix) {
+    if (key.size() <= prefix.size() + suffix.size() ||
+        key.substr(0, prefix.size()) != prefix ||
+        key.substr(key.size() - suffix.size()) != suffix) {
+        return std::nullopt;
+    }
+    auto digits = key.substr(prefix.size(), key.size() - prefix.size() - suffix.size());
+    int id = 0;
+    auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), id);
+    if (ec != std::errc() || ptr != digits.data() + digits.size()) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+} // namespace
+
 NetworkTablesService& NetworkTablesService::instance() {
     static NetworkTablesService instance;
     return instance;
@@ -84,12 +122,19 @@ void NetworkTablesService::disconnect() {
             std::lock_guard<std::mutex> lock(mutex_);
             mode_ = "disconnected";
             visionTable_.reset();
+            if (controlListener_) {
+                nt::NetworkTableInstance::RemoveListener(controlListener_);
+                controlListener_ = 0;
+            }
+            controlSubscriber_.reset();
         }
 
         {
             std::lock_guard<std::mutex> lock(publisherMutex_);
             detectionPublishers_.clear();
             tagPosePublishers_.clear();
+            remoteDetectionPublishers_.clear();
+            remoteFlowPublishers_.clear();
         }
 
         connected_.store(false, std::memory_order_release);
@@ -119,6 +164,114 @@ void NetworkTablesService::ensureTable() {
         posePublisher_ = visionTable_->GetDoubleArrayTopic("robotPose").Publish();
         poseTimestampPublisher_ = visionTable_->GetDoubleTopic("poseTimestamp").Publish();
         tagsUsedPublisher_ = visionTable_->GetIntegerTopic("tagsUsed").Publish();
+
+        // Robot-side activation and match state; kImmediate replays values set before we connected
+        std::string_view prefixes[] = {kControlPrefix, kFmsPrefix};
+        controlSubscriber_.emplace(ntInst_, prefixes);
+        controlListener_ = ntInst_.AddListener(
+            prefixes, nt::EventFlags::kValueAll | nt::EventFlags::kImmediate,
+            [this](const nt::Event& event) { handleControlEvent(event); });
+    }
+}
+
+void NetworkTablesService::setActivationCallbacks(PipelineEnabledCallback onPipelineEnabled,
+                                                  ActivePipelinesCallback onActivePipelines) {
+    std::lock_guard<std::mutex> lock(activationMutex_);
+    pipelineEnabledCallback_ = std::move(onPipelineEnabled);
+    activePipelinesCallback_ = std::move(onActivePipelines);
+}
+
+void NetworkTablesService::setRobotStateCallback(RobotStateCallback callback) {
+    std::lock_guard<std::mutex> lock(activationMutex_);
+    robotStateCallback_ = std::move(callback);
+}
+
+void NetworkTablesService::setMatchInfoCallback(MatchInfoCallback callback) {
+    std::lock_guard<std::mutex> lock(activationMutex_);
+    matchInfoCallback_ = std::move(callback);
+}
+
+int64_t NetworkTablesService::toServerTimeUs(std::chrono::steady_clock::time_point time) const {
+    auto age = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - time).count();
+    return nt::Now() - age + ntInst_.GetServerTimeOffset().value_or(0);
+}
+
+void NetworkTablesService::handleControlEvent(const nt::Event& event) {
+    const auto* data = event.GetValueEventData();
+    if (!data) return;
+
+    std::string name = nt::GetTopicName(data->topic);
+    if (name == kFmsEventNameTopic || name == kFmsMatchTypeTopic ||
+        name == kFmsMatchNumberTopic || name == kFmsReplayNumberTopic) {
+        MatchInfoCallback onMatchInfo;
+        MatchInfo info;
+        {
+            std::lock_guard<std::mutex> lock(activationMutex_);
+            MatchInfo next = matchInfo_;
+            if (name == kFmsEventNameTopic && data->value.IsString()) {
+                next.eventName = std::string(data->value.GetString());
+            } else if (data->value.IsInteger()) {
+                int value = static_cast<int>(data->value.GetInteger());
+                if (name == kFmsMatchTypeTopic) next.matchType = value;
+                else if (name == kFmsMatchNumberTopic) next.matchNumber = value;
+                else next.replayNumber = value;
+            }
+            if (next == matchInfo_) return;
+            matchInfo_ = next;
+            info = next;
+            onMatchInfo = matchInfoCallback_;
+        }
+        if (onMatchInfo) onMatchInfo(info);
+        return;
+    }
+    if (name == kFmsControlDataTopic) {
+        if (!data->value.IsInteger()) return;
+        int64_t bits = data->value.GetInteger();
+        RobotState state;
+        state.enabled = bits & kControlEnabled;
+        state.autonomous = bits & kControlAutonomous;
+        state.test = bits & kControlTest;
+        state.emergencyStop = bits & kControlEStop;
+        state.fmsAttached = bits & kControlFmsAttached;
+        state.dsAttached = bits & kControlDsAttached;
+
+        RobotStateCallback onRobotState;
+        {
+            std::lock_guard<std::mutex> lock(activationMutex_);
+            onRobotState = robotStateCallback_;
+        }
+        if (onRobotState) onRobotState(state);
+        return;
+    }
+    if (name.rfind(kControlPrefix, 0) != 0) return;
+    std::string_view key = std::string_view(name).substr(kControlPrefix.size());
+    const auto& value = data->value;
+
+    PipelineEnabledCallback onPipelineEnabled;
+    ActivePipelinesCallback onActivePipelines;
+    {
+        std::lock_guard<std::mutex> lock(activationMutex_);
+        onPipelineEnabled = pipelineEnabledCallback_;
+        onActivePipelines = activePipelinesCallback_;
+    }
+
+    try {
+        if (auto pipelineId = parseIndexedKey(key, "pipeline", "/enabled")) {
+            if (!value.IsBoolean()) return;
+            spdlog::info("NetworkTables: pipeline {} {} by robot", *pipelineId,
+                         value.GetBoolean() ? "enabled" : "disabled");
+            if (onPipelineEnabled) onPipelineEnabled(*pipelineId, value.GetBoolean());
+        } else if (auto cameraId = parseIndexedKey(key, "camera", "/activePipelines")) {
+            if (!value.IsIntegerArray()) return;
+            auto raw = value.GetIntegerArray();
+            std::vector<int> pipelineIds(raw.begin(), raw.end());
+            spdlog::info("NetworkTables: camera {} active pipelines set by robot ({} listed)", *cameraId,
+                         pipelineIds.size());
+            if (onActivePipelines) onActivePipelines(*cameraId, pipelineIds);
+        }
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to apply NetworkTables control value {}: {}", name, e.what());
     }
 }
 
@@ -143,6 +296,27 @@ void NetworkTablesService::publishDetections(int cameraId, const nlohmann::json&
     }
 }
 
+void NetworkTablesService::publishRemoteDetections(const std::string& nodeId, int cameraId,
+                                                   const nlohmann::json& detections) {
+    if (!connected_.load(std::memory_order_acquire) || !autoPublish_.load(std::memory_order_acquire)) return;
+
+    try {
+        ensureTable();
+
+        std::lock_guard<std::mutex> lock(publisherMutex_);
+        std::string key = "nodes/" + nodeId + "/camera" + std::to_string(cameraId) + "/detections";
+        auto it = remoteDetectionPublishers_.find(key);
+        if (it == remoteDetectionPublishers_.end()) {
+            auto publisher = visionTable_->GetStringTopic(key).Publish();
+            it = remoteDetectionPublishers_.emplace(key, std::move(publisher)).first;
+        }
+
+        it->second.Set(detections.dump());
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to publish remote detections: {}", e.what());
+    }
+}
+
 void NetworkTablesService::publishRobotPose(const Pose3d& pose, double timestamp, int tagsUsed) {
     if (!connected_.load(std::memory_order_acquire) || !autoPublish_.load(std::memory_order_acquire)) return;
 
@@ -226,6 +400,38 @@ void NetworkTablesService::publishOpticalFlowVelocity(double vx_mps, double vy_m
     }
 }
 
+void NetworkTablesService::publishRemoteOpticalFlowVelocity(const std::string& nodeId, int cameraId,
+                                                             double vx_mps, double vy_mps,
+                                                             int64_t timestamp_us, int features, bool valid) {
+    if (!connected_.load(std::memory_order_acquire) || !autoPublish_.load(std::memory_order_acquire)) return;
+
+    try {
+        ensureTable();
+
+        std::lock_guard<std::mutex> lock(publisherMutex_);
+        std::string key = "nodes/" + nodeId + "/camera" + std::to_string(cameraId) + "/opticalFlow";
+        auto it = remoteFlowPublishers_.find(key);
+        if (it == remoteFlowPublishers_.end()) {
+            auto flowTable = visionTable_->GetSubTable(key);
+            FlowPublishers publishers{
+                flowTable->GetDoubleArrayTopic("velocity").Publish(),
+                flowTable->GetIntegerTopic("timestamp").Publish(),
+                flowTable->GetIntegerTopic("features").Publish(),
+                flowTable->GetBooleanTopic("valid").Publish()
+            };
+            it = remoteFlowPublishers_.emplace(key, std::move(publishers)).first;
+        }
+
+        std::vector<double> velocity = {vx_mps, vy_mps};
+        it->second.velocity.Set(velocity);
+        it->second.timestamp.Set(timestamp_us);
+        it->second.features.Set(features);
+        it->second.valid.Set(valid);
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to publish remote optical flow: {}", e.what());
+    }
+}
+
 void NetworkTablesService::registerStatusCallback(StatusCallback callback) {
     std::lock_guard<std::mutex> lock(callbackMutex_);
     statusCallbacks_.push_back(std::move(callback));
@@ -5,6 +5,7 @@
 #include <optional>
 #include <unordered_map>
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <functional>
 #include <thread>
@@ -18,6 +19,7 @@
 #include <networktables/BooleanTopic.h>
 #include <networktables/DoubleArrayTopic.h>
 #include <networktables/IntegerTopic.h>
+#include <networktables/MultiSubscriber.h>
 
 namespace vision {
 
@@ -27,6 +29,46 @@ struct NTStatus;
 // Callback type for status change notifications
 using StatusCallback = std::function<void(const NTStatus&)>;
 
+// Robot state from FMSInfo/FMSControlData (published by every WPILib robot program)
+struct RobotState {
+    bool enabled = false;
+    bool autonomous = false;
+    bool test = false;
+    bool emergencyStop = false;
+    bool fmsAttached = false;
+    bool dsAttached = false;
+
+    nlohmann::json toJson() const {
+        return {
+            {"enabled", enabled},
+            {"autonomous", autonomous},
+            {"test", test},
+            {"emergency_stop", emergencyStop},
+            {"fms_attached", fmsAttached},
+            {"ds_attached", dsAttached}
+        };
+    }
+};
+
+using RobotStateCallback = std::function<void(const RobotState&)>;
+
+// Match identity from FMSInfo (EventName, MatchType, MatchNumber, ReplayNumber)
+struct MatchInfo {
+    std::string eventName;
+    int matchType = 0;  // 0 none, 1 practice, 2 qualification, 3 elimination
+    int matchNumber = 0;
+    int replayNumber = 0;
+
+    bool operator==(const MatchInfo&) const = default;
+};
+
+using MatchInfoCallback = std::function<void(const MatchInfo&)>;
+
+// Robot-driven activation: Vision/control/pipeline<id>/enabled (boolean)
+using PipelineEnabledCallback = std::function<void(int pipelineId, bool enabled)>;
+// Vision/control/camera<id>/activePipelines (integer array; empty = all)
+using ActivePipelinesCallback = std::function<void(int cameraId, const std::vector<int>& pipelineIds)>;
+
 // Connection status for UI
 struct NTStatus {
     bool connected = false;
@@ -64,6 +106,9 @@ public:
     // Publish detection results for a camera
     void publishDetections(int cameraId, const nlohmann::json& detections);
 
+    // Publish detections for a camera owned by a cluster follower node
+    void publishRemoteDetections(const std::string& nodeId, int cameraId, const nlohmann::json& detections);
+
     // Publish robot pose from multi-tag estimation
     void publishRobotPose(const Pose3d& pose, double timestamp, int tagsUsed);
 
@@ -74,6 +119,11 @@ public:
     void publishOpticalFlowVelocity(double vx_mps, double vy_mps,
                                      int64_t timestamp_us, int features, bool valid);
 
+    // Publish optical flow from a cluster follower node, kept apart from the local flow topic
+    void publishRemoteOpticalFlowVelocity(const std::string& nodeId, int cameraId,
+                                          double vx_mps, double vy_mps,
+                                          int64_t timestamp_us, int features, bool valid);
+
     // Set whether to auto-publish (called by pipeline manager)
     void setAutoPublish(bool enabled) { autoPublish_.store(enabled, std::memory_order_release); }
     bool isAutoPublishing() const { return autoPublish_.load(std::memory_order_acquire); }
@@ -83,6 +133,20 @@ public:
     void startStatusMonitor();
     void stopStatusMonitor();
 
+    // Activation requests from the robot; invoked on the NetworkTables listener thread
+    void setActivationCallbacks(PipelineEnabledCallback onPipelineEnabled,
+                                ActivePipelinesCallback onActivePipelines);
+
+    // Robot enable/mode changes; invoked on the NetworkTables listener thread
+    void setRobotStateCallback(RobotStateCallback callback);
+
+    // Match changes; invoked on the NetworkTables listener thread
+    void setMatchInfoCallback(MatchInfoCallback callback);
+
+    // A steady_clock instant in the NT server time base (microseconds), as AdvantageScope
+    // aligns robot logs; falls back to local NT time while no server offset is known
+    int64_t toServerTimeUs(std::chrono::steady_clock::time_point time) const;
+
 private:
     NetworkTablesService() = default;
 
@@ -114,11 +178,30 @@ private:
     // Cached publishers for detections and tag poses (protected by publisherMutex_)
     std::unordered_map<int, nt::StringPublisher> detectionPublishers_;
     std::unordered_map<int, nt::DoubleArrayPublisher> tagPosePublishers_;
+    std::unordered_map<std::string, nt::StringPublisher> remoteDetectionPublishers_;
+    struct FlowPublishers {
+        nt::DoubleArrayPublisher velocity;
+        nt::IntegerPublisher timestamp;
+        nt::IntegerPublisher features;
+        nt::BooleanPublisher valid;
+    };
+    std::unordered_map<std::string, FlowPublishers> remoteFlowPublishers_;
     std::mutex publisherMutex_;
 
     // Helper to ensure table exists
     void ensureTable();
 
+    // Subscription to Vision/control and FMSInfo and its value listener (protected by mutex_)
+    void handleControlEvent(const nt::Event& event);
+    std::optional<nt::MultiSubscriber> controlSubscriber_;
+    NT_Listener controlListener_ = 0;
+    PipelineEnabledCallback pipelineEnabledCallback_;
+    ActivePipelinesCallback activePipelinesCallback_;
+    RobotStateCallback robotStateCallback_;
+    MatchInfoCallback matchInfoCallback_;
+    MatchInfo matchInfo_;
+    std::mutex activationMutex_;
+
     // Status monitor members
     std::vector<StatusCallback> statusCallbacks_;
     std::mutex callbackMutex_;
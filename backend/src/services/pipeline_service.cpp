@@ -117,20 +117,56 @@ bool PipelineService::updatePipeline(const Pipeline& pipeline) {
 }
 
 bool PipelineService::updatePipelineConfig(int id, const nlohmann::json& config) {
+    auto generation = savePipelineConfig(id, config);
+    if (!generation) {
+        return false;
+    }
+    applyPipelineConfig(id, config, *generation);
+    return true;
+}
+
+std::optional<uint64_t> PipelineService::savePipelineConfig(int id, const nlohmann::json& config) {
     auto& db = Database::instance();
-    return db.withLock([id, &config](SQLite::Database& sqlDb) {
+    bool success = db.withLock([id, &config](SQLite::Database& sqlDb) {
         SQLite::Statement stmt(sqlDb, "UPDATE pipelines SET config = ? WHERE id = ?");
         stmt.bind(1, config.dump());
         stmt.bind(2, id);
+        return stmt.exec() > 0;
+    });
+    if (!success) {
+        return std::nullopt;
+    }
+    spdlog::debug("Updated config for pipeline {}", id);
 
-        bool success = stmt.exec() > 0;
-        if (success) {
-            spdlog::debug("Updated config for pipeline {}", id);
-            // Propagate update to running thread
-            ThreadManager::instance().updatePipelineConfig(id, config);
+    std::lock_guard<std::mutex> lock(generationMutex_);
+    return ++configGenerations_[id];
+}
+
+bool PipelineService::applyPipelineConfig(int id, const nlohmann::json& config, uint64_t generation) {
+    // Serialized so an older config can't land after a newer one
+    std::lock_guard<std::mutex> applyLock(applyMutex_);
+    {
+        std::lock_guard<std::mutex> lock(generationMutex_);
+        if (configGenerations_[id] != generation) {
+            spdlog::debug("Skipping superseded config for pipeline {}", id);
+            return false;
         }
-        return success;
-    });
+    }
+
+    // Propagate update to running thread (may load a model, so never under the DB lock)
+    ThreadManager::instance().updatePipelineConfig(id, config);
+    return true;
+}
+
+bool PipelineService::reloadPipeline(int id) {
+    // Read under the apply lock so a concurrent save's job still lands after this
+    std::lock_guard<std::mutex> applyLock(applyMutex_);
+    auto pipeline = getPipelineById(id);
+    if (!pipeline || !ThreadManager::instance().isPipelineRunning(id)) {
+        return false;
+    }
+    ThreadManager::instance().updatePipelineConfig(id, pipeline->getConfigJson());
+    return true;
 }
 
 void PipelineService::updateFieldLayout(const std::string& layoutName) {
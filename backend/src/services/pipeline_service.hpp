@@ -1,6 +1,9 @@
 #pragma once
 
 #include "models/pipeline.hpp"
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <vector>
 #include <optional>
 
@@ -17,7 +20,18 @@ public:
     std::optional<Pipeline> getPipelineById(int id);
     Pipeline createPipeline(Pipeline& pipeline);
     bool updatePipeline(const Pipeline& pipeline);
+    // Persist and apply to the running thread. Applying can load a model, so request
+    // handlers use the split form below and apply on the job pool.
     bool updatePipelineConfig(int id, const nlohmann::json& config);
+
+    // Persist a config; returns its generation, or nullopt when the pipeline doesn't exist
+    std::optional<uint64_t> savePipelineConfig(int id, const nlohmann::json& config);
+
+    // Apply a saved config to the running thread; false when a newer save superseded it
+    bool applyPipelineConfig(int id, const nlohmann::json& config, uint64_t generation);
+
+    // Re-apply the stored config to the running thread, e.g. after a provider decision
+    bool reloadPipeline(int id);
     bool deletePipeline(int id);
 
     // Update field layout for all pipelines
@@ -28,6 +42,10 @@ public:
 
 private:
     PipelineService() = default;
+
+    std::mutex generationMutex_;
+    std::map<int, uint64_t> configGenerations_;
+    std::mutex applyMutex_;
 };
 
 } // namespace vision
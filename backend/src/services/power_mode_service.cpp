@@ -0,0 +1,72 @@
+#include "services/power_mode_service.hpp"
+#include "threads/thread_manager.hpp"
+#include "metrics/registry.hpp"
+#include <spdlog/spdlog.h>
+
+namespace vision {
+
+PowerModeService& PowerModeService::instance() {
+    static PowerModeService instance;
+    return instance;
+}
+
+void PowerModeService::configure(bool idleWhenDisabled, int idleFps) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idleWhenDisabled_ = idleWhenDisabled && idleFps > 0;
+    idleFps_ = idleFps;
+    applyLocked();
+}
+
+void PowerModeService::setRobotState(const RobotState& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    robotState_ = state;
+    applyLocked();
+}
+
+void PowerModeService::setConnected(bool connected) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!connected) {
+        robotState_.reset();
+        applyLocked();
+    }
+}
+
+PowerMode PowerModeService::mode() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mode_;
+}
+
+void PowerModeService::applyLocked() {
+    PowerMode next = idleWhenDisabled_ && robotState_ && !robotState_->enabled
+        ? PowerMode::Idle : PowerMode::Full;
+    if (next == mode_) return;
+
+    mode_ = next;
+    modeSince_ = std::chrono::steady_clock::now();
+    transitions_++;
+
+    ThreadManager::instance().setFrameRateCap(next == PowerMode::Idle ? idleFps_ : 0.0);
+    MetricsRegistry::instance().setPowerMode(next == PowerMode::Idle);
+
+    if (next == PowerMode::Idle) {
+        spdlog::info("Robot disabled: cameras throttled to {} fps", idleFps_);
+    } else {
+        spdlog::info("Robot enabled: cameras back to full rate");
+    }
+}
+
+nlohmann::json PowerModeService::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - modeSince_).count();
+    return {
+        {"mode", mode_},
+        {"mode_seconds", seconds},
+        {"transitions", transitions_},
+        {"idle_when_disabled", idleWhenDisabled_},
+        {"idle_fps", idleFps_},
+        {"robot_state", robotState_ ? robotState_->toJson() : nlohmann::json(nullptr)}
+    };
+}
+
+} // namespace vision
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "services/networktables_service.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <mutex>
+#include <optional>
+
+namespace vision {
+
+enum class PowerMode {
+    Full,
+    Idle    // Robot disabled: cameras forward frames at the idle rate
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(PowerMode, {
+    {PowerMode::Full, "full"},
+    {PowerMode::Idle, "idle"}
+})
+
+// Drops every camera to a low frame rate while the robot is disabled and restores
+// full rate on enable. Pipelines keep processing the reduced stream, so ML sessions
+// stay warm and nothing is torn down between matches.
+class PowerModeService {
+public:
+    static PowerModeService& instance();
+
+    void configure(bool idleWhenDisabled, int idleFps);
+
+    // From FMSInfo/FMSControlData
+    void setRobotState(const RobotState& state);
+
+    // Without NetworkTables the robot state is unknown, which means full rate
+    void setConnected(bool connected);
+
+    PowerMode mode() const;
+    nlohmann::json toJson() const;
+
+private:
+    PowerModeService() = default;
+
+    // Caller holds mutex_
+    void applyLocked();
+
+    mutable std::mutex mutex_;
+    bool idleWhenDisabled_ = true;
+    int idleFps_ = 5;
+    std::optional<RobotState> robotState_;
+    PowerMode mode_ = PowerMode::Full;
+    std::chrono::steady_clock::time_point modeSince_ = std::chrono::steady_clock::now();
+    int transitions_ = 0;
+};
+
+} // namespace vision
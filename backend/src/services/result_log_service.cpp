@@ -0,0 +1,311 @@
+#include "services/result_log_service.hpp"
+#include <spdlog/spdlog.h>
+// wpiutil 2025 split the file writer out of DataLog; earlier releases write from DataLog itself
+#if __has_include(<wpi/DataLogBackgroundWriter.h>)
+#include <wpi/DataLogBackgroundWriter.h>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace vision {
+
+namespace {
+
+constexpr const char* kExtension = ".wpilog";
+constexpr const char* kExtraHeader = "2852Vision";
+
+// Pending records are handed to DataLog, and flushed, at least this often
+constexpr auto kFlushInterval = std::chrono::seconds(1);
+
+// DataLog's writer thread period in seconds
+constexpr double kWritePeriod = 0.25;
+
+std::unique_ptr<wpi::log::DataLog> createLog(const std::string& directory, const std::string& filename) {
+#if __has_include(<wpi/DataLogBackgroundWriter.h>)
+    return std::make_unique<wpi::log::DataLogBackgroundWriter>(directory, filename, kWritePeriod, kExtraHeader);
+#else
+    return std::make_unique<wpi::log::DataLog>(directory, filename, kWritePeriod, kExtraHeader);
+#endif
+}
+
+const char* matchTypeName(int type) {
+    switch (type) {
+        case 1: return "p";
+        case 2: return "q";
+        case 3: return "e";
+        default: return "m";
+    }
+}
+
+// Only plain file names from our own naming scheme are served
+bool isValidName(const std::string& name) {
+    if (name.size() <= std::string(kExtension).size() || name.front() == '.') return false;
+    if (name.substr(name.size() - std::string(kExtension).size()) != kExtension) return false;
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == '.';
+    });
+}
+
+std::string sanitize(const std::string& value) {
+    std::string out;
+    for (char c : value) {
+        if (std::isalnum(static_cast<unsigned char>(c))) out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+ResultLogService& ResultLogService::instance() {
+    static ResultLogService instance;
+    return instance;
+}
+
+ResultLogService::~ResultLogService() {
+    stop();
+}
+
+void ResultLogService::start(const ResultLogConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || !config.enabled) return;
+
+    std::error_code ec;
+    std::filesystem::create_directories(config.directory, ec);
+    if (ec) {
+        spdlog::error("WPILog result logging disabled: cannot create {}: {}", config.directory, ec.message());
+        return;
+    }
+
+    config_ = config;
+    running_ = true;
+    rotateRequested_ = true;
+    thread_ = std::thread(&ResultLogService::run, this);
+    spdlog::info("Logging pipeline results to {}", config_.directory);
+}
+
+void ResultLogService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ResultLogService::logResult(const Pipeline& pipeline, const PipelineResult& result,
+                                 std::chrono::steady_clock::time_point captureTime,
+                                 const FrameTimings& timings, bool stale) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+    }
+
+    ResultLogRecord record;
+    record.time = captureTime;
+    record.pipelineId = pipeline.id;
+    record.cameraId = pipeline.camera_id;
+    record.pipelineType = pipeline.pipeline_type;
+    record.detections = result.detections;
+    if (result.robotPose && !stale) {
+        const auto& pose = *result.robotPose;
+        auto q = pose.rotation.toQuaternion();
+        record.robotPose = std::vector<double>{
+            pose.translation.x, pose.translation.y, pose.translation.z, q.w, q.x, q.y, q.z};
+        record.tagsUsed = result.tagsUsed;
+    }
+    record.timings = timings;
+    record.stale = stale;
+    enqueue(std::move(record));
+}
+
+void ResultLogService::logDrop(int pipelineId) {
+    ResultLogRecord record;
+    record.kind = ResultLogRecord::Kind::Drop;
+    record.time = std::chrono::steady_clock::now();
+    record.pipelineId = pipelineId;
+    enqueue(std::move(record));
+}
+
+void ResultLogService::enqueue(ResultLogRecord record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    if (queue_.size() >= static_cast<size_t>(config_.queue_records)) {
+        droppedRecords_++;
+        return;
+    }
+    queue_.push_back(std::move(record));
+}
+
+void ResultLogService::setMatchInfo(const MatchInfo& info) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (info.matchType == 0 || info.matchNumber == 0) return;
+    if (match_ && *match_ == info) return;
+    match_ = info;
+    rotateRequested_ = true;
+    cv_.notify_all();
+}
+
+void ResultLogService::run() {
+    std::deque<ResultLogRecord> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait_for(lock, kFlushInterval, [this]() { return !running_ || rotateRequested_; });
+        bool rotate = rotateRequested_;
+        rotateRequested_ = false;
+        batch.swap(queue_);
+        bool stopping = !running_;
+        lock.unlock();
+
+        // Records queued before a match change still belong to the previous file
+        if (!log_) {
+            openFile();
+            rotate = false;
+        }
+        for (const auto& record : batch) {
+            write(record);
+        }
+        batch.clear();
+        std::error_code ec;
+        auto size = std::filesystem::file_size(currentPath_, ec);
+        if (rotate || (!ec && size >= static_cast<uintmax_t>(config_.max_file_mb) * 1024 * 1024)) {
+            openFile();
+        }
+        if (log_) log_->Flush();
+
+        if (stopping) break;
+        lock.lock();
+    }
+    // The destructor writes out what is buffered and closes the file
+    log_.reset();
+}
+
+int ResultLogService::entry(const std::string& name, std::string_view type, int64_t timestampUs) {
+    auto it = entries_.find(name);
+    if (it != entries_.end()) return it->second;
+    int id = log_->Start(name, type, {}, timestampUs);
+    entries_.emplace(name, id);
+    return id;
+}
+
+void ResultLogService::openFile() {
+    std::optional<MatchInfo> match;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        match = match_;
+    }
+
+    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    std::ostringstream name;
+    name << "vision_" << std::put_time(&local, "%Y%m%d_%H%M%S");
+    if (match) {
+        name << '_' << sanitize(match->eventName) << '_' << matchTypeName(match->matchType) << match->matchNumber;
+        if (match->replayNumber > 1) name << "r" << match->replayNumber;
+    }
+    name << kExtension;
+
+    if (name.str() == currentFile_) return;  // Rotated twice within a second
+
+    // The previous log writes out its buffer and closes its file as it is destroyed
+    log_.reset();
+    entries_.clear();
+    log_ = createLog(config_.directory, name.str());
+    currentPath_ = std::filesystem::path(config_.directory) / name.str();
+    currentFile_ = name.str();
+    spdlog::info("WPILog result log: {}", currentFile_);
+}
+
+void ResultLogService::write(const ResultLogRecord& record) {
+    if (!log_) return;
+
+    int64_t t = NetworkTablesService::instance().toServerTimeUs(record.time);
+    std::string pipelinePrefix = "/Vision/pipeline" + std::to_string(record.pipelineId);
+
+    if (record.kind == ResultLogRecord::Kind::Drop) {
+        log_->AppendInteger(entry(pipelinePrefix + "/droppedFrames", "int64", t), ++queueDrops_[record.pipelineId], t);
+        return;
+    }
+
+    // Topic names mirror what VisionThread publishes over NetworkTables, with AdvantageScope's "NT:" prefix
+    int detectionsId = entry("NT:/Vision/camera" + std::to_string(record.cameraId) + "/detections", "string", t);
+    log_->AppendString(detectionsId, record.detections.dump(), t);
+
+    if (record.robotPose) {
+        log_->AppendDoubleArray(entry("NT:/Vision/robotPose", "double[]", t), *record.robotPose, t);
+        log_->AppendInteger(entry("NT:/Vision/tagsUsed", "int64", t), record.tagsUsed, t);
+    }
+
+    if (record.pipelineType == PipelineType::OpticalFlow && record.detections.is_object()) {
+        std::vector<double> velocity = {record.detections.value("vx_mps", 0.0),
+                                        record.detections.value("vy_mps", 0.0)};
+        log_->AppendDoubleArray(entry("NT:/Vision/opticalFlow/velocity", "double[]", t), velocity, t);
+        log_->AppendInteger(entry("NT:/Vision/opticalFlow/features", "int64", t),
+                            record.detections.value("features", 0), t);
+        log_->AppendBoolean(entry("NT:/Vision/opticalFlow/valid", "boolean", t),
+                            record.detections.value("valid", false), t);
+    }
+
+    const auto& timings = record.timings;
+    log_->AppendDouble(entry(pipelinePrefix + "/latency/queueWaitMs", "double", t), timings.queueWaitMs, t);
+    log_->AppendDouble(entry(pipelinePrefix + "/latency/processingMs", "double", t), timings.processingMs, t);
+    log_->AppendDouble(entry(pipelinePrefix + "/latency/publishMs", "double", t), timings.publishMs, t);
+    log_->AppendDouble(entry(pipelinePrefix + "/latency/totalMs", "double", t), timings.totalMs, t);
+    log_->AppendBoolean(entry(pipelinePrefix + "/stale", "boolean", t), record.stale, t);
+}
+
+nlohmann::json ResultLogService::toJson() const {
+    nlohmann::json status;
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        directory = config_.directory;
+        status = {
+            {"enabled", running_},
+            {"directory", config_.directory},
+            {"queued", queue_.size()},
+            {"dropped_records", droppedRecords_}
+        };
+    }
+
+    nlohmann::json files = nlohmann::json::array();
+    std::error_code ec;
+    if (!directory.empty()) {
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            auto name = entry.path().filename().string();
+            if (!entry.is_regular_file() || !isValidName(name)) continue;
+            files.push_back({{"name", name}, {"size", entry.file_size()}});
+        }
+    }
+    // Names start with the creation time, so newest first is reverse name order
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) {
+        return a["name"].template get<std::string>() > b["name"].template get<std::string>();
+    });
+    status["files"] = files;
+    return status;
+}
+
+std::optional<std::filesystem::path> ResultLogService::pathFor(const std::string& name) const {
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        directory = config_.directory;
+    }
+    if (!isValidName(name) || directory.empty()) return std::nullopt;
+    auto path = std::filesystem::path(directory) / name;
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) return std::nullopt;
+    return path;
+}
+
+} // namespace vision
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "core/config.hpp"
+#include "metrics/registry.hpp"
+#include "models/pipeline.hpp"
+#include "pipelines/base_pipeline.hpp"
+#include "services/networktables_service.hpp"
+#include <nlohmann/json.hpp>
+#include <wpi/DataLog.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vision {
+
+// One pipeline result or queue drop, captured on the vision thread and encoded by the writer
+struct ResultLogRecord {
+    enum class Kind { Result, Drop } kind = Kind::Result;
+    std::chrono::steady_clock::time_point time;  // Frame capture time (drops: when dropped)
+    int pipelineId = -1;
+    int cameraId = -1;
+    PipelineType pipelineType = PipelineType::AprilTag;
+    nlohmann::json detections;               // Same JSON as Vision/camera<id>/detections
+    std::optional<std::vector<double>> robotPose;  // [x, y, z, qw, qx, qy, qz] as Vision/robotPose
+    int tagsUsed = 0;
+    FrameTimings timings;
+    bool stale = false;
+};
+
+// Append-only binary log of every pipeline result, written with wpiutil's DataLog
+// so AdvantageScope can line it up with the robot's own log. Vision threads only
+// push into a bounded queue; a background thread turns records into DataLog
+// entries, whose own writer thread does the disk I/O. Files rotate on size and
+// whenever the FMS reports a new match.
+class ResultLogService {
+public:
+    static ResultLogService& instance();
+
+    void start(const ResultLogConfig& config);
+    void stop();
+
+    // Never blocks on disk; records are dropped (and counted) when the queue is full
+    void logResult(const Pipeline& pipeline, const PipelineResult& result,
+                   std::chrono::steady_clock::time_point captureTime,
+                   const FrameTimings& timings, bool stale);
+    void logDrop(int pipelineId);
+
+    // Start a new file named after the match
+    void setMatchInfo(const MatchInfo& info);
+
+    // Log files, newest first, and the status of the writer
+    nlohmann::json toJson() const;
+
+    // Path of a log file in the log directory, if the name is valid and it exists
+    std::optional<std::filesystem::path> pathFor(const std::string& name) const;
+
+private:
+    ResultLogService() = default;
+    ~ResultLogService();
+
+    ResultLogService(const ResultLogService&) = delete;
+    ResultLogService& operator=(const ResultLogService&) = delete;
+
+    void enqueue(ResultLogRecord record);
+    void run();
+    void write(const ResultLogRecord& record);
+    void openFile();
+
+    ResultLogConfig config_;
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_ = false;
+    std::deque<ResultLogRecord> queue_;
+    uint64_t droppedRecords_ = 0;
+    std::optional<MatchInfo> match_;
+    bool rotateRequested_ = false;
+
+    // Entry for a name in the current log, started on first use
+    int entry(const std::string& name, std::string_view type, int64_t timestampUs);
+
+    // Writer thread only
+    std::unique_ptr<wpi::log::DataLog> log_;
+    std::unordered_map<std::string, int> entries_;
+    std::filesystem::path currentPath_;
+    std::string currentFile_;
+    std::unordered_map<int, int64_t> queueDrops_;
+};
+
+} // namespace vision
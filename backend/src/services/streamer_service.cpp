@@ -1,8 +1,19 @@
 #include "services/streamer_service.hpp"
+#include "metrics/memory.hpp"
+#include "utils/orientation.hpp"
 #include <spdlog/spdlog.h>
 
 namespace vision {
 
+namespace {
+
+// Degraded streaming: frames per second per path, width cap and JPEG quality
+constexpr auto kDegradedFrameInterval = std::chrono::milliseconds(100);
+constexpr int kDegradedMaxWidth = 640;
+constexpr int kDegradedQuality = 30;
+
+} // namespace
+
 StreamerService& StreamerService::instance() {
     static StreamerService instance;
     return instance;
@@ -56,11 +67,14 @@ void StreamerService::shutdown() {
     
     // Clear queue
     std::lock_guard<std::mutex> lock(queueMutex_);
-    std::queue<StreamerFrame> empty;
-    std::swap(queue_, empty);
+    auto& counter = MemoryTracker::instance().counter(MemorySubsystem::StreamerQueue);
+    while (!queue_.empty()) {
+        counter.sub(matBytes(queue_.front().frame));
+        queue_.pop();
+    }
 }
 
-void StreamerService::publishFrame(const std::string& path, const cv::Mat& frame) {
+void StreamerService::publishFrame(const std::string& path, const cv::Mat& frame, int orientation) {
     if (!initialized_ || !streamer_ || !streamer_->isRunning()) {
         return;
     }
@@ -77,11 +91,24 @@ void StreamerService::publishFrame(const std::string& path, const cv::Mat& frame
 
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
+        if (degraded_.load()) {
+            // Skip before the clone so throttled frames cost nothing
+            auto now = std::chrono::steady_clock::now();
+            auto& last = lastQueued_[path];
+            if (now - last < kDegradedFrameInterval) {
+                return;
+            }
+            last = now;
+        }
+
+        auto& counter = MemoryTracker::instance().counter(MemorySubsystem::StreamerQueue);
         if (queue_.size() > 5) {
             // Drop oldest frame if queue is full
+            counter.sub(matBytes(queue_.front().frame));
             queue_.pop();
         }
-        queue_.push({path, frame.clone()}); // Clone frame to ensure it's valid when processed
+        queue_.push({path, orientation::uprightCopy(frame, orientation)}); // Copy so it's valid when processed
+        counter.add(matBytes(queue_.back().frame));
     }
     queueCv_.notify_one();
 }
@@ -110,6 +137,7 @@ void StreamerService::workerLoop() {
 
             item = queue_.front();
             queue_.pop();
+            MemoryTracker::instance().counter(MemorySubsystem::StreamerQueue).sub(matBytes(item.frame));
         }
 
         // Double check if client is still connected before encoding
@@ -122,9 +150,12 @@ void StreamerService::workerLoop() {
             
             cv::Mat* frameToEncode = &item.frame;
 
+            bool degraded = degraded_.load();
+
             // Downscale if too large (e.g., > 1024 width) to improve performance
-            if (frameToEncode->cols > 1024) {
-                double scale = 1024.0 / frameToEncode->cols;
+            int maxWidth = degraded ? kDegradedMaxWidth : 1024;
+            if (frameToEncode->cols > maxWidth) {
+                double scale = static_cast<double>(maxWidth) / frameToEncode->cols;
                 // Use INTER_NEAREST for speed. It's much faster than LINEAR/CUBIC
                 cv::resize(*frameToEncode, resizedFrame, cv::Size(), scale, scale, cv::INTER_NEAREST);
                 frameToEncode = &resizedFrame;
@@ -160,7 +191,7 @@ void StreamerService::workerLoop() {
 
             // Encode to JPEG
             // Use lower quality (50) for better performance
-            std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, 50};
+            std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, degraded ? kDegradedQuality : 50};
             cv::imencode(".jpg", *frameToEncode, local_buffer, params);
 
             auto end = std::chrono::steady_clock::now();
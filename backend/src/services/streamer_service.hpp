@@ -6,11 +6,13 @@
 #include <memory>
 #include <mutex>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 #include <queue>
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <chrono>
 
 namespace vision {
 
@@ -24,14 +26,19 @@ public:
     // Stop the streamer
     void shutdown();
 
-    // Publish a frame to the specified path (e.g., "/camera/1")
-    void publishFrame(const std::string& path, const cv::Mat& frame);
+    // Publish a frame to the specified path (e.g., "/camera/1"). A sensor-oriented
+    // frame is turned upright in the copy the queue takes anyway.
+    void publishFrame(const std::string& path, const cv::Mat& frame, int orientation = 0);
 
     // Explicitly register a path with a placeholder frame to ensure it exists
     void registerPath(const std::string& path);
 
     bool isRunning() const;
 
+    // Thermal governor: smaller, lower-quality frames at a capped rate per path
+    void setDegraded(bool degraded) { degraded_.store(degraded); }
+    bool isDegraded() const { return degraded_.load(); }
+
 private:
     StreamerService() = default;
     ~StreamerService();
@@ -61,6 +68,8 @@ private:
     std::condition_variable queueCv_;
     std::thread workerThread_;
     std::atomic<bool> running_{false};
+    std::atomic<bool> degraded_{false};
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> lastQueued_;  // Protected by queueMutex_
     
     struct FpsTracker {
         std::chrono::steady_clock::time_point lastFrameTime = std::chrono::steady_clock::now();
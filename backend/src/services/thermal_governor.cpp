@@ -0,0 +1,218 @@
+#include "services/thermal_governor.hpp"
+#include "services/streamer_service.hpp"
+#include "threads/thread_manager.hpp"
+#include "metrics/registry.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <unordered_map>
+
+namespace vision {
+
+namespace {
+
+// Actions kept for GET /api/system/thermal
+constexpr size_t kActionsRetained = 128;
+
+// Frame strides for the two ML rounds
+constexpr int kMlStride[] = {1, 2, 4};
+
+} // namespace
+
+nlohmann::json ThermalAction::toJson() const {
+    return {
+        {"timestamp", std::chrono::duration_cast<std::chrono::milliseconds>(
+                          time.time_since_epoch()).count()},
+        {"direction", shed ? "shed" : "restore"},
+        {"level", level},
+        {"action", action},
+        {"temperature", temperature},
+        {"freq_headroom", freqHeadroom}
+    };
+}
+
+std::string ThermalGovernor::Step::describe() const {
+    switch (kind) {
+        case Kind::Stream:
+            return "stream_quality (reduced size, quality and rate)";
+        case Kind::MlRate:
+            return "ml_rate pipeline " + std::to_string(pipelineId) +
+                   " (1 in " + std::to_string(kMlStride[round]) + " frames)";
+        case Kind::TagDecimate:
+            return "apriltag_decimate pipeline " + std::to_string(pipelineId) +
+                   " (+" + std::to_string(round) + ")";
+    }
+    return {};
+}
+
+ThermalGovernor& ThermalGovernor::instance() {
+    static ThermalGovernor instance;
+    return instance;
+}
+
+ThermalGovernor::~ThermalGovernor() {
+    stop();
+}
+
+void ThermalGovernor::start(const ThermalConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || !config.enabled) return;
+
+    config_ = config;
+    running_ = true;
+    thread_ = std::thread(&ThermalGovernor::run, this);
+    spdlog::info("Thermal governor started (shed at {:.0f} C, restore below {:.0f} C)",
+                 config_.shed_c, config_.restore_c);
+}
+
+void ThermalGovernor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ThermalGovernor::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        cv_.wait_for(lock, std::chrono::milliseconds(config_.interval_ms), [this]() { return !running_; });
+        if (!running_) break;
+        lock.unlock();
+        tick();
+        lock.lock();
+    }
+}
+
+std::vector<ThermalGovernor::Step> ThermalGovernor::buildSteps() const {
+    auto pipelines = ThreadManager::instance().getPipelineLoadInfo();
+    std::stable_sort(pipelines.begin(), pipelines.end(), [](const auto& a, const auto& b) {
+        return a.priority != b.priority ? a.priority < b.priority : a.pipelineId < b.pipelineId;
+    });
+
+    std::vector<Step> steps;
+    steps.push_back({Step::Kind::Stream});
+    for (int round = 1; round <= 2; round++) {
+        for (const auto& p : pipelines) {
+            if (p.type == PipelineType::ObjectDetectionML) {
+                steps.push_back({Step::Kind::MlRate, p.pipelineId, round});
+            }
+        }
+    }
+    for (int round = 1; round <= 2; round++) {
+        for (const auto& p : pipelines) {
+            if (p.type == PipelineType::AprilTag) {
+                steps.push_back({Step::Kind::TagDecimate, p.pipelineId, round});
+            }
+        }
+    }
+    return steps;
+}
+
+void ThermalGovernor::applyLevel(const std::vector<Step>& steps, int level) {
+    // Later rounds for a pipeline override earlier ones, so collect the deepest applied
+    bool streamDegraded = false;
+    std::unordered_map<int, int> mlRound;
+    std::unordered_map<int, int> tagRound;
+    for (size_t i = 0; i < steps.size(); i++) {
+        const auto& step = steps[i];
+        bool applied = static_cast<int>(i) < level;
+        switch (step.kind) {
+            case Step::Kind::Stream:
+                streamDegraded = applied;
+                break;
+            case Step::Kind::MlRate:
+                mlRound.try_emplace(step.pipelineId, 0);
+                if (applied) mlRound[step.pipelineId] = step.round;
+                break;
+            case Step::Kind::TagDecimate:
+                tagRound.try_emplace(step.pipelineId, 0);
+                if (applied) tagRound[step.pipelineId] = step.round;
+                break;
+        }
+    }
+
+    auto& threads = ThreadManager::instance();
+    StreamerService::instance().setDegraded(streamDegraded);
+    for (const auto& [pipelineId, round] : mlRound) {
+        threads.setPipelineFrameStride(pipelineId, kMlStride[round]);
+    }
+    for (const auto& [pipelineId, round] : tagRound) {
+        threads.setPipelineLoadShedding(pipelineId, round);
+    }
+}
+
+void ThermalGovernor::tick() {
+    auto metrics = MetricsRegistry::instance().getSystemMetrics();
+    auto steps = buildSteps();
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    lastTemperature_ = metrics.cpu_temperature;
+    lastHeadroom_ = metrics.cpu_freq_headroom;
+
+    // Pipelines may have stopped since the last tick
+    level_ = (std::min)(level_, static_cast<int>(steps.size()));
+
+    bool hot = metrics.cpu_temperature >= config_.shed_c ||
+               metrics.cpu_freq_headroom < config_.min_freq_headroom;
+    bool cool = metrics.cpu_temperature < config_.restore_c &&
+                metrics.cpu_freq_headroom >= config_.min_freq_headroom;
+
+    std::optional<ThermalAction> action;
+    if (hot) {
+        coolSince_.reset();
+        if (level_ < static_cast<int>(steps.size())) {
+            action = ThermalAction{std::chrono::system_clock::now(), true, level_ + 1, steps[level_].describe()};
+            level_++;
+        }
+    } else if (cool && level_ > 0) {
+        if (!coolSince_) {
+            coolSince_ = now;
+        } else if (now - *coolSince_ >= std::chrono::milliseconds(config_.restore_hold_ms)) {
+            level_--;
+            action = ThermalAction{std::chrono::system_clock::now(), false, level_, steps[level_].describe()};
+            coolSince_ = now;  // Hold again before the next restore
+        }
+    } else {
+        coolSince_.reset();
+    }
+
+    // Reapplied every tick so pipelines started since pick up the current level
+    applyLevel(steps, level_);
+
+    if (action) {
+        action->temperature = metrics.cpu_temperature;
+        action->freqHeadroom = metrics.cpu_freq_headroom;
+        spdlog::warn("Thermal governor {} {} at {:.1f} C, cpufreq headroom {:.2f} (level {}/{})",
+                     action->shed ? "shed" : "restored", action->action, action->temperature,
+                     action->freqHeadroom, level_, steps.size());
+        actions_.push_back(std::move(*action));
+        while (actions_.size() > kActionsRetained) {
+            actions_.pop_front();
+        }
+    }
+}
+
+nlohmann::json ThermalGovernor::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json actions = nlohmann::json::array();
+    for (const auto& action : actions_) {
+        actions.push_back(action.toJson());
+    }
+    return {
+        {"enabled", running_},
+        {"level", level_},
+        {"temperature", lastTemperature_},
+        {"freq_headroom", lastHeadroom_},
+        {"shed_c", config_.shed_c},
+        {"restore_c", config_.restore_c},
+        {"min_freq_headroom", config_.min_freq_headroom},
+        {"actions", actions}
+    };
+}
+
+} // namespace vision
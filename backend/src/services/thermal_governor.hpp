@@ -0,0 +1,77 @@
+#pragma once
+
+#include "core/config.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vision {
+
+// One shed or restore step, kept for correlation with match logs
+struct ThermalAction {
+    std::chrono::system_clock::time_point time;
+    bool shed = true;           // false = restored
+    int level = 0;              // Steps applied after this action
+    std::string action;         // e.g. "ml_rate pipeline 3 (1 in 2 frames)"
+    double temperature = 0.0;
+    double freqHeadroom = 1.0;
+
+    nlohmann::json toJson() const;
+};
+
+// Sheds load one step at a time before the SoC throttles, and restores it once
+// the temperature has held below the restore point. Steps, in order: stream
+// quality, then ML frame rate, then AprilTag decimation; within each, the
+// lowest-priority pipelines first.
+class ThermalGovernor {
+public:
+    static ThermalGovernor& instance();
+
+    void start(const ThermalConfig& config);
+    void stop();
+
+    nlohmann::json toJson() const;
+
+private:
+    // A lever the governor can pull; level 1 and 2 rounds for ML and AprilTag
+    struct Step {
+        enum class Kind { Stream, MlRate, TagDecimate } kind;
+        int pipelineId = -1;
+        int round = 1;
+        std::string describe() const;
+    };
+
+    ThermalGovernor() = default;
+    ~ThermalGovernor();
+
+    ThermalGovernor(const ThermalGovernor&) = delete;
+    ThermalGovernor& operator=(const ThermalGovernor&) = delete;
+
+    void run();
+    void tick();
+
+    // Current pipelines in shedding order
+    std::vector<Step> buildSteps() const;
+    // Push the first `level` steps to the pipelines and lift the rest
+    void applyLevel(const std::vector<Step>& steps, int level);
+
+    ThermalConfig config_;
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_ = false;
+
+    int level_ = 0;
+    std::optional<std::chrono::steady_clock::time_point> coolSince_;
+    double lastTemperature_ = 0.0;
+    double lastHeadroom_ = 1.0;
+    std::deque<ThermalAction> actions_;  // Newest last
+};
+
+} // namespace vision
@@ -0,0 +1,320 @@
+#include "services/usb_bandwidth_planner.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+namespace vision {
+
+namespace {
+
+// Share of the link available to periodic (isochronous) transfers
+constexpr double kBusBudgetFraction = 0.8;
+// One high-bandwidth isochronous endpoint on USB 2.0: 3 x 1024 bytes per 125 us microframe
+constexpr double kUsb2EndpointMbps = 196.6;
+// Typical MJPEG size relative to YUYV for UVC webcams; scene dependent
+constexpr double kMjpegRatio = 0.2;
+// Lowest framerate the planner will fall back to
+constexpr int kMinFps = 15;
+
+std::string readSysfs(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::string value;
+    std::getline(file, value);
+    return value;
+}
+
+int parseSpeed(const std::string& text) {
+    try {
+        return static_cast<int>(std::stod(text));
+    } catch (...) {
+        return 0;
+    }
+}
+
+bool sameMode(const UsbAllocation& a, const UsbAllocation& b) {
+    return a.width == b.width && a.height == b.height && a.fps == b.fps && a.fourcc == b.fourcc;
+}
+
+// Step a camera one notch cheaper; false when it is already at the floor
+bool reduce(UsbAllocation& alloc) {
+    if (alloc.fourcc == "YUYV") {
+        alloc.fourcc = "MJPG";
+        return true;
+    }
+
+    const auto& ladder = UsbBandwidthPlanner::resolutionLadder();
+    double aspect = static_cast<double>(alloc.width) / alloc.height;
+    const UsbBandwidthPlanner::Resolution* best = nullptr;
+    const UsbBandwidthPlanner::Resolution* bestAnyAspect = nullptr;
+    for (const auto& res : ladder) {
+        if (res.width >= alloc.width || res.height >= alloc.height) continue;
+        bestAnyAspect = &res;
+        if (std::abs(static_cast<double>(res.width) / res.height - aspect) < 0.01) {
+            best = &res;
+        }
+    }
+    if (!best) best = bestAnyAspect;
+    if (best) {
+        alloc.width = best->width;
+        alloc.height = best->height;
+        return true;
+    }
+
+    if (alloc.fps > kMinFps) {
+        alloc.fps = (std::max)(kMinFps, alloc.fps / 2);
+        return true;
+    }
+    return false;
+}
+
+void estimate(UsbAllocation& alloc) {
+    alloc.estimatedMbps = UsbBandwidthPlanner::estimateMbps(alloc.width, alloc.height, alloc.fps, alloc.fourcc);
+}
+
+} // namespace
+
+nlohmann::json UsbAllocation::toJson() const {
+    nlohmann::json j = {
+        {"camera_id", cameraId},
+        {"camera_name", cameraName},
+        {"bus", port ? nlohmann::json(port->bus) : nlohmann::json(nullptr)},
+        {"device_path", port ? nlohmann::json(port->devicePath) : nlohmann::json(nullptr)},
+        {"device_speed_mbps", port ? nlohmann::json(port->deviceSpeedMbps) : nlohmann::json(nullptr)},
+        {"width", width},
+        {"height", height},
+        {"fps", fps},
+        {"fourcc", fourcc.empty() ? nlohmann::json(nullptr) : nlohmann::json(fourcc)},
+        {"estimated_mbps", estimatedMbps},
+        {"reduced", reduced}
+    };
+    return j;
+}
+
+nlohmann::json UsbBusLoad::toJson() const {
+    return {
+        {"bus", bus},
+        {"speed_mbps", speedMbps},
+        {"budget_mbps", budgetMbps},
+        {"allocated_mbps", allocatedMbps},
+        {"oversubscribed", oversubscribed}
+    };
+}
+
+UsbBandwidthPlanner& UsbBandwidthPlanner::instance() {
+    static UsbBandwidthPlanner instance;
+    return instance;
+}
+
+const std::vector<UsbBandwidthPlanner::Resolution>& UsbBandwidthPlanner::resolutionLadder() {
+    static const std::vector<Resolution> ladder = {
+        {320, 240}, {640, 360}, {640, 480}, {800, 600},
+        {1280, 720}, {1280, 960}, {1600, 1200}, {1920, 1080}
+    };
+    return ladder;
+}
+
+double UsbBandwidthPlanner::estimateMbps(int width, int height, int fps, const std::string& fourcc) {
+    // YUYV is 2 bytes per pixel on the wire
+    double yuyv = static_cast<double>(width) * height * 2.0 * 8.0 * fps / 1e6;
+    return fourcc == "MJPG" ? yuyv * kMjpegRatio : yuyv;
+}
+
+std::optional<UsbPort> UsbBandwidthPlanner::locate(const std::string& identifier) {
+#ifdef __linux__
+    namespace fs = std::filesystem;
+
+    // Identifiers are device indices ("0") or device nodes ("/dev/video0")
+    std::string node = identifier;
+    if (node.rfind("/dev/", 0) == 0) {
+        node = node.substr(5);
+    } else if (!node.empty() && std::all_of(node.begin(), node.end(), ::isdigit)) {
+        node = "video" + node;
+    }
+
+    std::error_code ec;
+    fs::path dir = fs::canonical(fs::path("/sys/class/video4linux") / node / "device", ec);
+    if (ec) return std::nullopt;
+
+    // The V4L node hangs off a USB interface; walk up to the device that owns busnum
+    while (!dir.empty() && dir != dir.root_path() && !fs::exists(dir / "busnum", ec)) {
+        dir = dir.parent_path();
+    }
+    if (!fs::exists(dir / "busnum", ec)) return std::nullopt;
+
+    UsbPort port;
+    try {
+        port.bus = std::stoi(readSysfs(dir / "busnum"));
+    } catch (...) {
+        return std::nullopt;
+    }
+    port.deviceSpeedMbps = parseSpeed(readSysfs(dir / "speed"));
+    port.busSpeedMbps = parseSpeed(readSysfs(fs::path("/sys/bus/usb/devices") / ("usb" + std::to_string(port.bus)) / "speed"));
+    if (port.busSpeedMbps == 0) port.busSpeedMbps = port.deviceSpeedMbps;
+    port.devicePath = dir.filename().string();
+    return port;
+#else
+    (void)identifier;
+    return std::nullopt;
+#endif
+}
+
+std::vector<int> UsbBandwidthPlanner::plan(const std::vector<Camera>& cameras) {
+    std::unordered_map<int, UsbAllocation> next;
+    std::unordered_map<int, UsbAllocation> requested;
+    std::map<int, std::vector<int>> busCameras;  // bus -> camera IDs
+    std::map<int, int> busSpeeds;
+
+    for (const auto& camera : cameras) {
+        if (camera.camera_type != CameraType::USB) continue;
+
+        UsbAllocation alloc;
+        alloc.cameraId = camera.id;
+        alloc.cameraName = camera.name;
+        if (camera.resolution_json) {
+            try {
+                auto res = nlohmann::json::parse(*camera.resolution_json);
+                alloc.width = res["width"].get<int>();
+                alloc.height = res["height"].get<int>();
+            } catch (const std::exception& e) {
+                spdlog::warn("Failed to parse resolution_json for camera '{}': {}", camera.name, e.what());
+            }
+        }
+        if (camera.framerate) {
+            alloc.fps = *camera.framerate;
+        }
+
+        alloc.port = locate(camera.identifier);
+        if (alloc.port) {
+            busCameras[alloc.port->bus].push_back(camera.id);
+            busSpeeds[alloc.port->bus] = alloc.port->busSpeedMbps;
+        }
+        next[camera.id] = alloc;
+        requested[camera.id] = alloc;
+    }
+
+    std::vector<UsbBusLoad> buses;
+    for (auto& [bus, ids] : busCameras) {
+        UsbBusLoad load;
+        load.bus = bus;
+        load.speedMbps = busSpeeds[bus];
+        load.budgetMbps = load.speedMbps * kBusBudgetFraction;
+
+        // Uncompressed only when the camera has the root hub to itself
+        bool alone = ids.size() == 1;
+        for (int id : ids) {
+            auto& alloc = next[id];
+            alloc.fourcc = alone ? "YUYV" : "MJPG";
+            estimate(alloc);
+        }
+
+        auto deviceCap = [](const UsbAllocation& alloc) {
+            return alloc.port->deviceSpeedMbps <= 480 ? kUsb2EndpointMbps : 1e9;
+        };
+
+        // Greedily cheapen the worst offender until the bus and every endpoint fit
+        while (true) {
+            UsbAllocation* target = nullptr;
+            double total = 0;
+            for (int id : ids) {
+                auto& alloc = next[id];
+                total += alloc.estimatedMbps;
+                if (alloc.estimatedMbps > deviceCap(alloc) && !target) {
+                    target = &alloc;
+                }
+            }
+            if (!target && total > load.budgetMbps) {
+                for (int id : ids) {
+                    auto& alloc = next[id];
+                    if (!target || alloc.estimatedMbps > target->estimatedMbps) {
+                        target = &alloc;
+                    }
+                }
+            }
+            if (!target) {
+                load.allocatedMbps = total;
+                break;
+            }
+
+            if (reduce(*target)) {
+                estimate(*target);
+                continue;
+            }
+
+            // Target is at the floor; try the other cameras before giving up
+            bool reducedOther = false;
+            std::vector<UsbAllocation*> order;
+            for (int id : ids) order.push_back(&next[id]);
+            std::sort(order.begin(), order.end(), [](auto* a, auto* b) { return a->estimatedMbps > b->estimatedMbps; });
+            for (auto* alloc : order) {
+                if (alloc != target && reduce(*alloc)) {
+                    estimate(*alloc);
+                    reducedOther = true;
+                    break;
+                }
+            }
+            if (!reducedOther) {
+                load.allocatedMbps = total;
+                load.oversubscribed = true;
+                spdlog::warn("USB bus {} is oversubscribed: {:.0f} Mbps requested, {:.0f} Mbps available",
+                             bus, total, load.budgetMbps);
+                break;
+            }
+        }
+        buses.push_back(load);
+    }
+
+    // Falling back from YUYV to MJPEG alone does not count as a reduction
+    for (auto& [id, alloc] : next) {
+        if (!alloc.port) continue;
+        const auto& req = requested[id];
+        alloc.reduced = alloc.width != req.width || alloc.height != req.height || alloc.fps != req.fps;
+        if (alloc.reduced) {
+            spdlog::info("USB camera '{}' on bus {} limited to {}x{} @ {} fps {} (~{:.0f} Mbps)",
+                         alloc.cameraName, alloc.port->bus, alloc.width, alloc.height,
+                         alloc.fps, alloc.fourcc, alloc.estimatedMbps);
+        }
+    }
+
+    std::vector<int> changed;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [id, alloc] : next) {
+        auto it = allocations_.find(id);
+        if (it == allocations_.end() || !sameMode(it->second, alloc)) {
+            changed.push_back(id);
+        }
+    }
+    allocations_ = std::move(next);
+    buses_ = std::move(buses);
+    return changed;
+}
+
+std::optional<UsbAllocation> UsbBandwidthPlanner::allocation(int cameraId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = allocations_.find(cameraId);
+    if (it == allocations_.end()) return std::nullopt;
+    return it->second;
+}
+
+nlohmann::json UsbBandwidthPlanner::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json busesJson = nlohmann::json::array();
+    for (const auto& bus : buses_) {
+        busesJson.push_back(bus.toJson());
+    }
+
+    std::vector<const UsbAllocation*> sorted;
+    for (const auto& [id, alloc] : allocations_) sorted.push_back(&alloc);
+    std::sort(sorted.begin(), sorted.end(), [](auto* a, auto* b) { return a->cameraId < b->cameraId; });
+
+    nlohmann::json camerasJson = nlohmann::json::array();
+    for (const auto* alloc : sorted) {
+        camerasJson.push_back(alloc->toJson());
+    }
+    return {{"buses", busesJson}, {"cameras", camerasJson}};
+}
+
+} // namespace vision
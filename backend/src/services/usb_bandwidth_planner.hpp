@@ -0,0 +1,79 @@
+#pragma once
+
+#include "models/camera.hpp"
+#include <nlohmann/json.hpp>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vision {
+
+// Where a USB camera sits in the bus topology (from sysfs)
+struct UsbPort {
+    int bus = -1;             // Root hub number; cameras on one bus share its bandwidth
+    int busSpeedMbps = 0;     // Root hub link speed (480 = USB 2.0, 5000+ = USB 3.x)
+    int deviceSpeedMbps = 0;  // Speed the camera negotiated
+    std::string devicePath;   // e.g. 1-2.3
+};
+
+// Mode the planner assigned to one camera
+struct UsbAllocation {
+    int cameraId = 0;
+    std::string cameraName;
+    std::optional<UsbPort> port;
+    int width = 640;
+    int height = 480;
+    int fps = 30;
+    std::string fourcc;        // "YUYV", "MJPG" or empty (leave the driver default)
+    double estimatedMbps = 0;
+    bool reduced = false;      // Planner lowered the requested mode to fit the bus
+
+    nlohmann::json toJson() const;
+};
+
+// Budget and load of one root hub
+struct UsbBusLoad {
+    int bus = -1;
+    int speedMbps = 0;
+    double budgetMbps = 0;
+    double allocatedMbps = 0;
+    bool oversubscribed = false;  // Even the cheapest modes do not fit
+
+    nlohmann::json toJson() const;
+};
+
+// Picks a feasible capture mode for every USB camera before the drivers connect,
+// so a shared controller is not silently oversubscribed.
+class UsbBandwidthPlanner {
+public:
+    static UsbBandwidthPlanner& instance();
+
+    // Recompute allocations for the USB cameras in the list; returns the IDs whose mode changed
+    std::vector<int> plan(const std::vector<Camera>& cameras);
+
+    // Allocation for a camera, if it was planned
+    std::optional<UsbAllocation> allocation(int cameraId) const;
+
+    nlohmann::json toJson() const;
+
+    // Resolve a USB camera identifier to its bus (Linux sysfs; nullopt elsewhere)
+    static std::optional<UsbPort> locate(const std::string& identifier);
+
+    // Bandwidth of a mode in Mbps (MJPEG is an estimate of typical compression)
+    static double estimateMbps(int width, int height, int fps, const std::string& fourcc);
+
+    // Common UVC resolutions, smallest first
+    struct Resolution { int width; int height; };
+    static const std::vector<Resolution>& resolutionLadder();
+
+private:
+    UsbBandwidthPlanner() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, UsbAllocation> allocations_;
+    std::vector<UsbBusLoad> buses_;
+};
+
+} // namespace vision
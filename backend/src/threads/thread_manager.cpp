@@ -2,33 +2,93 @@
 #include "platform/win32_compat.hpp"
 
 #include "threads/thread_manager.hpp"
+#include "core/config.hpp"
 #include "services/camera_service.hpp"
 #include "services/pipeline_service.hpp"
 #include "services/streamer_service.hpp"
 #include "services/settings_service.hpp"
 #include "services/networktables_service.hpp"
+#include "services/cluster_service.hpp"
+#include "services/frame_bus_service.hpp"
+#include "services/result_log_service.hpp"
 #include "routes/vision_ws.hpp"
+#include "metrics/memory.hpp"
+#include "metrics/registry.hpp"
 #include "vision/field_layout.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 
 namespace vision {
 
+namespace {
+    // Reconnect attempts wait this long for a lazily loaded camera SDK; short, so stop()
+    // is never held up by an SDK that is still initializing
+    constexpr std::chrono::milliseconds kConnectSdkWait{250};
+    constexpr std::chrono::milliseconds kReconnectInterval{1000};
+
+    // Parse stored intrinsics; returns false when the camera is uncalibrated
+    bool parseCalibration(const Camera& cam, cv::Mat& cameraMatrix, cv::Mat& distCoeffs) {
+        if (!cam.camera_matrix_json.has_value() || cam.camera_matrix_json->empty()) {
+            return false;
+        }
+
+        auto matrixJson = nlohmann::json::parse(*cam.camera_matrix_json);
+        cameraMatrix = cv::Mat::eye(3, 3, CV_64F);
+        if (matrixJson.is_array() && matrixJson.size() == 3) {
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    cameraMatrix.at<double>(r, c) = matrixJson[r][c];
+                }
+            }
+        }
+
+        distCoeffs = cv::Mat::zeros(5, 1, CV_64F);
+        if (cam.dist_coeffs_json.has_value() && !cam.dist_coeffs_json->empty()) {
+            auto distJson = nlohmann::json::parse(*cam.dist_coeffs_json);
+            if (distJson.is_array()) {
+                distCoeffs = cv::Mat::zeros(distJson.size(), 1, CV_64F);
+                for (size_t i = 0; i < distJson.size(); i++) {
+                    distCoeffs.at<double>(i) = distJson[i];
+                }
+            }
+        }
+        return true;
+    }
+
+    int64_t queuedBytes(const QueuedFrame& qf) {
+        return qf.frame ? matBytes(qf.frame->color()) : 0;
+    }
+}
+
 // ============== FrameQueue ==============
 
-FrameQueue::FrameQueue(size_t maxSize) : maxSize_(maxSize) {}
+FrameQueue::FrameQueue(size_t maxSize, int pipelineId) : maxSize_(maxSize), pipelineId_(pipelineId) {}
+
+FrameQueue::~FrameQueue() {
+    clear();
+}
 
 bool FrameQueue::push(FramePtr frame) {
     std::lock_guard<std::mutex> lock(mutex_);
+    auto& counter = MemoryTracker::instance().counter(MemorySubsystem::FrameQueues);
 
     if (queue_.size() >= maxSize_) {
         // Drop oldest frame
+        counter.sub(queuedBytes(queue_.front()));
         queue_.pop();
+        if (pipelineId_ >= 0) {
+            MetricsRegistry::instance().recordDrop(pipelineId_);
+            ResultLogService::instance().logDrop(pipelineId_);
+        }
     }
 
     QueuedFrame qf;
     qf.frame = frame;
     qf.queueTime = std::chrono::steady_clock::now();
     queue_.push(qf);
+    counter.add(queuedBytes(qf));
 
     cv_.notify_one();
     return true;
@@ -43,12 +103,15 @@ bool FrameQueue::pop(QueuedFrame& out, std::chrono::milliseconds timeout) {
 
     out = queue_.front();
     queue_.pop();
+    MemoryTracker::instance().counter(MemorySubsystem::FrameQueues).sub(queuedBytes(out));
     return true;
 }
 
 void FrameQueue::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
+    auto& counter = MemoryTracker::instance().counter(MemorySubsystem::FrameQueues);
     while (!queue_.empty()) {
+        counter.sub(queuedBytes(queue_.front()));
         queue_.pop();
     }
 }
@@ -67,7 +130,8 @@ bool FrameQueue::empty() const {
 
 CameraThread::CameraThread(const Camera& camera, std::unique_ptr<BaseDriver> driver)
     : camera_(camera)
-    , driver_(std::move(driver)) {
+    , driver_(std::move(driver))
+    , calibrated_(camera.camera_matrix_json && !camera.camera_matrix_json->empty()) {
 }
 
 CameraThread::~CameraThread() {
@@ -112,6 +176,12 @@ void CameraThread::registerQueue(int pipelineId, std::shared_ptr<FrameQueue> que
 void CameraThread::unregisterQueue(int pipelineId) {
     std::lock_guard<std::mutex> lock(queuesMutex_);
     queues_.erase(pipelineId);
+    queueExposure_.erase(pipelineId);
+}
+
+void CameraThread::setQueueExposure(int pipelineId, ExposureClass exposure) {
+    std::lock_guard<std::mutex> lock(queuesMutex_);
+    queueExposure_[pipelineId] = exposure;
 }
 
 FramePtr CameraThread::getDisplayFrame() {
@@ -143,9 +213,13 @@ void CameraThread::updateSettings(const Camera& camera) {
             triggerAutoSync = true;
         }
 
+        if (camera_.orientation != camera.orientation) {
+            renegotiate_ = true;  // Hardware flip may now apply or no longer apply
+        }
         camera_.orientation = camera.orientation;
         camera_.exposure_mode = camera.exposure_mode;
         camera_.exposure_value = camera.exposure_value;
+        camera_.alternate_exposure_value = camera.alternate_exposure_value;
         camera_.gain_mode = camera.gain_mode;
         camera_.gain_value = camera.gain_value;
 
@@ -167,6 +241,99 @@ void CameraThread::updateSettings(const Camera& camera) {
     }
 }
 
+void CameraThread::setCaptureRequirements(const CaptureRequirements& requirements) {
+    std::lock_guard<std::mutex> lock(settingsMutex_);
+    requirements_ = requirements;
+    renegotiate_ = true;
+}
+
+void CameraThread::setCalibrated(bool calibrated) {
+    if (calibrated_.exchange(calibrated) != calibrated) {
+        renegotiate_ = true;
+    }
+}
+
+void CameraThread::negotiateCaptureMode() {
+    CaptureRequirements req;
+    {
+        std::lock_guard<std::mutex> lock(settingsMutex_);
+        req = requirements_;
+        req.orientation = camera_.orientation;
+    }
+
+    // Intrinsics are only valid for the geometry they were calibrated at, and nothing
+    // rescales them for binning, a lower resolution or a sensor ROI
+    if (calibrated_.load() && (!req.fullResolution || req.roi)) {
+        spdlog::info("Camera {} is calibrated; keeping its configured geometry", camera_.id);
+        req.fullResolution = true;
+        req.roi.reset();
+    }
+
+    auto mode = driver_->negotiate(req);
+    hardwareOrientation_ = mode.hardwareOrientation;
+    if (mode.width == 0) {
+        return;  // Driver keeps its configured mode
+    }
+
+    spdlog::info("Camera {} capture mode: {}", camera_.id, mode.describe());
+
+    // Some drivers restart the stream to reconfigure; make sure controls survive
+    std::lock_guard<std::mutex> lock(settingsMutex_);
+    driver_->setExposure(camera_.exposure_mode, camera_.exposure_value);
+    driver_->setGain(camera_.gain_mode, camera_.gain_value);
+}
+
+ExposureClass CameraThread::advanceExposure(const FrameResult& frameResult) {
+    bool alternating = false;
+    int shortValue = 0;
+    int longValue = 0;
+    ExposureClass primary = ExposureClass::Short;
+    {
+        std::lock_guard<std::mutex> lock(settingsMutex_);
+        alternating = camera_.exposure_mode == ExposureMode::Manual &&
+                      camera_.alternate_exposure_value &&
+                      *camera_.alternate_exposure_value != camera_.exposure_value;
+        if (alternating) {
+            shortValue = (std::min)(camera_.exposure_value, *camera_.alternate_exposure_value);
+            longValue = (std::max)(camera_.exposure_value, *camera_.alternate_exposure_value);
+            primary = camera_.exposure_value == shortValue ? ExposureClass::Short : ExposureClass::Long;
+        }
+
+        // Switched off: go back to the single configured exposure
+        if (!alternating && lastRequested_ != ExposureClass::Any) {
+            driver_->setExposure(camera_.exposure_mode, camera_.exposure_value);
+        }
+    }
+
+    if (!alternating) {
+        pendingExposures_.clear();
+        lastRequested_ = ExposureClass::Any;
+        return ExposureClass::Any;
+    }
+
+    // Starting: frames already in flight were exposed with the primary value
+    if (lastRequested_ == ExposureClass::Any) {
+        pendingExposures_.assign((std::max)(driver_->exposureLatencyFrames(), 1), primary);
+        lastRequested_ = primary;
+    }
+
+    // Prefer the exposure the driver measured; otherwise trust the write latency
+    ExposureClass current = pendingExposures_.front();
+    pendingExposures_.pop_front();
+    if (frameResult.exposure) {
+        current = std::abs(*frameResult.exposure - shortValue) <= std::abs(*frameResult.exposure - longValue)
+            ? ExposureClass::Short : ExposureClass::Long;
+    }
+
+    // Per-frame write of the other exposure
+    ExposureClass next = lastRequested_ == ExposureClass::Short ? ExposureClass::Long : ExposureClass::Short;
+    driver_->setExposure(ExposureMode::Manual, next == ExposureClass::Short ? shortValue : longValue);
+    pendingExposures_.push_back(next);
+    lastRequested_ = next;
+
+    return current;
+}
+
 void CameraThread::run() {
     // Cache ID to avoid locking for every log message
     int cameraId = camera_.id;
@@ -179,6 +346,9 @@ void CameraThread::run() {
     static constexpr int INITIAL_FRAME_TIMEOUT_MS = 5000;  // 5 seconds to get first frame
     static constexpr int LOG_INTERVAL = 100;  // Log every 100 frames
 
+    // Last forwarded frame per exposure class, for the frame rate cap
+    std::array<std::chrono::steady_clock::time_point, 3> lastForwarded{};
+
     bool connectionErrorLogged = false;
     bool wasConnected = driver_->isConnected();
     bool wasStreaming = false;
@@ -202,8 +372,13 @@ void CameraThread::run() {
                  VisionWebSocket::instance().broadcastCameraStatus(cameraId, false, false);
              }
 
-             if (driver_->connect(connectionErrorLogged)) {
+             bool connectedNow = driver_->connect(connectionErrorLogged, kConnectSdkWait);
+             if (!running_.load()) break;
+
+             if (connectedNow) {
                  spdlog::info("Connected to camera {}", cameraId);
+                 renegotiate_ = true;  // Reconnect restores the configured mode
+                 lastRequested_ = ExposureClass::Any;  // ...and the single configured exposure
                  connectionErrorLogged = false;
                  wasConnected = true;
                  connected_.store(true);
@@ -240,12 +415,22 @@ void CameraThread::run() {
                          placeholder
                      );
                  }
-                 std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+                 // Sleep in short steps so stop() doesn't wait out the interval
+                 auto retryAt = std::chrono::steady_clock::now() + kReconnectInterval;
+                 while (running_.load() && std::chrono::steady_clock::now() < retryAt) {
+                     std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                 }
                  totalFrameCount++; // Increment to trigger placeholder logic
                  continue;
              }
         }
 
+        // Pipelines started/stopped or orientation changed since the last frame
+        if (renegotiate_.exchange(false)) {
+            negotiateCaptureMode();
+            if (!driver_->isConnected()) continue;
+        }
+
         auto frameResult = driver_->getFrame();
 
         if (frameResult.empty()) {
@@ -282,6 +467,7 @@ void CameraThread::run() {
             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::steady_clock::now() - startTime).count();
             spdlog::info("Camera {} received first frame after {}ms", cameraId, elapsed);
+            MetricsRegistry::instance().recordFirstFrame(cameraId);
 
             // Notify that camera is now streaming
             if (!wasStreaming) {
@@ -299,8 +485,23 @@ void CameraThread::run() {
                 cameraId, totalFrameCount, emptyFrameCount);
         }
 
-        // Apply orientation
-        applyOrientation(frameResult.color);
+        // Classify before throttling so the alternation stays in step
+        ExposureClass exposure = advanceExposure(frameResult);
+
+        // Throttled: drain the sensor but skip all downstream work. Each exposure class
+        // keeps its own clock so an alternating camera still forwards both.
+        double cap = frameRateCap_.load();
+        if (cap > 0.0) {
+            auto now = std::chrono::steady_clock::now();
+            auto& last = lastForwarded[static_cast<size_t>(exposure)];
+            if (now - last < std::chrono::duration<double>(1.0 / cap)) {
+                continue;
+            }
+            last = now;
+        }
+
+        // Apply orientation (or keep it as metadata for the pipelines)
+        int pendingOrientation = applyOrientation(frameResult.color);
 
         // Create frame with timestamp
         auto frame = std::make_shared<RefCountedFrame>(
@@ -308,23 +509,41 @@ void CameraThread::run() {
             frameResult.depth
         );
         frame->setSequence(++frameSequence_);
+        frame->setExposureClass(exposure);
+        frame->setOrientation(pendingOrientation);
 
-        // Update display frame
-        {
-            std::lock_guard<std::mutex> lock(displayMutex_);
-            displayFrame_ = frame;
+        // Publish to shared-memory frame bus; external readers always get upright frames
+        if (FrameBusService::instance().isEnabled()) {
+            FrameBusService::instance().publish(cameraId, frame->upright(), frame->timestamp(), frame->sequence(),
+                                                frame->exposureClass());
         }
 
-        // Publish to MJPEG streamer
-        StreamerService::instance().publishFrame(
-            "/camera/" + std::to_string(cameraId),
-            frame->color()
-        );
+        // The driver view only gets the bright frames of an alternating camera
+        if (frame->exposureClass() != ExposureClass::Short) {
+            {
+                std::lock_guard<std::mutex> lock(displayMutex_);
+                displayFrame_ = frame;
+            }
 
-        // Distribute to vision threads
+            // Publish to MJPEG streamer
+            StreamerService::instance().publishFrame(
+                "/camera/" + std::to_string(cameraId),
+                frame->color(),
+                frame->orientation()
+            );
+        }
+
+        // Distribute to vision threads, each only the exposure it asked for
         {
             std::lock_guard<std::mutex> lock(queuesMutex_);
             for (auto& [pipelineId, queue] : queues_) {
+                if (frame->exposureClass() != ExposureClass::Any) {
+                    auto accept = queueExposure_.find(pipelineId);
+                    if (accept != queueExposure_.end() && accept->second != ExposureClass::Any &&
+                        accept->second != frame->exposureClass()) {
+                        continue;
+                    }
+                }
                 queue->push(frame);
             }
         }
@@ -334,13 +553,25 @@ void CameraThread::run() {
         cameraId, totalFrameCount, emptyFrameCount);
 }
 
-void CameraThread::applyOrientation(cv::Mat& frame) {
+int CameraThread::applyOrientation(cv::Mat& frame) {
     int orientation;
     {
         std::lock_guard<std::mutex> lock(settingsMutex_);
         orientation = camera_.orientation;
     }
 
+    // Sensor readout is already reversed
+    if (orientation == 180 && hardwareOrientation_.load()) {
+        return 0;
+    }
+
+    // Pipelines map their outputs to upright coordinates instead; pixels are only
+    // rotated where something is displayed
+    if (Config::instance().capture.metadata_orientation &&
+        (orientation == 90 || orientation == 180 || orientation == 270)) {
+        return orientation;
+    }
+
     switch (orientation) {
         case 90:
             cv::rotate(frame, frame, cv::ROTATE_90_CLOCKWISE);
@@ -354,6 +585,7 @@ void CameraThread::applyOrientation(cv::Mat& frame) {
         default:
             break;
     }
+    return 0;
 }
 
 BaseDriver::Range CameraThread::getExposureRange() const {
@@ -414,6 +646,11 @@ void CameraThread::syncAutoValues() {
 VisionThread::VisionThread(const Pipeline& pipeline, std::unique_ptr<BasePipeline> processor)
     : pipeline_(pipeline)
     , processor_(std::move(processor)) {
+    try {
+        parseCaptureOverrides(nlohmann::json::parse(pipeline.config.empty() ? "{}" : pipeline.config));
+    } catch (const std::exception& e) {
+        spdlog::warn("Invalid config for pipeline {}: {}", pipeline.id, e.what());
+    }
 }
 
 VisionThread::~VisionThread() {
@@ -432,7 +669,12 @@ void VisionThread::start(std::shared_ptr<FrameQueue> inputQueue) {
 void VisionThread::stop() {
     if (!running_.load()) return;
 
-    running_ = false;
+    {
+        // Under the stage lock so neither stage misses the wakeup
+        std::lock_guard<std::mutex> lock(stageMutex_);
+        running_ = false;
+    }
+    stageCv_.notify_all();
     if (thread_.joinable()) {
         thread_.join();
     }
@@ -445,8 +687,13 @@ FramePtr VisionThread::getProcessedFrame() {
 }
 
 nlohmann::json VisionThread::getLatestResults() {
-    std::lock_guard<std::mutex> lock(resultsMutex_);
-    return latestResults_;
+    nlohmann::json results;
+    {
+        std::lock_guard<std::mutex> lock(resultsMutex_);
+        results = latestResults_;
+    }
+    results["active"] = active_.load();
+    return results;
 }
 
 
@@ -455,6 +702,62 @@ void VisionThread::updateConfig(const nlohmann::json& config) {
     if (processor_) {
         processor_->updateConfig(config);
     }
+    parseCaptureOverrides(config);
+
+    // Results from the old config must not be reused
+    std::lock_guard<std::mutex> lock(gateMutex_);
+    lastResult_.reset();
+}
+
+void VisionThread::parseCaptureOverrides(const nlohmann::json& config) {
+    std::lock_guard<std::mutex> lock(captureMutex_);
+    captureRoi_.reset();
+    captureFps_ = 0;
+    exposureOverride_.reset();
+    motionGate_ = MotionGate{};
+    if (!config.is_object()) return;
+
+    motionGate_.enabled = config.value("motion_gate", false);
+    motionGate_.threshold = config.value("motion_threshold", motionGate_.threshold);
+    motionGate_.maxAgeMs = config.value("motion_max_age_ms", motionGate_.maxAgeMs);
+
+    priority_.store(config.value("priority", 0));
+    captureFps_ = config.value("capture_fps", 0);
+    if (config.contains("exposure_class") && config["exposure_class"].is_string()) {
+        exposureOverride_ = parseExposureClass(config["exposure_class"].get<std::string>());
+    }
+
+    // Normalized {x, y, width, height}; the sensor only reads out this window
+    if (config.contains("capture_roi") && config["capture_roi"].is_object()) {
+        const auto& r = config["capture_roi"];
+        cv::Rect2d roi(r.value("x", 0.0), r.value("y", 0.0), r.value("width", 1.0), r.value("height", 1.0));
+        roi &= cv::Rect2d(0.0, 0.0, 1.0, 1.0);
+        if (roi.area() > 0.0 && roi.area() < 1.0) {
+            captureRoi_ = roi;
+        }
+    }
+}
+
+void VisionThread::setLoadShedding(int level) {
+    if (processor_) {
+        processor_->setLoadShedding(level);
+    }
+}
+
+CaptureRequirements VisionThread::captureRequirements() const {
+    CaptureRequirements req = processor_ ? processor_->captureRequirements() : CaptureRequirements{};
+    std::lock_guard<std::mutex> lock(captureMutex_);
+    if (captureRoi_) req.roi = captureRoi_;
+    if (captureFps_ > 0) req.targetFps = captureFps_;
+    return req;
+}
+
+ExposureClass VisionThread::exposureClass() const {
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        if (exposureOverride_) return *exposureOverride_;
+    }
+    return processor_ ? processor_->preferredExposure() : ExposureClass::Any;
 }
 
 void VisionThread::updateFieldLayout(const std::string& layoutName) {
@@ -471,15 +774,34 @@ void VisionThread::updateFieldLayout(const std::string& layoutName) {
 }
 
 void VisionThread::run() {
+    bool staged = processor_->isStaged();
+    if (staged) {
+        finishThread_ = std::thread(&VisionThread::finishLoop, this);
+    }
+
+    // Throttled cameras leave gaps between frames; only a stalled feed gets the placeholder
+    auto lastInputTime = std::chrono::steady_clock::now();
+    uint64_t strideCounter = 0;
+
     while (running_.load()) {
+        // Staged: hold off popping until the finish thread has taken the last frame,
+        // so the next frame is detected while that one is solved and published
+        if (staged) {
+            std::unique_lock<std::mutex> lock(stageMutex_);
+            stageCv_.wait(lock, [this]() { return !pendingWork_ || !running_.load(); });
+            if (!running_.load()) break;
+        }
+
         QueuedFrame qf;
         if (!inputQueue_->pop(qf, std::chrono::milliseconds(100))) {
             // Timeout - publish placeholder to keep stream alive
             static auto lastPlaceholderTime = std::chrono::steady_clock::now();
             auto now = std::chrono::steady_clock::now();
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastPlaceholderTime).count() > 1000) {
+            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastPlaceholderTime).count() > 1000 &&
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - lastInputTime).count() > 1000) {
                 cv::Mat placeholder = cv::Mat::zeros(480, 640, CV_8UC3);
-                cv::putText(placeholder, "Waiting for input...", cv::Point(160, 240), 
+                cv::putText(placeholder, active_.load() ? "Waiting for input..." : "Pipeline idle",
+                    cv::Point(160, 240), 
                     cv::FONT_HERSHEY_SIMPLEX, 1.0, cv::Scalar(0, 0, 255), 2);
                 StreamerService::instance().publishFrame(
                     "/pipeline/" + std::to_string(pipeline_.id),
@@ -494,73 +816,231 @@ void VisionThread::run() {
             continue;
         }
 
+        auto dequeueTime = std::chrono::steady_clock::now();
+        lastInputTime = dequeueTime;
+
+        // Thermal governor: skip frames between strides without touching the processor
+        int stride = frameStride_.load();
+        if (stride > 1 && ++strideCounter % stride != 0) {
+            continue;
+        }
+
+        MotionGate gate;
+        {
+            std::lock_guard<std::mutex> lock(captureMutex_);
+            gate = motionGate_;
+        }
+        if (gate.enabled) {
+            cv::Mat thumbnail = qf.frame->changeThumbnail();
+            if (reuseIfUnchanged(qf, thumbnail, gate, staged, dequeueTime)) {
+                continue;
+            }
+            lastThumbnail_ = thumbnail;
+            lastThumbnailSequence_ = qf.frame->sequence();
+        }
+
+        processor_->setFrameOrientation(qf.frame->orientation());
+
+        if (staged) {
+            StagedWork work;
+            work.staged = processor_->detectStage(qf.frame->color(), qf.frame->depth());
+            work.frame = std::move(qf);
+            work.dequeueTime = dequeueTime;
+            {
+                std::unique_lock<std::mutex> lock(stageMutex_);
+                stageCv_.wait(lock, [this]() { return !pendingWork_ || !running_.load(); });
+                if (!running_.load()) break;
+                pendingWork_ = std::move(work);
+            }
+            stageCv_.notify_all();
+            continue;
+        }
+
         // Process frame
         auto result = processor_->process(qf.frame->color(), qf.frame->depth());
+        auto processedTime = std::chrono::steady_clock::now();
+        publishResult(qf, result, dequeueTime, processedTime);
+    }
 
-        // Create output frame
-        auto outputFrame = std::make_shared<RefCountedFrame>(result.annotatedFrame);
-        outputFrame->setSequence(qf.frame->sequence());
+    if (finishThread_.joinable()) {
+        stageCv_.notify_all();
+        finishThread_.join();
+    }
+    pendingWork_.reset();
+    finishing_ = false;
+}
 
-        // Update processed frame
+void VisionThread::finishLoop() {
+    while (true) {
+        StagedWork work;
         {
-            std::lock_guard<std::mutex> lock(frameMutex_);
-            processedFrame_ = outputFrame;
+            std::unique_lock<std::mutex> lock(stageMutex_);
+            stageCv_.wait(lock, [this]() { return pendingWork_.has_value() || !running_.load(); });
+            if (!running_.load()) return;
+            work = std::move(*pendingWork_);
+            pendingWork_.reset();
+            finishing_ = true;
         }
+        // Frees the slot; the detect stage can start on the next frame now
+        stageCv_.notify_all();
 
-        // Publish to MJPEG streamer
-        StreamerService::instance().publishFrame(
-            "/pipeline/" + std::to_string(pipeline_.id),
-            outputFrame->color()
-        );
+        auto result = processor_->finishStage(std::move(work.staged));
+        auto processedTime = std::chrono::steady_clock::now();
+        publishResult(work.frame, result, work.dequeueTime, processedTime);
 
-        // Update results
-        nlohmann::json resultsJson;
         {
-            std::lock_guard<std::mutex> lock(resultsMutex_);
-            latestResults_ = {
-                {"pipeline_id", pipeline_.id},
-                {"pipeline_name", pipeline_.name},
-                {"detections", result.detections},
-                {"processing_time_ms", result.processingTimeMs}
-            };
-
-            if (result.robotPose) {
-                latestResults_["robot_pose"] = result.robotPose->toJson();
-            } else {
-                latestResults_["robot_pose"] = nullptr;
-            }
-            resultsJson = latestResults_;
+            std::lock_guard<std::mutex> lock(stageMutex_);
+            finishing_ = false;
         }
+        stageCv_.notify_all();
+    }
+}
+
+bool VisionThread::reuseIfUnchanged(const QueuedFrame& qf, const cv::Mat& thumbnail, const MotionGate& gate,
+                                    bool staged, std::chrono::steady_clock::time_point dequeueTime) {
+    // Compared against the last processed frame, so slow drift still triggers a refresh
+    if (lastThumbnail_.empty()) return false;
+    double change = RefCountedFrame::changeScore(thumbnail, lastThumbnail_);
+    if (change >= gate.threshold) return false;
+
+    // Staged: the frame that thumbnail came from may still be in the finish stage.
+    // Wait for it to publish so the reused result is its result and goes out after it.
+    // Changed scenes never get here, so detect/finish overlap is kept while moving.
+    if (staged) {
+        std::unique_lock<std::mutex> lock(stageMutex_);
+        stageCv_.wait(lock, [this]() { return (!pendingWork_ && !finishing_) || !running_.load(); });
+        if (!running_.load()) return false;
+    }
+
+    PipelineResult result;
+    double ageMs = 0;
+    {
+        std::lock_guard<std::mutex> lock(gateMutex_);
+        if (!lastResult_ || lastResultSequence_ != lastThumbnailSequence_) return false;
+        ageMs = std::chrono::duration<double, std::milli>(qf.frame->timestamp() - lastResultTime_).count();
+        if (ageMs >= gate.maxAgeMs) return false;
+        result = *lastResult_;
+    }
+
+    result.processingTimeMs = 0;
+    result.extras["stale"] = true;
+    result.extras["age_ms"] = ageMs;
+    result.extras["scene_change"] = change;
+    publishResult(qf, result, dequeueTime, std::chrono::steady_clock::now());
+    return true;
+}
+
+void VisionThread::publishResult(const QueuedFrame& qf, PipelineResult& result,
+                                 std::chrono::steady_clock::time_point dequeueTime,
+                                 std::chrono::steady_clock::time_point processedTime) {
+    bool stale = result.extras.is_object() && result.extras.value("stale", false);
+    auto recordTimings = [&]() {
+        using ms = std::chrono::duration<double, std::milli>;
+        auto publishedTime = std::chrono::steady_clock::now();
+        FrameTimings timings;
+        timings.queueWaitMs = ms(dequeueTime - qf.queueTime).count();
+        timings.processingMs = ms(processedTime - dequeueTime).count();
+        timings.publishMs = ms(publishedTime - processedTime).count();
+        timings.totalMs = ms(publishedTime - qf.frame->timestamp()).count();
+        MetricsRegistry::instance().recordFrame(pipeline_.id, timings);
+        ResultLogService::instance().logResult(pipeline_, result, qf.frame->timestamp(), timings, stale);
+    };
+
+    // Fresh results become the motion gate's fallback
+    bool gated = false;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        gated = motionGate_.enabled;
+    }
+    if (gated && !stale) {
+        result.extras["stale"] = false;
+        result.extras["age_ms"] = 0.0;
+        std::lock_guard<std::mutex> lock(gateMutex_);
+        lastResult_ = result;
+        lastResultSequence_ = qf.frame->sequence();
+        lastResultTime_ = qf.frame->timestamp();
+    }
+
+    // Create output frame
+    auto outputFrame = std::make_shared<RefCountedFrame>(result.annotatedFrame);
+    outputFrame->setSequence(qf.frame->sequence());
+
+    // Update processed frame
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        processedFrame_ = outputFrame;
+    }
+
+    // Publish to MJPEG streamer
+    StreamerService::instance().publishFrame(
+        "/pipeline/" + std::to_string(pipeline_.id),
+        outputFrame->color()
+    );
+
+    // Update results
+    nlohmann::json resultsJson;
+    {
+        std::lock_guard<std::mutex> lock(resultsMutex_);
+        latestResults_ = {
+            {"pipeline_id", pipeline_.id},
+            {"pipeline_name", pipeline_.name},
+            {"detections", result.detections},
+            {"processing_time_ms", result.processingTimeMs}
+        };
+
+        if (result.robotPose) {
+            latestResults_["robot_pose"] = result.robotPose->toJson();
+        } else {
+            latestResults_["robot_pose"] = nullptr;
+        }
+        if (result.extras.is_object()) {
+            latestResults_.update(result.extras);
+        }
+        resultsJson = latestResults_;
+    }
+
+    // Broadcast to WebSocket subscribers
+    VisionWebSocket::instance().broadcastPipelineResults(
+        pipeline_.camera_id, pipeline_.id, resultsJson);
+
+    // Forward to the cluster leader, or feed the leader's pose fusion.
+    // Stale results would count as new observations there, so they stay local.
+    auto& cluster = ClusterService::instance();
+    if (!stale) {
+        cluster.submitResult(pipeline_, result, qf.frame->timestamp());
+    }
+    if (!cluster.publishesNetworkTables()) {
+        recordTimings();
+        return;
+    }
 
-        // Broadcast to WebSocket subscribers
-        VisionWebSocket::instance().broadcastPipelineResults(
-            pipeline_.camera_id, pipeline_.id, resultsJson);
+    // Publish to NetworkTables (methods check connection internally)
+    auto& nt = NetworkTablesService::instance();
+    nt.publishDetections(pipeline_.camera_id, result.detections);
 
-        // Publish to NetworkTables (methods check connection internally)
-        auto& nt = NetworkTablesService::instance();
-        nt.publishDetections(pipeline_.camera_id, result.detections);
+    // In cluster mode the leader publishes the fused pose instead
+    if (result.robotPose.has_value() && !cluster.isLeader() && !stale) {
+        double timestamp = std::chrono::duration<double>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        nt.publishRobotPose(result.robotPose.value(), timestamp, result.tagsUsed);
+    }
 
-        if (result.robotPose.has_value()) {
-            double timestamp = std::chrono::duration<double>(
+    // Publish optical flow velocity if this is an optical flow pipeline
+    if (pipeline_.pipeline_type == PipelineType::OpticalFlow) {
+        try {
+            double vx = result.detections.value("vx_mps", 0.0);
+            double vy = result.detections.value("vy_mps", 0.0);
+            int features = result.detections.value("features", 0);
+            bool valid = result.detections.value("valid", false);
+            int64_t timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
                 std::chrono::steady_clock::now().time_since_epoch()).count();
-            nt.publishRobotPose(result.robotPose.value(), timestamp, result.tagsUsed);
-        }
-
-        // Publish optical flow velocity if this is an optical flow pipeline
-        if (pipeline_.pipeline_type == PipelineType::OpticalFlow) {
-            try {
-                double vx = result.detections.value("vx_mps", 0.0);
-                double vy = result.detections.value("vy_mps", 0.0);
-                int features = result.detections.value("features", 0);
-                bool valid = result.detections.value("valid", false);
-                int64_t timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-                    std::chrono::steady_clock::now().time_since_epoch()).count();
-                nt.publishOpticalFlowVelocity(vx, vy, timestamp_us, features, valid);
-            } catch (...) {
-                // Ignore parsing errors
-            }
+            nt.publishOpticalFlowVelocity(vx, vy, timestamp_us, features, valid);
+        } catch (...) {
+            // Ignore parsing errors
         }
     }
+
+    recordTimings();
 }
 
 // ============== ThreadManager ==============
@@ -586,12 +1066,23 @@ bool ThreadManager::startCamera(const Camera& camera) {
     }
 
     auto thread = std::make_unique<CameraThread>(camera, std::move(driver));
+    thread->setFrameRateCap(frameRateCap_);
     if (!thread->start()) {
         spdlog::error("Failed to start camera thread for camera {}", camera.id);
         return false;
     }
 
     cameraThreads_.emplace(camera.id, std::move(thread));
+
+    // Expose intrinsics to frame bus readers
+    try {
+        cv::Mat cameraMatrix, distCoeffs;
+        if (parseCalibration(camera, cameraMatrix, distCoeffs)) {
+            FrameBusService::instance().setCalibration(camera.id, cameraMatrix, distCoeffs);
+        }
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to parse calibration for camera {}: {}", camera.id, e.what());
+    }
     
     // Register stream path immediately so it doesn't 404 even if camera is slow/broken
     StreamerService::instance().registerPath("/camera/" + std::to_string(camera.id));
@@ -607,6 +1098,8 @@ void ThreadManager::stopCamera(int cameraId) {
         it->second->stop();
         cameraThreads_.erase(it);
     }
+
+    FrameBusService::instance().close(cameraId);
 }
 
 bool ThreadManager::isCameraRunning(int cameraId) {
@@ -638,7 +1131,7 @@ void ThreadManager::executeWithCameraPaused(int cameraId, std::function<void()>
 
             // Find all pipelines for this camera and their queues
             for (auto const& [pipelineId, camId] : pipelineToCameraMap_) {
-                if (camId == cameraId) {
+                if (camId == cameraId && !idlePipelines_.count(pipelineId)) {
                     auto qIt = pipelineQueues_.find(pipelineId);
                     if (qIt != pipelineQueues_.end()) {
                         queuesToRestore.push_back({pipelineId, qIt->second});
@@ -664,6 +1157,7 @@ void ThreadManager::executeWithCameraPaused(int cameraId, std::function<void()>
                  for (const auto& [pipelineId, queue] : queuesToRestore) {
                      it->second->registerQueue(pipelineId, queue);
                  }
+                 refreshCaptureRequirements(cameraId);
              }
         }
     }
@@ -684,7 +1178,7 @@ void ThreadManager::restartCamera(const Camera& newCamera) {
 
             // Find all pipelines for this camera and their queues
             for (auto const& [pipelineId, camId] : pipelineToCameraMap_) {
-                if (camId == cameraId) {
+                if (camId == cameraId && !idlePipelines_.count(pipelineId)) {
                     auto qIt = pipelineQueues_.find(pipelineId);
                     if (qIt != pipelineQueues_.end()) {
                         queuesToRestore.push_back({pipelineId, qIt->second});
@@ -707,6 +1201,7 @@ void ThreadManager::restartCamera(const Camera& newCamera) {
                  for (const auto& [pipelineId, queue] : queuesToRestore) {
                      it->second->registerQueue(pipelineId, queue);
                  }
+                 refreshCaptureRequirements(cameraId);
              }
              spdlog::info("Restarted camera {} with new settings", cameraId);
         }
@@ -739,38 +1234,24 @@ bool ThreadManager::startPipeline(const Pipeline& pipeline, int cameraId) {
         return false;
     }
 
-    // Create queue and register with camera
-    auto queue = std::make_shared<FrameQueue>(2);
-    cameraIt->second->registerQueue(pipeline.id, queue);
+    // Create queue and register with camera, unless the robot has idled this pipeline
+    auto queue = std::make_shared<FrameQueue>(2, pipeline.id);
+    bool active = isPipelineActiveLocked(pipeline.id, cameraId);
+    if (active) {
+        cameraIt->second->registerQueue(pipeline.id, queue);
+    } else {
+        idlePipelines_.insert(pipeline.id);
+        spdlog::info("Pipeline {} starts idle (disabled over NetworkTables)", pipeline.id);
+    }
 
     // Create and start vision thread
     auto thread = std::make_unique<VisionThread>(pipeline, std::move(processor));
+    thread->setActive(active);
 
     // Inject calibration if available
     try {
-        if (cam.camera_matrix_json.has_value() && !cam.camera_matrix_json->empty()) {
-            auto matrixJson = nlohmann::json::parse(*cam.camera_matrix_json);
-            
-            cv::Mat cameraMatrix = cv::Mat::eye(3, 3, CV_64F);
-            if (matrixJson.is_array() && matrixJson.size() == 3) {
-                for (int r = 0; r < 3; r++) {
-                    for (int c = 0; c < 3; c++) {
-                        cameraMatrix.at<double>(r, c) = matrixJson[r][c];
-                    }
-                }
-            }
-
-            cv::Mat distCoeffs = cv::Mat::zeros(5, 1, CV_64F);
-            if (cam.dist_coeffs_json.has_value() && !cam.dist_coeffs_json->empty()) {
-                auto distJson = nlohmann::json::parse(*cam.dist_coeffs_json);
-                if (distJson.is_array()) {
-                    distCoeffs = cv::Mat::zeros(distJson.size(), 1, CV_64F);
-                    for (size_t i = 0; i < distJson.size(); i++) {
-                        distCoeffs.at<double>(i) = distJson[i];
-                    }
-                }
-            }
-
+        cv::Mat cameraMatrix, distCoeffs;
+        if (parseCalibration(cam, cameraMatrix, distCoeffs)) {
             thread->getProcessor()->setCalibration(cameraMatrix, distCoeffs);
             spdlog::info("Set calibration for pipeline {} (camera {}) with distortion", pipeline.id, cameraId);
         }
@@ -779,10 +1260,12 @@ bool ThreadManager::startPipeline(const Pipeline& pipeline, int cameraId) {
     }
 
     thread->start(queue);
+    MetricsRegistry::instance().setPipelineInfo(pipeline.id, pipeline.name);
 
     pipelineQueues_.emplace(pipeline.id, queue);
     pipelineToCameraMap_.emplace(pipeline.id, cameraId);
     visionThreads_.emplace(pipeline.id, std::move(thread));
+    refreshCaptureRequirements(cameraId);
 
     // Register stream path immediately
     StreamerService::instance().registerPath("/pipeline/" + std::to_string(pipeline.id));
@@ -794,9 +1277,11 @@ void ThreadManager::stopPipeline(int pipelineId) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Unregister from camera
+    int cameraId = -1;
     auto mapIt = pipelineToCameraMap_.find(pipelineId);
     if (mapIt != pipelineToCameraMap_.end()) {
-        auto cameraIt = cameraThreads_.find(mapIt->second);
+        cameraId = mapIt->second;
+        auto cameraIt = cameraThreads_.find(cameraId);
         if (cameraIt != cameraThreads_.end()) {
             cameraIt->second->unregisterQueue(pipelineId);
         }
@@ -810,7 +1295,117 @@ void ThreadManager::stopPipeline(int pipelineId) {
         visionThreads_.erase(it);
     }
 
+    // Remaining pipelines may accept a cheaper mode
+    if (cameraId >= 0) {
+        refreshCaptureRequirements(cameraId);
+    }
+
     pipelineQueues_.erase(pipelineId);
+    idlePipelines_.erase(pipelineId);
+    MetricsRegistry::instance().removePipeline(pipelineId);
+}
+
+void ThreadManager::setPipelineEnabled(int pipelineId, bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pipelineEnabled_[pipelineId] = enabled;
+
+    auto mapIt = pipelineToCameraMap_.find(pipelineId);
+    if (mapIt != pipelineToCameraMap_.end()) {
+        applyActivation(mapIt->second);
+    }
+}
+
+void ThreadManager::setActivePipelines(int cameraId, const std::vector<int>& pipelineIds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cameraActive_[cameraId] = pipelineIds;
+    applyActivation(cameraId);
+}
+
+bool ThreadManager::isPipelineActive(int pipelineId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return visionThreads_.count(pipelineId) && !idlePipelines_.count(pipelineId);
+}
+
+void ThreadManager::setFrameRateCap(double fps) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frameRateCap_ = fps;
+    for (auto& [cameraId, thread] : cameraThreads_) {
+        thread->setFrameRateCap(fps);
+    }
+}
+
+std::vector<PipelineLoadInfo> ThreadManager::getPipelineLoadInfo() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<PipelineLoadInfo> infos;
+    for (const auto& [pipelineId, thread] : visionThreads_) {
+        if (!thread->getProcessor()) continue;
+        infos.push_back({pipelineId, thread->getProcessor()->type(), thread->priority()});
+    }
+    return infos;
+}
+
+void ThreadManager::setPipelineFrameStride(int pipelineId, int stride) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = visionThreads_.find(pipelineId);
+    if (it != visionThreads_.end()) {
+        it->second->setFrameStride(stride);
+    }
+}
+
+void ThreadManager::setPipelineLoadShedding(int pipelineId, int level) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = visionThreads_.find(pipelineId);
+    if (it != visionThreads_.end()) {
+        it->second->setLoadShedding(level);
+    }
+}
+
+bool ThreadManager::isPipelineActiveLocked(int pipelineId, int cameraId) const {
+    auto enabledIt = pipelineEnabled_.find(pipelineId);
+    if (enabledIt != pipelineEnabled_.end() && !enabledIt->second) {
+        return false;
+    }
+    auto activeIt = cameraActive_.find(cameraId);
+    if (activeIt == cameraActive_.end() || activeIt->second.empty()) {
+        return true;
+    }
+    const auto& ids = activeIt->second;
+    return std::find(ids.begin(), ids.end(), pipelineId) != ids.end();
+}
+
+// Takes effect on the camera's next frame; capture requirements stay merged over
+// every pipeline so switching never renegotiates the sensor
+void ThreadManager::applyActivation(int cameraId) {
+    auto cameraIt = cameraThreads_.find(cameraId);
+
+    for (const auto& [pipelineId, camId] : pipelineToCameraMap_) {
+        if (camId != cameraId) continue;
+        auto threadIt = visionThreads_.find(pipelineId);
+        auto queueIt = pipelineQueues_.find(pipelineId);
+        if (threadIt == visionThreads_.end() || queueIt == pipelineQueues_.end()) continue;
+
+        bool active = isPipelineActiveLocked(pipelineId, cameraId);
+        bool idle = idlePipelines_.count(pipelineId) > 0;
+        if (active == !idle) continue;
+
+        if (active) {
+            idlePipelines_.erase(pipelineId);
+            if (cameraIt != cameraThreads_.end()) {
+                cameraIt->second->registerQueue(pipelineId, queueIt->second);
+                cameraIt->second->setQueueExposure(pipelineId, threadIt->second->exposureClass());
+            }
+            spdlog::info("Pipeline {} activated on camera {}", pipelineId, cameraId);
+        } else {
+            idlePipelines_.insert(pipelineId);
+            if (cameraIt != cameraThreads_.end()) {
+                cameraIt->second->unregisterQueue(pipelineId);
+            }
+            // Drop frames queued before the switch so nothing stale is processed
+            queueIt->second->clear();
+            spdlog::info("Pipeline {} idled on camera {}", pipelineId, cameraId);
+        }
+        threadIt->second->setActive(active);
+    }
 }
 
 bool ThreadManager::isPipelineRunning(int pipelineId) {
@@ -822,6 +1417,13 @@ bool ThreadManager::isPipelineRunning(int pipelineId) {
 void ThreadManager::updateCalibration(int cameraId, const cv::Mat& cameraMatrix, const cv::Mat& distCoeffs) {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    FrameBusService::instance().setCalibration(cameraId, cameraMatrix, distCoeffs);
+
+    auto cameraIt = cameraThreads_.find(cameraId);
+    if (cameraIt != cameraThreads_.end()) {
+        cameraIt->second->setCalibrated(!cameraMatrix.empty());
+    }
+
     for (const auto& [pipelineId, camId] : pipelineToCameraMap_) {
         if (camId != cameraId) continue;
 
@@ -840,9 +1442,41 @@ void ThreadManager::updatePipelineConfig(int pipelineId, const nlohmann::json& c
     if (it != visionThreads_.end() && it->second->isRunning()) {
         it->second->updateConfig(config);
         spdlog::info("Updated configuration for running pipeline {}", pipelineId);
+
+        auto mapIt = pipelineToCameraMap_.find(pipelineId);
+        if (mapIt != pipelineToCameraMap_.end()) {
+            refreshCaptureRequirements(mapIt->second);
+        }
     }
 }
 
+// Also routes each pipeline to its exposure class
+void ThreadManager::refreshCaptureRequirements(int cameraId) {
+    auto cameraIt = cameraThreads_.find(cameraId);
+    if (cameraIt == cameraThreads_.end()) return;
+
+    std::optional<CaptureRequirements> merged;
+    for (const auto& [pipelineId, camId] : pipelineToCameraMap_) {
+        if (camId != cameraId) continue;
+        auto it = visionThreads_.find(pipelineId);
+        if (it == visionThreads_.end()) continue;
+
+        if (!idlePipelines_.count(pipelineId)) {
+            cameraIt->second->setQueueExposure(pipelineId, it->second->exposureClass());
+        }
+
+        auto req = it->second->captureRequirements();
+        if (merged) {
+            merged->merge(req);
+        } else {
+            merged = req;
+        }
+    }
+
+    // No pipelines: fall back to the configured mode for the raw feed
+    cameraIt->second->setCaptureRequirements(merged.value_or(CaptureRequirements{}));
+}
+
 void ThreadManager::updateCameraSettings(const Camera& camera) {
     std::lock_guard<std::mutex> lock(mutex_);
     
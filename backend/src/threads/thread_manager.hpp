@@ -5,12 +5,15 @@
 #include "drivers/base_driver.hpp"
 #include "pipelines/base_pipeline.hpp"
 #include "utils/frame_buffer.hpp"
+#include <algorithm>
 #include <thread>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <deque>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 
 namespace vision {
@@ -28,7 +31,8 @@ struct QueuedFrame {
 // Thread-safe frame queue
 class FrameQueue {
 public:
-    explicit FrameQueue(size_t maxSize = 2);
+    explicit FrameQueue(size_t maxSize = 2, int pipelineId = -1);
+    ~FrameQueue();
 
     bool push(FramePtr frame);  // Returns false if queue is full (frame dropped)
     bool pop(QueuedFrame& out, std::chrono::milliseconds timeout);
@@ -41,6 +45,7 @@ private:
     mutable std::mutex mutex_;
     std::condition_variable cv_;
     size_t maxSize_;
+    int pipelineId_;  // For drop accounting; -1 when untracked
 };
 
 // Camera acquisition thread
@@ -65,6 +70,9 @@ public:
     void registerQueue(int pipelineId, std::shared_ptr<FrameQueue> queue);
     void unregisterQueue(int pipelineId);
 
+    // Exposure class a pipeline receives when the camera alternates exposures
+    void setQueueExposure(int pipelineId, ExposureClass exposure);
+
     // Get latest display frame (for raw video feed)
     FramePtr getDisplayFrame();
 
@@ -85,14 +93,31 @@ public:
     int getExposure() const;
     int getGain() const;
 
+    // Merged needs of the attached pipelines; the sensor is renegotiated between frames
+    void setCaptureRequirements(const CaptureRequirements& requirements);
+
+    // A calibrated camera keeps its configured geometry: no binning, downscaling or ROI
+    void setCalibrated(bool calibrated);
+
+    // Forward at most this many frames per second downstream (0 = every frame).
+    // The sensor keeps streaming, so lifting the cap applies on the next frame.
+    void setFrameRateCap(double fps) { frameRateCap_.store(fps); }
+
 private:
     void run();
-    void applyOrientation(cv::Mat& frame);
+    int applyOrientation(cv::Mat& frame);  // Returns the rotation left to carry as metadata
     void syncAutoValues();
+    void negotiateCaptureMode();
+    ExposureClass advanceExposure(const FrameResult& frameResult);
 
     Camera camera_;
     mutable std::mutex settingsMutex_; // Protects camera_ access
     std::unique_ptr<BaseDriver> driver_;
+    CaptureRequirements requirements_;  // Protected by settingsMutex_
+    std::atomic<bool> renegotiate_{true};
+    std::atomic<bool> calibrated_{false};
+    std::atomic<bool> hardwareOrientation_{false};  // Sensor flips, skip cv::rotate
+    std::atomic<double> frameRateCap_{0.0};
     std::atomic<bool> running_{false};
     std::atomic<bool> connected_{false};
     std::atomic<bool> streaming_{false};
@@ -100,8 +125,13 @@ private:
 
     // Subscribed vision threads
     std::unordered_map<int, std::shared_ptr<FrameQueue>> queues_;
+    std::unordered_map<int, ExposureClass> queueExposure_;  // Missing = Any
     std::mutex queuesMutex_;
 
+    // Alternating exposure state (camera thread only)
+    std::deque<ExposureClass> pendingExposures_;  // Requested but not yet captured
+    ExposureClass lastRequested_ = ExposureClass::Any;  // Any = not alternating
+
     // Latest frame for display
     FramePtr displayFrame_;
     std::mutex displayMutex_;
@@ -144,13 +174,77 @@ public:
     // Get underlying processor
     BasePipeline* getProcessor() { return processor_.get(); }
 
+    // Processor needs plus capture_roi/capture_fps overrides from the pipeline config
+    CaptureRequirements captureRequirements() const;
+
+    // Processor's preferred exposure class unless the config sets exposure_class
+    ExposureClass exposureClass() const;
+
+    // Thermal governor: process one in every `stride` frames (1 = all) and shed pipeline work
+    void setFrameStride(int stride) { frameStride_.store((std::max)(1, stride)); }
+    void setLoadShedding(int level);
+
+    // Config "priority"; the governor degrades lower priorities first
+    int priority() const { return priority_.load(); }
+
+    // Idle pipelines are detached from their camera; only the placeholder changes here
+    void setActive(bool active) { active_.store(active); }
+    bool isActive() const { return active_.load(); }
+
 private:
+    // Detect-stage work waiting for the finish thread
+    struct StagedWork {
+        QueuedFrame frame;
+        std::unique_ptr<StagedFrame> staged;
+        std::chrono::steady_clock::time_point dequeueTime;
+    };
+
     void run();
+    void finishLoop();
+    void publishResult(const QueuedFrame& qf, PipelineResult& result,
+                       std::chrono::steady_clock::time_point dequeueTime,
+                       std::chrono::steady_clock::time_point processedTime);
+    void parseCaptureOverrides(const nlohmann::json& config);
+
+    // Motion gate: republish the last result while the scene is unchanged
+    struct MotionGate {
+        bool enabled = false;
+        double threshold = 2.0;   // Mean absolute gray-level change on the thumbnail
+        int maxAgeMs = 1000;      // Forced refresh so results never stay stale
+    };
+    bool reuseIfUnchanged(const QueuedFrame& qf, const cv::Mat& thumbnail, const MotionGate& gate,
+                          bool staged, std::chrono::steady_clock::time_point dequeueTime);
 
     Pipeline pipeline_;
     std::unique_ptr<BasePipeline> processor_;
     std::shared_ptr<FrameQueue> inputQueue_;
+
+    // Staged processors: one frame in flight between detect (run) and finish (finishLoop)
+    std::thread finishThread_;
+    std::optional<StagedWork> pendingWork_;
+    bool finishing_ = false;  // Finish thread holds a frame it has not published yet
+    std::mutex stageMutex_;
+    std::condition_variable stageCv_;
+
+    // Sensor overrides from the pipeline config
+    std::optional<cv::Rect2d> captureRoi_;
+    int captureFps_ = 0;
+    std::optional<ExposureClass> exposureOverride_;
+    MotionGate motionGate_;
+    mutable std::mutex captureMutex_;
+
+    // Last processed thumbnail (run thread) and result (either stage thread)
+    // Sequences pair them: a result is only reused for the frame whose thumbnail it came from
+    cv::Mat lastThumbnail_;
+    uint64_t lastThumbnailSequence_ = 0;
+    std::optional<PipelineResult> lastResult_;
+    uint64_t lastResultSequence_ = 0;
+    std::chrono::steady_clock::time_point lastResultTime_;
+    std::mutex gateMutex_;
     std::atomic<bool> running_{false};
+    std::atomic<bool> active_{true};
+    std::atomic<int> frameStride_{1};
+    std::atomic<int> priority_{0};
     std::thread thread_;
 
     // Latest processed frame
@@ -162,6 +256,13 @@ private:
     std::mutex resultsMutex_;
 };
 
+// What the thermal governor needs to order a running pipeline
+struct PipelineLoadInfo {
+    int pipelineId = 0;
+    PipelineType type = PipelineType::AprilTag;
+    int priority = 0;
+};
+
 // Thread manager singleton
 class ThreadManager {
 public:
@@ -184,6 +285,20 @@ public:
     void stopPipeline(int pipelineId);
     bool isPipelineRunning(int pipelineId);
 
+    // Robot-driven activation; idle pipelines stop receiving frames until re-enabled.
+    // A pipeline runs when it is enabled and listed in its camera's active set (empty = all).
+    void setPipelineEnabled(int pipelineId, bool enabled);
+    void setActivePipelines(int cameraId, const std::vector<int>& pipelineIds);
+    bool isPipelineActive(int pipelineId);
+
+    // Cap on frames each camera forwards to its pipelines and stream (0 = none)
+    void setFrameRateCap(double fps);
+
+    // Running pipelines for the thermal governor, and its per-pipeline levers
+    std::vector<PipelineLoadInfo> getPipelineLoadInfo();
+    void setPipelineFrameStride(int pipelineId, int stride);
+    void setPipelineLoadShedding(int pipelineId, int level);
+
     // Update calibration for all pipelines associated with a camera
     void updateCalibration(int cameraId, const cv::Mat& cameraMatrix, const cv::Mat& distCoeffs);
 
@@ -225,6 +340,18 @@ private:
     std::unordered_map<int, std::shared_ptr<FrameQueue>> pipelineQueues_;
     std::unordered_map<int, int> pipelineToCameraMap_;  // pipeline_id -> camera_id
 
+    // Push the merged pipeline requirements to a camera (caller holds mutex_)
+    void refreshCaptureRequirements(int cameraId);
+
+    // Attach active and detach idle queues on a camera (caller holds mutex_)
+    bool isPipelineActiveLocked(int pipelineId, int cameraId) const;
+    void applyActivation(int cameraId);
+
+    std::unordered_map<int, bool> pipelineEnabled_;               // Missing = enabled
+    std::unordered_map<int, std::vector<int>> cameraActive_;      // Missing or empty = all
+    std::unordered_set<int> idlePipelines_;                       // Currently detached
+    double frameRateCap_ = 0.0;
+
     std::mutex mutex_;
 };
 
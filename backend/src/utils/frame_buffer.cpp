@@ -1,11 +1,34 @@
 #include "utils/frame_buffer.hpp"
+#include "metrics/memory.hpp"
+#include "utils/orientation.hpp"
 
 namespace vision {
 
+namespace {
+
+// Change thumbnails: coarse enough to ignore sensor noise, cheap to compare
+constexpr int kThumbnailWidth = 64;
+constexpr int kThumbnailHeight = 48;
+
+} // namespace
+
 RefCountedFrame::RefCountedFrame(cv::Mat color, std::optional<cv::Mat> depth)
     : colorFrame_(std::move(color))
     , depthFrame_(std::move(depth))
     , timestamp_(std::chrono::steady_clock::now()) {
+    trackedBytes_ = matBytes(colorFrame_) + (depthFrame_ ? matBytes(*depthFrame_) : 0);
+    MemoryTracker::instance().counter(MemorySubsystem::Frames).add(trackedBytes_);
+    tracked_ = true;
+}
+
+RefCountedFrame::~RefCountedFrame() {
+    // Default-constructed frames were never counted
+    if (tracked_) {
+        MemoryTracker::instance().counter(MemorySubsystem::Frames).sub(trackedBytes_);
+    }
+    if (trackedJpegBytes_ > 0) {
+        MemoryTracker::instance().counter(MemorySubsystem::JpegCache).sub(trackedJpegBytes_);
+    }
 }
 
 void RefCountedFrame::acquire() {
@@ -33,6 +56,7 @@ const std::vector<uchar>& RefCountedFrame::getJpeg(int quality) {
 
     jpegQuality_ = quality;
     jpegCacheValid_ = true;
+    trackJpegCache();
 
     return jpegCache_;
 }
@@ -41,6 +65,51 @@ void RefCountedFrame::clearJpegCache() {
     std::lock_guard<std::mutex> lock(jpegMutex_);
     jpegCacheValid_ = false;
     jpegCache_.clear();
+    trackJpegCache();
+}
+
+cv::Mat RefCountedFrame::changeThumbnail() {
+    std::lock_guard<std::mutex> lock(derivedMutex_);
+    if (changeThumbnail_.empty() && !colorFrame_.empty()) {
+        // Shrink first so the color conversion only touches the thumbnail
+        cv::Mat small;
+        cv::resize(colorFrame_, small, cv::Size(kThumbnailWidth, kThumbnailHeight), 0, 0, cv::INTER_AREA);
+        if (small.channels() == 3) {
+            cv::cvtColor(small, changeThumbnail_, cv::COLOR_BGR2GRAY);
+        } else {
+            changeThumbnail_ = small;
+        }
+    }
+    return changeThumbnail_;
+}
+
+cv::Mat RefCountedFrame::upright() {
+    if (orientation_ == 0) return colorFrame_;
+    std::lock_guard<std::mutex> lock(derivedMutex_);
+    if (upright_.empty() && !colorFrame_.empty()) {
+        upright_ = orientation::uprightCopy(colorFrame_, orientation_);
+    }
+    return upright_;
+}
+
+double RefCountedFrame::changeScore(const cv::Mat& a, const cv::Mat& b) {
+    if (a.empty() || b.empty() || a.size() != b.size() || a.type() != b.type()) {
+        return 255.0;
+    }
+    return cv::norm(a, b, cv::NORM_L1) / static_cast<double>(a.total());
+}
+
+void RefCountedFrame::trackJpegCache() {
+    // Caller holds jpegMutex_
+    int64_t bytes = static_cast<int64_t>(jpegCache_.capacity());
+    auto& counter = MemoryTracker::instance().counter(MemorySubsystem::JpegCache);
+    if (trackedJpegBytes_ > 0) {
+        counter.sub(trackedJpegBytes_);
+    }
+    if (bytes > 0) {
+        counter.add(bytes);
+    }
+    trackedJpegBytes_ = bytes;
 }
 
 } // namespace vision
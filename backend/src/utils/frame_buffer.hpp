@@ -6,13 +6,38 @@
 #include <optional>
 #include <chrono>
 #include <memory>
+#include <string>
 
 namespace vision {
 
+// Which exposure a frame was captured with when the camera alternates exposures.
+// Any means the camera is not alternating (or the consumer takes every frame).
+enum class ExposureClass {
+    Any,
+    Short,  // Low blur, for fiducials
+    Long    // Bright, for the driver stream and ML
+};
+
+inline const char* exposureClassName(ExposureClass cls) {
+    switch (cls) {
+        case ExposureClass::Short: return "short";
+        case ExposureClass::Long: return "long";
+        default: return "any";
+    }
+}
+
+inline ExposureClass parseExposureClass(const std::string& name, ExposureClass fallback = ExposureClass::Any) {
+    if (name == "short") return ExposureClass::Short;
+    if (name == "long") return ExposureClass::Long;
+    if (name == "any") return ExposureClass::Any;
+    return fallback;
+}
+
 class RefCountedFrame {
 public:
     RefCountedFrame() = default;
     RefCountedFrame(cv::Mat color, std::optional<cv::Mat> depth = std::nullopt);
+    ~RefCountedFrame();
 
     // Acquire a reference
     void acquire();
@@ -46,21 +71,53 @@ public:
     uint64_t sequence() const { return sequence_; }
     void setSequence(uint64_t seq) { sequence_ = seq; }
 
+    // Exposure class (alternating-exposure cameras)
+    ExposureClass exposureClass() const { return exposureClass_; }
+    void setExposureClass(ExposureClass cls) { exposureClass_ = cls; }
+
+    // Mount rotation still to apply (0/90/180/270) when the camera carries orientation
+    // as metadata; color() is then in sensor coordinates
+    int orientation() const { return orientation_; }
+    void setOrientation(int degrees) { orientation_ = degrees; }
+
+    // Upright color image for display and calibration; rotated on first use and
+    // shared by every consumer of this frame (color() itself when orientation is 0)
+    cv::Mat upright();
+
     // Clear cached JPEG
     void clearJpegCache();
 
+    // Small grayscale thumbnail for change detection; built on first use and
+    // shared by every pipeline that receives this frame
+    cv::Mat changeThumbnail();
+
+    // Mean absolute difference in gray levels (0-255) between two thumbnails
+    static double changeScore(const cv::Mat& a, const cv::Mat& b);
+
 private:
     cv::Mat colorFrame_;
     std::optional<cv::Mat> depthFrame_;
     std::atomic<int> refCount_{0};
     std::chrono::steady_clock::time_point timestamp_;
     uint64_t sequence_ = 0;
+    ExposureClass exposureClass_ = ExposureClass::Any;
+    int orientation_ = 0;
+    int64_t trackedBytes_ = 0;  // Pixel bytes reported to MemoryTracker
+    bool tracked_ = false;
 
     // JPEG cache
     std::vector<uchar> jpegCache_;
     int jpegQuality_ = 0;
     bool jpegCacheValid_ = false;
+    int64_t trackedJpegBytes_ = 0;
+
+    void trackJpegCache();
     std::mutex jpegMutex_;
+
+    // Derived images
+    cv::Mat changeThumbnail_;
+    cv::Mat upright_;
+    std::mutex derivedMutex_;
 };
 
 using FramePtr = std::shared_ptr<RefCountedFrame>;
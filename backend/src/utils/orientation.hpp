@@ -0,0 +1,73 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+namespace vision {
+
+// Mapping between sensor and upright image coordinates for cameras whose mount
+// rotation travels as frame metadata instead of being applied with cv::rotate.
+// orientation is the clockwise rotation (0, 90, 180, 270) that makes the sensor
+// image upright; sensor is the size of the unrotated image.
+namespace orientation {
+
+inline bool swapsAxes(int orientation) {
+    return orientation == 90 || orientation == 270;
+}
+
+inline cv::Size uprightSize(cv::Size sensor, int orientation) {
+    return swapsAxes(orientation) ? cv::Size(sensor.height, sensor.width) : sensor;
+}
+
+// Same pixel as cv::rotate would move it to
+template <typename T>
+cv::Point_<T> toUpright(const cv::Point_<T>& p, int orientation, cv::Size sensor) {
+    const T w = static_cast<T>(sensor.width - 1);
+    const T h = static_cast<T>(sensor.height - 1);
+    switch (orientation) {
+        case 90: return {h - p.y, p.x};
+        case 180: return {w - p.x, h - p.y};
+        case 270: return {p.y, w - p.x};
+        default: return p;
+    }
+}
+
+// Inverse of toUpright, for sampling sensor-aligned data such as depth
+template <typename T>
+cv::Point_<T> toSensor(const cv::Point_<T>& p, int orientation, cv::Size sensor) {
+    const T w = static_cast<T>(sensor.width - 1);
+    const T h = static_cast<T>(sensor.height - 1);
+    switch (orientation) {
+        case 90: return {p.y, h - p.x};
+        case 180: return {w - p.x, h - p.y};
+        case 270: return {w - p.y, p.x};
+        default: return p;
+    }
+}
+
+// Displacements only rotate; there is no offset
+template <typename T>
+cv::Point_<T> vectorToUpright(const cv::Point_<T>& v, int orientation) {
+    switch (orientation) {
+        case 90: return {-v.y, v.x};
+        case 180: return {-v.x, -v.y};
+        case 270: return {v.y, -v.x};
+        default: return v;
+    }
+}
+
+// Upright copy of a sensor image. The rotation is the copy, so this costs the
+// same memory pass as clone() and can stand in wherever a frame is cloned anyway.
+inline cv::Mat uprightCopy(const cv::Mat& sensor, int orientation) {
+    cv::Mat out;
+    switch (orientation) {
+        case 90: cv::rotate(sensor, out, cv::ROTATE_90_CLOCKWISE); break;
+        case 180: cv::rotate(sensor, out, cv::ROTATE_180); break;
+        case 270: cv::rotate(sensor, out, cv::ROTATE_90_COUNTERCLOCKWISE); break;
+        default: out = sensor.clone(); break;
+    }
+    return out;
+}
+
+} // namespace orientation
+
+} // namespace vision
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vision {
+
+// Incremental SHA-256 for hashing files as they are streamed to disk
+class Sha256 {
+public:
+    Sha256();
+
+    void update(const void* data, size_t length);
+
+    // Finalize and return the lowercase hex digest (object must not be reused)
+    std::string hexDigest();
+
+private:
+    void transform(const uint8_t* block);
+
+    std::array<uint32_t, 8> state_;
+    std::array<uint8_t, 64> buffer_;
+    uint64_t totalBytes_ = 0;
+    size_t bufferLength_ = 0;
+};
+
+} // namespace vision
@@ -0,0 +1,398 @@
+#include "apriltag_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace {
+
+constexpr size_t kDefaultChunkBytes = 256 * 1024;
+constexpr size_t kLargeGranule = 64 * 1024;
+constexpr size_t kAlign = 16;
+constexpr uint32_t kMagic = 0xA7A6A2E4u;
+// Free chunks untouched for this many frames go back to malloc
+constexpr uint64_t kIdleFrames = 8;
+
+struct Chunk;
+
+// Precedes every pointer handed to the library
+struct alignas(16) Header {
+    Chunk* chunk;   // nullptr when served by malloc
+    size_t size;    // Requested size
+    uint32_t magic;
+};
+static_assert(sizeof(Header) % kAlign == 0, "header must keep allocations aligned");
+
+struct alignas(16) Chunk {
+    apriltag_arena_t* arena = nullptr;
+    // Live allocations, plus one while a thread bumps through it
+    std::atomic<int64_t> live{0};
+    size_t capacity = 0;
+    size_t used = 0;          // Only touched by the thread bumping through it
+    bool large = false;
+    uint64_t idleSince = 0;   // Frame it went back on the free list
+    Chunk* next = nullptr;
+
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+size_t alignUp(size_t n) {
+    return (n + kAlign - 1) & ~(kAlign - 1);
+}
+
+void updatePeak(std::atomic<int64_t>& peak, int64_t value) {
+    int64_t current = peak.load(std::memory_order_relaxed);
+    while (value > current &&
+           !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+struct apriltag_arena {
+    size_t chunkBytes = kDefaultChunkBytes;
+
+    std::mutex mutex;              // Guards the free lists
+    Chunk* freeChunks = nullptr;   // Standard chunks
+    Chunk* freeLarge = nullptr;    // Dedicated chunks
+
+    // The owner, each bound thread and each chunk off the free lists hold one
+    std::atomic<int64_t> refs{1};
+    std::atomic<uint64_t> frame{0};
+
+    std::atomic<uint64_t> allocs{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> frameAllocsStart{0};
+    std::atomic<uint64_t> frameBytesStart{0};
+    std::atomic<uint64_t> largeAllocs{0};
+    std::atomic<uint64_t> chunkReuses{0};
+    std::atomic<uint64_t> chunkMallocs{0};
+    std::atomic<int64_t> liveBytes{0};
+    std::atomic<int64_t> peakLiveBytes{0};
+    std::atomic<int64_t> reservedBytes{0};
+};
+
+namespace {
+
+// The calling thread's binding and the chunk it bumps through
+struct Lane {
+    apriltag_arena_t* arena = nullptr;
+    Chunk* chunk = nullptr;
+    ~Lane();
+};
+
+thread_local Lane lane;
+
+void freeChunk(apriltag_arena_t* arena, Chunk* chunk) {
+    arena->reservedBytes.fetch_sub(static_cast<int64_t>(sizeof(Chunk) + chunk->capacity),
+                                   std::memory_order_relaxed);
+    chunk->~Chunk();
+    std::free(chunk);
+}
+
+void release(apriltag_arena_t* arena) {
+    if (arena->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    for (Chunk* list : {arena->freeChunks, arena->freeLarge}) {
+        while (list) {
+            Chunk* next = list->next;
+            freeChunk(arena, list);
+            list = next;
+        }
+    }
+    delete arena;
+}
+
+// Last allocation in the chunk freed: back on the free list
+void recycle(Chunk* chunk) {
+    apriltag_arena_t* arena = chunk->arena;
+    {
+        std::lock_guard<std::mutex> lock(arena->mutex);
+        chunk->used = 0;
+        chunk->idleSince = arena->frame.load(std::memory_order_relaxed);
+        Chunk*& list = chunk->large ? arena->freeLarge : arena->freeChunks;
+        chunk->next = list;
+        list = chunk;
+    }
+    release(arena);
+}
+
+void unref(Chunk* chunk) {
+    if (chunk->live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        recycle(chunk);
+    }
+}
+
+// A chunk with at least `capacity` bytes, holding one live reference
+Chunk* takeChunk(apriltag_arena_t* arena, size_t capacity, bool large) {
+    Chunk* chunk = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(arena->mutex);
+        for (Chunk** link = large ? &arena->freeLarge : &arena->freeChunks; *link; link = &(*link)->next) {
+            // A dedicated chunk is reused for requests down to half its size, so each
+            // frame's image-sized buffers land in last frame's chunks
+            size_t available = (*link)->capacity;
+            if (available >= capacity && (!large || available / 2 <= capacity)) {
+                chunk = *link;
+                *link = chunk->next;
+                break;
+            }
+        }
+    }
+
+    if (chunk) {
+        arena->chunkReuses.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        void* memory = std::malloc(sizeof(Chunk) + capacity);
+        if (!memory) return nullptr;
+        chunk = new (memory) Chunk;
+        chunk->arena = arena;
+        chunk->capacity = capacity;
+        chunk->large = large;
+        arena->chunkMallocs.fetch_add(1, std::memory_order_relaxed);
+        arena->reservedBytes.fetch_add(static_cast<int64_t>(sizeof(Chunk) + capacity),
+                                       std::memory_order_relaxed);
+    }
+
+    chunk->next = nullptr;
+    chunk->live.store(1, std::memory_order_relaxed);
+    arena->refs.fetch_add(1, std::memory_order_relaxed);
+    return chunk;
+}
+
+void* stamp(void* at, Chunk* chunk, size_t size) {
+    auto* header = static_cast<Header*>(at);
+    header->chunk = chunk;
+    header->size = size;
+    header->magic = kMagic;
+    return header + 1;
+}
+
+void* systemAlloc(size_t size) {
+    void* at = std::malloc(sizeof(Header) + size);
+    return at ? stamp(at, nullptr, size) : nullptr;
+}
+
+void* arenaAlloc(apriltag_arena_t* arena, size_t size) {
+    size_t need = sizeof(Header) + alignUp((std::max)(size, size_t{1}));
+    Chunk* chunk = nullptr;
+    char* at = nullptr;
+
+    if (need > arena->chunkBytes / 4) {
+        // The allocation takes over the new chunk's reference; no thread bumps through it
+        chunk = takeChunk(arena, (need + kLargeGranule - 1) / kLargeGranule * kLargeGranule, true);
+        if (!chunk) return nullptr;
+        at = chunk->data();
+        arena->largeAllocs.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        if (!lane.chunk || lane.chunk->used + need > lane.chunk->capacity) {
+            if (lane.chunk) unref(lane.chunk);
+            lane.chunk = takeChunk(arena, arena->chunkBytes, false);
+            if (!lane.chunk) return nullptr;
+        }
+        chunk = lane.chunk;
+        at = chunk->data() + chunk->used;
+        chunk->used += need;
+        chunk->live.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    arena->allocs.fetch_add(1, std::memory_order_relaxed);
+    arena->bytes.fetch_add(size, std::memory_order_relaxed);
+    updatePeak(arena->peakLiveBytes,
+               arena->liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) +
+                   static_cast<int64_t>(size));
+    return stamp(at, chunk, size);
+}
+
+Header* headerOf(void* ptr) {
+    return static_cast<Header*>(ptr) - 1;
+}
+
+#ifndef _WIN32
+struct ThreadStart {
+    void* (*start)(void*);
+    void* arg;
+    apriltag_arena_t* arena;
+};
+
+void* startBound(void* raw) {
+    ThreadStart start = *static_cast<ThreadStart*>(raw);
+    delete static_cast<ThreadStart*>(raw);
+    apriltag_arena_bind(start.arena);
+    release(start.arena);  // Reference taken for the thread while it was starting
+    return start.start(start.arg);
+}
+#endif
+
+Lane::~Lane() {
+    apriltag_arena_bind(nullptr);
+}
+
+} // namespace
+
+extern "C" {
+
+apriltag_arena_t* apriltag_arena_create(size_t chunk_bytes) {
+    auto* arena = new (std::nothrow) apriltag_arena;
+    if (arena && chunk_bytes > 0) {
+        arena->chunkBytes = alignUp((std::max)(chunk_bytes, size_t{4096}));
+    }
+    return arena;
+}
+
+void apriltag_arena_destroy(apriltag_arena_t* arena) {
+    if (arena) release(arena);
+}
+
+void apriltag_arena_bind(apriltag_arena_t* arena) {
+    if (arena == lane.arena) return;
+    if (lane.chunk) {
+        unref(lane.chunk);
+        lane.chunk = nullptr;
+    }
+    if (arena) arena->refs.fetch_add(1, std::memory_order_relaxed);
+    apriltag_arena_t* previous = lane.arena;
+    lane.arena = arena;
+    if (previous) release(previous);
+}
+
+void apriltag_arena_frame_begin(apriltag_arena_t* arena) {
+    if (!arena) return;
+    uint64_t frame = arena->frame.fetch_add(1, std::memory_order_relaxed) + 1;
+    arena->frameAllocsStart.store(arena->allocs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    arena->frameBytesStart.store(arena->bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    // A frame full of tags can take more chunks than usual; give them back once it passes
+    Chunk* idle = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(arena->mutex);
+        for (Chunk** list : {&arena->freeChunks, &arena->freeLarge}) {
+            for (Chunk** link = list; *link;) {
+                if (frame - (*link)->idleSince > kIdleFrames) {
+                    Chunk* chunk = *link;
+                    *link = chunk->next;
+                    chunk->next = idle;
+                    idle = chunk;
+                } else {
+                    link = &(*link)->next;
+                }
+            }
+        }
+    }
+    while (idle) {
+        Chunk* next = idle->next;
+        freeChunk(arena, idle);
+        idle = next;
+    }
+}
+
+void apriltag_arena_get_stats(const apriltag_arena_t* arena, apriltag_arena_stats_t* stats) {
+    std::memset(stats, 0, sizeof(*stats));
+    if (!arena) return;
+    stats->allocs = arena->allocs.load(std::memory_order_relaxed);
+    stats->bytes = arena->bytes.load(std::memory_order_relaxed);
+    stats->frame_allocs = stats->allocs - arena->frameAllocsStart.load(std::memory_order_relaxed);
+    stats->frame_bytes = stats->bytes - arena->frameBytesStart.load(std::memory_order_relaxed);
+    stats->large_allocs = arena->largeAllocs.load(std::memory_order_relaxed);
+    stats->chunk_reuses = arena->chunkReuses.load(std::memory_order_relaxed);
+    stats->chunk_mallocs = arena->chunkMallocs.load(std::memory_order_relaxed);
+    stats->live_bytes = arena->liveBytes.load(std::memory_order_relaxed);
+    stats->peak_live_bytes = arena->peakLiveBytes.load(std::memory_order_relaxed);
+    stats->reserved_bytes = arena->reservedBytes.load(std::memory_order_relaxed);
+}
+
+void* apriltag_arena_malloc(size_t size) {
+    return lane.arena ? arenaAlloc(lane.arena, size) : systemAlloc(size);
+}
+
+void* apriltag_arena_calloc(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) return nullptr;
+    void* ptr = apriltag_arena_malloc(count * size);
+    // Recycled chunks are not zeroed
+    if (ptr) std::memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* apriltag_arena_realloc(void* ptr, size_t size) {
+    if (!ptr) return apriltag_arena_malloc(size);
+    if (size == 0) {
+        apriltag_arena_free(ptr);
+        return nullptr;
+    }
+
+    Header* header = headerOf(ptr);
+    if (header->magic != kMagic) {
+        return std::realloc(ptr, size);  // Not allocated through the hooks
+    }
+    if (size <= header->size) {
+        return ptr;
+    }
+
+    Chunk* chunk = header->chunk;
+    if (!chunk && !lane.arena) {
+        void* grown = std::realloc(header, sizeof(Header) + size);
+        return grown ? stamp(grown, nullptr, size) : nullptr;
+    }
+    if (chunk && chunk->large && sizeof(Header) + size <= chunk->capacity) {
+        chunk->arena->liveBytes.fetch_add(static_cast<int64_t>(size - header->size), std::memory_order_relaxed);
+        header->size = size;
+        return ptr;
+    }
+
+    void* grown = apriltag_arena_malloc(size);
+    if (!grown) return nullptr;
+    std::memcpy(grown, ptr, header->size);
+    apriltag_arena_free(ptr);
+    return grown;
+}
+
+void apriltag_arena_free(void* ptr) {
+    if (!ptr) return;
+    Header* header = headerOf(ptr);
+    if (header->magic != kMagic) {
+        std::free(ptr);  // Not allocated through the hooks
+        return;
+    }
+    header->magic = 0;
+
+    Chunk* chunk = header->chunk;
+    if (!chunk) {
+        std::free(header);
+        return;
+    }
+    chunk->arena->liveBytes.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+    unref(chunk);
+}
+
+char* apriltag_arena_strdup(const char* str) {
+    size_t length = std::strlen(str) + 1;
+    auto* copy = static_cast<char*>(apriltag_arena_malloc(length));
+    if (copy) std::memcpy(copy, str, length);
+    return copy;
+}
+
+#ifndef _WIN32
+int apriltag_arena_pthread_create(pthread_t* thread, const pthread_attr_t* attr,
+                                  void* (*start)(void*), void* arg) {
+    apriltag_arena_t* arena = lane.arena;
+    if (!arena) {
+        return pthread_create(thread, attr, start, arg);
+    }
+
+    auto* bound = new (std::nothrow) ThreadStart{start, arg, arena};
+    if (!bound) return EAGAIN;
+    arena->refs.fetch_add(1, std::memory_order_relaxed);
+    int rc = pthread_create(thread, attr, startBound, bound);
+    if (rc != 0) {
+        delete bound;
+        release(arena);
+    }
+    return rc;
+}
+#endif
+
+} // extern "C"
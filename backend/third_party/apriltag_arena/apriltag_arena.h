@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Per-detector allocation arena for the vendored apriltag library.
+//
+// apriltag_arena_hooks.h is force-included into every apriltag C source, so the
+// library's malloc/calloc/realloc/free/strdup land here. On a thread with an
+// arena bound, allocations bump through a chunk owned by that thread, without a
+// lock. A chunk goes back on the arena's free list as soon as everything in it
+// has been freed. At the end of a frame that is nearly every chunk, and the next
+// frame reuses them. Requests over a quarter chunk (image copies, union-find
+// tables) get a chunk of their own, kept for the next frame's buffer of the same
+// size. Threads the library starts while bound, such as its worker pool, inherit
+// the binding. Frees work from any thread, bound or not. Unbound allocations go
+// to malloc.
+//
+// The arena is not rewound wholesale at frame start. The detector keeps a few
+// allocations across frames (its worker pool and family list), and those simply
+// keep their chunk.
+
+typedef struct apriltag_arena apriltag_arena_t;
+
+typedef struct {
+    uint64_t allocs;          // Allocations served since creation
+    uint64_t bytes;           // Bytes requested since creation
+    uint64_t frame_allocs;    // Allocations since apriltag_arena_frame_begin
+    uint64_t frame_bytes;
+    uint64_t large_allocs;    // Allocations that needed a dedicated chunk
+    uint64_t chunk_reuses;    // Chunks taken from the free list
+    uint64_t chunk_mallocs;   // Chunks obtained from malloc
+    int64_t live_bytes;       // Allocated and not yet freed
+    int64_t peak_live_bytes;
+    int64_t reserved_bytes;   // Chunks held by the arena, in use or free
+} apriltag_arena_stats_t;
+
+// chunk_bytes of 0 selects the default (256 KiB)
+apriltag_arena_t* apriltag_arena_create(size_t chunk_bytes);
+
+// Drops the owner's reference; the arena is freed once nothing allocated from it
+// is live and no thread is bound to it
+void apriltag_arena_destroy(apriltag_arena_t* arena);
+
+// Bind an arena to the calling thread, replacing any previous binding (NULL unbinds)
+void apriltag_arena_bind(apriltag_arena_t* arena);
+
+// Start a frame: zero the frame counters and return chunks that have sat unused
+// for several frames to malloc
+void apriltag_arena_frame_begin(apriltag_arena_t* arena);
+
+void apriltag_arena_get_stats(const apriltag_arena_t* arena, apriltag_arena_stats_t* stats);
+
+// Targets of the hooks in apriltag_arena_hooks.h
+void* apriltag_arena_malloc(size_t size);
+void* apriltag_arena_calloc(size_t count, size_t size);
+void* apriltag_arena_realloc(void* ptr, size_t size);
+void apriltag_arena_free(void* ptr);
+char* apriltag_arena_strdup(const char* str);
+#ifndef _WIN32
+int apriltag_arena_pthread_create(pthread_t* thread, const pthread_attr_t* attr,
+                                  void* (*start)(void*), void* arg);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+
+// Force-included into every vendored apriltag C source by third_party/CMakeLists.txt,
+// so the submodule is used unmodified at whatever revision it pins. The real
+// declarations are pulled in first; later includes of these headers are no-ops, and
+// the macros only rewrite the library's own calls. They are object-like so heap
+// functions passed by pointer (zarray_vmap(za, free)) are redirected too.
+
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include "apriltag_arena.h"
+
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+#undef strdup
+#define malloc apriltag_arena_malloc
+#define calloc apriltag_arena_calloc
+#define realloc apriltag_arena_realloc
+#define free apriltag_arena_free
+#define strdup apriltag_arena_strdup
+
+// Worker threads inherit the creating thread's arena. On Windows apriltag brings its
+// own pthread shim, which must keep its name; workers there allocate from malloc.
+#ifndef _WIN32
+#undef pthread_create
+#define pthread_create apriltag_arena_pthread_create
+#endif
@@ -0,0 +1,17 @@
+import { test, expect } from '@playwright/test';
+import { navigateTo } from './utils';
+
+test.describe('Cluster Page', () => {
+  test('should show this node and the cluster role', async ({ page }) => {
+    await navigateTo(page, '/cluster', 'page-title-cluster');
+    await expect(page.locator('text=This Node')).toBeVisible();
+  });
+
+  test('should explain how to enable cluster mode when standalone', async ({ page, request }) => {
+    const status = await (await request.get('/api/cluster/status')).json();
+    test.skip(status.role !== 'standalone', 'Backend is running in a cluster role');
+
+    await navigateTo(page, '/cluster', 'page-title-cluster');
+    await expect(page.locator('text=Cluster mode is off')).toBeVisible();
+  });
+});
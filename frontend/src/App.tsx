@@ -10,6 +10,7 @@ const Cameras = lazy(() => import('./pages/Cameras'))
 const Settings = lazy(() => import('./pages/Settings'))
 const Monitoring = lazy(() => import('./pages/Monitoring'))
 const Calibration = lazy(() => import('./pages/Calibration'))
+const Cluster = lazy(() => import('./pages/Cluster'))
 const NotFound = lazy(() => import('./pages/NotFound'))
 
 const router = createBrowserRouter([
@@ -57,6 +58,14 @@ const router = createBrowserRouter([
           </Suspense>
         ),
       },
+      {
+        path: 'cluster',
+        element: (
+          <Suspense fallback={<LoadingSpinner />}>
+            <Cluster />
+          </Suspense>
+        ),
+      },
       {
         path: '*',
         element: (
@@ -4,6 +4,7 @@ import { Button } from '../ui/button';
 import { Alert, AlertTitle, AlertDescription } from '../ui/alert';
 import { Save, RotateCcw, CheckCircle, AlertTriangle } from 'lucide-react';
 import type { BoardConfig } from './BoardConfig';
+import { waitForJob } from '@/lib/jobs';
 
 interface Corner {
     x: number;
@@ -17,6 +18,8 @@ interface Detection {
 }
 
 interface CalibrationResult {
+    success?: boolean;
+    error?: string;
     camera_matrix: number[][];
     dist_coeffs: number[];
     reprojection_error: number;
@@ -36,6 +39,7 @@ export function ResultStep({
     onRestart
 }: ResultStepProps) {
     const [isCalibrating, setIsCalibrating] = useState(true);
+    const [progressMessage, setProgressMessage] = useState<string | null>(null);
     const [isSaving, setIsSaving] = useState(false);
     const [error, setError] = useState<string | null>(null);
     const [result, setResult] = useState<CalibrationResult | null>(null);
@@ -63,7 +67,15 @@ export function ResultStep({
                 const data = await response.json();
                 if (!response.ok) throw new Error(data.error || "Calibration failed");
 
-                setResult(data);
+                // The solve runs as a background job; wait for its result
+                const calibration = await waitForJob<CalibrationResult>(data.job_id, (job) => {
+                    setProgressMessage(job.message);
+                });
+                if (calibration.success === false) {
+                    throw new Error(calibration.error || "Calibration failed");
+                }
+
+                setResult(calibration);
             } catch (e: unknown) {
                 setError(e instanceof Error ? e.message : 'Calibration failed');
             } finally {
@@ -105,7 +117,7 @@ export function ResultStep({
             <div className="flex flex-col items-center justify-center py-12 space-y-4">
                 <div className="h-12 w-12 animate-spin rounded-full border-4 border-primary border-t-transparent"></div>
                 <p className="text-lg font-medium">Calculating calibration parameters...</p>
-                <p className="text-muted-foreground">This may take a moment.</p>
+                <p className="text-muted-foreground">{progressMessage ?? 'This may take a moment.'}</p>
             </div>
         );
     }
@@ -123,6 +123,27 @@ export const CameraControls = memo(function CameraControls({
         </div>
       </div>
 
+      {/* Alternate Exposure: frames alternate between the two, short to AprilTag, long to ML and the stream */}
+      <div className="space-y-2">
+        <Label htmlFor="alternate-exposure">Alternate Exposure</Label>
+        <Input
+          id="alternate-exposure"
+          type="number"
+          min={controls.exposure_min ?? 0}
+          max={controls.exposure_max ?? 10000}
+          step={controls.exposure_step ?? 1}
+          placeholder="Off"
+          value={controls.alternate_exposure_value ?? ''}
+          onChange={(e) =>
+            queueSave({
+              alternate_exposure_value: e.target.value === '' ? null : parseInt(e.target.value),
+            })
+          }
+          disabled={controls.exposure_mode !== 'manual'}
+          aria-label="Alternate exposure value"
+        />
+      </div>
+
       {/* Gain Mode */}
       <div className="space-y-2">
         <Label>Gain Mode</Label>
@@ -79,6 +79,7 @@ export const PipelineConfigPanel = memo(function PipelineConfigPanel({
         config={config}
         onChange={queueSave}
         results={results.ml}
+        inference={results.inference ?? null}
         labelOptions={labelOptions}
         onFileUpload={onFileUpload}
         onFileDelete={onFileDelete}
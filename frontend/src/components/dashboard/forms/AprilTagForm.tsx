@@ -1,5 +1,5 @@
 import { memo } from 'react'
-import type { PipelineConfig, AprilTagDetection, RobotPose } from '@/types'
+import type { PipelineConfig, AprilTagDetection, AprilTagFamilyConfig, RobotPose } from '@/types'
 import { TAG_FAMILIES } from '@/constants/pipeline'
 import { quaternionToEuler } from '@/lib/math'
 import { Input } from '@/components/ui/input'
@@ -23,6 +23,27 @@ export const AprilTagForm = memo(function AprilTagForm({
   robotPose,
   processingTimeMs,
 }: AprilTagFormProps) {
+  const primaryFamily = (config.family as string) ?? 'tag36h11'
+  const extraFamilies = (config.families ?? []).filter((f) => f.family !== primaryFamily)
+
+  // The primary family always leads the list; no extras means single-family mode
+  const setFamilies = (primary: string, extras: AprilTagFamilyConfig[]) => {
+    const rest = extras.filter((f) => f.family !== primary)
+    onChange({ family: primary, families: rest.length > 0 ? [{ family: primary }, ...rest] : [] })
+  }
+
+  const toggleExtraFamily = (family: string, enabled: boolean) => {
+    const rest = extraFamilies.filter((f) => f.family !== family)
+    setFamilies(primaryFamily, enabled ? [...rest, { family }] : rest)
+  }
+
+  const setExtraFamilySize = (family: string, size: number | undefined) => {
+    setFamilies(
+      primaryFamily,
+      extraFamilies.map((f) => (f.family === family ? { ...f, tag_size_m: size } : f))
+    )
+  }
+
   return (
     <div className="space-y-6">
       <div className="grid grid-cols-1 lg:grid-cols-2 gap-6">
@@ -32,7 +53,7 @@ export const AprilTagForm = memo(function AprilTagForm({
 
           <div className="space-y-2">
             <Label>Target Family</Label>
-            <Select value={config.family as string} onValueChange={(value) => onChange({ family: value })}>
+            <Select value={primaryFamily} onValueChange={(value) => setFamilies(value, extraFamilies)}>
               <SelectTrigger>
                 <SelectValue />
               </SelectTrigger>
@@ -46,6 +67,39 @@ export const AprilTagForm = memo(function AprilTagForm({
             </Select>
           </div>
 
+          <div className="space-y-2">
+            <Label>Additional Families</Label>
+            <p className="text-xs text-muted-foreground">
+              Decoded in the same detection pass. Leave the size empty to use the tag size below.
+            </p>
+            {TAG_FAMILIES.filter((family) => family !== primaryFamily).map((family) => {
+              const extra = extraFamilies.find((f) => f.family === family)
+              return (
+                <div key={family} className="flex items-center gap-2">
+                  <Switch
+                    checked={!!extra}
+                    onCheckedChange={(checked) => toggleExtraFamily(family, checked)}
+                  />
+                  <Label className="w-28">{family.replace('tag', '')}</Label>
+                  {extra && (
+                    <Input
+                      type="number"
+                      step="0.001"
+                      min="0.001"
+                      placeholder="Size (m)"
+                      value={extra.tag_size_m ?? ''}
+                      onChange={(e) => {
+                        const size = parseFloat(e.target.value)
+                        setExtraFamilySize(family, Number.isNaN(size) ? undefined : size)
+                      }}
+                      className="w-28"
+                    />
+                  )}
+                </div>
+              )
+            })}
+          </div>
+
           <div className="space-y-2">
             <Label>Tag Size (m)</Label>
             <Input
@@ -178,6 +232,7 @@ export const AprilTagForm = memo(function AprilTagForm({
               <TableHeader>
                 <TableRow>
                   <TableHead>ID</TableHead>
+                  <TableHead>Family</TableHead>
                   <TableHead>X (m)</TableHead>
                   <TableHead>Y (m)</TableHead>
                   <TableHead>Z (m)</TableHead>
@@ -189,14 +244,15 @@ export const AprilTagForm = memo(function AprilTagForm({
               <TableBody>
                 {results.length === 0 ? (
                   <TableRow>
-                    <TableCell colSpan={7} className="text-center text-muted-foreground">
+                    <TableCell colSpan={8} className="text-center text-muted-foreground">
                       No targets detected
                     </TableCell>
                   </TableRow>
                 ) : (
                   results.map((target) => (
-                    <TableRow key={target.id}>
+                    <TableRow key={`${target.family ?? ''}-${target.id}`}>
                       <TableCell>{target.id}</TableCell>
+                      <TableCell>{target.family?.replace('tag', '') ?? '—'}</TableCell>
                       <TableCell>{target.pose_relative?.translation?.x?.toFixed(3) ?? 'N/A'}</TableCell>
                       <TableCell>{target.pose_relative?.translation?.y?.toFixed(3) ?? 'N/A'}</TableCell>
                       <TableCell>{target.pose_relative?.translation?.z?.toFixed(3) ?? 'N/A'}</TableCell>
@@ -1,8 +1,9 @@
 import { memo } from 'react'
-import type { PipelineConfig, MLDetection } from '@/types'
+import type { PipelineConfig, MLDetection, MLInferenceInfo, OnnxAutoSelection } from '@/types'
 import { Input } from '@/components/ui/input'
 import { Label } from '@/components/ui/label'
 import { Button } from '@/components/ui/button'
+import { Switch } from '@/components/ui/switch'
 import { Table, TableBody, TableCell, TableHead, TableHeader, TableRow } from '@/components/ui/table'
 import {
   Select,
@@ -17,6 +18,7 @@ interface MLFormProps {
   config: PipelineConfig
   onChange: (updates: Partial<PipelineConfig>) => void
   results: MLDetection[]
+  inference: MLInferenceInfo | null
   labelOptions: string[]
   onFileUpload: (event: React.ChangeEvent<HTMLInputElement>, type: 'model' | 'labels') => void
   onFileDelete: (type: 'model' | 'labels') => void
@@ -26,6 +28,7 @@ export const MLForm = memo(function MLForm({
   config,
   onChange,
   results,
+  inference,
   labelOptions,
   onFileUpload,
   onFileDelete,
@@ -35,6 +38,10 @@ export const MLForm = memo(function MLForm({
   // Extract available ONNX providers from the ML availability data
   const onnxProviders = (mlAvailability?.onnx as { providers?: string[] })?.providers ?? []
 
+  // Provider the startup benchmark picked for this model, when accelerator is auto
+  const autoSelection = (mlAvailability?.onnx as { auto_selection?: OnnxAutoSelection[] })?.auto_selection ?? []
+  const autoPick = autoSelection.find((s) => s.model === config.model_filename)
+
   return (
     <div className="space-y-6">
       <div className="grid grid-cols-1 lg:grid-cols-2 gap-6">
@@ -52,6 +59,13 @@ export const MLForm = memo(function MLForm({
               </SelectTrigger>
               <SelectContent>
                 <SelectItem value="none">CPU (Default)</SelectItem>
+                <SelectItem value="auto">Auto (fastest measured)</SelectItem>
+                {onnxProviders.includes('XnnpackExecutionProvider') && (
+                  <SelectItem value="xnnpack">XNNPACK (ARM/x86 CPU)</SelectItem>
+                )}
+                {onnxProviders.includes('OpenVINOExecutionProvider') && (
+                  <SelectItem value="openvino">Intel OpenVINO</SelectItem>
+                )}
                 {onnxProviders.includes('CUDAExecutionProvider') && (
                   <SelectItem value="cuda">NVIDIA CUDA</SelectItem>
                 )}
@@ -66,6 +80,35 @@ export const MLForm = memo(function MLForm({
             <p className="text-xs text-muted-foreground">
               Available providers: {onnxProviders.length > 0 ? onnxProviders.join(', ') : 'Loading...'}
             </p>
+            {config.accelerator === 'auto' && autoPick && (
+              <p className="text-xs text-muted-foreground">
+                Selected {autoPick.provider} (
+                {Object.entries(autoPick.median_ms)
+                  .map(([provider, ms]) => `${provider.replace('ExecutionProvider', '')} ${ms.toFixed(1)} ms`)
+                  .join(', ')}
+                )
+              </p>
+            )}
+          </div>
+
+          <div className="space-y-2">
+            <Label>Inference Threads (0 = default)</Label>
+            <Input
+              type="number"
+              min="0"
+              max="64"
+              step="1"
+              value={config.provider_threads ?? 0}
+              onChange={(e) => onChange({ provider_threads: parseInt(e.target.value) })}
+            />
+          </div>
+
+          <div className="flex items-center gap-2">
+            <Switch
+              checked={config.provider_fp16 ?? false}
+              onCheckedChange={(checked) => onChange({ provider_fp16: checked })}
+            />
+            <Label>FP16 inference (OpenVINO, TensorRT)</Label>
           </div>
 
           <div className="space-y-2">
@@ -134,6 +177,31 @@ export const MLForm = memo(function MLForm({
             />
           </div>
 
+          <div className="space-y-2">
+            <Label>Mask Detections (segmentation models)</Label>
+            <Input
+              type="number"
+              min="0"
+              max="100"
+              step="1"
+              value={config.mask_top_k ?? 10}
+              onChange={(e) => onChange({ mask_top_k: parseInt(e.target.value) })}
+            />
+            <p className="text-sm text-muted-foreground">Outlines are computed only for the highest-scoring detections</p>
+          </div>
+
+          <div className="space-y-2">
+            <Label>Mask Threshold</Label>
+            <Input
+              type="number"
+              min="0.05"
+              max="0.95"
+              step="0.05"
+              value={config.mask_threshold ?? 0.5}
+              onChange={(e) => onChange({ mask_threshold: parseFloat(e.target.value) })}
+            />
+          </div>
+
           <div className="space-y-2">
             <Label>Target Classes</Label>
             <select
@@ -160,6 +228,13 @@ export const MLForm = memo(function MLForm({
 
         <div className="space-y-4">
           <h4 className="font-semibold">Live Detections</h4>
+          {inference && (
+            <p className="text-xs text-muted-foreground">
+              Input {inference.input_size[0]}×{inference.input_size[1]}
+              {inference.compute_saved_pct !== undefined && inference.compute_saved_pct > 0 &&
+                ` (${inference.compute_saved_pct.toFixed(0)}% less compute than ${inference.square_size}×${inference.square_size})`}
+            </p>
+          )}
           <div className="overflow-x-auto">
             <Table>
               <TableHeader>
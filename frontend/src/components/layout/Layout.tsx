@@ -8,7 +8,8 @@ import {
   Activity,
   Menu,
   X,
-  Scan
+  Scan,
+  Network
 } from 'lucide-react'
 
 const navigation = [
@@ -16,6 +17,7 @@ const navigation = [
   { name: 'Monitoring', href: '/monitoring', icon: Activity },
   { name: 'Cameras', href: '/cameras', icon: Camera },
   { name: 'Calibration', href: '/calibration', icon: Scan },
+  { name: 'Cluster', href: '/cluster', icon: Network },
   { name: 'Settings', href: '/settings', icon: Settings },
 ]
 
@@ -25,6 +25,7 @@ export const DEFAULT_CAMERA_CONTROLS = {
   orientation: 0,
   exposure_mode: 'auto' as const,
   exposure_value: 500,
+  alternate_exposure_value: null,
   exposure_min: 0,
   exposure_max: 10000,
   exposure_step: 1,
@@ -68,8 +69,13 @@ export const ML_DEFAULTS: PipelineConfig = {
   target_classes: [],
   onnx_provider: 'CPUExecutionProvider',
   accelerator: 'none',
+  provider_threads: 0,
+  provider_fp16: false,
   max_detections: 100,
   img_size: 640,
+  mask_top_k: 10,
+  mask_threshold: 0.5,
+  contour_epsilon_px: 2,
   model_filename: '',
   labels_filename: '',
   tflite_delegate: null,
@@ -2,14 +2,15 @@ import { useState, useEffect, useMemo } from 'react'
 
 // Message types from server
 interface WebSocketMessage {
-  type: 'metrics' | 'nt_status' | 'camera_status' | 'pipeline_results' | 'pong'
+  type: 'metrics' | 'nt_status' | 'camera_status' | 'pipeline_results' | 'job' | 'pong'
   data?: unknown
   cameraId?: number
   pipelineId?: number
+  jobId?: string
 }
 
 // Valid message types for runtime validation
-const VALID_MESSAGE_TYPES = ['metrics', 'nt_status', 'camera_status', 'pipeline_results', 'pong'] as const
+const VALID_MESSAGE_TYPES = ['metrics', 'nt_status', 'camera_status', 'pipeline_results', 'job', 'pong'] as const
 
 // Type guard for validating incoming messages
 function isValidWebSocketMessage(data: unknown): data is WebSocketMessage {
@@ -228,6 +229,11 @@ class VisionWebSocketManager {
           subKey = makeSubKey('pipeline_results', { cameraId: msg.cameraId, pipelineId: msg.pipelineId })
         }
         break
+      case 'job':
+        if (msg.jobId !== undefined) {
+          subKey = makeSubKey('job', { jobId: msg.jobId })
+        }
+        break
       default:
         return
     }
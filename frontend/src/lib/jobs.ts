@@ -0,0 +1,46 @@
+import { api } from './api'
+import { getVisionWS } from '@/hooks/useVisionWebSocket'
+import type { Job } from '@/types'
+
+/** Poll interval used alongside the WebSocket, in case it is disconnected */
+const POLL_INTERVAL_MS = 2000
+
+/**
+ * Wait for a background job to finish.
+ * Progress arrives over the WebSocket "job" topic; polling covers a dropped connection.
+ * Resolves with the job result, rejects with the job error.
+ */
+export function waitForJob<T>(jobId: string, onProgress?: (job: Job<T>) => void): Promise<T> {
+  return new Promise((resolve, reject) => {
+    let settled = false
+    let unsubscribe: () => void = () => {}
+    let pollId: ReturnType<typeof setInterval> | undefined
+
+    const finish = () => {
+      settled = true
+      unsubscribe()
+      if (pollId) clearInterval(pollId)
+    }
+
+    const handle = (job: Job<T>) => {
+      if (settled) return
+      onProgress?.(job)
+      if (job.state === 'done') {
+        finish()
+        resolve(job.result as T)
+      } else if (job.state === 'failed') {
+        finish()
+        reject(new Error(job.error || 'Job failed'))
+      }
+    }
+
+    unsubscribe = getVisionWS().subscribe('job', { jobId }, (data) => handle(data as Job<T>))
+
+    pollId = setInterval(() => {
+      api.get<Job<T>>(`/api/jobs/${jobId}`).then(handle).catch((e) => {
+        finish()
+        reject(e)
+      })
+    }, POLL_INTERVAL_MS)
+  })
+}
@@ -1,16 +1,22 @@
 import { useQuery, useMutation, useQueryClient } from '@tanstack/react-query'
 import { api } from './api'
-import type { Camera, Pipeline, PipelineConfig, CameraControls } from '@/types'
+import { waitForJob } from './jobs'
+import type {
+  Camera, Pipeline, PipelineConfig, CameraControls, UsbBandwidthPlan, ClusterStatus, ClusterNodeResult,
+} from '@/types'
 
 // Query Keys
 export const queryKeys = {
   cameras: ['cameras'] as const,
   camera: (id: string) => ['cameras', id] as const,
   cameraControls: (id: string) => ['cameras', id, 'controls'] as const,
+  usbPlan: ['cameras', 'usb_plan'] as const,
   pipelines: (cameraId: string) => ['pipelines', cameraId] as const,
   pipeline: (id: string) => ['pipelines', 'detail', id] as const,
   pipelineLabels: (id: string) => ['pipelines', id, 'labels'] as const,
   mlAvailability: ['ml', 'availability'] as const,
+  clusterStatus: ['cluster', 'status'] as const,
+  clusterNodeResults: (nodeId: string) => ['cluster', 'nodes', nodeId, 'results'] as const,
 }
 
 /**
@@ -23,6 +29,16 @@ export function useCameras() {
   })
 }
 
+/**
+ * Fetch the USB bandwidth plan (bus budgets and the mode chosen per camera).
+ */
+export function useUsbPlan() {
+  return useQuery({
+    queryKey: queryKeys.usbPlan,
+    queryFn: () => api.get<UsbBandwidthPlan>('/api/cameras/usb_plan'),
+  })
+}
+
 /**
  * Fetch camera controls (exposure, gain, orientation).
  */
@@ -106,11 +122,14 @@ export function useDeletePipeline(cameraId: string) {
 
 /**
  * Update pipeline configuration.
+ * Resolves once the running pipeline has applied it (a model may reload).
  */
 export function useUpdatePipelineConfig(pipelineId: string) {
   return useMutation({
-    mutationFn: (config: PipelineConfig) =>
-      api.put(`/api/pipelines/${pipelineId}/config`, config),
+    mutationFn: async (config: PipelineConfig) => {
+      const { job_id } = await api.put<{ job_id: string }>(`/api/pipelines/${pipelineId}/config`, config)
+      return waitForJob(job_id)
+    },
   })
 }
 
@@ -142,8 +161,10 @@ export function useUploadPipelineFile(pipelineId: string) {
   const queryClient = useQueryClient()
 
   return useMutation({
-    mutationFn: (formData: FormData) =>
-      api.uploadFile(`/api/pipelines/${pipelineId}/files`, formData),
+    mutationFn: async (formData: FormData) => {
+      const { job_id } = await api.uploadFile<{ job_id: string }>(`/api/pipelines/${pipelineId}/files`, formData)
+      return waitForJob(job_id)
+    },
     onSuccess: () => {
       queryClient.invalidateQueries({ queryKey: queryKeys.pipelineLabels(pipelineId) })
     },
@@ -164,3 +185,26 @@ export function useDeletePipelineFile(pipelineId: string) {
     },
   })
 }
+
+/**
+ * Fetch cluster role, clock sync and, on the leader, the follower nodes.
+ */
+export function useClusterStatus() {
+  return useQuery({
+    queryKey: queryKeys.clusterStatus,
+    queryFn: () => api.get<ClusterStatus>('/api/cluster/status'),
+    refetchInterval: 2000,
+  })
+}
+
+/**
+ * Fetch the latest results the leader received from a follower.
+ */
+export function useClusterNodeResults(nodeId: string | null) {
+  return useQuery({
+    queryKey: queryKeys.clusterNodeResults(nodeId ?? ''),
+    queryFn: () => api.get<ClusterNodeResult[]>(`/api/cluster/nodes/${encodeURIComponent(nodeId ?? '')}/results`),
+    enabled: !!nodeId,
+    refetchInterval: 1000,
+  })
+}
@@ -23,6 +23,7 @@ import {
 import { StatusBadge } from '@/components/shared'
 import { toast } from '@/hooks/use-toast'
 import { api } from '@/lib/api'
+import { useUsbPlan } from '@/lib/queries'
 import { useAppStore } from '@/store/useAppStore'
 import { useCameraStatus } from '@/hooks/useCameraStatus'
 import type { Camera, DeviceInfo } from '@/types'
@@ -104,6 +105,7 @@ export default function Cameras() {
   const setCameras = useAppStore((state) => state.setCameras)
   const updateCamera = useAppStore((state) => state.updateCamera)
   const deleteCamera = useAppStore((state) => state.deleteCamera)
+  const { data: usbPlan, refetch: refetchUsbPlan } = useUsbPlan()
 
   const [addModalOpen, setAddModalOpen] = useState(false)
   const [editModalOpen, setEditModalOpen] = useState(false)
@@ -143,6 +145,7 @@ export default function Cameras() {
     try {
       const data = await api.get<Camera[]>('/api/cameras')
       setCameras(data)
+      refetchUsbPlan()
     } catch (error) {
       toast({
         variant: 'destructive',
@@ -606,6 +609,70 @@ export default function Cameras() {
         </CardContent>
       </Card>
 
+      {usbPlan && usbPlan.cameras.length > 0 && (
+        <Card data-testid="usb-plan">
+          <CardHeader>
+            <CardTitle>USB Bandwidth</CardTitle>
+            <CardDescription>
+              Capture modes chosen so every camera on a shared bus fits its bandwidth
+            </CardDescription>
+          </CardHeader>
+          <CardContent className="space-y-4">
+            {usbPlan.buses.length > 0 && (
+              <div className="flex flex-wrap gap-4 text-sm">
+                {usbPlan.buses.map((bus) => (
+                  <div key={bus.bus} className="flex items-center gap-2">
+                    <span className="font-medium">Bus {bus.bus}</span>
+                    <span className="text-muted">
+                      {bus.allocated_mbps.toFixed(0)} / {bus.budget_mbps.toFixed(0)} Mbps
+                      ({bus.speed_mbps >= 5000 ? 'USB 3' : 'USB 2'})
+                    </span>
+                    {bus.oversubscribed && (
+                      <StatusBadge status="error" label="Oversubscribed" />
+                    )}
+                  </div>
+                ))}
+              </div>
+            )}
+            <Table>
+              <TableHeader>
+                <TableRow>
+                  <TableHead>Camera</TableHead>
+                  <TableHead>Bus</TableHead>
+                  <TableHead>Mode</TableHead>
+                  <TableHead>Format</TableHead>
+                  <TableHead className="text-right">Bandwidth</TableHead>
+                </TableRow>
+              </TableHeader>
+              <TableBody>
+                {usbPlan.cameras.map((alloc) => (
+                  <TableRow key={alloc.camera_id}>
+                    <TableCell className="font-medium">{alloc.camera_name}</TableCell>
+                    <TableCell className="text-sm">
+                      {alloc.bus !== null ? (
+                        `${alloc.bus} (${alloc.device_path})`
+                      ) : (
+                        <span className="text-muted">Unknown</span>
+                      )}
+                    </TableCell>
+                    <TableCell className="text-sm">
+                      {alloc.width}x{alloc.height} @ {alloc.fps} FPS
+                      {alloc.reduced && (
+                        <StatusBadge status="warning" label="Reduced" className="ml-2" />
+                      )}
+                    </TableCell>
+                    <TableCell className="text-sm">{alloc.fourcc ?? '—'}</TableCell>
+                    <TableCell className="text-right text-sm">
+                      {alloc.bus !== null ? `~${alloc.estimated_mbps.toFixed(0)} Mbps` : '—'}
+                    </TableCell>
+                  </TableRow>
+                ))}
+              </TableBody>
+            </Table>
+          </CardContent>
+        </Card>
+      )}
+
       {/* Add Camera Modal */}
       <Dialog open={addModalOpen} onOpenChange={handleAddModalClose}>
         <DialogContent className="max-w-md" data-testid="add-camera-modal">
@@ -0,0 +1,259 @@
+import { useState } from 'react'
+import { Network, Server, AlertCircle } from 'lucide-react'
+import { Card, CardContent, CardDescription, CardHeader, CardTitle } from '@/components/ui/card'
+import { Table, TableBody, TableCell, TableHead, TableHeader, TableRow } from '@/components/ui/table'
+import { Badge } from '@/components/ui/badge'
+import { Button } from '@/components/ui/button'
+import { MJPEGStream } from '@/components/shared/MJPEGStream'
+import { useClusterStatus, useClusterNodeResults } from '@/lib/queries'
+import type { ClusterNode } from '@/types'
+
+interface SelectedStream {
+  nodeId: string
+  label: string
+  url: string
+}
+
+export default function Cluster() {
+  const { data: status, isLoading, error } = useClusterStatus()
+  const [selected, setSelected] = useState<SelectedStream | null>(null)
+  const { data: nodeResults } = useClusterNodeResults(selected?.nodeId ?? null)
+
+  if (isLoading) {
+    return (
+      <div className="p-6">
+        <div className="flex items-center justify-center h-96">
+          <div className="flex flex-col items-center gap-2">
+            <div className="h-8 w-8 animate-spin rounded-full border-4 border-[var(--color-border-strong)] border-t-[var(--color-primary)]"></div>
+            <p className="text-sm text-muted">Loading cluster status...</p>
+          </div>
+        </div>
+      </div>
+    )
+  }
+
+  if (error || !status) {
+    return (
+      <div className="p-6">
+        <div className="flex items-center justify-center h-96">
+          <div className="text-center">
+            <AlertCircle className="h-12 w-12 text-[var(--color-danger)] mx-auto mb-4" />
+            <h2 className="text-xl font-semibold mb-2">Cluster status unavailable</h2>
+            <p className="text-muted">{error instanceof Error ? error.message : 'No response from the backend'}</p>
+          </div>
+        </div>
+      </div>
+    )
+  }
+
+  const nodes = status.nodes ?? []
+  const relaysFull = status.stream_relays.active >= status.stream_relays.max
+
+  // One proxied stream at a time; each open stream holds a relay on the leader
+  const openStream = (node: ClusterNode, label: string, url: string) => {
+    setSelected({ nodeId: node.node_id, label: `${node.node_id} · ${label}`, url })
+  }
+
+  return (
+    <div className="p-6 space-y-6">
+      <div>
+        <h1 className="text-3xl font-semibold mb-2" data-testid="page-title-cluster">
+          Cluster
+        </h1>
+        <p className="text-muted">Coprocessors in this cluster and their proxied streams</p>
+      </div>
+
+      <div className="grid grid-cols-1 md:grid-cols-3 gap-4">
+        <Card>
+          <CardHeader className="flex flex-row items-center justify-between space-y-0 pb-2">
+            <CardTitle className="text-sm font-medium">This Node</CardTitle>
+            <Server className="h-4 w-4 text-muted" />
+          </CardHeader>
+          <CardContent>
+            <div className="text-2xl font-bold capitalize">{status.role}</div>
+            <p className="text-xs text-muted mt-2">{status.node_id}</p>
+          </CardContent>
+        </Card>
+
+        {status.role === 'leader' && (
+          <>
+            <Card>
+              <CardHeader className="flex flex-row items-center justify-between space-y-0 pb-2">
+                <CardTitle className="text-sm font-medium">Followers Online</CardTitle>
+                <Network className="h-4 w-4 text-muted" />
+              </CardHeader>
+              <CardContent>
+                <div className="text-2xl font-bold">
+                  {nodes.filter((n) => n.online).length} / {nodes.length}
+                </div>
+                <p className="text-xs text-muted mt-2">
+                  Stream relays: {status.stream_relays.active} / {status.stream_relays.max}
+                </p>
+              </CardContent>
+            </Card>
+
+            <Card>
+              <CardHeader className="pb-2">
+                <CardTitle className="text-sm font-medium">Fused Robot Pose</CardTitle>
+              </CardHeader>
+              <CardContent>
+                {status.fused_pose ? (
+                  <>
+                    <div className="text-lg font-bold font-mono">
+                      {status.fused_pose.pose.translation.x.toFixed(2)}, {status.fused_pose.pose.translation.y.toFixed(2)},{' '}
+                      {status.fused_pose.pose.translation.z.toFixed(2)} m
+                    </div>
+                    <p className="text-xs text-muted mt-2">
+                      {status.fused_pose.tags_used} tags · {status.fused_pose.sources.length} sources ·{' '}
+                      {status.fused_pose.age_ms} ms old
+                    </p>
+                  </>
+                ) : (
+                  <p className="text-sm text-muted">No pose yet</p>
+                )}
+              </CardContent>
+            </Card>
+          </>
+        )}
+
+        {status.role === 'follower' && status.clock && (
+          <Card className="md:col-span-2">
+            <CardHeader className="pb-2">
+              <CardTitle className="text-sm font-medium">Leader</CardTitle>
+            </CardHeader>
+            <CardContent>
+              <div className="text-lg font-bold font-mono">{status.leader}</div>
+              <p className="text-xs text-muted mt-2">
+                {status.clock.synced
+                  ? `Clock offset ${status.clock.offset_us} µs · RTT ${status.clock.rtt_us} µs`
+                  : 'Clock not synced'}
+                {' · '}
+                {status.results_sent ?? 0} results sent
+              </p>
+            </CardContent>
+          </Card>
+        )}
+      </div>
+
+      {status.role === 'standalone' && (
+        <Card>
+          <CardContent className="py-8">
+            <div className="text-center">
+              <Network className="h-12 w-12 text-muted mx-auto mb-4 opacity-50" />
+              <p className="text-muted">Cluster mode is off</p>
+              <p className="text-sm text-subtle mt-1">
+                Set VISION_CLUSTER_ROLE to leader or follower to join coprocessors
+              </p>
+            </div>
+          </CardContent>
+        </Card>
+      )}
+
+      {status.role === 'leader' && (
+        <Card>
+          <CardHeader>
+            <CardTitle>Follower Nodes</CardTitle>
+            <CardDescription>Streams are relayed through this node, so they open from any network the UI can reach</CardDescription>
+          </CardHeader>
+          <CardContent>
+            {nodes.length === 0 ? (
+              <p className="text-sm text-muted">No followers have connected yet</p>
+            ) : (
+              <Table>
+                <TableHeader>
+                  <TableRow>
+                    <TableHead>Node</TableHead>
+                    <TableHead>Status</TableHead>
+                    <TableHead>Results</TableHead>
+                    <TableHead>Streams</TableHead>
+                  </TableRow>
+                </TableHeader>
+                <TableBody>
+                  {nodes.map((node) => (
+                    <TableRow key={node.node_id}>
+                      <TableCell className="font-medium">
+                        <div className="flex flex-col">
+                          <span>{node.node_id}</span>
+                          <span className="text-xs text-muted">{node.address}</span>
+                        </div>
+                      </TableCell>
+                      <TableCell>
+                        <Badge variant={node.online ? 'success' : 'destructive'}>
+                          {node.online ? 'Online' : 'Offline'}
+                        </Badge>
+                        <div className="text-xs text-muted mt-1">{node.last_seen_ms} ms ago</div>
+                      </TableCell>
+                      <TableCell>{node.results_received}</TableCell>
+                      <TableCell>
+                        <div className="flex flex-wrap gap-2">
+                          {node.pipelines.map((p) => (
+                            <div key={p.pipeline_id} className="flex gap-1">
+                              <Button
+                                size="sm"
+                                variant="outline"
+                                disabled={!node.online || (relaysFull && selected?.url !== p.camera_stream)}
+                                onClick={() => openStream(node, `camera ${p.camera_id}`, p.camera_stream)}
+                              >
+                                Camera {p.camera_id}
+                              </Button>
+                              <Button
+                                size="sm"
+                                variant="outline"
+                                disabled={!node.online || (relaysFull && selected?.url !== p.stream)}
+                                onClick={() => openStream(node, `pipeline ${p.pipeline_id}`, p.stream)}
+                              >
+                                Pipeline {p.pipeline_id}
+                              </Button>
+                            </div>
+                          ))}
+                          {node.pipelines.length === 0 && <span className="text-xs text-muted">No results yet</span>}
+                        </div>
+                      </TableCell>
+                    </TableRow>
+                  ))}
+                </TableBody>
+              </Table>
+            )}
+          </CardContent>
+        </Card>
+      )}
+
+      {selected && (
+        <div className="grid grid-cols-1 lg:grid-cols-3 gap-4">
+          <Card className="lg:col-span-2">
+            <CardHeader className="flex flex-row items-center justify-between space-y-0">
+              <CardTitle>{selected.label}</CardTitle>
+              <Button size="sm" variant="outline" onClick={() => setSelected(null)}>
+                Close
+              </Button>
+            </CardHeader>
+            <CardContent>
+              <MJPEGStream key={selected.url} src={selected.url} alt={selected.label} className="w-full" />
+            </CardContent>
+          </Card>
+
+          <Card>
+            <CardHeader>
+              <CardTitle>Latest Results</CardTitle>
+              <CardDescription>{selected.nodeId}</CardDescription>
+            </CardHeader>
+            <CardContent className="space-y-3">
+              {(nodeResults ?? []).map((r) => (
+                <div key={r.pipeline_id} className="text-sm">
+                  <div className="font-medium">
+                    Pipeline {r.pipeline_id} · {r.pipeline_type}
+                  </div>
+                  <div className="text-xs text-muted">
+                    {Array.isArray(r.detections) ? `${r.detections.length} detections` : 'Flow'} ·{' '}
+                    {r.processing_time_ms.toFixed(1)} ms · {r.age_ms} ms old
+                  </div>
+                </div>
+              ))}
+              {(nodeResults ?? []).length === 0 && <p className="text-sm text-muted">No results</p>}
+            </CardContent>
+          </Card>
+        </div>
+      )}
+    </div>
+  )
+}
@@ -116,6 +116,7 @@ export default function Dashboard() {
         orientation: controlsData.orientation ?? 0,
         exposure_mode: controlsData.exposure_mode || 'auto',
         exposure_value: controlsData.exposure_value ?? 500,
+        alternate_exposure_value: controlsData.alternate_exposure_value ?? null,
         exposure_min: controlsData.exposure_min ?? 0,
         exposure_max: controlsData.exposure_max ?? 10000,
         exposure_step: controlsData.exposure_step ?? 1,
@@ -217,6 +218,7 @@ export default function Dashboard() {
         ml: (resultsData.detections as PipelineResults['ml']) || [],
         robotPose: null,
         processingTimeMs: (resultsData.processing_time_ms as number) || null,
+        inference: (resultsData.inference as PipelineResults['inference']) || null,
       }
     }
 
@@ -106,6 +106,8 @@ export default function Monitoring() {
             )}
             <p className="text-xs text-muted mt-2">
               {system.cpu_temperature > 70 ? 'Hot' : 'Normal'}
+              {system.power_watts > 0 && ` · ${system.power_watts.toFixed(1)} W`}
+              {system.power_mode === 'idle' && ' · Idle (robot disabled)'}
             </p>
           </CardContent>
         </Card>
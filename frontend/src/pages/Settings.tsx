@@ -229,11 +229,15 @@ export default function Settings() {
   const handleRefreshSpinnaker = async () => {
     setIsLoading(true)
     try {
-      const data = await api.get<{ available: boolean }>('/api/spinnaker/status')
+      const data = await api.get<{ available: boolean; state: string }>('/api/spinnaker/status')
       setSpinnakerAvailable(data.available)
       toast({
         title: 'Spinnaker status refreshed',
-        description: data.available ? 'SDK is available' : 'SDK not available',
+        description: data.available
+          ? 'SDK is available'
+          : data.state === 'initializing'
+            ? 'SDK is initializing, refresh again shortly'
+            : 'SDK not available',
       })
     } catch (error) {
       toast({
@@ -34,8 +34,18 @@ export interface Pipeline {
 /**
  * AprilTag pipeline configuration.
  */
+export interface AprilTagFamilyConfig {
+  family: string
+  /** Defaults to the pipeline's tag_size_m */
+  tag_size_m?: number
+  /** Field layout for this family; defaults to the selected field */
+  field?: string
+}
+
 export interface AprilTagConfig {
   family?: string
+  /** Families decoded together in one pass; empty = just `family` */
+  families?: AprilTagFamilyConfig[]
   tag_size_m?: number
   threads?: number
   decimate?: number
@@ -69,6 +79,21 @@ export interface MLConfig {
   tflite_delegate?: string | null
   max_detections?: number
   img_size?: number
+  provider_threads?: number
+  provider_fp16?: boolean
+  mask_top_k?: number
+  mask_threshold?: number
+  contour_epsilon_px?: number
+}
+
+/**
+ * Provider picked by the startup benchmark for one model (accelerator: 'auto').
+ */
+export interface OnnxAutoSelection {
+  model: string
+  img_size: number
+  provider: string
+  median_ms: Record<string, number>
 }
 
 /**
@@ -86,6 +111,8 @@ export interface CameraControls {
   orientation: number
   exposure_mode: 'auto' | 'manual'
   exposure_value: number
+  /** Manual mode: alternate frames use this exposure (null = single exposure) */
+  alternate_exposure_value?: number | null
   exposure_min?: number
   exposure_max?: number
   exposure_step?: number
@@ -96,16 +123,114 @@ export interface CameraControls {
   gain_step?: number
 }
 
+export interface UsbCameraAllocation {
+  camera_id: number
+  camera_name: string
+  /** Root hub number, null when the bus could not be resolved */
+  bus: number | null
+  device_path: string | null
+  device_speed_mbps: number | null
+  width: number
+  height: number
+  fps: number
+  fourcc: 'YUYV' | 'MJPG' | null
+  estimated_mbps: number
+  /** Planner lowered the configured resolution or framerate to fit the bus */
+  reduced: boolean
+}
+
+export interface UsbBusLoad {
+  bus: number
+  speed_mbps: number
+  budget_mbps: number
+  allocated_mbps: number
+  oversubscribed: boolean
+}
+
+export interface UsbBandwidthPlan {
+  buses: UsbBusLoad[]
+  cameras: UsbCameraAllocation[]
+}
+
+export interface Job<T = unknown> {
+  id: string
+  kind: string
+  state: 'queued' | 'running' | 'done' | 'failed'
+  progress: number
+  message: string
+  created: number
+  result?: T
+  error?: string
+}
+
 export interface DeviceInfo {
   identifier: string
   name: string
   camera_type: string
 }
 
+export interface ClusterNodePipeline {
+  pipeline_id: number
+  camera_id: number
+  pipeline_type: string
+  /** Proxied through the leader */
+  stream: string
+  camera_stream: string
+}
+
+export interface ClusterNode {
+  node_id: string
+  address: string
+  http_port: number
+  stream_port: number
+  online: boolean
+  last_seen_ms: number
+  results_received: number
+  pipelines: ClusterNodePipeline[]
+}
+
+export interface ClusterStatus {
+  role: 'standalone' | 'leader' | 'follower'
+  node_id: string
+  running: boolean
+  stream_relays: { active: number; max: number }
+  // Leader
+  port?: number
+  nodes?: ClusterNode[]
+  fused_pose?: {
+    pose: Pose3D
+    tags_used: number
+    sources: string[]
+    age_ms: number
+  } | null
+  // Follower
+  leader?: string
+  results_sent?: number
+  clock?: {
+    synced: boolean
+    offset_us: number
+    rtt_us: number
+    last_sync_age_ms: number
+  }
+}
+
+export interface ClusterNodeResult {
+  pipeline_id: number
+  camera_id: number
+  pipeline_type: string
+  capture_time_us: number
+  age_ms: number
+  processing_time_ms: number
+  detections: unknown
+  robot_pose: Pose3D | null
+  tags_used: number
+}
+
 export interface MetricsSummary {
   pipelines: PipelineMetrics[]
   system: SystemMetrics
   thresholds: MetricsThresholds
+  memory?: MemoryMetrics
 }
 
 export interface PipelineMetrics {
@@ -145,6 +270,10 @@ export interface SystemMetrics {
   ram_used_mb: number
   ram_total_mb: number
   cpu_temperature: number
+  cpu_freq_mhz: number
+  cpu_freq_headroom: number
+  power_watts: number
+  power_mode: 'full' | 'idle'
   active_pipelines: number
 }
 
@@ -155,6 +284,27 @@ export interface MetricsThresholds {
   queue_critical: number
 }
 
+export interface SubsystemMemory {
+  name: string
+  bytes: number
+  peak_bytes: number
+  count: number
+  peak_count: number
+  estimated: boolean
+}
+
+export interface MemoryMetrics {
+  subsystems: SubsystemMemory[]
+  process_rss_bytes: number
+  process_rss_peak_bytes: number
+  sqlite_bytes: number
+  sqlite_peak_bytes: number
+  heap_in_use_bytes: number
+  heap_free_bytes: number
+  heap_mmap_bytes: number
+  heap_mmap_chunks: number
+}
+
 
 
 export interface AprilTagField {
@@ -193,6 +343,7 @@ export interface Pose3D {
 
 export interface AprilTagDetection {
   id: number
+  family?: string
   pose_relative: Pose3D | null
   euler?: EulerAngles
   decision_margin?: number
@@ -216,6 +367,9 @@ export interface MLDetection {
   ta?: number       // Target area as percentage of image (0-100)
   tv?: number       // Valid target (1 = valid, 0 = invalid)
   td?: number       // Distance to target in meters (from depth camera)
+  // Segmentation data (YOLO-seg models)
+  contour?: [number, number][]   // Simplified outline in image pixels
+  centroid?: [number, number]    // Mask centroid in image pixels
 }
 
 export interface RobotPose {
@@ -225,9 +379,21 @@ export interface RobotPose {
   }
 }
 
+/**
+ * ML input shape for the last frame; rectangular inputs skip the square's padding.
+ * The square comparison is only reported for dynamic-shape models.
+ */
+export interface MLInferenceInfo {
+  input_size: [number, number]
+  dynamic: boolean
+  square_size?: number
+  compute_saved_pct?: number
+}
+
 export interface PipelineResults {
   apriltag: AprilTagDetection[]
   ml: MLDetection[]
   robotPose: RobotPose | null
   processingTimeMs: number | null
+  inference?: MLInferenceInfo | null
 }